@@ -0,0 +1,668 @@
+#ifndef QBUF_BROADCAST_HPP
+#define QBUF_BROADCAST_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <qbuf/wait.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace qbuf {
+
+/**
+ * @brief What a `Broadcast` producer does when the slowest reader is a whole ring behind
+ */
+enum class BroadcastMode {
+    lossless, ///< The producer waits (or `try_enqueue` fails) until every reader has moved on
+    lossy,    ///< The producer overwrites; readers that fall behind skip the lost elements
+};
+
+/**
+ * @brief Single-producer multi-reader broadcast ring
+ *
+ * Every element the producer publishes is delivered to every `Source`: each reader has its own
+ * cursor, and dequeueing copies the element out instead of moving it. Positions are 64-bit
+ * sequence numbers that never wrap, so every slot is usable (maximum occupancy `Capacity`).
+ *
+ * Indices follow the SPSC scheme. The producer owns `tail_` and keeps `cached_min_head_`, the
+ * slowest reader's position as of its last scan; it only rescans the reader cursors when the
+ * cached value says there is not enough room. Each reader owns its cursor's `head` and keeps a
+ * reader-local copy of `tail_`, refreshed only when its cached copy runs out.
+ *
+ * In `BroadcastMode::lossy` the producer never waits: it overwrites the oldest slot and readers
+ * never hold it back. Each slot then carries the sequence number of the element it holds,
+ * written like a seqlock; a reader validates it before and after copying the element out, and a
+ * reader that was overrun skips ahead to the oldest element still in the ring. The skipped count
+ * is reported by `Source::lost()`, and `Source::position()` is the sequence number of the next
+ * element, so gaps can be detected per call. Lossy mode requires a trivially copyable `T`.
+ *
+ * @tparam T The type of elements stored in the queue
+ * @tparam Capacity Number of slots (power of two)
+ * @tparam Mode Whether the producer waits for the slowest reader
+ * @tparam Wait Strategy used by the blocking `enqueue`/`dequeue` calls (see qbuf/wait.hpp); all
+ * readers wait on the same object
+ */
+template <
+    typename T, std::size_t Capacity, BroadcastMode Mode = BroadcastMode::lossless,
+    typename Wait = YieldWait>
+class Broadcast {
+public:
+    static_assert(Capacity > 1, "Queue capacity must be greater than 1");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of 2");
+
+    static constexpr bool lossy = Mode == BroadcastMode::lossy;
+    static_assert(
+        !lossy || std::is_trivially_copyable_v<T>,
+        "Lossy broadcast requires a trivially copyable type"
+    );
+
+private:
+    explicit Broadcast(std::size_t readers)
+            : tail_(0), cached_min_head_(0), readers_(readers), cursors_(new Cursor[readers]) {
+        if constexpr (lossy) {
+            for (auto& slot : slots_) {
+                slot.sequence.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Per-reader state. `head` and `attached` are read by the producer; the rest only by the
+    // reader, on its own cache line.
+    struct Cursor {
+        alignas(64) std::atomic<std::uint64_t> head { 0 };
+        std::atomic<bool> attached { true };
+        alignas(64) std::uint64_t cached_tail = 0; // reader-local copy of tail_
+        std::uint64_t lost = 0;                    // elements skipped after overruns (lossy)
+    };
+
+public:
+    // non-copyable
+    Broadcast(const Broadcast&) = delete;
+    Broadcast& operator=(const Broadcast&) = delete;
+    // non-movable
+    Broadcast(Broadcast&&) = delete;
+    Broadcast& operator=(Broadcast&&) = delete;
+
+    /**
+     * @brief Producer-side handle for Broadcast queue
+     *
+     * Provides a restricted interface exposing only enqueue operations and utility methods.
+     * This handle is intended for use by the single producer thread.
+     */
+    class Sink {
+    private:
+        friend class Broadcast;
+        explicit Sink(std::shared_ptr<Broadcast> queue) : queue_(std::move(queue)) { }
+
+    public:
+        // Non-copyable
+        Sink(const Sink&) = delete;
+        Sink& operator=(const Sink&) = delete;
+
+        // Movable
+        Sink(Sink&&) = default;
+        Sink& operator=(Sink&&) = default;
+
+        /**
+         * @brief Try to enqueue a single element
+         *
+         * Always succeeds in lossy mode.
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if the slowest reader is a whole ring behind
+         */
+        bool try_enqueue(const T& value) { return queue_->try_enqueue(value); }
+
+        /**
+         * @brief Try to enqueue a single element (move semantics)
+         *
+         * The value is only moved from if it was enqueued.
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if the slowest reader is a whole ring behind
+         */
+        bool try_enqueue(T&& value) { return queue_->try_enqueue(std::move(value)); }
+
+        /**
+         * @brief Try to enqueue multiple elements
+         *
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @return Number of elements successfully enqueued (`count` in lossy mode)
+         */
+        std::size_t try_enqueue(const T* data, std::size_t count) {
+            return queue_->try_enqueue(data, count);
+        }
+
+        /**
+         * @brief Block until an element can be enqueued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue
+         * @param timeout Maximum time to wait for the slowest reader
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(value, timeout);
+        }
+
+        /**
+         * @brief Block until an element can be enqueued with timeout (move semantics)
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue (moved from only if enqueued)
+         * @param timeout Maximum time to wait for the slowest reader
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(std::move(value), timeout);
+        }
+
+        /**
+         * @brief Block until all elements are enqueued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @param timeout Maximum time to wait for room for all elements
+         * @return true if all elements were enqueued, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(data, count, timeout);
+        }
+
+        /**
+         * @brief Check if every reader has consumed everything
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return queue_->size() == 0; }
+
+        /**
+         * @brief Get the approximate backlog of the slowest attached reader
+         *
+         * Scans every reader cursor.
+         *
+         * @return Approximate number of elements not yet read by the slowest reader
+         */
+        std::size_t size() const { return queue_->size(); }
+
+        /**
+         * @brief Get the maximum number of elements the queue can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+        /**
+         * @brief Get the number of readers whose Source still exists
+         */
+        std::size_t readers() const { return queue_->attached_readers(); }
+
+    private:
+        std::shared_ptr<Broadcast> queue_;
+    };
+
+    /**
+     * @brief Reader-side handle for Broadcast queue
+     *
+     * Provides a restricted interface exposing only dequeue operations and utility methods.
+     * Each Source is one reader with its own position and is intended for use by one thread.
+     * Destroying it detaches the reader, so it no longer holds the producer back.
+     */
+    class Source {
+    private:
+        friend class Broadcast;
+        Source(std::shared_ptr<Broadcast> queue, Cursor* cursor)
+                : queue_(std::move(queue)), cursor_(cursor) { }
+
+    public:
+        ~Source() { detach(); }
+
+        // Non-copyable
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+        // Movable
+        Source(Source&&) = default;
+        Source& operator=(Source&& other) noexcept {
+            if (this != &other) {
+                detach();
+                queue_ = std::move(other.queue_);
+                cursor_ = other.cursor_;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Try to dequeue (copy out) the next element for this reader
+         *
+         * @return std::optional containing the value if successful, std::nullopt if this reader
+         * has caught up with the producer
+         */
+        std::optional<T> try_dequeue() { return queue_->try_dequeue(*cursor_); }
+
+        /**
+         * @brief Try to dequeue (copy out) multiple elements for this reader
+         *
+         * @param data Pointer to output array
+         * @param count Maximum number of elements to dequeue
+         * @return Number of elements successfully dequeued
+         */
+        std::size_t try_dequeue(T* data, std::size_t count) {
+            return queue_->try_dequeue(*cursor_, data, count);
+        }
+
+        /**
+         * @brief Block until an element can be dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param timeout Maximum time to wait for dequeue
+         * @return std::optional containing the element if successful, std::nullopt if timeout
+         * expired
+         */
+        template <typename Rep, typename Period>
+        std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+            return queue_->dequeue(*cursor_, timeout);
+        }
+
+        /**
+         * @brief Block until all elements are dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to output array
+         * @param count Number of elements to dequeue
+         * @param timeout Maximum time to wait for all elements to be dequeued
+         * @return Number of elements successfully dequeued (may be less than count if timeout)
+         */
+        template <typename Rep, typename Period>
+        std::size_t dequeue(
+            T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout
+        ) {
+            return queue_->dequeue(*cursor_, data, count, timeout);
+        }
+
+        /**
+         * @brief Sequence number of the next element this reader will get
+         *
+         * Starts at 0 and counts every element published, including the ones lost in lossy
+         * mode; after a dequeue, `position() - 1` is the sequence number of the last element.
+         */
+        std::uint64_t position() const { return cursor_->head.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Total number of elements this reader skipped because it was overrun
+         *
+         * Always 0 in lossless mode.
+         */
+        std::uint64_t lost() const { return cursor_->lost; }
+
+        /**
+         * @brief Check if this reader has caught up with the producer
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Get the approximate number of elements this reader has not read yet
+         *
+         * @return Approximate backlog, at most `Capacity`
+         */
+        std::size_t size() const { return queue_->backlog(*cursor_); }
+
+        /**
+         * @brief Get the maximum number of elements the queue can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        void detach() {
+            if (!queue_) return;
+            cursor_->attached.store(false, std::memory_order_release);
+            queue_->not_full_.notify(); // a producer may be waiting on this reader
+            queue_.reset();
+        }
+
+        std::shared_ptr<Broadcast> queue_;
+        Cursor* cursor_;
+    };
+
+    /**
+     * @brief Factory method to create a queue with one sink and `readers` sources
+     *
+     * Every Source starts at sequence number 0, so each reader sees every element.
+     *
+     * @param readers Number of readers (at least 1)
+     * @return std::pair<Sink, std::vector<Source>> The producer handle and one handle per reader
+     * @throws std::invalid_argument if `readers` is 0
+     */
+    static std::pair<Sink, std::vector<Source>> make_queue(std::size_t readers) {
+        if (readers == 0) throw std::invalid_argument("Broadcast needs at least one reader");
+        std::shared_ptr<Broadcast> queue(new Broadcast(readers));
+        std::vector<Source> sources;
+        sources.reserve(readers);
+        for (std::size_t i = 0; i < readers; ++i) {
+            sources.push_back(Source(queue, &queue->cursors_[i]));
+        }
+        return { Sink(queue), std::move(sources) };
+    }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    struct LossySlot {
+        std::atomic<std::uint64_t> sequence; // `pos + 1` once position `pos` is written, 0 while
+                                             // the producer overwrites it
+        T value;
+    };
+    using Slot = std::conditional_t<lossy, LossySlot, T>;
+
+    // Slowest attached reader; `tail` if none is attached
+    std::uint64_t min_head(std::uint64_t tail) const {
+        std::uint64_t slowest = tail;
+        for (std::size_t i = 0; i < readers_; ++i) {
+            const Cursor& cursor = cursors_[i];
+            if (!cursor.attached.load(std::memory_order_acquire)) continue;
+            slowest = std::min(slowest, cursor.head.load(std::memory_order_acquire));
+        }
+        return slowest;
+    }
+
+    /**
+     * @brief Number of the next `count` positions from `tail` the producer may write
+     *
+     * Rescans the reader cursors only when the cached slowest position says there is not
+     * enough room. Lossy mode never waits for readers.
+     */
+    std::size_t writable(std::uint64_t tail, std::size_t count) {
+        if constexpr (lossy) {
+            return count;
+        } else {
+            std::size_t available = Capacity - static_cast<std::size_t>(tail - cached_min_head_);
+            if (available < count) {
+                cached_min_head_ = min_head(tail);
+                available = Capacity - static_cast<std::size_t>(tail - cached_min_head_);
+            }
+            return std::min(available, count);
+        }
+    }
+
+    template <typename U>
+    void write(std::uint64_t pos, U&& value) {
+        if constexpr (lossy) {
+            LossySlot& slot = slots_[pos & mask];
+            // Readers still copying the previous lap out of this slot now fail their recheck
+            slot.sequence.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.value = std::forward<U>(value);
+            slot.sequence.store(pos + 1, std::memory_order_release);
+        } else {
+            slots_[pos & mask] = std::forward<U>(value);
+        }
+    }
+
+    void publish(std::uint64_t tail) {
+        tail_.store(tail, std::memory_order_release);
+        not_empty_.notify();
+    }
+
+    template <typename U>
+    bool push(U&& value) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (writable(tail, 1) == 0) return false;
+        write(tail, std::forward<U>(value));
+        publish(tail + 1);
+        return true;
+    }
+
+    bool try_enqueue(const T& value) { return push(value); }
+
+    bool try_enqueue(T&& value) { return push(std::move(value)); }
+
+    std::size_t try_enqueue(const T* data, std::size_t count) {
+        if (count == 0) return 0;
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t to_enqueue = writable(tail, count);
+        if (to_enqueue == 0) return 0;
+
+        if constexpr (lossy) {
+            for (std::size_t i = 0; i < to_enqueue; ++i) write(tail + i, data[i]);
+        } else {
+            // First segment runs to the end of the ring, second wraps around to slot 0
+            const std::size_t index = tail & mask;
+            const std::size_t first_segment = std::min(to_enqueue, Capacity - index);
+            std::copy(data, data + first_segment, slots_.data() + index);
+            std::copy(data + first_segment, data + to_enqueue, slots_.data());
+        }
+        publish(tail + to_enqueue);
+        return to_enqueue;
+    }
+
+    template <typename U, typename Rep, typename Period>
+    bool enqueue_one(U&& value, std::chrono::duration<Rep, Period> timeout) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if (writable(tail, 1) == 0) {
+            const bool ready = not_full_.wait_until(
+                [&] { return writable(tail, 1) != 0; }, std::chrono::steady_clock::now() + timeout
+            );
+            if (!ready) return false;
+        }
+        write(tail, std::forward<U>(value));
+        publish(tail + 1);
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+        return enqueue_one(value, timeout);
+    }
+
+    template <typename Rep, typename Period>
+    bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+        return enqueue_one(std::move(value), timeout);
+    }
+
+    template <typename Rep, typename Period>
+    bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::size_t total_enqueued = try_enqueue(data, count);
+        while (total_enqueued < count) {
+            const bool ready = not_full_.wait_until(
+                [&] {
+                    total_enqueued += try_enqueue(data + total_enqueued, count - total_enqueued);
+                    return total_enqueued == count;
+                },
+                deadline
+            );
+            if (!ready) return false;
+        }
+        return true;
+    }
+
+    // Elements published after `head`, refreshing the reader's cached tail only when its cached
+    // copy holds fewer than `count`
+    std::size_t readable(Cursor& cursor, std::uint64_t head, std::size_t count) {
+        auto available = static_cast<std::size_t>(cursor.cached_tail - head);
+        if (available < count) {
+            cursor.cached_tail = tail_.load(std::memory_order_acquire);
+            available = static_cast<std::size_t>(cursor.cached_tail - head);
+        }
+        return available;
+    }
+
+    /**
+     * @brief Copy up to `count` elements out for a lossy reader, skipping overwritten ones
+     *
+     * An element counts only if its slot holds the expected sequence number both before and
+     * after the copy; otherwise the producer lapped the reader, which restarts at the oldest
+     * position that can still be intact.
+     */
+    std::size_t read_lossy(Cursor& cursor, T* data, std::size_t count) {
+        std::uint64_t head = cursor.head.load(std::memory_order_relaxed);
+        std::size_t n = 0;
+        while (n < count && readable(cursor, head, 1) != 0) {
+            // Positions before `oldest` have certainly been overwritten
+            std::uint64_t oldest =
+                cursor.cached_tail - std::min<std::uint64_t>(cursor.cached_tail, Capacity);
+            if (head >= oldest) {
+                const LossySlot& slot = slots_[head & mask];
+                const auto sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence == head + 1) {
+                    std::memcpy(static_cast<void*>(data + n), &slot.value, sizeof(T));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                        ++n;
+                        ++head;
+                        continue;
+                    }
+                }
+                // Overwritten while we looked: the producer is at least a ring ahead of `head`
+                cursor.cached_tail = tail_.load(std::memory_order_acquire);
+                const std::uint64_t newest = cursor.cached_tail + 1;
+                oldest = std::max(head + 1, newest - std::min<std::uint64_t>(newest, Capacity));
+            }
+            cursor.lost += oldest - head;
+            head = oldest;
+        }
+        cursor.head.store(head, std::memory_order_release);
+        return n;
+    }
+
+    std::optional<T> try_dequeue(Cursor& cursor) {
+        if constexpr (lossy) {
+            T value;
+            if (read_lossy(cursor, &value, 1) == 0) return std::nullopt;
+            return value;
+        } else {
+            const auto head = cursor.head.load(std::memory_order_relaxed);
+            if (readable(cursor, head, 1) == 0) return std::nullopt;
+
+            std::optional<T> value(slots_[head & mask]);
+            cursor.head.store(head + 1, std::memory_order_release);
+            not_full_.notify();
+            return value;
+        }
+    }
+
+    std::size_t try_dequeue(Cursor& cursor, T* data, std::size_t count) {
+        if (count == 0) return 0;
+        if constexpr (lossy) {
+            return read_lossy(cursor, data, count);
+        } else {
+            const auto head = cursor.head.load(std::memory_order_relaxed);
+            const std::size_t to_dequeue = std::min(count, readable(cursor, head, count));
+            if (to_dequeue == 0) return 0;
+
+            const std::size_t index = head & mask;
+            const std::size_t first_segment = std::min(to_dequeue, Capacity - index);
+            std::copy(slots_.data() + index, slots_.data() + index + first_segment, data);
+            std::copy(
+                slots_.data(), slots_.data() + (to_dequeue - first_segment), data + first_segment
+            );
+
+            cursor.head.store(head + to_dequeue, std::memory_order_release);
+            not_full_.notify();
+            return to_dequeue;
+        }
+    }
+
+    template <typename Rep, typename Period>
+    std::optional<T> dequeue(Cursor& cursor, std::chrono::duration<Rep, Period> timeout) {
+        std::optional<T> value = try_dequeue(cursor);
+        if (value.has_value()) return value;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        not_empty_.wait_until(
+            [&] {
+                value = try_dequeue(cursor);
+                return value.has_value();
+            },
+            deadline
+        );
+        return value;
+    }
+
+    template <typename Rep, typename Period>
+    std::size_t dequeue(
+        Cursor& cursor, T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout
+    ) {
+        std::size_t total_dequeued = try_dequeue(cursor, data, count);
+        if (total_dequeued == count) return total_dequeued;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        not_empty_.wait_until(
+            [&] {
+                total_dequeued +=
+                    try_dequeue(cursor, data + total_dequeued, count - total_dequeued);
+                return total_dequeued == count;
+            },
+            deadline
+        );
+        return total_dequeued;
+    }
+
+    std::size_t backlog(const Cursor& cursor) const {
+        const auto tail = tail_.load(std::memory_order_acquire);
+        const auto behind = tail - cursor.head.load(std::memory_order_relaxed);
+        return static_cast<std::size_t>(std::min<std::uint64_t>(behind, Capacity));
+    }
+
+    std::size_t size() const {
+        const auto tail = tail_.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(std::min<std::uint64_t>(tail - min_head(tail), Capacity));
+    }
+
+    std::size_t attached_readers() const {
+        std::size_t attached = 0;
+        for (std::size_t i = 0; i < readers_; ++i) {
+            attached += cursors_[i].attached.load(std::memory_order_relaxed) ? 1 : 0;
+        }
+        return attached;
+    }
+
+    // The producer owns `tail_` and `cached_min_head_`; readers own their cursors
+    alignas(64) std::atomic<std::uint64_t> tail_;
+    alignas(64) std::uint64_t cached_min_head_; // producer-local copy of the slowest head
+    const std::size_t readers_;
+    std::unique_ptr<Cursor[]> cursors_;
+    // The waiting producer parks on `not_full_`, waiting readers on `not_empty_`
+    alignas(64) Wait not_full_;
+    alignas(64) Wait not_empty_;
+    alignas(64) std::array<Slot, Capacity> slots_;
+};
+
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using LossyBroadcast = Broadcast<T, Capacity, BroadcastMode::lossy, Wait>;
+
+template <
+    typename T, std::size_t Capacity, BroadcastMode Mode = BroadcastMode::lossless,
+    typename Wait = YieldWait>
+using BroadcastSource = typename Broadcast<T, Capacity, Mode, Wait>::Source;
+
+template <
+    typename T, std::size_t Capacity, BroadcastMode Mode = BroadcastMode::lossless,
+    typename Wait = YieldWait>
+using BroadcastSink = typename Broadcast<T, Capacity, Mode, Wait>::Sink;
+
+} // namespace qbuf
+#endif // QBUF_BROADCAST_HPP
@@ -0,0 +1,331 @@
+#ifndef QBUF_BYTE_SPSC_HPP
+#define QBUF_BYTE_SPSC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <qbuf/mmap_spsc.hpp>
+#include <qbuf/span.hpp>
+#include <qbuf/wait.hpp>
+#include <utility>
+
+namespace qbuf {
+
+/**
+ * @brief Single-Producer Single-Consumer ring of variable-length byte records
+ *
+ * Built on the double-mapped `MmapSPSC` ring, viewed as 8-byte words. Each record is one header
+ * word holding its length followed by the payload, rounded up to whole words, so every payload
+ * starts 8-byte aligned. Thanks to the mirror a record never splits at the wrap: the producer
+ * writes it in place after `reserve(len)` and the consumer reads it in place as one contiguous
+ * `(data, size)` span.
+ *
+ * Publishing and releasing are one tail / head store per call, regardless of the record count, so
+ * `Source::drain()` releases every record it visits at once and throughput scales with bytes
+ * rather than messages.
+ *
+ * Without the mirror (non-Linux fallback) a record that would run past the end of the buffer is
+ * preceded by a padding record filling the rest of it; the consumer skips padding transparently.
+ *
+ * @tparam Capacity Ring size in bytes (power of two, at least 16)
+ * @tparam Wait Wait strategy of the underlying ring (only relevant for shared rings, see
+ * `create_shared()`)
+ */
+template <std::size_t Capacity, typename Wait = YieldWait>
+class ByteSPSC {
+public:
+    static_assert(Capacity >= 16, "Byte ring capacity must be at least 16 bytes");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Byte ring capacity must be a power of 2");
+
+private:
+    using Word = std::uint64_t;
+    static constexpr std::size_t ring_words = Capacity / sizeof(Word);
+    using Ring = MmapSPSC<Word, ring_words, Wait>;
+
+    // Set in the header of padding records (fallback only); the low bits still hold the length
+    static constexpr Word padding_flag = Word(1) << 63;
+
+    // Header word plus the payload rounded up to whole words
+    static constexpr std::size_t record_words(std::size_t size) {
+        return 1 + (size + sizeof(Word) - 1) / sizeof(Word);
+    }
+
+public:
+    /// Alignment of every record payload
+    static constexpr std::size_t alignment = sizeof(Word);
+
+    /// Largest payload a single record can carry (the ring holds `ring_words - 1` words)
+    static constexpr std::size_t max_record_size = (ring_words - 2) * sizeof(Word);
+
+    /**
+     * @brief Producer-side handle: writes records in place
+     *
+     * Move-only; intended for the single producer thread.
+     */
+    class Sink {
+    private:
+        friend class ByteSPSC;
+        explicit Sink(typename Ring::Sink ring) : ring_(std::move(ring)) { }
+
+    public:
+        // Non-copyable
+        Sink(const Sink&) = delete;
+        Sink& operator=(const Sink&) = delete;
+
+        // Movable
+        Sink(Sink&&) = default;
+        Sink& operator=(Sink&&) = default;
+
+        /**
+         * @brief Reserve a contiguous, 8-byte aligned region for a record of `size` bytes
+         *
+         * Nothing is visible to the consumer until `commit()`. A later `reserve()` replaces an
+         * uncommitted reservation.
+         *
+         * @param size Payload size in bytes, at most `max_record_size`
+         * @return Writable span of exactly `size` bytes, or an empty span with a null `data()` if
+         * the ring does not have room (or `size` is too large)
+         */
+        Span<std::byte> reserve(std::size_t size) {
+            pending_ = nullptr;
+            if (size > max_record_size) return { };
+            const std::size_t words = record_words(size);
+
+            if constexpr (!Ring::is_mirrored) {
+                // Pad out the end of the buffer so the record starts at word 0
+                const std::size_t to_end = ring_words - tail_;
+                if (words > to_end) {
+                    auto pad = ring_.reserve(to_end);
+                    if (pad.size() < to_end) return { };
+                    pad[0] = padding_flag | ((to_end - 1) * sizeof(Word));
+                    ring_.commit(to_end);
+                    tail_ = 0;
+                }
+            }
+
+            auto slots = ring_.reserve(words);
+            if (slots.size() < words) return { };
+            pending_ = slots.data();
+            pending_size_ = size;
+            return Span<std::byte>(reinterpret_cast<std::byte*>(pending_ + 1), size);
+        }
+
+        /**
+         * @brief Publish the last reservation at its full size
+         */
+        void commit() { commit(pending_size_); }
+
+        /**
+         * @brief Publish the last reservation, shrunk to its first `size` bytes
+         *
+         * Lets a producer reserve for the largest possible message and commit what it wrote.
+         * No-op without an outstanding reservation.
+         *
+         * @param size Bytes written; must not exceed the size passed to `reserve()`
+         */
+        void commit(std::size_t size) {
+            if (pending_ == nullptr) return;
+            pending_[0] = size;
+            const std::size_t words = record_words(size);
+            ring_.commit(words);
+            if constexpr (!Ring::is_mirrored) tail_ = (tail_ + words) % ring_words;
+            pending_ = nullptr;
+        }
+
+        /**
+         * @brief Copy `size` bytes into a new record and publish it
+         *
+         * @param data Payload to copy
+         * @param size Payload size in bytes, at most `max_record_size`
+         * @return true if successful, false if the ring does not have room
+         */
+        bool try_enqueue(const void* data, std::size_t size) {
+            auto record = reserve(size);
+            if (record.data() == nullptr) return false;
+            if (size != 0) std::memcpy(record.data(), data, size);
+            commit();
+            return true;
+        }
+
+        /**
+         * @brief Approximate number of ring bytes in use, headers and padding included
+         */
+        std::size_t size() const { return ring_.size() * sizeof(Word); }
+
+        /**
+         * @brief Check if the ring is empty (approximate)
+         */
+        bool empty() const { return ring_.empty(); }
+
+    private:
+        typename Ring::Sink ring_;
+        Word* pending_ = nullptr; // header word of the outstanding reservation
+        std::size_t pending_size_ = 0;
+        std::size_t tail_ = 0; // word index of the next record; only tracked without the mirror
+    };
+
+    /**
+     * @brief Consumer-side handle: reads records in place
+     *
+     * Move-only; intended for the single consumer thread.
+     */
+    class Source {
+    private:
+        friend class ByteSPSC;
+        explicit Source(typename Ring::Source ring) : ring_(std::move(ring)) { }
+
+    public:
+        // Non-copyable
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+        // Movable
+        Source(Source&&) = default;
+        Source& operator=(Source&&) = default;
+
+        /**
+         * @brief View the oldest record without releasing it
+         *
+         * The span stays valid until `pop()` or `drain()`.
+         *
+         * @return The record's payload (8-byte aligned), or std::nullopt if the ring is empty
+         */
+        std::optional<Span<const std::byte>> front() {
+            auto slots = ring_.peek();
+            while (!slots.empty() && (slots[0] & padding_flag) != 0) {
+                ring_.consume(record_words(slots[0] & ~padding_flag));
+                slots = ring_.peek();
+            }
+            if (slots.empty()) return std::nullopt;
+            return payload(slots.data());
+        }
+
+        /**
+         * @brief Release the oldest record
+         *
+         * Must follow a `front()` that returned a record.
+         */
+        void pop() {
+            const auto slots = ring_.peek();
+            ring_.consume(record_words(slots[0]));
+        }
+
+        /**
+         * @brief Copy the oldest record out and release it
+         *
+         * @param out Destination buffer
+         * @param capacity Size of `out` in bytes
+         * @return The record's size, or std::nullopt if the ring is empty or the record does not
+         * fit in `capacity` bytes (it then stays in the ring)
+         */
+        std::optional<std::size_t> try_dequeue(void* out, std::size_t capacity) {
+            const auto record = front();
+            if (!record.has_value() || record->size() > capacity) return std::nullopt;
+            const std::size_t size = record->size();
+            if (size != 0) std::memcpy(out, record->data(), size);
+            pop();
+            return size;
+        }
+
+        /**
+         * @brief Visit every available record in place, then release them with one head store
+         *
+         * Reads the tail once, calls `f(Span<const std::byte>)` for up to `max_records` records
+         * in FIFO order, and publishes the new head once at the end. If `f` throws, the records
+         * visited before the throwing one are released and the exception propagates.
+         *
+         * @param f Callback for each record; the span is only valid during the call
+         * @param max_records Upper bound on the number of records visited
+         * @return Number of records visited
+         */
+        template <typename F>
+        std::size_t drain(
+            F&& f, std::size_t max_records = std::numeric_limits<std::size_t>::max()
+        ) {
+            const auto slots = ring_.peek();
+            std::size_t position = 0;
+            std::size_t records = 0;
+            try {
+                while (position < slots.size() && records < max_records) {
+                    const Word header = slots[position];
+                    if ((header & padding_flag) == 0) {
+                        f(payload(slots.data() + position));
+                        ++records;
+                    }
+                    position += record_words(header & ~padding_flag);
+                }
+            } catch (...) {
+                ring_.consume(position);
+                throw;
+            }
+            if (position != 0) ring_.consume(position);
+            return records;
+        }
+
+        /**
+         * @brief Approximate number of ring bytes in use, headers and padding included
+         */
+        std::size_t size() const { return ring_.size() * sizeof(Word); }
+
+        /**
+         * @brief Check if the ring is empty (approximate)
+         */
+        bool empty() const { return ring_.empty(); }
+
+    private:
+        static Span<const std::byte> payload(const Word* header) {
+            return Span<const std::byte>(
+                reinterpret_cast<const std::byte*>(header + 1), static_cast<std::size_t>(*header)
+            );
+        }
+
+        typename Ring::Source ring_;
+    };
+
+    /**
+     * @brief Factory method to create a byte ring with sink and source handles
+     *
+     * @param numa_node Bind the ring pages to this NUMA node (Linux only); -1 leaves placement
+     * to first touch
+     * @return std::pair containing (Sink, Source)
+     * @throws std::runtime_error if the mapping cannot be created or bound to `numa_node`
+     */
+    static std::pair<Sink, Source> create(int numa_node = -1) {
+        auto [sink, source] = Ring::create(numa_node);
+        return { Sink(std::move(sink)), Source(std::move(source)) };
+    }
+
+    /**
+     * @brief Create a byte ring that other processes can map (see `MmapSPSC::create_shared()`)
+     *
+     * @param name Optional shared memory object name, or nullptr for a memfd
+     * @return File descriptor owned by the caller
+     * @throws std::runtime_error if the region cannot be created
+     */
+    static int create_shared(const char* name = nullptr) { return Ring::create_shared(name); }
+
+    /**
+     * @brief Map a region from `create_shared()` and return its producer handle
+     *
+     * @throws std::runtime_error if the region does not match this ring type or already has one
+     */
+    static Sink attach_sink(int fd) { return Sink(Ring::attach_sink(fd)); }
+
+    /**
+     * @brief Map a region from `create_shared()` and return its consumer handle
+     *
+     * @throws std::runtime_error if the region does not match this ring type or already has one
+     */
+    static Source attach_source(int fd) { return Source(Ring::attach_source(fd)); }
+};
+
+template <std::size_t Capacity, typename Wait = YieldWait>
+using ByteSpscSink = typename ByteSPSC<Capacity, Wait>::Sink;
+
+template <std::size_t Capacity, typename Wait = YieldWait>
+using ByteSpscSource = typename ByteSPSC<Capacity, Wait>::Source;
+
+} // namespace qbuf
+#endif // QBUF_BYTE_SPSC_HPP
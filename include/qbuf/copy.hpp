@@ -0,0 +1,69 @@
+#ifndef QBUF_COPY_HPP
+#define QBUF_COPY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Byte size at or above which bulk writes into a ring use non-temporal stores
+ *
+ * Streaming stores bypass the producer's cache, which keeps very large batches from evicting
+ * the working set. Defaults to 0 (disabled); define before including any qbuf header to opt in.
+ */
+#ifndef QBUF_STREAMING_STORE_THRESHOLD
+#define QBUF_STREAMING_STORE_THRESHOLD 0
+#endif
+
+namespace qbuf::detail {
+
+/**
+ * @brief Copy `bytes` from `src` to `dst` with non-temporal stores where available
+ *
+ * Unaligned head and tail bytes go through `memcpy`. Ends with a store fence so the data is
+ * globally visible before the caller's release store publishes it.
+ */
+inline void stream_copy(void* dst, const void* src, std::size_t bytes) {
+#if defined(__SSE2__)
+    auto* out = static_cast<std::uint8_t*>(dst);
+    const auto* in = static_cast<const std::uint8_t*>(src);
+
+    const std::size_t misalignment = reinterpret_cast<std::uintptr_t>(out) & 15;
+    std::size_t head = misalignment ? 16 - misalignment : 0;
+    if (head > bytes) head = bytes;
+    std::memcpy(out, in, head);
+    out += head;
+    in += head;
+    bytes -= head;
+
+    for (; bytes >= 16; bytes -= 16, out += 16, in += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(out), chunk);
+    }
+    std::memcpy(out, in, bytes);
+    _mm_sfence();
+#else
+    std::memcpy(dst, src, bytes);
+#endif
+}
+
+/**
+ * @brief Copy `bytes` into ring memory, streaming past `QBUF_STREAMING_STORE_THRESHOLD`
+ */
+inline void copy_to_ring(void* dst, const void* src, std::size_t bytes) {
+    constexpr std::size_t threshold = QBUF_STREAMING_STORE_THRESHOLD;
+    if constexpr (threshold != 0) {
+        if (bytes >= threshold) {
+            stream_copy(dst, src, bytes);
+            return;
+        }
+    }
+    std::memcpy(dst, src, bytes);
+}
+
+} // namespace qbuf::detail
+#endif // QBUF_COPY_HPP
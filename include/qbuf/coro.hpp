@@ -0,0 +1,207 @@
+#ifndef QBUF_CORO_HPP
+#define QBUF_CORO_HPP
+
+#if __cplusplus < 202002L || !defined(__cpp_impl_coroutine)
+#error "qbuf/coro.hpp requires C++20 coroutine support"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <qbuf/mmap_spsc.hpp>
+#include <qbuf/spsc.hpp>
+#include <qbuf/wait.hpp>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace qbuf {
+
+/**
+ * @brief Wait strategy that lets coroutines await the queue instead of blocking a thread
+ *
+ * Use it as the `Wait` parameter of an `SPSC` or `MmapSPSC` queue to enable
+ * `co_await sink.async_enqueue(value)` and `co_await source.async_dequeue()`. A suspended
+ * coroutine registers its handle here; the opposite side's `notify()` (called after every
+ * publish) checks whether the awaited condition now holds and, if so, resumes the coroutine
+ * inline, on the notifying thread, until its next suspension point. Executors that need the
+ * coroutine back on their own thread can reschedule it right after the `co_await`.
+ *
+ * Like `ParkingWait`, `notify()` costs a fence and a relaxed load when nothing is suspended. The
+ * regular blocking `enqueue`/`dequeue` calls still work and wait like `YieldWait`. Only one
+ * coroutine per direction may be suspended at a time, which the single producer / single
+ * consumer contract already implies. In-process queues only.
+ */
+class AsyncWait {
+public:
+    static constexpr bool process_shared = false;
+
+    template <typename Ready, typename Clock, typename Duration>
+    bool wait_until(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        return YieldWait().wait_until(std::forward<Ready>(ready), deadline);
+    }
+
+    void notify() noexcept {
+        // Pairs with the fence in suspend(): either we see the waiter or it sees our publish
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiter_.load(std::memory_order_acquire) == nullptr) return;
+
+        const auto ready = ready_.load(std::memory_order_relaxed);
+        void* context = context_.load(std::memory_order_relaxed);
+        if (!ready(context)) return;
+        void* address = waiter_.exchange(nullptr, std::memory_order_acq_rel);
+        if (address != nullptr) std::coroutine_handle<>::from_address(address).resume();
+    }
+
+    /**
+     * @brief Register `handle` to be resumed once `ready(context)` holds
+     *
+     * Must not touch the suspending coroutine's frame: from the moment the handle is published
+     * another thread may resume (and finish) the coroutine.
+     *
+     * @return false if the condition already holds and the caller should not suspend
+     */
+    bool suspend(std::coroutine_handle<> handle, bool (*ready)(void*), void* context) noexcept {
+        ready_.store(ready, std::memory_order_relaxed);
+        context_.store(context, std::memory_order_relaxed);
+        waiter_.store(handle.address(), std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!ready(context)) return true;
+        // Ready after all; take the registration back unless a notify() already claimed it
+        return waiter_.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+    }
+
+private:
+    std::atomic<void*> waiter_ { nullptr };
+    std::atomic<bool (*)(void*)> ready_ { nullptr };
+    std::atomic<void*> context_ { nullptr };
+};
+
+namespace detail {
+
+template <typename T, std::size_t Capacity, typename Wait>
+struct AsyncAccess<SPSC<T, Capacity, Wait>> {
+    using Queue = SPSC<T, Capacity, Wait>;
+    using Value = T;
+    using WaitType = Wait;
+
+    static Queue& queue(typename Queue::Sink& sink) { return *sink.queue_; }
+    static Queue& queue(typename Queue::Source& source) { return *source.queue_; }
+    static Wait& not_full(Queue& queue) { return queue.not_full_; }
+    static Wait& not_empty(Queue& queue) { return queue.not_empty_; }
+
+    // Exact when called by the side that is not suspended: only the suspended side could undo it
+    static bool writable(void* queue) {
+        const auto& q = *static_cast<Queue*>(queue);
+        return q.size() + 1 < q.capacity();
+    }
+    static bool readable(void* queue) { return static_cast<Queue*>(queue)->size() != 0; }
+};
+
+template <typename T, std::size_t Capacity, typename Wait>
+struct AsyncAccess<MmapSPSC<T, Capacity, Wait>> {
+    using Queue = MmapSPSC<T, Capacity, Wait>;
+    using Value = T;
+    using WaitType = Wait;
+
+    static Queue& queue(typename Queue::Sink& sink) { return *sink.queue_; }
+    static Queue& queue(typename Queue::Source& source) { return *source.queue_; }
+    static Wait& not_full(Queue& queue) { return queue.control_->not_full; }
+    static Wait& not_empty(Queue& queue) { return queue.control_->not_empty; }
+
+    static bool writable(void* queue) { return static_cast<Queue*>(queue)->size() + 1 < Capacity; }
+    static bool readable(void* queue) { return static_cast<Queue*>(queue)->size() != 0; }
+};
+
+/**
+ * @brief Awaiter returned by `Sink::async_enqueue()`
+ *
+ * Holds the value until it is in the queue; the sink must outlive the `co_await`.
+ */
+template <typename Queue>
+class EnqueueAwaiter {
+    using Access = AsyncAccess<Queue>;
+    using Sink = typename Queue::Sink;
+    using Value = typename Access::Value;
+
+    static_assert(
+        std::is_same_v<typename Access::WaitType, AsyncWait>,
+        "async_enqueue() requires a queue using the AsyncWait strategy"
+    );
+
+public:
+    EnqueueAwaiter(Sink& sink, Value value) : sink_(sink), value_(std::move(value)) { }
+
+    bool await_ready() {
+        enqueued_ = sink_.try_enqueue(std::move(value_));
+        return enqueued_;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        Queue& queue = Access::queue(sink_);
+        return Access::not_full(queue).suspend(handle, &Access::writable, &queue);
+    }
+
+    void await_resume() {
+        // Resumed only once there is room, so this does not loop in practice
+        while (!enqueued_) {
+            enqueued_ = sink_.try_enqueue(std::move(value_));
+            if (!enqueued_) std::this_thread::yield();
+        }
+    }
+
+private:
+    Sink& sink_;
+    Value value_;
+    bool enqueued_ = false;
+};
+
+/**
+ * @brief Awaiter returned by `Source::async_dequeue()`; `co_await` yields the element
+ *
+ * The source must outlive the `co_await`.
+ */
+template <typename Queue>
+class DequeueAwaiter {
+    using Access = AsyncAccess<Queue>;
+    using Source = typename Queue::Source;
+    using Value = typename Access::Value;
+
+    static_assert(
+        std::is_same_v<typename Access::WaitType, AsyncWait>,
+        "async_dequeue() requires a queue using the AsyncWait strategy"
+    );
+
+public:
+    explicit DequeueAwaiter(Source& source) : source_(source) { }
+
+    bool await_ready() {
+        value_ = source_.try_dequeue();
+        return value_.has_value();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        Queue& queue = Access::queue(source_);
+        return Access::not_empty(queue).suspend(handle, &Access::readable, &queue);
+    }
+
+    Value await_resume() {
+        // Resumed only once an element is available, so this does not loop in practice
+        while (!value_.has_value()) {
+            value_ = source_.try_dequeue();
+            if (!value_.has_value()) std::this_thread::yield();
+        }
+        return std::move(*value_);
+    }
+
+private:
+    Source& source_;
+    std::optional<Value> value_;
+};
+
+} // namespace detail
+} // namespace qbuf
+#endif // QBUF_CORO_HPP
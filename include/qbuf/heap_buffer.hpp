@@ -0,0 +1,163 @@
+#ifndef QBUF_HEAP_BUFFER_HPP
+#define QBUF_HEAP_BUFFER_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace qbuf {
+
+/**
+ * @brief Capacity sentinel selecting a queue whose capacity is chosen at runtime
+ *
+ * `SPSC<T, dynamic_extent>` is created with `make_queue(capacity)` and keeps its ring in a
+ * separately allocated `detail::HeapBuffer` instead of an inline `std::array`.
+ */
+inline constexpr std::size_t dynamic_extent = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Allocation options for runtime-capacity queue buffers
+ */
+struct BufferOptions {
+    /// Back the buffer with an anonymous mapping advised for transparent huge pages (Linux only;
+    /// best effort, silently uses regular pages where huge pages are unavailable)
+    bool huge_pages = false;
+    /// Bind the buffer's pages to this NUMA node (Linux only; -1 leaves placement to the kernel,
+    /// which allocates on the node of the thread that first touches each page)
+    int numa_node = -1;
+};
+
+namespace detail {
+
+/**
+ * @brief Bind the pages of `[addr, addr + bytes)` to `numa_node` before they are first touched
+ *
+ * Uses the raw `mbind` syscall so no libnuma dependency is needed. `addr` must be page aligned.
+ * A no-op for `numa_node < 0` and on non-Linux platforms.
+ *
+ * @throws std::runtime_error if the kernel rejects the node
+ */
+inline void bind_to_numa_node(void* addr, std::size_t bytes, int numa_node) {
+    if (numa_node < 0) return;
+#if defined(__linux__)
+    constexpr std::size_t mask_bits = 8 * sizeof(unsigned long);
+    constexpr std::size_t mask_words = 16; // nodes 0..1023
+    if (static_cast<std::size_t>(numa_node) >= mask_bits * mask_words) {
+        throw std::runtime_error("NUMA node out of range");
+    }
+    unsigned long mask[mask_words] = { };
+    mask[numa_node / mask_bits] = 1UL << (numa_node % mask_bits);
+    if (syscall(SYS_mbind, addr, bytes, MPOL_BIND, mask, mask_bits * mask_words, 0) != 0) {
+        throw std::runtime_error("Failed to bind memory to NUMA node");
+    }
+#else
+    (void)addr;
+    (void)bytes;
+#endif
+}
+
+/**
+ * @brief Owning, 64-byte-aligned array of `T` with a runtime size
+ *
+ * Elements are value-initialized on construction and destroyed on destruction, so the buffer
+ * behaves like the `std::array` used by fixed-capacity queues.
+ *
+ * @tparam T The element type
+ */
+template <typename T>
+class HeapBuffer {
+public:
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+    HeapBuffer(std::size_t size, const BufferOptions& options) : size_(size) {
+        // Leave headroom for rounding up to a huge page so neither computation can wrap
+        if (size > (std::numeric_limits<std::size_t>::max() - huge_page_size) / sizeof(T)) {
+            throw std::length_error("HeapBuffer size exceeds the addressable range");
+        }
+        const std::size_t bytes = size * sizeof(T);
+        void* memory = nullptr;
+
+#if defined(__linux__)
+        // Huge pages and NUMA binding both need a mapping of their own, untouched until bound
+        if (options.huge_pages || options.numa_node >= 0) {
+            const std::size_t granule = options.huge_pages
+                ? huge_page_size
+                : static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            mapped_bytes_ = ((bytes + granule - 1) / granule) * granule;
+            memory = mmap(
+                nullptr, mapped_bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+            );
+            if (memory == MAP_FAILED) throw std::bad_alloc();
+            if (options.huge_pages) madvise(memory, mapped_bytes_, MADV_HUGEPAGE);
+            try {
+                bind_to_numa_node(memory, mapped_bytes_, options.numa_node);
+            } catch (...) {
+                munmap(memory, mapped_bytes_);
+                throw;
+            }
+        }
+#else
+        (void)options;
+#endif
+        if (memory == nullptr) {
+            memory = ::operator new(bytes, std::align_val_t(alignment));
+        }
+        data_ = static_cast<T*>(memory);
+
+        try {
+            std::uninitialized_value_construct_n(data_, size_);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    ~HeapBuffer() {
+        std::destroy_n(data_, size_);
+        release();
+    }
+
+    // non-copyable
+    HeapBuffer(const HeapBuffer&) = delete;
+    HeapBuffer& operator=(const HeapBuffer&) = delete;
+    // non-movable
+    HeapBuffer(HeapBuffer&&) = delete;
+    HeapBuffer& operator=(HeapBuffer&&) = delete;
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    std::size_t size() const { return size_; }
+
+private:
+    void release() {
+#if defined(__linux__)
+        if (mapped_bytes_ != 0) {
+            munmap(data_, mapped_bytes_);
+            return;
+        }
+#endif
+        ::operator delete(data_, std::align_val_t(alignment));
+    }
+
+    T* data_ = nullptr;
+    std::size_t size_;
+    std::size_t mapped_bytes_ = 0; // non-zero if the buffer is an anonymous mapping
+};
+
+} // namespace detail
+} // namespace qbuf
+#endif // QBUF_HEAP_BUFFER_HPP
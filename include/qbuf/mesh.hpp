@@ -0,0 +1,465 @@
+#ifndef QBUF_MESH_HPP
+#define QBUF_MESH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <qbuf/spsc.hpp>
+#include <qbuf/wait.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace qbuf {
+
+/**
+ * @brief Order in which a Mesh consumer visits its inbound lanes
+ */
+enum class PollPolicy {
+    round_robin, ///< Rotate over the lanes, taking at most `lane_quantum` elements per visit
+    priority,    ///< Always drain lower producer indices first (producer 0 is the most urgent)
+};
+
+/**
+ * @brief Fairness and starvation controls for Mesh consumers
+ */
+struct MeshOptions {
+    PollPolicy policy = PollPolicy::round_robin;
+    /// Round robin: most elements taken from one lane per visit, so one busy producer cannot
+    /// hold a consumer's batch to itself
+    std::size_t lane_quantum = 64;
+    /// Priority: every `starvation_limit`-th poll is a round-robin pass, so low-priority lanes
+    /// keep moving under sustained high-priority load (0 = strict priority, which can starve)
+    std::size_t starvation_limit = 16;
+};
+
+/**
+ * @brief N producers x M consumers mesh of SPSC lanes
+ *
+ * `make_queue(producers, consumers)` builds one `SPSC<T, LaneCapacity, Wait>` lane for every
+ * producer/consumer pair and hands each producer a Sink over its outbound lanes and each
+ * consumer a Source over its inbound lanes. Producers pick a consumer per element or batch with
+ * `route(key)`, so every lane keeps the SPSC fast path: no atomic read-modify-write, and no two
+ * threads contend on any index. Elements from one producer to one consumer stay in order.
+ *
+ * A Source polls its lanes by `MeshOptions::policy` and drains them with the lanes' bulk
+ * `try_dequeue(T*, count)`. The keyless `Sink::try_enqueue` calls spread elements over the
+ * consumers round-robin, skipping full lanes.
+ *
+ * Blocking consumer calls poll every inbound lane, yielding between passes (`YieldWait`): there
+ * is no single object a producer could notify. Blocking routed enqueues wait on the lane with
+ * `Wait`.
+ *
+ * @tparam T The type of elements stored in the lanes
+ * @tparam LaneCapacity Capacity of each lane (power of two; holds `LaneCapacity - 1` elements)
+ * @tparam Wait Strategy used by the blocking calls of each lane (see qbuf/wait.hpp)
+ */
+template <typename T, std::size_t LaneCapacity, typename Wait = YieldWait>
+class Mesh {
+public:
+    using Lane = SPSC<T, LaneCapacity, Wait>;
+    using LaneSink = typename Lane::Sink;
+    using LaneSource = typename Lane::Source;
+
+    /**
+     * @brief Producer-side handle: one lane to every consumer
+     *
+     * Intended for use by one producer thread.
+     */
+    class Sink {
+    private:
+        friend class Mesh;
+        explicit Sink(std::vector<LaneSink> lanes) : lanes_(std::move(lanes)), next_(0) { }
+
+    public:
+        // Non-copyable
+        Sink(const Sink&) = delete;
+        Sink& operator=(const Sink&) = delete;
+
+        // Movable
+        Sink(Sink&&) = default;
+        Sink& operator=(Sink&&) = default;
+
+        /**
+         * @brief Lane to the consumer that owns `key`
+         *
+         * Keys map to consumers by `key % consumers()`; hash non-integral keys first. The lane
+         * offers the full SPSC Sink API, including `reserve()`/`commit()`.
+         *
+         * @param key Partitioning key
+         * @return The lane sink for consumer `key % consumers()`
+         */
+        LaneSink& route(std::size_t key) { return lanes_[key % lanes_.size()]; }
+
+        /**
+         * @brief Lane to consumer `consumer`
+         */
+        LaneSink& lane(std::size_t consumer) { return lanes_[consumer]; }
+
+        /**
+         * @brief Number of consumers, i.e. outbound lanes
+         */
+        std::size_t consumers() const { return lanes_.size(); }
+
+        /**
+         * @brief Try to enqueue a single element on the next lane with room
+         *
+         * Lanes are tried round-robin starting after the lane used last.
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if every outbound lane is full
+         */
+        bool try_enqueue(const T& value) { return spread(value); }
+
+        /**
+         * @brief Try to enqueue a single element on the next lane with room (move semantics)
+         *
+         * The value is only moved from if it was enqueued.
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if every outbound lane is full
+         */
+        bool try_enqueue(T&& value) { return spread(std::move(value)); }
+
+        /**
+         * @brief Try to enqueue multiple elements, filling lanes round-robin
+         *
+         * Each lane takes as much of the remainder as fits, so a batch that fits stays on one
+         * lane (and reaches one consumer in order).
+         *
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @return Number of elements successfully enqueued
+         */
+        std::size_t try_enqueue(const T* data, std::size_t count) {
+            std::size_t total_enqueued = 0;
+            for (std::size_t i = 0; i < lanes_.size() && total_enqueued < count; ++i) {
+                total_enqueued +=
+                    lanes_[next_].try_enqueue(data + total_enqueued, count - total_enqueued);
+                advance();
+            }
+            return total_enqueued;
+        }
+
+        /**
+         * @brief Block until an element can be enqueued on some lane with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue
+         * @param timeout Maximum time to wait for room on any lane
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+            return YieldWait().wait_until(
+                [&] { return spread(value); }, std::chrono::steady_clock::now() + timeout
+            );
+        }
+
+        /**
+         * @brief Block until an element can be enqueued on some lane with timeout (move
+         * semantics)
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue (moved from only if enqueued)
+         * @param timeout Maximum time to wait for room on any lane
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+            return YieldWait().wait_until(
+                [&] { return spread(std::move(value)); },
+                std::chrono::steady_clock::now() + timeout
+            );
+        }
+
+        /**
+         * @brief Block until all elements are enqueued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @param timeout Maximum time to wait for room for all elements
+         * @return true if all elements were enqueued, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+            std::size_t total_enqueued = 0;
+            return YieldWait().wait_until(
+                [&] {
+                    total_enqueued += try_enqueue(data + total_enqueued, count - total_enqueued);
+                    return total_enqueued == count;
+                },
+                std::chrono::steady_clock::now() + timeout
+            );
+        }
+
+        /**
+         * @brief Check if every outbound lane is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Get the approximate number of elements in the outbound lanes
+         */
+        std::size_t size() const {
+            std::size_t total = 0;
+            for (const auto& lane : lanes_) total += lane.size();
+            return total;
+        }
+
+        /**
+         * @brief Get the number of elements the outbound lanes can hold together
+         *
+         * @return `consumers() * (LaneCapacity - 1)`
+         */
+        std::size_t capacity() const { return lanes_.size() * (LaneCapacity - 1); }
+
+    private:
+        void advance() { next_ = (next_ + 1 == lanes_.size()) ? 0 : next_ + 1; }
+
+        template <typename U>
+        bool spread(U&& value) {
+            // A refused rvalue is left intact by the lane, so it can be offered to the next one
+            for (std::size_t i = 0; i < lanes_.size(); ++i) {
+                const bool enqueued = lanes_[next_].try_enqueue(std::forward<U>(value));
+                advance();
+                if (enqueued) return true;
+            }
+            return false;
+        }
+
+        std::vector<LaneSink> lanes_;
+        std::size_t next_; // lane the next keyless enqueue tries first
+    };
+
+    /**
+     * @brief Consumer-side handle: one lane from every producer
+     *
+     * Intended for use by one consumer thread.
+     */
+    class Source {
+    private:
+        friend class Mesh;
+        Source(std::vector<LaneSource> lanes, const MeshOptions& options)
+                : lanes_(std::move(lanes)), options_(options), next_(0), priority_polls_(0) { }
+
+    public:
+        // Non-copyable
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+        // Movable
+        Source(Source&&) = default;
+        Source& operator=(Source&&) = default;
+
+        /**
+         * @brief Try to dequeue a single element from the inbound lanes
+         *
+         * @return std::optional containing the value if successful, std::nullopt if every
+         * inbound lane is empty
+         */
+        std::optional<T> try_dequeue() {
+            std::optional<T> value;
+            poll(1, [&](LaneSource& lane, std::size_t) {
+                value = lane.try_dequeue();
+                return value.has_value() ? 1 : 0;
+            });
+            return value;
+        }
+
+        /**
+         * @brief Drain up to `count` elements from the inbound lanes
+         *
+         * Visits lanes by the poll policy and drains each with one bulk `try_dequeue`.
+         *
+         * @param data Pointer to output array
+         * @param count Maximum number of elements to dequeue
+         * @return Number of elements successfully dequeued
+         */
+        std::size_t try_dequeue(T* data, std::size_t count) {
+            std::size_t total_dequeued = 0;
+            poll(count, [&](LaneSource& lane, std::size_t max) {
+                const std::size_t n = lane.try_dequeue(data + total_dequeued, max);
+                total_dequeued += n;
+                return n;
+            });
+            return total_dequeued;
+        }
+
+        /**
+         * @brief Block until an element can be dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param timeout Maximum time to wait for dequeue
+         * @return std::optional containing the element if successful, std::nullopt if timeout
+         * expired
+         */
+        template <typename Rep, typename Period>
+        std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+            std::optional<T> value;
+            YieldWait().wait_until(
+                [&] {
+                    value = try_dequeue();
+                    return value.has_value();
+                },
+                std::chrono::steady_clock::now() + timeout
+            );
+            return value;
+        }
+
+        /**
+         * @brief Block until all elements are dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to output array
+         * @param count Number of elements to dequeue
+         * @param timeout Maximum time to wait for all elements to be dequeued
+         * @return Number of elements successfully dequeued (may be less than count if timeout)
+         */
+        template <typename Rep, typename Period>
+        std::size_t dequeue(
+            T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout
+        ) {
+            std::size_t total_dequeued = 0;
+            YieldWait().wait_until(
+                [&] {
+                    total_dequeued += try_dequeue(data + total_dequeued, count - total_dequeued);
+                    return total_dequeued == count;
+                },
+                std::chrono::steady_clock::now() + timeout
+            );
+            return total_dequeued;
+        }
+
+        /**
+         * @brief Lane from producer `producer`
+         */
+        LaneSource& lane(std::size_t producer) { return lanes_[producer]; }
+
+        /**
+         * @brief Number of producers, i.e. inbound lanes
+         */
+        std::size_t producers() const { return lanes_.size(); }
+
+        /**
+         * @brief Check if every inbound lane is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Get the approximate number of elements in the inbound lanes
+         */
+        std::size_t size() const {
+            std::size_t total = 0;
+            for (const auto& lane : lanes_) total += lane.size();
+            return total;
+        }
+
+        /**
+         * @brief Get the number of elements the inbound lanes can hold together
+         *
+         * @return `producers() * (LaneCapacity - 1)`
+         */
+        std::size_t capacity() const { return lanes_.size() * (LaneCapacity - 1); }
+
+    private:
+        // Priority polls count towards the next forced round-robin pass
+        bool fair_turn() {
+            if (options_.policy == PollPolicy::round_robin) return true;
+            if (options_.starvation_limit == 0) return false;
+            if (++priority_polls_ < options_.starvation_limit) return false;
+            priority_polls_ = 0;
+            return true;
+        }
+
+        /**
+         * @brief Visit lanes by the poll policy until `count` elements are taken
+         *
+         * `take(lane, max)` dequeues at most `max` elements from `lane` and returns how many.
+         * Priority polls drain lanes in producer order without a quantum; round-robin passes
+         * take at most `lane_quantum` per visit and stop after a full lap of empty lanes.
+         */
+        template <typename Take>
+        void poll(std::size_t count, Take&& take) {
+            std::size_t total = 0;
+            if (!fair_turn()) {
+                for (std::size_t i = 0; i < lanes_.size() && total < count; ++i) {
+                    total += take(lanes_[i], count - total);
+                }
+                return;
+            }
+            std::size_t idle = 0;
+            while (total < count && idle < lanes_.size()) {
+                const std::size_t n =
+                    take(lanes_[next_], std::min(options_.lane_quantum, count - total));
+                total += n;
+                idle = (n == 0) ? idle + 1 : 0;
+                next_ = (next_ + 1 == lanes_.size()) ? 0 : next_ + 1;
+            }
+        }
+
+        std::vector<LaneSource> lanes_;
+        MeshOptions options_;
+        std::size_t next_;           // lane the next round-robin pass visits first
+        std::size_t priority_polls_; // priority polls since the last round-robin pass
+    };
+
+    /**
+     * @brief Factory method to build the lanes and their handles
+     *
+     * @param producers Number of producer handles (at least 1)
+     * @param consumers Number of consumer handles (at least 1)
+     * @param options Poll policy and fairness controls for every Source
+     * @return std::pair of one Sink per producer and one Source per consumer; `Sink::lane(c)`
+     * and `Source::lane(p)` are the two ends of the same lane
+     * @throws std::invalid_argument if `producers`, `consumers` or `options.lane_quantum` is 0
+     */
+    static std::pair<std::vector<Sink>, std::vector<Source>> make_queue(
+        std::size_t producers, std::size_t consumers, const MeshOptions& options = { }
+    ) {
+        if (producers == 0 || consumers == 0) {
+            throw std::invalid_argument("Mesh needs at least one producer and one consumer");
+        }
+        if (options.lane_quantum == 0) {
+            throw std::invalid_argument("Mesh lane quantum must be at least 1");
+        }
+
+        std::vector<std::vector<LaneSink>> outbound(producers);
+        std::vector<std::vector<LaneSource>> inbound(consumers);
+        for (std::size_t p = 0; p < producers; ++p) {
+            for (std::size_t c = 0; c < consumers; ++c) {
+                auto [sink, source] = Lane::make_queue();
+                outbound[p].push_back(std::move(sink));
+                inbound[c].push_back(std::move(source));
+            }
+        }
+
+        std::vector<Sink> sinks;
+        sinks.reserve(producers);
+        for (auto& lanes : outbound) sinks.push_back(Sink(std::move(lanes)));
+        std::vector<Source> sources;
+        sources.reserve(consumers);
+        for (auto& lanes : inbound) sources.push_back(Source(std::move(lanes), options));
+        return { std::move(sinks), std::move(sources) };
+    }
+};
+
+template <typename T, std::size_t LaneCapacity, typename Wait = YieldWait>
+using MeshSource = typename Mesh<T, LaneCapacity, Wait>::Source;
+
+template <typename T, std::size_t LaneCapacity, typename Wait = YieldWait>
+using MeshSink = typename Mesh<T, LaneCapacity, Wait>::Sink;
+
+} // namespace qbuf
+#endif // QBUF_MESH_HPP
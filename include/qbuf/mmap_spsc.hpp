@@ -1,21 +1,32 @@
 #ifndef QBUF_MMAP_SPSC_HPP
 #define QBUF_MMAP_SPSC_HPP
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fcntl.h>
+#include <limits>
 #include <memory>
+#include <new>
 #include <optional>
+#include <qbuf/copy.hpp>
+#include <qbuf/heap_buffer.hpp>
+#include <qbuf/span.hpp>
+#include <qbuf/stats.hpp>
+#include <qbuf/wait.hpp>
 #include <stdexcept>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <thread>
+#include <type_traits>
 #include <unistd.h>
 
 #if defined(__linux__)
 #include <linux/memfd.h>
+#include <sys/file.h>
 #include <sys/syscall.h>
 #if __GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 27)
 static inline int memfd_create(const char* name, unsigned int flags) {
@@ -26,6 +37,191 @@ static inline int memfd_create(const char* name, unsigned int flags) {
 
 namespace qbuf {
 
+/**
+ * @brief Page and residency options for `MmapSPSC::create()`
+ *
+ * All options are Linux only and ignored by the non-Linux fallback.
+ */
+struct MmapOptions {
+    /// Back the queue with explicit huge pages of this size (`MFD_HUGETLB`): 2 MiB or 1 GiB, or 0
+    /// for regular pages. Needs pages reserved in `vm.nr_hugepages` (or the per-size pool); the
+    /// ring is rounded up to whole huge pages and the control block takes one huge page.
+    std::size_t huge_page_size = 0;
+    /// Fault in the control block, the ring and its mirror at creation (after NUMA binding), so
+    /// the first lap through the ring takes no page faults
+    bool populate = false;
+    /// `mlock` the mapping so its pages stay resident; this also faults them in. Needs
+    /// `CAP_IPC_LOCK` or a large enough `RLIMIT_MEMLOCK`
+    bool lock = false;
+    /// Bind the control block and ring pages to this NUMA node; -1 leaves placement to first touch
+    int numa_node = -1;
+};
+
+inline constexpr std::size_t huge_page_2mb = std::size_t(2) << 20;
+inline constexpr std::size_t huge_page_1gb = std::size_t(1) << 30;
+
+/**
+ * @brief When a journal's producer forces published elements to stable storage
+ */
+enum class SyncPolicy {
+    none, ///< Never; the page cache survives a process crash, not a power loss (default)
+    every_n, ///< After every `JournalOptions::every_messages` published elements
+    interval, ///< On the first publish at least `JournalOptions::interval` after the last sync
+};
+
+/**
+ * @brief How a journal sync reaches the file
+ */
+enum class SyncMethod {
+    fdatasync, ///< `fdatasync()` on the file: data pages plus the size metadata it needs
+    msync, ///< `msync(MS_SYNC)` over the control block and the ring
+};
+
+/**
+ * @brief Durability settings for `MmapSPSC::open_journal()`
+ */
+struct JournalOptions {
+    SyncPolicy policy = SyncPolicy::none;
+    /// `SyncPolicy::every_n`: elements published between syncs
+    std::size_t every_messages = 1;
+    /// `SyncPolicy::interval`: minimum time between syncs
+    std::chrono::microseconds interval { 1000 };
+    SyncMethod method = SyncMethod::fdatasync;
+};
+
+namespace detail {
+
+/**
+ * @brief Page size a mapping created with `options` is made of
+ *
+ * @throws std::invalid_argument if `options.huge_page_size` is not 0, 2 MiB or 1 GiB
+ */
+inline std::size_t mapping_page_size(const MmapOptions& options) {
+    if (options.huge_page_size == 0) return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    if (options.huge_page_size != huge_page_2mb && options.huge_page_size != huge_page_1gb) {
+        throw std::invalid_argument("Huge page size must be 0, 2 MiB or 1 GiB");
+    }
+    return options.huge_page_size;
+}
+
+/**
+ * @brief Smallest power-of-two slot count >= `capacity` (a power of two) whose ring of `T`
+ * is a whole number of `page_size` pages, as a mirrored mapping needs
+ */
+template <typename T>
+std::size_t mirrored_slots(std::size_t capacity, std::size_t page_size) {
+    std::size_t align = 1; // largest power of two dividing sizeof(T), capped at page_size
+    while (align < page_size && (sizeof(T) % (align * 2)) == 0) align *= 2;
+    const std::size_t min_slots = page_size / align;
+    return (capacity < min_slots) ? min_slots : capacity;
+}
+
+#if defined(__linux__)
+/**
+ * @brief Create a close-on-exec memfd, backed by huge pages if `options` asks for them
+ *
+ * @throws std::runtime_error if the kernel refuses
+ */
+inline int create_memfd(const char* name, const MmapOptions& options) {
+    unsigned int flags = MFD_CLOEXEC;
+    if (options.huge_page_size != 0) {
+        flags |= MFD_HUGETLB
+            | ((options.huge_page_size == huge_page_2mb) ? MFD_HUGE_2MB : MFD_HUGE_1GB);
+    }
+    const int fd = memfd_create(name, flags);
+    if (fd == -1) {
+        throw std::runtime_error(
+            (options.huge_page_size != 0) ? "Failed to create huge page memfd"
+                                          : "Failed to create memfd"
+        );
+    }
+    return fd;
+}
+
+/**
+ * @brief Map `fd` as [prefix][ring][ring mirror] in one reserved address range
+ *
+ * The prefix (e.g. a control block; may be empty) maps file offset 0 and both ring views map
+ * offset `prefix_bytes`, so a run past the end of the ring continues at its start. Both sizes
+ * must be multiples of `page_size`; above the system page size (huge pages) the range is placed
+ * on a `page_size` boundary. Release it with `munmap(base, prefix_bytes + 2 * ring_bytes)`.
+ *
+ * @return Start of the prefix
+ * @throws std::runtime_error if any of the mappings fails; `fd` is left open
+ */
+inline std::uint8_t* map_mirrored(
+    int fd, std::size_t prefix_bytes, std::size_t ring_bytes, std::size_t page_size
+) {
+    const std::size_t total = prefix_bytes + 2 * ring_bytes;
+
+    // Reserve virtual address space for the prefix and the double mapping, with slack to start
+    // it on a `page_size` boundary as huge page mappings require
+    const std::size_t slack = page_size - static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    void* reserved = mmap(nullptr, total + slack, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        throw std::runtime_error("Failed to reserve virtual memory");
+    }
+    auto* base = static_cast<std::uint8_t*>(reserved);
+    auto* addr = reinterpret_cast<std::uint8_t*>(
+        (reinterpret_cast<std::uintptr_t>(base) + page_size - 1) & ~(page_size - 1)
+    );
+    if (addr != base) munmap(base, static_cast<std::size_t>(addr - base));
+    if (addr != base + slack) munmap(addr + total, static_cast<std::size_t>(base + slack - addr));
+
+    const auto map_fixed = [fd](void* at, std::size_t bytes, std::size_t offset) {
+        return mmap(
+                   at, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd,
+                   static_cast<off_t>(offset)
+               )
+            != MAP_FAILED;
+    };
+    const char* error = nullptr;
+    if (prefix_bytes != 0 && !map_fixed(addr, prefix_bytes, 0)) {
+        error = "Failed to map control block";
+    } else if (!map_fixed(addr + prefix_bytes, ring_bytes, prefix_bytes)) {
+        error = "Failed to map first region";
+    } else if (!map_fixed(addr + prefix_bytes + ring_bytes, ring_bytes, prefix_bytes)) {
+        error = "Failed to map second region";
+    }
+    if (error != nullptr) {
+        munmap(addr, total);
+        throw std::runtime_error(error);
+    }
+    return addr;
+}
+
+/**
+ * @brief Apply `options.populate` and `options.lock` to a freshly mapped, still untouched range
+ *
+ * Call after NUMA binding so the pages are allocated on the right node. Populating uses
+ * `MADV_POPULATE_WRITE` where the kernel has it (5.14+) and otherwise writes a zero to every
+ * page, which is harmless while the pages still hold nothing but zeros.
+ *
+ * @throws std::runtime_error if `mlock` fails
+ */
+inline void make_resident(void* addr, std::size_t bytes, const MmapOptions& options) {
+    if (options.populate) {
+#if defined(MADV_POPULATE_WRITE)
+        const bool populated = madvise(addr, bytes, MADV_POPULATE_WRITE) == 0;
+#else
+        const bool populated = false;
+#endif
+        if (!populated) {
+            const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            auto* bytes_ptr = static_cast<volatile std::uint8_t*>(addr);
+            for (std::size_t offset = 0; offset < bytes; offset += page_size) {
+                bytes_ptr[offset] = 0;
+            }
+        }
+    }
+    if (options.lock && mlock(addr, bytes) != 0) {
+        throw std::runtime_error("Failed to lock queue memory");
+    }
+}
+#endif
+
+} // namespace detail
+
 /**
  * @brief Memory-mapped Single-Producer Single-Consumer lock-free queue
  *
@@ -33,17 +229,40 @@ namespace qbuf {
  * Uses the double-mapping trick where two adjacent virtual memory regions
  * point to the same physical memory, eliminating wrap-around logic.
  *
+ * Head, tail, and the wait strategy state live in a control block at the start of the mapping,
+ * ahead of the ring. `create()` keeps the mapping private to the process; `create_shared()`
+ * returns a descriptor that other processes turn into handles with `attach_sink()` /
+ * `attach_source()`, so producer and consumer can run in separate processes. `open_journal()`
+ * maps a regular file instead, so the queued elements and both cursors survive a restart.
+ *
  * @tparam T The type of elements stored in the queue
  * @tparam Capacity Maximum number of elements the queue can hold
+ * @tparam Wait Strategy used by the blocking `enqueue`/`dequeue` calls (see qbuf/wait.hpp)
  */
-template <typename T, std::size_t Capacity>
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
 class MmapSPSC {
 public:
     static_assert(Capacity > 0, "Queue capacity must be greater than 0");
     static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of 2");
 
 private:
-    MmapSPSC() : head_(0), tail_(0), buffer_(nullptr), fd_(-1) { initialize_mmap(); }
+    // Which handles this mapping backs; shared attachments claim their role in the control block
+    enum class Role { both, sink, source };
+
+    explicit MmapSPSC(const MmapOptions& options)
+            : cached_tail_(0), cached_head_(0), buffer_(nullptr), fd_(-1), role_(Role::both) {
+        initialize_mmap(options);
+    }
+
+    MmapSPSC(int fd, Role role)
+            : cached_tail_(0), cached_head_(0), buffer_(nullptr), fd_(-1), role_(role) {
+        attach_mmap(fd);
+    }
+
+    MmapSPSC(const char* path, const JournalOptions& options)
+            : cached_tail_(0), cached_head_(0), buffer_(nullptr), fd_(-1), role_(Role::both) {
+        open_journal_file(path, options);
+    }
 
 public:
     // non-copyable
@@ -53,7 +272,14 @@ public:
     MmapSPSC(MmapSPSC&&) = delete;
     MmapSPSC& operator=(MmapSPSC&&) = delete;
 
-    ~MmapSPSC() { cleanup_mmap(); }
+    ~MmapSPSC() {
+#if defined(__linux__)
+        // A private control block was constructed in place (and may own eventfds); shared ones
+        // outlive the handles
+        if (role_ == Role::both && control_ != nullptr) control_->~ControlBlock();
+#endif
+        cleanup_mmap();
+    }
 
     /**
      * @brief Producer-side handle for MmapSPSC queue
@@ -63,7 +289,8 @@ public:
      */
     class Sink {
         friend class MmapSPSC;
-        explicit Sink(std::shared_ptr<MmapSPSC<T, Capacity>> queue) : queue_(queue) { }
+        friend struct detail::AsyncAccess<MmapSPSC>;
+        explicit Sink(std::shared_ptr<MmapSPSC<T, Capacity, Wait>> queue) : queue_(queue) { }
 
     public:
         // Non-copyable
@@ -90,6 +317,17 @@ public:
          */
         bool try_enqueue(T&& value) { return queue_->try_enqueue(std::move(value)); }
 
+        /**
+         * @brief Try to construct an element from `args` directly in the tail slot
+         *
+         * @param args Constructor arguments for `T`
+         * @return true if successful, false if queue is full (nothing is constructed)
+         */
+        template <typename... Args>
+        bool emplace(Args&&... args) {
+            return queue_->emplace(std::forward<Args>(args)...);
+        }
+
         /**
          * @brief Try to enqueue multiple elements
          *
@@ -101,6 +339,25 @@ public:
             return queue_->try_enqueue(data, count);
         }
 
+        /**
+         * @brief Reserve writable slots directly in the ring buffer
+         *
+         * Thanks to the double mapping the region is always one contiguous span, even when it
+         * crosses the wrap point. Nothing is visible to the consumer until `commit()`. Only
+         * available for trivially copyable `T`, since the slots are raw storage.
+         *
+         * @param count Maximum number of slots to reserve
+         * @return Writable span of `min(count, free slots)` elements (possibly empty)
+         */
+        Span<T> reserve(std::size_t count) { return queue_->reserve(count); }
+
+        /**
+         * @brief Publish the first `count` slots of the last reservation
+         *
+         * @param count Number of slots written; must not exceed the size of the last `reserve()`
+         */
+        void commit(std::size_t count) { queue_->commit(count); }
+
         /**
          * @brief Block until an element can be enqueued with timeout
          *
@@ -158,8 +415,36 @@ public:
          */
         std::size_t size() const { return queue_->size(); }
 
+        /**
+         * @brief Snapshot of this process's counters (all zero unless built with `QBUF_STATS`)
+         */
+        QueueStats stats() const { return queue_->stats(); }
+
+        /**
+         * @brief Force everything published so far, and both indices, to stable storage
+         *
+         * Journals only (see `open_journal()`); a no-op for memory-backed queues. Resets the
+         * sync policy's message count and interval.
+         *
+         * @throws std::runtime_error if the sync fails
+         */
+        void sync() { queue_->sync(); }
+
+        /**
+         * @brief Awaitable enqueue for C++20 coroutines (include qbuf/coro.hpp; needs `AsyncWait`)
+         *
+         * `co_await sink.async_enqueue(value)` suspends the coroutine while the queue is full; the
+         * consumer's next dequeue resumes it. No thread blocks.
+         *
+         * @param value The value to enqueue
+         */
+        template <typename Queue = MmapSPSC>
+        detail::EnqueueAwaiter<Queue> async_enqueue(T value) {
+            return detail::EnqueueAwaiter<Queue>(*this, std::move(value));
+        }
+
     private:
-        std::shared_ptr<MmapSPSC<T, Capacity>> queue_;
+        std::shared_ptr<MmapSPSC<T, Capacity, Wait>> queue_;
     };
 
     /**
@@ -170,7 +455,8 @@ public:
      */
     class Source {
         friend class MmapSPSC;
-        explicit Source(std::shared_ptr<MmapSPSC<T, Capacity>> queue) : queue_(queue) { }
+        friend struct detail::AsyncAccess<MmapSPSC>;
+        explicit Source(std::shared_ptr<MmapSPSC<T, Capacity, Wait>> queue) : queue_(queue) { }
 
     public:
         // Non-copyable
@@ -189,6 +475,50 @@ public:
          */
         std::optional<T> try_dequeue() { return queue_->try_dequeue(); }
 
+        /**
+         * @brief Try to dequeue a single element into `out` (move-assigned)
+         *
+         * @param out Destination, left untouched if the queue is empty
+         * @return true if successful, false if queue is empty
+         */
+        bool try_dequeue(T& out) { return queue_->try_dequeue(out); }
+
+        /**
+         * @brief Invoke `consume(element)` on the front element in its slot, then destroy it
+         *
+         * The element is not moved out of the ring; `consume` receives a `T&` and may read it or
+         * move from it. If `consume` throws, the element stays at the front of the queue.
+         *
+         * @param consume Callable taking `T&`
+         * @return true if an element was consumed, false if queue is empty
+         */
+        template <typename F>
+        bool try_consume(F&& consume) {
+            return queue_->try_consume(std::forward<F>(consume));
+        }
+
+        /**
+         * @brief Visit every available element in place, then release them with one head store
+         *
+         * Reads the tail once, calls `f(T&)` on up to `max` elements of the contiguous readable
+         * range in FIFO order, destroying each after its call, and publishes the new head once
+         * at the end, or every `release_every` elements so a long drain hands slots back to the
+         * producer as it goes. If `f` throws, the elements visited before the throwing one are
+         * released and the exception propagates.
+         *
+         * @param f Callback for each element; it may read the element or move from it
+         * @param max Upper bound on the number of elements visited
+         * @param release_every Publish the head after this many elements (0: only at the end)
+         * @return Number of elements visited
+         */
+        template <typename F>
+        std::size_t drain(
+            F&& f, std::size_t max = std::numeric_limits<std::size_t>::max(),
+            std::size_t release_every = 0
+        ) {
+            return queue_->drain(std::forward<F>(f), max, release_every);
+        }
+
         /**
          * @brief Try to dequeue multiple elements
          *
@@ -200,6 +530,23 @@ public:
             return queue_->try_dequeue(data, count);
         }
 
+        /**
+         * @brief View the readable region in place without dequeuing
+         *
+         * Thanks to the double mapping the view is one contiguous span, even across the wrap
+         * point. It stays valid until the matching `consume()`.
+         *
+         * @return Read-only span of all currently readable elements (possibly empty)
+         */
+        Span<const T> peek() { return queue_->peek(); }
+
+        /**
+         * @brief Destroy the first `count` elements of the last `peek()` and release their slots
+         *
+         * @param count Number of elements to drop; must not exceed the size of the last `peek()`
+         */
+        void consume(std::size_t count) { queue_->consume(count); }
+
         /**
          * @brief Block until an element can be dequeued with timeout
          *
@@ -245,136 +592,672 @@ public:
          */
         std::size_t size() const { return queue_->size(); }
 
+        /**
+         * @brief Snapshot of this process's counters (all zero unless built with `QBUF_STATS`)
+         */
+        QueueStats stats() const { return queue_->stats(); }
+
+        /**
+         * @brief Force the consumer's position to stable storage
+         *
+         * Journals only (see `open_journal()`): the head is otherwise persisted whenever the
+         * producer syncs, so after a power loss consumption resumes from the last synced head
+         * and may replay elements (at-least-once). A no-op for memory-backed queues.
+         *
+         * @throws std::runtime_error if the sync fails
+         */
+        void sync() { queue_->sync_file(); }
+
+        /**
+         * @brief Descriptor that becomes readable when elements arrive (`EventFdWait` only)
+         *
+         * Register it with poll/epoll for `POLLIN` and call `arm_notification()` before each
+         * sleep; without arming, the producer never signals it.
+         */
+        int native_handle() const { return queue_->control_->not_empty.native_handle(); }
+
+        /**
+         * @brief Ask the producer to signal `native_handle()` on its next publish
+         *
+         * Call after draining the queue, right before sleeping on the descriptor. Marks the
+         * consumer as sleeping and rechecks the queue, so a publish racing with the call is
+         * never missed; the producer clears the mark when it signals. Wakeups may be spurious.
+         *
+         * @return true if the queue is still empty and the caller may sleep, false if elements
+         * are already available (dequeue them instead)
+         */
+        bool arm_notification() {
+            return queue_->control_->not_empty.arm([this] { return !queue_->empty(); });
+        }
+
+        /**
+         * @brief Awaitable dequeue for C++20 coroutines (include qbuf/coro.hpp; needs `AsyncWait`)
+         *
+         * `co_await source.async_dequeue()` yields the next element, suspending the coroutine
+         * while the queue is empty; the producer's next publish resumes it. No thread blocks.
+         */
+        template <typename Queue = MmapSPSC>
+        detail::DequeueAwaiter<Queue> async_dequeue() {
+            return detail::DequeueAwaiter<Queue>(*this);
+        }
+
     private:
-        std::shared_ptr<MmapSPSC<T, Capacity>> queue_;
+        std::shared_ptr<MmapSPSC<T, Capacity, Wait>> queue_;
     };
 
     /**
      * @brief Factory method to create a memory-mapped SPSC queue with sink and source handles
      *
+     * @param numa_node Bind the control block and ring pages to this NUMA node (Linux only), e.g.
+     * the consumer's node; -1 leaves placement to first touch
      * @return std::pair containing (Sink, Source)
+     * @throws std::runtime_error if the mapping cannot be created or bound to `numa_node`
      */
-    static std::pair<Sink, Source> create() {
-        auto queue = std::shared_ptr<MmapSPSC<T, Capacity>>(new MmapSPSC<T, Capacity>());
+    static std::pair<Sink, Source> create(int numa_node = -1) {
+        MmapOptions options;
+        options.numa_node = numa_node;
+        return create(options);
+    }
+
+    /**
+     * @brief Create a queue with huge pages, pre-faulted or locked memory
+     *
+     * With `options.huge_page_size` set the ring is rounded up to whole huge pages, so the
+     * mapping may hold more slots than `Capacity`; occupancy is still limited to `Capacity - 1`.
+     *
+     * @param options Page size, residency and NUMA placement (see `MmapOptions`)
+     * @return std::pair containing (Sink, Source)
+     * @throws std::invalid_argument if `options.huge_page_size` is not 0, 2 MiB or 1 GiB
+     * @throws std::runtime_error if the mapping cannot be created (e.g. no huge pages reserved),
+     * bound to `options.numa_node`, or locked
+     */
+    static std::pair<Sink, Source> create(const MmapOptions& options) {
+        std::shared_ptr<MmapSPSC> queue(new MmapSPSC<T, Capacity, Wait>(options));
         return { Sink(queue), Source(queue) };
     }
 
-private:
-    void initialize_mmap() {
-        const std::size_t buffer_size = Capacity * sizeof(T);
+    /**
+     * @brief Same as `create()`, under the factory name the other queues use
+     */
+    static std::pair<Sink, Source> make_queue(int numa_node = -1) { return create(numa_node); }
+
+    /**
+     * @brief Same as `create(options)`, under the factory name the other queues use
+     */
+    static std::pair<Sink, Source> make_queue(const MmapOptions& options) {
+        return create(options);
+    }
+
+    /**
+     * @brief Create a queue whose control block and ring can be mapped by other processes
+     *
+     * With a `name` the region is a POSIX shared memory object (`shm_open`, must not exist yet;
+     * remove it with `unlink_shared()`), otherwise an anonymous memfd that can be inherited across
+     * `fork`/`exec` or passed over a Unix socket with `SCM_RIGHTS`. Each process then calls
+     * `attach_sink()` or `attach_source()` on its descriptor. Linux only.
+     *
+     * @param name Optional shared memory object name (e.g. "/feed"), or nullptr for a memfd
+     * @return File descriptor owned by the caller; close it once every process has attached
+     * @throws std::runtime_error if the region cannot be created
+     */
+    static int create_shared(const char* name = nullptr) {
+        static_assert(
+            std::is_trivially_copyable_v<T>, "Cross-process queues require a trivially copyable T"
+        );
+        static_assert(Wait::process_shared, "Wait strategy does not work across processes");
+#if defined(__linux__)
+        const int fd = (name != nullptr) ? shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600)
+                                         : memfd_create("mmap_spsc_shared", 0);
+        if (fd == -1) {
+            throw std::runtime_error("Failed to create shared memory region");
+        }
+
         const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const std::size_t control_size = control_bytes(page_size);
+        const std::size_t slots = ring_slots(page_size);
+        if (ftruncate(fd, control_size + slots * sizeof(T)) != 0) {
+            close(fd);
+            if (name != nullptr) shm_unlink(name);
+            throw std::runtime_error("Failed to set shared memory size");
+        }
+
+        void* control = mmap(nullptr, control_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (control == MAP_FAILED) {
+            close(fd);
+            if (name != nullptr) shm_unlink(name);
+            throw std::runtime_error("Failed to map shared control block");
+        }
+        try {
+            new (control) ControlBlock(slots, false);
+        } catch (...) {
+            munmap(control, control_size);
+            close(fd);
+            if (name != nullptr) shm_unlink(name);
+            throw;
+        }
+        munmap(control, control_size);
+        return fd;
+#else
+        (void)name;
+        throw std::runtime_error("Cross-process MmapSPSC requires Linux");
+#endif
+    }
+
+    /**
+     * @brief Open an existing named region created by `create_shared(name)`
+     *
+     * @param name Shared memory object name
+     * @return File descriptor owned by the caller
+     * @throws std::runtime_error if the object does not exist
+     */
+    static int open_shared(const char* name) {
+        const int fd = shm_open(name, O_RDWR, 0);
+        if (fd == -1) {
+            throw std::runtime_error("Failed to open shared memory region");
+        }
+        return fd;
+    }
+
+    /**
+     * @brief Remove a named region; processes that already attached keep their mapping
+     *
+     * @param name Shared memory object name
+     */
+    static void unlink_shared(const char* name) { shm_unlink(name); }
 
-        // Round up to page size
-        std::size_t mmap_size = buffer_size;
-        if (mmap_size % page_size != 0) {
-            mmap_size = ((mmap_size / page_size) + 1) * page_size;
+    /**
+     * @brief Map a shared region as the producer side
+     *
+     * Validates the control block (magic, version, capacity, element size) and claims the
+     * producer role, so at most one Sink exists across all processes. `fd` is duplicated; the
+     * caller keeps ownership of its descriptor.
+     *
+     * @param fd Descriptor from `create_shared()` / `open_shared()`, inherited or received
+     * @return Producer handle
+     * @throws std::runtime_error if the region is incompatible or already has a producer
+     */
+    static Sink attach_sink(int fd) {
+        static_assert(
+            std::is_trivially_copyable_v<T>, "Cross-process queues require a trivially copyable T"
+        );
+        static_assert(Wait::process_shared, "Wait strategy does not work across processes");
+        std::shared_ptr<MmapSPSC> queue(new MmapSPSC<T, Capacity, Wait>(fd, Role::sink));
+        return Sink(queue);
+    }
+
+    /**
+     * @brief Map a shared region as the consumer side
+     *
+     * Counterpart of `attach_sink()`; claims the consumer role.
+     *
+     * @param fd Descriptor from `create_shared()` / `open_shared()`, inherited or received
+     * @return Consumer handle
+     * @throws std::runtime_error if the region is incompatible or already has a consumer
+     */
+    static Source attach_source(int fd) {
+        static_assert(
+            std::is_trivially_copyable_v<T>, "Cross-process queues require a trivially copyable T"
+        );
+        static_assert(Wait::process_shared, "Wait strategy does not work across processes");
+        std::shared_ptr<MmapSPSC> queue(new MmapSPSC<T, Capacity, Wait>(fd, Role::source));
+        return Source(queue);
+    }
+
+    /**
+     * @brief Open or create a journal: a queue whose control block and ring live in a regular file
+     *
+     * A missing or empty file is created and sized for this queue type; an existing one is
+     * validated like `attach_*()` and both cursors are recovered from its control block, so the
+     * Source resumes at the first element not yet consumed. The file is `flock`ed while the
+     * handles exist, so a second open fails until they are gone (or their process died).
+     *
+     * Elements are written straight into the shared file mapping by every enqueue path,
+     * `reserve()`/`commit()` included, and read back at memory speed. Finished writes reach the
+     * page cache immediately, so a process crash loses nothing; `options.policy` decides how
+     * often the producer also forces them to disk (and with them the head, for at-least-once
+     * replay after a power loss). Elements published after the last completed sync may be lost
+     * or torn by a power loss. Linux only.
+     *
+     * @param path Journal file path
+     * @param options Sync policy and method (see `JournalOptions`)
+     * @return std::pair containing (Sink, Source)
+     * @throws std::invalid_argument if `options.every_messages` is 0 with `SyncPolicy::every_n`
+     * @throws std::runtime_error if the file cannot be opened, locked, sized or mapped, or holds
+     * a different queue type
+     */
+    static std::pair<Sink, Source> open_journal(
+        const char* path, const JournalOptions& options = { }
+    ) {
+        static_assert(std::is_trivially_copyable_v<T>, "Journals require a trivially copyable T");
+        if (options.policy == SyncPolicy::every_n && options.every_messages == 0) {
+            throw std::invalid_argument("Journal sync interval must be at least one message");
         }
+        std::shared_ptr<MmapSPSC> queue(new MmapSPSC<T, Capacity, Wait>(path, options));
+        return { Sink(queue), Source(queue) };
+    }
 
+    /**
+     * @brief Whether the ring is double-mapped (Linux)
+     *
+     * When true, `reserve()` and `peek()` always return every available slot as one contiguous
+     * span; otherwise (regular allocation fallback) they stop at the end of the buffer.
+     */
 #if defined(__linux__)
+    // buffer_[ring_size + i] aliases buffer_[i], so any run of slots is contiguous
+    static constexpr bool is_mirrored = true;
+#else
+    static constexpr bool is_mirrored = false;
+#endif
+
+private:
+    // Whether bulk copies and drains may run straight through the mirror. A non-trivially
+    // copyable object may hold pointers into itself (e.g. a short `std::string`), so it must only
+    // ever be built, moved and destroyed at its canonical address `buffer_[i]`, `i` < ring size.
+    static constexpr bool contiguous_runs = is_mirrored && std::is_trivially_copyable_v<T>;
+
+    std::size_t used_space(std::size_t head, std::size_t tail) const {
+        return (tail - head) & mask_;
+    }
+
+    std::size_t free_space(std::size_t tail, std::size_t head) const {
+        return (Capacity - 1) - used_space(head, tail);
+    }
+
+    /**
+     * @brief Number of ring slots needed for `Capacity` elements to fill whole pages
+     *
+     * The mirror only lines up with the ring if the ring is a whole number of pages, so the slot
+     * count is rounded up to the smallest power of two (at least `Capacity`) whose byte size is a
+     * multiple of `page_size`. Occupancy is still limited to `Capacity - 1`.
+     */
+    static std::size_t ring_slots(std::size_t page_size) {
+        return detail::mirrored_slots<T>(Capacity, page_size);
+    }
+
+    static constexpr std::uint64_t control_magic = 0x7162756653505343; // "qbufSPSC"
+    static constexpr std::uint32_t control_version = 1;
+
+    static_assert(
+        std::atomic<std::size_t>::is_always_lock_free,
+        "Shared control block requires lock-free indices"
+    );
+
+    /**
+     * @brief Shared state at the start of the mapping
+     *
+     * The header fields let `attach_*()` reject regions created for a different queue type.
+     */
+    struct ControlBlock {
+        ControlBlock(std::size_t slots, bool attached)
+                : magic(control_magic)
+                , version(control_version)
+                , element_size(sizeof(T))
+                , capacity(Capacity)
+                , ring_slots(slots)
+                , sink_attached(attached)
+                , source_attached(attached)
+                , head(0)
+                , tail(0) { }
+
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t element_size;
+        std::uint64_t capacity;
+        std::uint64_t ring_slots;
+        std::atomic<std::uint32_t> sink_attached;
+        std::atomic<std::uint32_t> source_attached;
+
+        alignas(64) std::atomic<std::size_t> head;
+        alignas(64) std::atomic<std::size_t> tail;
+        // Waiting producers park on `not_full`, waiting consumers on `not_empty`
+        alignas(64) Wait not_full;
+        alignas(64) Wait not_empty;
+    };
+
+    // Bytes reserved for the control block: whole pages, so the ring stays page aligned
+    static std::size_t control_bytes(std::size_t page_size) {
+        return ((sizeof(ControlBlock) + page_size - 1) / page_size) * page_size;
+    }
+
+    void initialize_mmap(const MmapOptions& options) {
+        const std::size_t page_size = detail::mapping_page_size(options);
+#if defined(__linux__)
+        const std::size_t slots = ring_slots(page_size);
+
         // Create anonymous memory-backed file
-        fd_ = memfd_create("mmap_spsc_queue", 0);
-        if (fd_ == -1) {
-            throw std::runtime_error("Failed to create memfd");
-        }
+        fd_ = detail::create_memfd("mmap_spsc_queue", options);
 
         // Set size
-        if (ftruncate(fd_, mmap_size) != 0) {
+        if (ftruncate(fd_, control_bytes(page_size) + slots * sizeof(T)) != 0) {
             close(fd_);
             throw std::runtime_error("Failed to set memfd size");
         }
 
-        // Reserve virtual address space for double mapping
-        void* addr = mmap(nullptr, 2 * mmap_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-        if (addr == MAP_FAILED) {
+        map_region(page_size, slots);
+        try {
+            detail::bind_to_numa_node(control_, control_size_ + mmap_size_, options.numa_node);
+        } catch (...) {
+            cleanup_mmap();
+            throw;
+        }
+        try {
+            detail::make_resident(control_, control_size_ + 2 * mmap_size_, options);
+        } catch (...) {
+            cleanup_mmap();
+            throw;
+        }
+        try {
+            control_ = new (control_) ControlBlock(slots, true);
+        } catch (...) {
+            cleanup_mmap();
+            throw;
+        }
+#else
+        // Fallback for non-Linux: use regular allocation
+        (void)page_size;
+        const std::size_t buffer_size = Capacity * sizeof(T);
+        control_ = new ControlBlock(Capacity, true);
+        buffer_ = static_cast<T*>(::operator new(buffer_size));
+        mmap_size_ = buffer_size;
+        mask_ = Capacity - 1;
+        fd_ = -1;
+#endif
+    }
+
+    void attach_mmap(int fd) {
+#if defined(__linux__)
+        fd_ = dup(fd);
+        if (fd_ == -1) {
+            throw std::runtime_error("Failed to duplicate shared memory descriptor");
+        }
+
+        const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const std::size_t slots = ring_slots(page_size);
+        const std::size_t expected_size = control_bytes(page_size) + slots * sizeof(T);
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || static_cast<std::size_t>(st.st_size) != expected_size) {
             close(fd_);
-            throw std::runtime_error("Failed to reserve virtual memory");
+            throw std::runtime_error("Shared memory region has an unexpected size");
         }
 
-        // Map first region
-        if (mmap(addr, mmap_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_, 0)
-            == MAP_FAILED) {
-            munmap(addr, 2 * mmap_size);
+        map_region(page_size, slots);
+        const char* error = control_error(slots);
+        if (error == nullptr && role_flag().exchange(1, std::memory_order_acq_rel) != 0) {
+            error = "Shared queue already has a handle for this role";
+        }
+        if (error != nullptr) {
+            role_ = Role::both; // nothing claimed
+            cleanup_mmap();
+            throw std::runtime_error(error);
+        }
+
+        // Start from the indices the other side has already published
+        cached_tail_ = control_->tail.load(std::memory_order_acquire);
+        cached_head_ = control_->head.load(std::memory_order_acquire);
+#else
+        (void)fd;
+        throw std::runtime_error("Cross-process MmapSPSC requires Linux");
+#endif
+    }
+
+    void open_journal_file(const char* path, const JournalOptions& options) {
+#if defined(__linux__)
+        fd_ = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ == -1) {
+            throw std::runtime_error("Failed to open journal file");
+        }
+        // The lock goes with the descriptor, so a crashed owner never leaves the journal locked
+        if (flock(fd_, LOCK_EX | LOCK_NB) != 0) {
             close(fd_);
-            throw std::runtime_error("Failed to map first region");
+            throw std::runtime_error("Journal file is already open");
         }
 
-        // Map second region at adjacent address
-        if (mmap(
-                static_cast<uint8_t*>(addr) + mmap_size, mmap_size, PROT_READ | PROT_WRITE,
-                MAP_SHARED | MAP_FIXED, fd_, 0
-            )
-            == MAP_FAILED) {
-            munmap(addr, 2 * mmap_size);
+        const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const std::size_t slots = ring_slots(page_size);
+        const std::size_t expected_size = control_bytes(page_size) + slots * sizeof(T);
+        struct stat st;
+        const char* size_error = nullptr;
+        if (fstat(fd_, &st) != 0) {
+            size_error = "Failed to stat journal file";
+        } else if (st.st_size == 0) {
+            if (ftruncate(fd_, expected_size) != 0) size_error = "Failed to set journal file size";
+        } else if (static_cast<std::size_t>(st.st_size) != expected_size) {
+            size_error = "Journal file has an unexpected size";
+        }
+        if (size_error != nullptr) {
             close(fd_);
-            throw std::runtime_error("Failed to map second region");
+            throw std::runtime_error(size_error);
         }
 
-        buffer_ = static_cast<T*>(addr);
-        mmap_size_ = mmap_size;
+        map_region(page_size, slots);
+        const char* error = nullptr;
+        if (control_->magic == 0) {
+            // New file, or one whose header never reached the disk: start empty
+            new (control_) ControlBlock(slots, true);
+        } else if ((error = control_error(slots)) == nullptr) {
+            const auto head = control_->head.load(std::memory_order_relaxed);
+            const auto tail = control_->tail.load(std::memory_order_relaxed);
+            if (head > mask_ || tail > mask_ || used_space(head, tail) > Capacity - 1) {
+                error = "Journal file is corrupt";
+            } else {
+                // Wait state belongs to the handles that last had the file open, not the data
+                new (&control_->not_full) Wait();
+                new (&control_->not_empty) Wait();
+                cached_tail_ = tail;
+                cached_head_ = head;
+            }
+        }
+        if (error != nullptr) {
+            cleanup_mmap();
+            throw std::runtime_error(error);
+        }
+
+        journal_ = true;
+        journal_options_ = options;
+        last_sync_ = std::chrono::steady_clock::now();
 #else
-        // Fallback for non-Linux: use regular allocation
-        buffer_ = static_cast<T*>(::operator new(buffer_size));
-        mmap_size_ = buffer_size;
-        fd_ = -1;
+        (void)path;
+        (void)options;
+        throw std::runtime_error("Journaled MmapSPSC requires Linux");
 #endif
     }
 
-    void cleanup_mmap() {
-        if (buffer_ == nullptr) return;
+    /**
+     * @brief Why the mapped control block does not belong to this queue type, or nullptr
+     */
+    const char* control_error(std::size_t slots) const {
+        if (control_->magic != control_magic || control_->version != control_version) {
+            return "Shared memory region is not an MmapSPSC queue";
+        }
+        if (control_->element_size != sizeof(T) || control_->capacity != Capacity
+            || control_->ring_slots != slots) {
+            return "Shared memory region was created for a different queue type";
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Force the control block and the ring of a journal to stable storage
+     */
+    void sync_file() {
+        if (!journal_) return;
+#if defined(__linux__)
+        const bool synced = (journal_options_.method == SyncMethod::msync)
+            ? msync(control_, control_size_ + mmap_size_, MS_SYNC) == 0
+            : fdatasync(fd_) == 0;
+        if (!synced) {
+            throw std::runtime_error("Failed to sync journal");
+        }
+#endif
+    }
+
+    // Producer-side sync: also restarts the policy's count and interval
+    void sync() {
+        sync_file();
+        unsynced_ = 0;
+        last_sync_ = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Apply the journal sync policy after the producer published `count` elements
+     */
+    void journal_published(std::size_t count) {
+        unsynced_ += count;
+        if (journal_options_.policy == SyncPolicy::every_n) {
+            if (unsynced_ >= journal_options_.every_messages) sync();
+        } else if (std::chrono::steady_clock::now() - last_sync_ >= journal_options_.interval) {
+            sync();
+        }
+    }
 
 #if defined(__linux__)
-        if (fd_ != -1) {
-            munmap(buffer_, 2 * mmap_size_);
+    /**
+     * @brief Map `fd_` as [control block][ring][ring mirror] in one reserved address range
+     */
+    void map_region(std::size_t page_size, std::size_t slots) {
+        const std::size_t control_size = control_bytes(page_size);
+        const std::size_t mmap_size = slots * sizeof(T);
+        std::uint8_t* addr = nullptr;
+        try {
+            addr = detail::map_mirrored(fd_, control_size, mmap_size, page_size);
+        } catch (...) {
             close(fd_);
-        } else {
-            ::operator delete(buffer_);
+            throw;
         }
+
+        control_ = reinterpret_cast<ControlBlock*>(addr);
+        buffer_ = reinterpret_cast<T*>(addr + control_size);
+        mmap_size_ = mmap_size;
+        control_size_ = control_size;
+        mask_ = slots - 1;
+    }
+#endif
+
+    std::atomic<std::uint32_t>& role_flag() {
+        return (role_ == Role::sink) ? control_->sink_attached : control_->source_attached;
+    }
+
+    void cleanup_mmap() {
+        if (buffer_ == nullptr) return;
+
+#if defined(__linux__)
+        if (role_ != Role::both) role_flag().store(0, std::memory_order_release);
+        munmap(control_, control_size_ + 2 * mmap_size_);
+        close(fd_);
 #else
+        delete control_;
         ::operator delete(buffer_);
 #endif
         buffer_ = nullptr;
+        control_ = nullptr;
         fd_ = -1;
     }
 
     /**
-     * @brief Try to enqueue a single element
+     * @brief Copy-construct `count` elements into the slots starting at `index`
      *
-     * @param value The value to enqueue
-     * @return true if successful, false if queue is full
+     * For trivially copyable `T` on the mirrored mapping this is a single `memcpy`; otherwise the
+     * run is split at the end of the buffer so every element lives at its canonical address.
      */
-    bool try_enqueue(const T& value) {
-        const auto current_tail = tail_.load(std::memory_order_relaxed);
-        const auto current_head = head_.load(std::memory_order_acquire);
+    void write_slots(std::size_t index, const T* data, std::size_t count) {
+        std::size_t first = count;
+        if constexpr (!contiguous_runs) {
+            first = (index + count <= mask_ + 1) ? count : (mask_ + 1 - index);
+        }
 
-        const auto next_tail = (current_tail + 1) & (Capacity - 1);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            detail::copy_to_ring(&buffer_[index], data, first * sizeof(T));
+            if (first < count) {
+                detail::copy_to_ring(&buffer_[0], data + first, (count - first) * sizeof(T));
+            }
+        } else {
+            for (std::size_t i = 0; i < first; ++i) new (&buffer_[index + i]) T(data[i]);
+            for (std::size_t i = first; i < count; ++i) new (&buffer_[i - first]) T(data[i]);
+        }
+    }
 
-        if (next_tail == current_head) {
-            return false;
+    /**
+     * @brief Move `count` elements out of the slots starting at `index` and destroy them
+     *
+     * Counterpart of `write_slots()`, with the same contiguous fast path.
+     */
+    void read_slots(std::size_t index, T* data, std::size_t count) {
+        std::size_t first = count;
+        if constexpr (!contiguous_runs) {
+            first = (index + count <= mask_ + 1) ? count : (mask_ + 1 - index);
         }
 
-        new (&buffer_[current_tail]) T(value);
-        tail_.store(next_tail, std::memory_order_release);
-        return true;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(data, &buffer_[index], first * sizeof(T));
+            if (first < count) std::memcpy(data + first, &buffer_[0], (count - first) * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < first; ++i) {
+                data[i] = std::move(buffer_[index + i]);
+                buffer_[index + i].~T();
+            }
+            for (std::size_t i = first; i < count; ++i) {
+                data[i] = std::move(buffer_[i - first]);
+                buffer_[i - first].~T();
+            }
+        }
     }
 
     /**
-     * @brief Try to enqueue a single element (move semantics)
+     * @brief Try to enqueue a single element
      *
      * @param value The value to enqueue
      * @return true if successful, false if queue is full
      */
+    bool try_enqueue(const T& value) {
+        return try_publish([&](void* slot) { new (slot) T(value); });
+    }
+
+    /**
+     * @brief Try to enqueue a single element (move semantics)
+     *
+     * @param value The value to enqueue
+     * @return true if successful, false if queue is full (`value` is left untouched)
+     */
     bool try_enqueue(T&& value) {
-        const auto current_tail = tail_.load(std::memory_order_relaxed);
-        const auto current_head = head_.load(std::memory_order_acquire);
+        return try_publish([&](void* slot) { new (slot) T(std::move(value)); });
+    }
 
-        const auto next_tail = (current_tail + 1) & (Capacity - 1);
+    /**
+     * @brief Try to construct an element from `args` directly in the tail slot
+     *
+     * @param args Constructor arguments for `T`
+     * @return true if successful, false if queue is full (nothing is constructed)
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        return try_publish([&](void* slot) { new (slot) T(std::forward<Args>(args)...); });
+    }
 
-        if (next_tail == current_head) {
-            return false;
+    /**
+     * @brief Claim the tail slot, let `construct(slot)` build an element in it, and publish it
+     *
+     * `construct` only runs when there is room.
+     */
+    template <typename Construct>
+    bool try_publish(Construct&& construct) {
+        const auto current_tail = control_->tail.load(std::memory_order_relaxed);
+        const auto next_tail = (current_tail + 1) & mask_;
+
+        // The ring may hold more slots than Capacity, so check occupancy rather than next == head
+        if (free_space(current_tail, cached_head_) == 0) {
+            cached_head_ = control_->head.load(std::memory_order_acquire);
+            if (free_space(current_tail, cached_head_) == 0) {
+                producer_stats_.record_rejection();
+                return false;
+            }
         }
 
-        new (&buffer_[current_tail]) T(std::move(value));
-        tail_.store(next_tail, std::memory_order_release);
+        construct(static_cast<void*>(&buffer_[current_tail]));
+        control_->tail.store(next_tail, std::memory_order_release);
+        control_->not_empty.notify();
+        if (journal_options_.policy != SyncPolicy::none) journal_published(1);
+        producer_stats_.record_success(1);
+        producer_stats_.record_occupancy(used_space(cached_head_, next_tail));
         return true;
     }
 
@@ -388,30 +1271,73 @@ private:
     std::size_t try_enqueue(const T* data, std::size_t count) {
         if (count == 0) return 0;
 
-        const auto current_tail = tail_.load(std::memory_order_relaxed);
-        const auto current_head = head_.load(std::memory_order_acquire);
+        const auto current_tail = control_->tail.load(std::memory_order_relaxed);
 
-        const auto available = (current_head > current_tail)
-            ? (current_head - current_tail - 1)
-            : (Capacity - current_tail + current_head - 1);
+        auto available = free_space(current_tail, cached_head_);
+        if (available < count) {
+            cached_head_ = control_->head.load(std::memory_order_acquire);
+            available = free_space(current_tail, cached_head_);
+        }
 
         const auto to_write = (count < available) ? count : available;
-        if (to_write == 0) return 0;
+        if (to_write == 0) {
+            producer_stats_.record_rejection();
+            return 0;
+        }
 
-        const auto first_chunk
-            = (current_tail + to_write <= Capacity) ? to_write : (Capacity - current_tail);
+        write_slots(current_tail, data, to_write);
 
-        for (std::size_t i = 0; i < first_chunk; ++i) {
-            new (&buffer_[current_tail + i]) T(data[i]);
+        const auto next_tail = (current_tail + to_write) & mask_;
+        control_->tail.store(next_tail, std::memory_order_release);
+        control_->not_empty.notify();
+        if (journal_options_.policy != SyncPolicy::none) journal_published(to_write);
+        producer_stats_.record_success(to_write);
+        producer_stats_.record_occupancy(used_space(cached_head_, next_tail));
+        return to_write;
+    }
+
+    /**
+     * @brief Reserve up to `count` contiguous writable slots starting at the tail
+     *
+     * @param count Maximum number of slots to reserve
+     * @return Writable span into the mirrored region
+     */
+    Span<T> reserve(std::size_t count) {
+        static_assert(
+            std::is_trivially_copyable_v<T>, "reserve() requires a trivially copyable T"
+        );
+
+        const auto current_tail = control_->tail.load(std::memory_order_relaxed);
+
+        auto available = free_space(current_tail, cached_head_);
+        if (available < count) {
+            cached_head_ = control_->head.load(std::memory_order_acquire);
+            available = free_space(current_tail, cached_head_);
         }
 
-        const auto second_chunk = to_write - first_chunk;
-        for (std::size_t i = 0; i < second_chunk; ++i) {
-            new (&buffer_[i]) T(data[first_chunk + i]);
+        std::size_t n = (count < available) ? count : available;
+        if constexpr (!is_mirrored) {
+            // No mirror to run into; stop at the end of the buffer
+            if (n > mask_ + 1 - current_tail) n = mask_ + 1 - current_tail;
         }
+        return Span<T>(&buffer_[current_tail], n);
+    }
 
-        tail_.store((current_tail + to_write) & (Capacity - 1), std::memory_order_release);
-        return to_write;
+    /**
+     * @brief Publish `count` reserved slots with a single release store of the tail
+     *
+     * @param count Number of slots to publish
+     */
+    void commit(std::size_t count) {
+        const auto current_tail = control_->tail.load(std::memory_order_relaxed);
+        const auto next_tail = (current_tail + count) & mask_;
+        control_->tail.store(next_tail, std::memory_order_release);
+        control_->not_empty.notify();
+        if (count != 0) {
+            if (journal_options_.policy != SyncPolicy::none) journal_published(count);
+            producer_stats_.record_success(count);
+            producer_stats_.record_occupancy(used_space(cached_head_, next_tail));
+        }
     }
 
     /**
@@ -420,18 +1346,48 @@ private:
      * @return std::optional containing the element if successful, std::nullopt if queue is empty
      */
     std::optional<T> try_dequeue() {
-        const auto current_head = head_.load(std::memory_order_relaxed);
-        const auto current_tail = tail_.load(std::memory_order_acquire);
+        std::optional<T> value;
+        try_consume([&](T& element) { value.emplace(std::move(element)); });
+        return value;
+    }
+
+    /**
+     * @brief Try to dequeue a single element into `out` (move-assigned)
+     *
+     * @param out Destination, left untouched if the queue is empty
+     * @return true if successful, false if queue is empty
+     */
+    bool try_dequeue(T& out) {
+        return try_consume([&](T& element) { out = std::move(element); });
+    }
 
-        if (current_head == current_tail) {
-            return std::nullopt;
+    /**
+     * @brief Invoke `consume(element)` on the front element in its slot, then destroy it
+     *
+     * If `consume` throws, the element stays at the front of the queue.
+     *
+     * @param consume Callable taking `T&`; it may read the element or move from it
+     * @return true if an element was consumed, false if queue is empty
+     */
+    template <typename Consume>
+    bool try_consume(Consume&& consume) {
+        const auto current_head = control_->head.load(std::memory_order_relaxed);
+
+        if (current_head == cached_tail_) {
+            cached_tail_ = control_->tail.load(std::memory_order_acquire);
+            if (current_head == cached_tail_) {
+                consumer_stats_.record_rejection();
+                return false;
+            }
         }
 
-        T value = std::move(buffer_[current_head]);
+        consume(buffer_[current_head]);
         buffer_[current_head].~T();
 
-        head_.store((current_head + 1) & (Capacity - 1), std::memory_order_release);
-        return value;
+        control_->head.store((current_head + 1) & mask_, std::memory_order_release);
+        control_->not_full.notify();
+        consumer_stats_.record_success(1);
+        return true;
     }
 
     /**
@@ -444,32 +1400,109 @@ private:
     std::size_t try_dequeue(T* data, std::size_t count) {
         if (count == 0) return 0;
 
-        const auto current_head = head_.load(std::memory_order_relaxed);
-        const auto current_tail = tail_.load(std::memory_order_acquire);
+        const auto current_head = control_->head.load(std::memory_order_relaxed);
 
-        const auto available = (current_tail >= current_head)
-            ? (current_tail - current_head)
-            : (Capacity - current_head + current_tail);
+        auto available = used_space(current_head, cached_tail_);
+        if (available < count) {
+            cached_tail_ = control_->tail.load(std::memory_order_acquire);
+            available = used_space(current_head, cached_tail_);
+        }
 
         const auto to_read = (count < available) ? count : available;
-        if (to_read == 0) return 0;
+        if (to_read == 0) {
+            consumer_stats_.record_rejection();
+            return 0;
+        }
 
-        const auto first_chunk
-            = (current_head + to_read <= Capacity) ? to_read : (Capacity - current_head);
+        read_slots(current_head, data, to_read);
+
+        control_->head.store((current_head + to_read) & mask_, std::memory_order_release);
+        control_->not_full.notify();
+        consumer_stats_.record_success(to_read);
+        return to_read;
+    }
 
-        for (std::size_t i = 0; i < first_chunk; ++i) {
-            data[i] = std::move(buffer_[current_head + i]);
-            buffer_[current_head + i].~T();
+    /**
+     * @brief View all readable elements starting at the head as one contiguous span
+     *
+     * @return Read-only span into the mirrored region
+     */
+    Span<const T> peek() {
+        const auto current_head = control_->head.load(std::memory_order_relaxed);
+        cached_tail_ = control_->tail.load(std::memory_order_acquire);
+
+        std::size_t n = used_space(current_head, cached_tail_);
+        if constexpr (!is_mirrored) {
+            // No mirror to read through; stop at the end of the buffer
+            if (n > mask_ + 1 - current_head) n = mask_ + 1 - current_head;
         }
+        return Span<const T>(&buffer_[current_head], n);
+    }
 
-        const auto second_chunk = to_read - first_chunk;
-        for (std::size_t i = 0; i < second_chunk; ++i) {
-            data[first_chunk + i] = std::move(buffer_[i]);
-            buffer_[i].~T();
+    /**
+     * @brief Destroy `count` peeked elements and advance the head with a single release store
+     *
+     * @param count Number of elements to release
+     */
+    void consume(std::size_t count) {
+        const auto current_head = control_->head.load(std::memory_order_relaxed);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t i = 0; i < count; ++i) {
+                buffer_[(current_head + i) & mask_].~T();
+            }
         }
+        release(count);
+    }
 
-        head_.store((current_head + to_read) & (Capacity - 1), std::memory_order_release);
-        return to_read;
+    /**
+     * @brief Call `f(T&)` on up to `max` readable elements in place, releasing them in groups
+     *
+     * @return Number of elements visited
+     */
+    template <typename F>
+    std::size_t drain(F&& f, std::size_t max, std::size_t release_every) {
+        const auto current_head = control_->head.load(std::memory_order_relaxed);
+        cached_tail_ = control_->tail.load(std::memory_order_acquire);
+
+        const std::size_t n = std::min(max, used_space(current_head, cached_tail_));
+        if (n == 0) {
+            consumer_stats_.record_rejection();
+            return 0;
+        }
+
+        std::size_t visited = 0;
+        std::size_t released = 0;
+        auto visit = [&](T* slots, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                f(slots[i]);
+                slots[i].~T();
+                if (++visited - released == release_every) {
+                    release(release_every);
+                    released = visited;
+                }
+            }
+        };
+        try {
+            // One range through the mirror for trivially copyable `T`; otherwise (or without a
+            // mirror) up to two segments split at the end, so no object is touched via its alias
+            std::size_t first = n;
+            if constexpr (!contiguous_runs) first = std::min(n, mask_ + 1 - current_head);
+            visit(&buffer_[current_head], first);
+            visit(&buffer_[0], n - first);
+        } catch (...) {
+            if (visited != released) release(visited - released);
+            throw;
+        }
+        if (visited != released) release(visited - released);
+        return n;
+    }
+
+    // Advance the head past `count` already destroyed elements with one release store
+    void release(std::size_t count) {
+        const auto current_head = control_->head.load(std::memory_order_relaxed);
+        control_->head.store((current_head + count) & mask_, std::memory_order_release);
+        control_->not_full.notify();
+        if (count != 0) consumer_stats_.record_success(count);
     }
 
     /**
@@ -483,16 +1516,11 @@ private:
      */
     template <typename Rep, typename Period>
     bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        while (true) {
-            if (try_enqueue(value)) {
-                return true;
-            }
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return false;
-            }
-            std::this_thread::yield();
-        }
+        if (try_enqueue(value)) return true;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return producer_stats_.wait_until(
+            control_->not_full, [&] { return try_enqueue(value); }, deadline
+        );
     }
 
     /**
@@ -506,16 +1534,11 @@ private:
      */
     template <typename Rep, typename Period>
     bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        while (true) {
-            if (try_enqueue(std::move(value))) {
-                return true;
-            }
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return false;
-            }
-            std::this_thread::yield();
-        }
+        if (try_enqueue(std::move(value))) return true;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return producer_stats_.wait_until(
+            control_->not_full, [&] { return try_enqueue(std::move(value)); }, deadline
+        );
     }
 
     /**
@@ -530,23 +1553,18 @@ private:
      */
     template <typename Rep, typename Period>
     bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
-        if (count == 0) return true;
-
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        std::size_t total_enqueued = 0;
-        while (total_enqueued < count) {
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return false;
-            }
-
-            std::size_t enqueued = try_enqueue(data + total_enqueued, count - total_enqueued);
-            total_enqueued += enqueued;
-
-            if (total_enqueued < count) {
-                std::this_thread::yield();
-            }
-        }
-        return true;
+        std::size_t total_enqueued = try_enqueue(data, count);
+        if (total_enqueued == count) return true;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return producer_stats_.wait_until(
+            control_->not_full,
+            [&] {
+                total_enqueued += try_enqueue(data + total_enqueued, count - total_enqueued);
+                return total_enqueued == count;
+            },
+            deadline
+        );
     }
 
     /**
@@ -559,17 +1577,19 @@ private:
      */
     template <typename Rep, typename Period>
     std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        while (true) {
-            auto value = try_dequeue();
-            if (value.has_value()) {
-                return value;
-            }
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return std::nullopt;
-            }
-            std::this_thread::yield();
-        }
+        std::optional<T> value = try_dequeue();
+        if (value.has_value()) return value;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        consumer_stats_.wait_until(
+            control_->not_empty,
+            [&] {
+                value = try_dequeue();
+                return value.has_value();
+            },
+            deadline
+        );
+        return value;
     }
 
     /**
@@ -584,22 +1604,18 @@ private:
      */
     template <typename Rep, typename Period>
     std::size_t dequeue(T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
-        if (count == 0) return 0;
-
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        std::size_t total_dequeued = 0;
-        while (total_dequeued < count) {
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return total_dequeued;
-            }
-
-            std::size_t dequeued = try_dequeue(data + total_dequeued, count - total_dequeued);
-            total_dequeued += dequeued;
-
-            if (total_dequeued < count) {
-                std::this_thread::yield();
-            }
-        }
+        std::size_t total_dequeued = try_dequeue(data, count);
+        if (total_dequeued == count) return total_dequeued;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        consumer_stats_.wait_until(
+            control_->not_empty,
+            [&] {
+                total_dequeued += try_dequeue(data + total_dequeued, count - total_dequeued);
+                return total_dequeued == count;
+            },
+            deadline
+        );
         return total_dequeued;
     }
 
@@ -609,7 +1625,8 @@ private:
      * @return true if empty, false otherwise
      */
     bool empty() const {
-        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        return control_->head.load(std::memory_order_acquire)
+            == control_->tail.load(std::memory_order_acquire);
     }
 
     /**
@@ -618,23 +1635,43 @@ private:
      * @return Approximate number of elements in the queue
      */
     std::size_t size() const {
-        const auto head = head_.load(std::memory_order_acquire);
-        const auto tail = tail_.load(std::memory_order_acquire);
-        return (tail >= head) ? (tail - head) : (Capacity - head + tail);
+        const auto head = control_->head.load(std::memory_order_acquire);
+        const auto tail = control_->tail.load(std::memory_order_acquire);
+        return used_space(head, tail);
     }
 
-    alignas(64) std::atomic<std::size_t> head_;
-    alignas(64) std::atomic<std::size_t> tail_;
-    T* buffer_;
+    QueueStats stats() const { return detail::make_stats(producer_stats_, consumer_stats_); }
+
+    // qbuf/coro.hpp reaches the wait objects and occupancy checks through this
+    friend struct detail::AsyncAccess<MmapSPSC>;
+
+    // Producer owns `control_->tail` and `cached_head_`; consumer owns `control_->head` and
+    // `cached_tail_`. The cached copies are process-local and each sits on its own cache line, so
+    // the shared index is only pulled across when the cache runs out.
+    ControlBlock* control_ = nullptr;
+    alignas(64) std::size_t cached_tail_; // consumer-local copy of the tail
+    alignas(64) std::size_t cached_head_; // producer-local copy of the head
+    // Journal sync policy state, producer-local like `cached_head_`
+    JournalOptions journal_options_ { };
+    std::size_t unsynced_ = 0; // elements published since the last sync
+    std::chrono::steady_clock::time_point last_sync_ { };
+    // Process-local counters, written only by the producer / only by the consumer
+    detail::StatsCounters producer_stats_;
+    detail::StatsCounters consumer_stats_;
+    alignas(64) T* buffer_;
     int fd_;
+    Role role_;
+    bool journal_ = false; // backed by a regular file (see open_journal())
     std::size_t mmap_size_;
+    std::size_t control_size_ = 0;
+    std::size_t mask_; // ring slot count minus one (see ring_slots())
 };
 
-template <typename T, std::size_t Capacity>
-using MmapSpscSource = typename MmapSPSC<T, Capacity>::Source;
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using MmapSpscSource = typename MmapSPSC<T, Capacity, Wait>::Source;
 
-template <typename T, std::size_t Capacity>
-using MmapSpscSink = typename MmapSPSC<T, Capacity>::Sink;
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using MmapSpscSink = typename MmapSPSC<T, Capacity, Wait>::Sink;
 
 } // namespace qbuf
 #endif // QBUF_MMAP_SPSC_HPP
@@ -0,0 +1,610 @@
+#ifndef QBUF_MPMC_HPP
+#define QBUF_MPMC_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <qbuf/wait.hpp>
+
+namespace qbuf {
+
+/**
+ * @brief Multi-Producer Multi-Consumer bounded lock-free queue
+ *
+ * Vyukov-style ring where every slot carries a sequence number. A slot at position `pos` is
+ * free for the producer that claims `pos` when its sequence equals `pos`, and holds a value for
+ * the consumer that claims `pos` when its sequence equals `pos + 1`. Producers and consumers
+ * claim positions with a CAS on `enqueue_pos_` / `dequeue_pos_`; no locks are taken.
+ *
+ * Unlike SPSC, every slot is usable, so maximum occupancy is `Capacity`.
+ *
+ * @tparam T The type of elements stored in the queue
+ * @tparam Capacity Maximum number of elements the queue can hold (power of two)
+ * @tparam Wait Strategy used by the blocking `enqueue`/`dequeue` calls (see qbuf/wait.hpp)
+ */
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+class MPMC {
+public:
+    static_assert(Capacity > 1, "Queue capacity must be greater than 1");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of 2");
+
+private:
+    MPMC() : enqueue_pos_(0), dequeue_pos_(0) {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    // non-copyable
+    MPMC(const MPMC&) = delete;
+    MPMC& operator=(const MPMC&) = delete;
+    // non-movable
+    MPMC(MPMC&&) = delete;
+    MPMC& operator=(MPMC&&) = delete;
+
+    /**
+     * @brief Producer-side handle for MPMC queue
+     *
+     * Provides a restricted interface exposing only enqueue operations and utility methods.
+     * Copyable: every producer thread may hold its own copy.
+     */
+    class Sink {
+    private:
+        friend class MPMC;
+        explicit Sink(std::shared_ptr<MPMC<T, Capacity, Wait>> queue) : queue_(queue) { }
+
+    public:
+        // Copyable
+        Sink(const Sink&) = default;
+        Sink& operator=(const Sink&) = default;
+
+        // Movable
+        Sink(Sink&&) = default;
+        Sink& operator=(Sink&&) = default;
+
+        /**
+         * @brief Try to enqueue a single element
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if queue is full
+         */
+        bool try_enqueue(const T& value) { return queue_->try_enqueue(value); }
+
+        /**
+         * @brief Try to enqueue a single element (move semantics)
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if queue is full
+         */
+        bool try_enqueue(T&& value) { return queue_->try_enqueue(std::move(value)); }
+
+        /**
+         * @brief Try to enqueue multiple elements into consecutive positions
+         *
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @return Number of elements successfully enqueued
+         */
+        std::size_t try_enqueue(const T* data, std::size_t count) {
+            return queue_->try_enqueue(data, count);
+        }
+
+        /**
+         * @brief Block until an element can be enqueued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue
+         * @param timeout Maximum time to wait for enqueue
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(value, timeout);
+        }
+
+        /**
+         * @brief Block until an element can be enqueued with timeout (move semantics)
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue (will be moved)
+         * @param timeout Maximum time to wait for enqueue
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(std::move(value), timeout);
+        }
+
+        /**
+         * @brief Block until all elements are enqueued with timeout
+         *
+         * Elements from one call may interleave with elements from other producers.
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @param timeout Maximum time to wait for all elements to be enqueued
+         * @return true if all elements were enqueued, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(data, count, timeout);
+        }
+
+        /**
+         * @brief Check if the queue is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return queue_->empty(); }
+
+        /**
+         * @brief Get approximate size of the queue
+         *
+         * @return Approximate number of elements in the queue
+         */
+        std::size_t size() const { return queue_->size(); }
+
+        /**
+         * @brief Get the maximum number of elements the queue can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<MPMC<T, Capacity, Wait>> queue_;
+    };
+
+    /**
+     * @brief Consumer-side handle for MPMC queue
+     *
+     * Provides a restricted interface exposing only dequeue operations and utility methods.
+     * Copyable: every consumer thread may hold its own copy.
+     */
+    class Source {
+    private:
+        friend class MPMC;
+        explicit Source(std::shared_ptr<MPMC<T, Capacity, Wait>> queue) : queue_(queue) { }
+
+    public:
+        // Copyable
+        Source(const Source&) = default;
+        Source& operator=(const Source&) = default;
+
+        // Movable
+        Source(Source&&) = default;
+        Source& operator=(Source&&) = default;
+
+        /**
+         * @brief Try to dequeue a single element
+         *
+         * @return std::optional containing the value if successful, std::nullopt if queue is empty
+         */
+        std::optional<T> try_dequeue() { return queue_->try_dequeue(); }
+
+        /**
+         * @brief Try to dequeue multiple elements from consecutive positions
+         *
+         * @param data Pointer to output array
+         * @param count Maximum number of elements to dequeue
+         * @return Number of elements successfully dequeued
+         */
+        std::size_t try_dequeue(T* data, std::size_t count) {
+            return queue_->try_dequeue(data, count);
+        }
+
+        /**
+         * @brief Block until an element can be dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param timeout Maximum time to wait for dequeue
+         * @return std::optional containing the element if successful, std::nullopt if timeout
+         * expired
+         */
+        template <typename Rep, typename Period>
+        std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+            return queue_->dequeue(timeout);
+        }
+
+        /**
+         * @brief Block until all elements are dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to output array
+         * @param count Number of elements to dequeue
+         * @param timeout Maximum time to wait for all elements to be dequeued
+         * @return Number of elements successfully dequeued (may be less than count if timeout)
+         */
+        template <typename Rep, typename Period>
+        std::size_t dequeue(
+            T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout
+        ) {
+            return queue_->dequeue(data, count, timeout);
+        }
+
+        /**
+         * @brief Check if the queue is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return queue_->empty(); }
+
+        /**
+         * @brief Get approximate size of the queue
+         *
+         * @return Approximate number of elements in the queue
+         */
+        std::size_t size() const { return queue_->size(); }
+
+        /**
+         * @brief Get the maximum number of elements the queue can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<MPMC<T, Capacity, Wait>> queue_;
+    };
+
+    /**
+     * @brief Factory method to create a queue with sink and source handles
+     *
+     * The returned handles can be copied freely to hand one to each producer and consumer.
+     *
+     * @return std::pair<Sink, Source> A pair of producer and consumer handles
+     */
+    static std::pair<Sink, Source> make_queue() {
+        std::shared_ptr<MPMC> queue(new MPMC<T, Capacity, Wait>());
+        return { Sink(queue), Source(queue) };
+    }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    // Signed distance between a slot sequence and a position; positions never wrap in practice
+    static std::ptrdiff_t distance(std::size_t sequence, std::size_t pos) {
+        return static_cast<std::ptrdiff_t>(sequence - pos);
+    }
+
+    /**
+     * @brief Claim one position for writing
+     *
+     * @param pos Receives the claimed position
+     * @return true if a slot was claimed, false if the queue is full
+     */
+    bool claim_enqueue(std::size_t& pos) {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            const auto sequence = slots_[pos & mask].sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = distance(sequence, pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Slot still holds a value from the previous lap: full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Claim one position for reading
+     *
+     * @param pos Receives the claimed position
+     * @return true if a slot was claimed, false if the queue is empty
+     */
+    bool claim_dequeue(std::size_t& pos) {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            const auto sequence = slots_[pos & mask].sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = distance(sequence, pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Slot not yet published: empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Try to enqueue a single element
+     *
+     * @param value The value to enqueue
+     * @return true if successful, false if queue is full
+     */
+    bool try_enqueue(const T& value) {
+        std::size_t pos;
+        if (!claim_enqueue(pos)) return false;
+
+        Slot& slot = slots_[pos & mask];
+        slot.value = value;
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        not_empty_.notify();
+        return true;
+    }
+
+    /**
+     * @brief Try to enqueue a single element (move semantics)
+     *
+     * @param value The value to enqueue
+     * @return true if successful, false if queue is full
+     */
+    bool try_enqueue(T&& value) {
+        std::size_t pos;
+        if (!claim_enqueue(pos)) return false;
+
+        Slot& slot = slots_[pos & mask];
+        slot.value = std::move(value);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        not_empty_.notify();
+        return true;
+    }
+
+    /**
+     * @brief Try to enqueue multiple elements into consecutive positions
+     *
+     * Counts the run of free slots starting at the current position and claims the whole run
+     * with a single CAS, then publishes the slots in order.
+     *
+     * @param data Pointer to array of elements to enqueue
+     * @param count Number of elements to enqueue
+     * @return Number of elements successfully enqueued
+     */
+    std::size_t try_enqueue(const T* data, std::size_t count) {
+        if (count > Capacity) count = Capacity;
+        if (count == 0) return 0;
+
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        std::size_t n;
+        while (true) {
+            n = 0;
+            while (n < count) {
+                const auto& slot = slots_[(pos + n) & mask];
+                if (slot.sequence.load(std::memory_order_acquire) != pos + n) break;
+                ++n;
+            }
+            if (n == 0) {
+                // Either full or another producer moved past `pos`; only retry in the latter case
+                const std::size_t current = enqueue_pos_.load(std::memory_order_relaxed);
+                if (current == pos) return 0;
+                pos = current;
+                continue;
+            }
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) break;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            Slot& slot = slots_[(pos + i) & mask];
+            slot.value = data[i];
+            slot.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        not_empty_.notify();
+        return n;
+    }
+
+    /**
+     * @brief Try to dequeue a single element
+     *
+     * @return std::optional containing the value if successful, std::nullopt if queue is empty
+     */
+    std::optional<T> try_dequeue() {
+        std::size_t pos;
+        if (!claim_dequeue(pos)) return std::nullopt;
+
+        Slot& slot = slots_[pos & mask];
+        T value = std::move(slot.value);
+        slot.sequence.store(pos + Capacity, std::memory_order_release);
+        not_full_.notify();
+        return value;
+    }
+
+    /**
+     * @brief Try to dequeue multiple elements from consecutive positions
+     *
+     * Counts the run of published slots starting at the current position and claims the whole
+     * run with a single CAS.
+     *
+     * @param data Pointer to output array
+     * @param count Maximum number of elements to dequeue
+     * @return Number of elements successfully dequeued
+     */
+    std::size_t try_dequeue(T* data, std::size_t count) {
+        if (count > Capacity) count = Capacity;
+        if (count == 0) return 0;
+
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        std::size_t n;
+        while (true) {
+            n = 0;
+            while (n < count) {
+                const auto& slot = slots_[(pos + n) & mask];
+                if (slot.sequence.load(std::memory_order_acquire) != pos + n + 1) break;
+                ++n;
+            }
+            if (n == 0) {
+                const std::size_t current = dequeue_pos_.load(std::memory_order_relaxed);
+                if (current == pos) return 0;
+                pos = current;
+                continue;
+            }
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) break;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            Slot& slot = slots_[(pos + i) & mask];
+            data[i] = std::move(slot.value);
+            slot.sequence.store(pos + i + Capacity, std::memory_order_release);
+        }
+        not_full_.notify();
+        return n;
+    }
+
+    /**
+     * @brief Block until an element can be enqueued with timeout
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param value The value to enqueue
+     * @param timeout Maximum time to wait for enqueue
+     * @return true if successful, false if timeout expired
+     */
+    template <typename Rep, typename Period>
+    bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+        if (try_enqueue(value)) return true;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return not_full_.wait_until([&] { return try_enqueue(value); }, deadline);
+    }
+
+    /**
+     * @brief Block until an element can be enqueued with timeout (move semantics)
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param value The value to enqueue (will be moved)
+     * @param timeout Maximum time to wait for enqueue
+     * @return true if successful, false if timeout expired
+     */
+    template <typename Rep, typename Period>
+    bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+        if (try_enqueue(std::move(value))) return true;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return not_full_.wait_until([&] { return try_enqueue(std::move(value)); }, deadline);
+    }
+
+    /**
+     * @brief Block until all elements are enqueued with timeout
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param data Pointer to array of elements to enqueue
+     * @param count Number of elements to enqueue
+     * @param timeout Maximum time to wait for all elements to be enqueued
+     * @return true if all elements were enqueued, false if timeout expired
+     */
+    template <typename Rep, typename Period>
+    bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t total_enqueued = try_enqueue(data, count);
+        if (total_enqueued == count) return true;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return not_full_.wait_until(
+            [&] {
+                total_enqueued += try_enqueue(data + total_enqueued, count - total_enqueued);
+                return total_enqueued == count;
+            },
+            deadline
+        );
+    }
+
+    /**
+     * @brief Block until an element can be dequeued with timeout
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param timeout Maximum time to wait for dequeue
+     * @return std::optional containing the element if successful, std::nullopt if timeout expired
+     */
+    template <typename Rep, typename Period>
+    std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+        std::optional<T> value = try_dequeue();
+        if (value.has_value()) return value;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        not_empty_.wait_until(
+            [&] {
+                value = try_dequeue();
+                return value.has_value();
+            },
+            deadline
+        );
+        return value;
+    }
+
+    /**
+     * @brief Block until all elements are dequeued with timeout
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param data Pointer to output array
+     * @param count Number of elements to dequeue
+     * @param timeout Maximum time to wait for all elements to be dequeued
+     * @return Number of elements successfully dequeued (may be less than count if timeout)
+     */
+    template <typename Rep, typename Period>
+    std::size_t dequeue(T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t total_dequeued = try_dequeue(data, count);
+        if (total_dequeued == count) return total_dequeued;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        not_empty_.wait_until(
+            [&] {
+                total_dequeued += try_dequeue(data + total_dequeued, count - total_dequeued);
+                return total_dequeued == count;
+            },
+            deadline
+        );
+        return total_dequeued;
+    }
+
+    /**
+     * @brief Check if the queue is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Get approximate size of the queue
+     *
+     * Counts claimed positions, so in-flight writes and reads are included.
+     *
+     * @return Approximate number of elements in the queue
+     */
+    std::size_t size() const {
+        const auto dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+        const auto enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+        const auto diff = distance(enqueue_pos, dequeue_pos);
+        if (diff <= 0) return 0;
+        return (static_cast<std::size_t>(diff) > Capacity) ? Capacity
+                                                            : static_cast<std::size_t>(diff);
+    }
+
+    // Producers contend on `enqueue_pos_`, consumers on `dequeue_pos_`; keep them apart
+    alignas(64) std::atomic<std::size_t> enqueue_pos_;
+    alignas(64) std::atomic<std::size_t> dequeue_pos_;
+    // Waiting producers park on `not_full_`, waiting consumers on `not_empty_`
+    alignas(64) Wait not_full_;
+    alignas(64) Wait not_empty_;
+    alignas(64) std::array<Slot, Capacity> slots_;
+};
+
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using MpmcSource = typename MPMC<T, Capacity, Wait>::Source;
+
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using MpmcSink = typename MPMC<T, Capacity, Wait>::Sink;
+
+} // namespace qbuf
+#endif // QBUF_MPMC_HPP
@@ -0,0 +1,576 @@
+#ifndef QBUF_MPSC_HPP
+#define QBUF_MPSC_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <qbuf/wait.hpp>
+
+namespace qbuf {
+
+/**
+ * @brief Multi-Producer Single-Consumer bounded lock-free queue
+ *
+ * Producers claim positions on a shared 64-bit `tail_` and publish each slot by storing
+ * `pos + 1` into its sequence word. The single consumer owns `head_`: it reads the run of
+ * published slots starting at `head_` and releases the whole run with one plain store, so the
+ * consumer side performs no atomic read-modify-write at all.
+ *
+ * Every enqueue claims with a CAS that never moves `tail_` past the consumer, so a claimed
+ * position is always free to write. The blocking `enqueue` calls retry that claim through the
+ * `Wait` strategy until their deadline; producers racing for the last free slot cannot
+ * over-claim, and the losers time out like any other waiter.
+ *
+ * Every slot is usable, so maximum occupancy is `Capacity`.
+ *
+ * @tparam T The type of elements stored in the queue
+ * @tparam Capacity Maximum number of elements the queue can hold (power of two)
+ * @tparam Wait Strategy used by the blocking `enqueue`/`dequeue` calls (see qbuf/wait.hpp)
+ */
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+class MPSC {
+public:
+    static_assert(Capacity > 1, "Queue capacity must be greater than 1");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of 2");
+
+private:
+    MPSC() : tail_(0), head_(0) {
+        for (auto& slot : slots_) {
+            slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    // non-copyable
+    MPSC(const MPSC&) = delete;
+    MPSC& operator=(const MPSC&) = delete;
+    // non-movable
+    MPSC(MPSC&&) = delete;
+    MPSC& operator=(MPSC&&) = delete;
+
+    /**
+     * @brief Producer-side handle for MPSC queue
+     *
+     * Provides a restricted interface exposing only enqueue operations and utility methods.
+     * Copyable: every producer thread may hold its own copy.
+     */
+    class Sink {
+    private:
+        friend class MPSC;
+        explicit Sink(std::shared_ptr<MPSC<T, Capacity, Wait>> queue) : queue_(queue) { }
+
+    public:
+        // Copyable
+        Sink(const Sink&) = default;
+        Sink& operator=(const Sink&) = default;
+
+        // Movable
+        Sink(Sink&&) = default;
+        Sink& operator=(Sink&&) = default;
+
+        /**
+         * @brief Try to enqueue a single element
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if queue is full
+         */
+        bool try_enqueue(const T& value) { return queue_->try_enqueue(value); }
+
+        /**
+         * @brief Try to enqueue a single element (move semantics)
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if queue is full
+         */
+        bool try_enqueue(T&& value) { return queue_->try_enqueue(std::move(value)); }
+
+        /**
+         * @brief Try to enqueue multiple elements into consecutive positions
+         *
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @return Number of elements successfully enqueued
+         */
+        std::size_t try_enqueue(const T* data, std::size_t count) {
+            return queue_->try_enqueue(data, count);
+        }
+
+        /**
+         * @brief Block until an element can be enqueued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue
+         * @param timeout Maximum time to wait for room in the queue
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(value, timeout);
+        }
+
+        /**
+         * @brief Block until an element can be enqueued with timeout (move semantics)
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param value The value to enqueue (will be moved)
+         * @param timeout Maximum time to wait for room in the queue
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(std::move(value), timeout);
+        }
+
+        /**
+         * @brief Block until all elements are enqueued with timeout
+         *
+         * Elements from one call may interleave with elements from other producers.
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to array of elements to enqueue
+         * @param count Number of elements to enqueue
+         * @param timeout Maximum time to wait for room for all elements
+         * @return true if all elements were enqueued, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(data, count, timeout);
+        }
+
+        /**
+         * @brief Check if the queue is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return queue_->empty(); }
+
+        /**
+         * @brief Get approximate size of the queue
+         *
+         * @return Approximate number of elements in the queue
+         */
+        std::size_t size() const { return queue_->size(); }
+
+        /**
+         * @brief Get the maximum number of elements the queue can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<MPSC<T, Capacity, Wait>> queue_;
+    };
+
+    /**
+     * @brief Consumer-side handle for MPSC queue
+     *
+     * Provides a restricted interface exposing only dequeue operations and utility methods.
+     * This handle is intended for use by the single consumer thread.
+     */
+    class Source {
+    private:
+        friend class MPSC;
+        explicit Source(std::shared_ptr<MPSC<T, Capacity, Wait>> queue) : queue_(queue) { }
+
+    public:
+        // Non-copyable
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+        // Movable
+        Source(Source&&) = default;
+        Source& operator=(Source&&) = default;
+
+        /**
+         * @brief Try to dequeue a single element
+         *
+         * @return std::optional containing the value if successful, std::nullopt if queue is empty
+         */
+        std::optional<T> try_dequeue() { return queue_->try_dequeue(); }
+
+        /**
+         * @brief Drain up to `count` elements from the published run at the head
+         *
+         * Stops at the first slot whose producer has claimed but not yet published it.
+         *
+         * @param data Pointer to output array
+         * @param count Maximum number of elements to dequeue
+         * @return Number of elements successfully dequeued
+         */
+        std::size_t try_dequeue(T* data, std::size_t count) {
+            return queue_->try_dequeue(data, count);
+        }
+
+        /**
+         * @brief Block until an element can be dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param timeout Maximum time to wait for dequeue
+         * @return std::optional containing the element if successful, std::nullopt if timeout
+         * expired
+         */
+        template <typename Rep, typename Period>
+        std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+            return queue_->dequeue(timeout);
+        }
+
+        /**
+         * @brief Block until all elements are dequeued with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param data Pointer to output array
+         * @param count Number of elements to dequeue
+         * @param timeout Maximum time to wait for all elements to be dequeued
+         * @return Number of elements successfully dequeued (may be less than count if timeout)
+         */
+        template <typename Rep, typename Period>
+        std::size_t dequeue(
+            T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout
+        ) {
+            return queue_->dequeue(data, count, timeout);
+        }
+
+        /**
+         * @brief Check if the queue is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return queue_->empty(); }
+
+        /**
+         * @brief Get approximate size of the queue
+         *
+         * @return Approximate number of elements in the queue
+         */
+        std::size_t size() const { return queue_->size(); }
+
+        /**
+         * @brief Get the maximum number of elements the queue can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<MPSC<T, Capacity, Wait>> queue_;
+    };
+
+    /**
+     * @brief Factory method to create a queue with sink and source handles
+     *
+     * Copy the Sink to hand one to each producer; the Source stays with the single consumer.
+     *
+     * @return std::pair<Sink, Source> A pair of producer and consumer handles
+     */
+    static std::pair<Sink, Source> make_queue() {
+        std::shared_ptr<MPSC> queue(new MPSC<T, Capacity, Wait>());
+        return { Sink(queue), Source(queue) };
+    }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence; // `pos + 1` once position `pos` is published
+        T value;
+    };
+
+    // Free slots as seen by a producer that last read `tail`. A stale `tail` can trail the
+    // consumer; that reports room and the subsequent claim sorts it out.
+    std::size_t free_space(std::size_t tail) const {
+        const auto used = static_cast<std::ptrdiff_t>(tail - head_.load(std::memory_order_acquire));
+        if (used <= 0) return Capacity;
+        return (static_cast<std::size_t>(used) < Capacity) ? Capacity - used : 0;
+    }
+
+    /**
+     * @brief Claim up to `count` positions with a CAS, never past the consumer
+     *
+     * @param pos Receives the first claimed position
+     * @return Number of claimed positions (0 if the queue is full)
+     */
+    std::size_t try_claim(std::size_t count, std::size_t& pos) {
+        pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            const std::size_t available = free_space(pos);
+            const std::size_t n = (count < available) ? count : available;
+            if (n == 0) return 0;
+            if (tail_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) return n;
+        }
+    }
+
+    /**
+     * @brief Claim up to `count` positions, waiting on `not_full_` until `deadline` for room
+     *
+     * @param pos Receives the first claimed position
+     * @return Number of claimed positions (0 if the deadline passed with the queue still full)
+     */
+    template <typename Clock, typename Duration>
+    std::size_t claim_until(
+        std::size_t count, std::size_t& pos, std::chrono::time_point<Clock, Duration> deadline
+    ) {
+        std::size_t n = try_claim(count, pos);
+        if (n != 0) return n;
+        not_full_.wait_until([&] { return (n = try_claim(count, pos)) != 0; }, deadline);
+        return n;
+    }
+
+    template <typename U>
+    void publish(std::size_t pos, U&& value) {
+        Slot& slot = slots_[pos & mask];
+        slot.value = std::forward<U>(value);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    void publish_range(std::size_t pos, const T* data, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) publish(pos + i, data[i]);
+        not_empty_.notify();
+    }
+
+    /**
+     * @brief Try to enqueue a single element
+     *
+     * @param value The value to enqueue
+     * @return true if successful, false if queue is full
+     */
+    bool try_enqueue(const T& value) {
+        std::size_t pos;
+        if (try_claim(1, pos) == 0) return false;
+        publish(pos, value);
+        not_empty_.notify();
+        return true;
+    }
+
+    /**
+     * @brief Try to enqueue a single element (move semantics)
+     *
+     * @param value The value to enqueue
+     * @return true if successful, false if queue is full
+     */
+    bool try_enqueue(T&& value) {
+        std::size_t pos;
+        if (try_claim(1, pos) == 0) return false;
+        publish(pos, std::move(value));
+        not_empty_.notify();
+        return true;
+    }
+
+    /**
+     * @brief Try to enqueue multiple elements into consecutive positions
+     *
+     * @param data Pointer to array of elements to enqueue
+     * @param count Number of elements to enqueue
+     * @return Number of elements successfully enqueued
+     */
+    std::size_t try_enqueue(const T* data, std::size_t count) {
+        if (count == 0) return 0;
+        std::size_t pos;
+        const std::size_t n = try_claim(count, pos);
+        if (n != 0) publish_range(pos, data, n);
+        return n;
+    }
+
+    /**
+     * @brief Try to dequeue a single element
+     *
+     * @return std::optional containing the value if successful, std::nullopt if queue is empty
+     */
+    std::optional<T> try_dequeue() {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[current_head & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != current_head + 1) {
+            return std::nullopt; // Empty, or the next producer has not published yet
+        }
+
+        T value = std::move(slot.value);
+        head_.store(current_head + 1, std::memory_order_release);
+        not_full_.notify();
+        return value;
+    }
+
+    /**
+     * @brief Drain up to `count` elements from the published run at the head
+     *
+     * Reads slots while their sequence says they are published, then releases the whole run
+     * with one store of `head_`.
+     *
+     * @param data Pointer to output array
+     * @param count Maximum number of elements to dequeue
+     * @return Number of elements successfully dequeued
+     */
+    std::size_t try_dequeue(T* data, std::size_t count) {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+
+        std::size_t n = 0;
+        while (n < count) {
+            Slot& slot = slots_[(current_head + n) & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != current_head + n + 1) break;
+            data[n] = std::move(slot.value);
+            ++n;
+        }
+        if (n == 0) return 0;
+
+        head_.store(current_head + n, std::memory_order_release);
+        not_full_.notify();
+        return n;
+    }
+
+    /**
+     * @brief Block until an element can be enqueued with timeout
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param value The value to enqueue
+     * @param timeout Maximum time to wait for room in the queue
+     * @return true if successful, false if timeout expired
+     */
+    template <typename Rep, typename Period>
+    bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t pos;
+        if (claim_until(1, pos, std::chrono::steady_clock::now() + timeout) == 0) return false;
+        publish(pos, value);
+        not_empty_.notify();
+        return true;
+    }
+
+    /**
+     * @brief Block until an element can be enqueued with timeout (move semantics)
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param value The value to enqueue (will be moved)
+     * @param timeout Maximum time to wait for room in the queue
+     * @return true if successful, false if timeout expired
+     */
+    template <typename Rep, typename Period>
+    bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t pos;
+        if (claim_until(1, pos, std::chrono::steady_clock::now() + timeout) == 0) return false;
+        publish(pos, std::move(value));
+        not_empty_.notify();
+        return true;
+    }
+
+    /**
+     * @brief Block until all elements are enqueued with timeout
+     *
+     * Claims in chunks of whatever room is free, one CAS per chunk.
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param data Pointer to array of elements to enqueue
+     * @param count Number of elements to enqueue
+     * @param timeout Maximum time to wait for room for all elements
+     * @return true if all elements were enqueued, false if timeout expired
+     */
+    template <typename Rep, typename Period>
+    bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::size_t total_enqueued = 0;
+        while (total_enqueued < count) {
+            std::size_t pos;
+            const std::size_t chunk = claim_until(count - total_enqueued, pos, deadline);
+            if (chunk == 0) return false;
+            publish_range(pos, data + total_enqueued, chunk);
+            total_enqueued += chunk;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Block until an element can be dequeued with timeout
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param timeout Maximum time to wait for dequeue
+     * @return std::optional containing the element if successful, std::nullopt if timeout expired
+     */
+    template <typename Rep, typename Period>
+    std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+        std::optional<T> value = try_dequeue();
+        if (value.has_value()) return value;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        not_empty_.wait_until(
+            [&] {
+                value = try_dequeue();
+                return value.has_value();
+            },
+            deadline
+        );
+        return value;
+    }
+
+    /**
+     * @brief Block until all elements are dequeued with timeout
+     *
+     * @tparam Rep The arithmetic type representing the timeout duration count
+     * @tparam Period The `std::ratio` type representing the timeout duration period
+     * @param data Pointer to output array
+     * @param count Number of elements to dequeue
+     * @param timeout Maximum time to wait for all elements to be dequeued
+     * @return Number of elements successfully dequeued (may be less than count if timeout)
+     */
+    template <typename Rep, typename Period>
+    std::size_t dequeue(T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t total_dequeued = try_dequeue(data, count);
+        if (total_dequeued == count) return total_dequeued;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        not_empty_.wait_until(
+            [&] {
+                total_dequeued += try_dequeue(data + total_dequeued, count - total_dequeued);
+                return total_dequeued == count;
+            },
+            deadline
+        );
+        return total_dequeued;
+    }
+
+    /**
+     * @brief Check if the queue is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Get approximate size of the queue
+     *
+     * Counts claimed positions, so in-flight writes are included.
+     *
+     * @return Approximate number of elements in the queue
+     */
+    std::size_t size() const {
+        const auto head = head_.load(std::memory_order_acquire);
+        const auto tail = tail_.load(std::memory_order_acquire);
+        const std::size_t used = tail - head;
+        return (used > Capacity) ? Capacity : used;
+    }
+
+    // Producers contend on `tail_`; only the consumer writes `head_`
+    alignas(64) std::atomic<std::size_t> tail_;
+    alignas(64) std::atomic<std::size_t> head_;
+    // Waiting producers park on `not_full_`, the waiting consumer on `not_empty_`
+    alignas(64) Wait not_full_;
+    alignas(64) Wait not_empty_;
+    alignas(64) std::array<Slot, Capacity> slots_;
+};
+
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using MpscSource = typename MPSC<T, Capacity, Wait>::Source;
+
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using MpscSink = typename MPSC<T, Capacity, Wait>::Sink;
+
+} // namespace qbuf
+#endif // QBUF_MPSC_HPP
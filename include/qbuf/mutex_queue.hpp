@@ -1,19 +1,38 @@
 #ifndef QBUF_MUTEX_QUEUE_HPP
 #define QBUF_MUTEX_QUEUE_HPP
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <qbuf/span.hpp>
+#include <qbuf/stats.hpp>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 namespace qbuf {
 
+/**
+ * @brief When MutexQueue wakes blocked producers and consumers
+ *
+ * Blocked producers are only woken once occupancy drops below `low`, blocked consumers once it
+ * rises above `high`, so a woken thread finds a batch of room or elements instead of a single
+ * one. Like socket low watermarks, a waiter is not woken while occupancy stays on the wrong side
+ * of its threshold; it then returns at its timeout, so this suits continuous streams. The
+ * defaults wake on every change.
+ */
+struct Watermarks {
+    std::size_t low = std::numeric_limits<std::size_t>::max();
+    std::size_t high = 0;
+};
+
 /**
  * @brief Mutex-based circular buffer queue
  *
@@ -21,20 +40,21 @@ namespace qbuf {
  * Provides an API surface compatible with SPSC (Sink/Source handles,
  * try_/blocking operations). Reserves one slot to distinguish full from empty.
  *
- * @tparam T The type of elements stored in the queue
+ * Blocked threads are counted under the mutex, and an operation only signals a condition
+ * variable when the other side has a waiter (and the `Watermarks` allow it), so uncontended
+ * calls never enter the kernel for a notification.
+ *
+ * @tparam T The type of elements stored in the queue (default constructible; bulk transfers of
+ * trivially copyable types use `memcpy`, other types are copied or moved element by element)
  * @tparam Capacity Maximum number of elements the queue can hold
  */
 template <typename T, std::size_t Capacity>
 class MutexQueue {
 public:
     static_assert(Capacity > 1, "Queue capacity must be greater than 1");
-    static_assert(
-        std::is_trivially_copyable_v<T>,
-        "T must be trivially copyable for bulk operations using memcpy"
-    );
 
 private:
-    MutexQueue() : head_(0), tail_(0) { }
+    explicit MutexQueue(Watermarks watermarks) : head_(0), tail_(0), watermarks_(watermarks) { }
 
 public:
     MutexQueue(const MutexQueue&) = delete;
@@ -108,6 +128,24 @@ public:
             return queue_->try_enqueue(data, count);
         }
 
+        /**
+         * @brief Reserve writable slots directly in the ring buffer
+         *
+         * The returned region holds up to `count` slots and is split into two segments when it
+         * wraps past the end of the buffer. Nothing is visible to the consumer until `commit()`.
+         *
+         * @param count Maximum number of slots to reserve
+         * @return Writable region of `min(count, free slots)` elements (possibly empty)
+         */
+        RingSpan<T> reserve(std::size_t count) { return queue_->reserve(count); }
+
+        /**
+         * @brief Publish the first `count` slots of the last reservation
+         *
+         * @param count Number of slots written; must not exceed the size of the last `reserve()`
+         */
+        void commit(std::size_t count) { queue_->commit(count); }
+
         /**
          * @brief Block until an element can be enqueued with timeout
          *
@@ -155,6 +193,11 @@ public:
 
         std::size_t size() const { return queue_->size(); }
 
+        /**
+         * @brief Snapshot of the queue's counters (all zero unless built with `QBUF_STATS`)
+         */
+        QueueStats stats() const { return queue_->stats(); }
+
     private:
         std::shared_ptr<MutexQueue<T, Capacity>> queue_;
     };
@@ -186,6 +229,17 @@ public:
          */
         std::optional<T> try_dequeue() { return queue_->try_dequeue(); }
 
+        /**
+         * @brief Try to dequeue a single element into `out`
+         *
+         * Move-assigns the element straight into `out`, so non-trivial payloads skip the
+         * `std::optional` round trip and `out` can reuse its storage (e.g. a string's buffer).
+         *
+         * @param out Destination, left untouched if the queue is empty
+         * @return true if an element was dequeued, false if queue is empty
+         */
+        bool try_dequeue(T& out) { return queue_->try_dequeue(out); }
+
         /**
          * @brief Try to dequeue multiple elements
          *
@@ -197,6 +251,45 @@ public:
             return queue_->try_dequeue(data, count);
         }
 
+        /**
+         * @brief View the readable region in place without dequeuing
+         *
+         * The region is split into two segments when it wraps past the end of the buffer. It stays
+         * valid until the matching `consume()`.
+         *
+         * @return Read-only region of all currently readable elements (possibly empty)
+         */
+        RingSpan<const T> peek() { return queue_->peek(); }
+
+        /**
+         * @brief Release the first `count` elements of the last `peek()` back to the producer
+         *
+         * @param count Number of elements to drop; must not exceed the size of the last `peek()`
+         */
+        void consume(std::size_t count) { queue_->consume(count); }
+
+        /**
+         * @brief Visit every available element in place under one lock acquisition
+         *
+         * Calls `f(T&)` on up to `max` of the elements present when the call starts, in FIFO
+         * order, while holding the queue's mutex, then advances the head and wakes a producer
+         * once. With `release_every`, the lock is dropped (and producers woken) after each group
+         * of that many elements instead. `f` must not call back into this queue. If `f` throws,
+         * the elements visited before the throwing one are released and the exception propagates.
+         *
+         * @param f Callback for each element; it may read the element or move from it
+         * @param max Upper bound on the number of elements visited
+         * @param release_every Unlock after this many elements (0: only at the end)
+         * @return Number of elements visited
+         */
+        template <typename F>
+        std::size_t drain(
+            F&& f, std::size_t max = std::numeric_limits<std::size_t>::max(),
+            std::size_t release_every = 0
+        ) {
+            return queue_->drain(std::forward<F>(f), max, release_every);
+        }
+
         /**
          * @brief Block until an element can be dequeued with timeout
          *
@@ -231,6 +324,11 @@ public:
         bool empty() const { return queue_->empty(); }
         std::size_t size() const { return queue_->size(); }
 
+        /**
+         * @brief Snapshot of the queue's counters (all zero unless built with `QBUF_STATS`)
+         */
+        QueueStats stats() const { return queue_->stats(); }
+
     private:
         std::shared_ptr<MutexQueue<T, Capacity>> queue_;
     };
@@ -242,10 +340,17 @@ public:
      * (Sink, Source) that can be used by producer and consumer threads
      * respectively.
      *
+     * @param watermarks Wake-up thresholds for blocked producers and consumers (default: wake
+     * on every change)
      * @return std::pair<Sink, Source> A pair of producer and consumer handles
+     * @throws std::invalid_argument if a watermark can never be crossed (`low == 0` or
+     * `high >= Capacity - 1`)
      */
-    static std::pair<Sink, Source> make_queue() {
-        std::shared_ptr<MutexQueue> queue(new MutexQueue<T, Capacity>());
+    static std::pair<Sink, Source> make_queue(Watermarks watermarks = { }) {
+        if (watermarks.low == 0 || watermarks.high >= Capacity - 1) {
+            throw std::invalid_argument("Watermarks must be reachable within the queue capacity");
+        }
+        std::shared_ptr<MutexQueue> queue(new MutexQueue<T, Capacity>(watermarks));
         return { Sink(queue), Source(queue) };
     }
 
@@ -254,79 +359,123 @@ private:
     friend class Source;
 
     bool try_enqueue(const T& value) {
+        bool wake;
         {
             std::lock_guard lk(mtx_);
-            if (full_unlocked()) return false;
+            if (full_unlocked()) {
+                producer_stats_.record_rejection();
+                return false;
+            }
             buffer_[tail_] = value;
             tail_ = next(tail_);
+            record_enqueue_unlocked(1);
+            wake = wake_consumer_unlocked();
         }
-        cv_not_empty_.notify_one();
+        if (wake) cv_not_empty_.notify_one();
         return true;
     }
 
     bool try_enqueue(T&& value) {
+        bool wake;
         {
             std::lock_guard lk(mtx_);
-            if (full_unlocked()) return false;
+            if (full_unlocked()) {
+                producer_stats_.record_rejection();
+                return false;
+            }
             buffer_[tail_] = std::move(value);
             tail_ = next(tail_);
+            record_enqueue_unlocked(1);
+            wake = wake_consumer_unlocked();
         }
-        cv_not_empty_.notify_one();
+        if (wake) cv_not_empty_.notify_one();
         return true;
     }
 
     std::size_t try_enqueue(const T* data, std::size_t count) {
         if (count == 0) return 0;
         std::size_t n;
+        bool wake;
         {
             std::lock_guard lk(mtx_);
             const std::size_t free = free_unlocked();
             n = (free < count) ? free : count;
-            if (n == 0) return 0;
+            if (n == 0) {
+                producer_stats_.record_rejection();
+                return 0;
+            }
 
             std::size_t first_segment = (n < (Capacity - tail_)) ? n : (Capacity - tail_);
-            std::memcpy(&buffer_[tail_], data, first_segment * sizeof(T));
-            std::size_t second_segment = n - first_segment;
-            if (second_segment > 0) {
-                std::memcpy(&buffer_[0], data + first_segment, second_segment * sizeof(T));
-            }
+            copy_in(&buffer_[tail_], data, first_segment);
+            copy_in(&buffer_[0], data + first_segment, n - first_segment);
             tail_ = (tail_ + n) % Capacity;
+            record_enqueue_unlocked(n);
+            wake = wake_consumer_unlocked();
         }
-        cv_not_empty_.notify_one();
+        if (wake) cv_not_empty_.notify_one();
         return n;
     }
 
+    RingSpan<T> reserve(std::size_t count) {
+        // Only the single Sink writes the free region, so the slots stay valid after unlocking
+        std::lock_guard lk(mtx_);
+        const std::size_t free = free_unlocked();
+        const std::size_t n = (free < count) ? free : count;
+        const std::size_t first_segment = (n < (Capacity - tail_)) ? n : (Capacity - tail_);
+        return { Span<T>(&buffer_[tail_], first_segment), Span<T>(&buffer_[0], n - first_segment) };
+    }
+
+    void commit(std::size_t count) {
+        if (count == 0) return;
+        bool wake;
+        {
+            std::lock_guard lk(mtx_);
+            tail_ = (tail_ + count) % Capacity;
+            record_enqueue_unlocked(count);
+            wake = wake_consumer_unlocked();
+        }
+        if (wake) cv_not_empty_.notify_one();
+    }
+
     template <typename Rep, typename Period>
     bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+        bool wake;
         {
             std::unique_lock lk(mtx_);
             auto deadline = std::chrono::steady_clock::now() + timeout;
             while (full_unlocked()) {
-                if (cv_not_full_.wait_until(lk, deadline) == std::cv_status::timeout) {
+                // Recheck on timeout: with watermarks, room can appear without a notification
+                if (wait_not_full(lk, deadline) == std::cv_status::timeout && full_unlocked()) {
                     return false;
                 }
             }
             buffer_[tail_] = value;
             tail_ = next(tail_);
+            record_enqueue_unlocked(1);
+            wake = wake_consumer_unlocked();
         }
-        cv_not_empty_.notify_one();
+        if (wake) cv_not_empty_.notify_one();
         return true;
     }
 
     template <typename Rep, typename Period>
     bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+        bool wake;
         {
             std::unique_lock lk(mtx_);
             auto deadline = std::chrono::steady_clock::now() + timeout;
             while (full_unlocked()) {
-                if (cv_not_full_.wait_until(lk, deadline) == std::cv_status::timeout) {
+                // Recheck on timeout: with watermarks, room can appear without a notification
+                if (wait_not_full(lk, deadline) == std::cv_status::timeout && full_unlocked()) {
                     return false;
                 }
             }
             buffer_[tail_] = std::move(value);
             tail_ = next(tail_);
+            record_enqueue_unlocked(1);
+            wake = wake_consumer_unlocked();
         }
-        cv_not_empty_.notify_one();
+        if (wake) cv_not_empty_.notify_one();
         return true;
     }
 
@@ -338,10 +487,12 @@ private:
         std::size_t total = 0;
 
         while (total < count) {
+            bool wake;
             {
                 std::unique_lock lk(mtx_);
                 while (free_unlocked() == 0) {
-                    if (cv_not_full_.wait_until(lk, deadline) == std::cv_status::timeout) {
+                    if (wait_not_full(lk, deadline) == std::cv_status::timeout
+                        && free_unlocked() == 0) {
                         return false;
                     }
                 }
@@ -350,69 +501,161 @@ private:
                 std::size_t can = (free_unlocked() < remaining) ? free_unlocked() : remaining;
                 std::size_t first_segment = (can < (Capacity - tail_)) ? can : (Capacity - tail_);
 
-                std::memcpy(&buffer_[tail_], data + total, first_segment * sizeof(T));
-                std::size_t second_segment = can - first_segment;
-                if (second_segment > 0) {
-                    std::memcpy(
-                        &buffer_[0], data + total + first_segment, second_segment * sizeof(T)
-                    );
-                }
+                copy_in(&buffer_[tail_], data + total, first_segment);
+                copy_in(&buffer_[0], data + total + first_segment, can - first_segment);
                 tail_ = (tail_ + can) % Capacity;
                 total += can;
+                record_enqueue_unlocked(can);
+                wake = wake_consumer_unlocked();
             }
-            cv_not_empty_.notify_one();
+            if (wake) cv_not_empty_.notify_one();
         }
         return true;
     }
 
     std::optional<T> try_dequeue() {
-        T value;
+        std::optional<T> value;
+        bool wake;
         {
             std::lock_guard lk(mtx_);
-            if (head_ == tail_) return std::nullopt;
-            value = std::move(buffer_[head_]);
+            if (head_ == tail_) {
+                consumer_stats_.record_rejection();
+                return std::nullopt;
+            }
+            value.emplace(std::move(buffer_[head_]));
             head_ = next(head_);
+            consumer_stats_.record_success(1);
+            wake = wake_producer_unlocked();
         }
-        cv_not_full_.notify_one();
+        if (wake) cv_not_full_.notify_one();
         return value;
     }
 
+    bool try_dequeue(T& out) {
+        bool wake;
+        {
+            std::lock_guard lk(mtx_);
+            if (head_ == tail_) {
+                consumer_stats_.record_rejection();
+                return false;
+            }
+            out = std::move(buffer_[head_]);
+            head_ = next(head_);
+            consumer_stats_.record_success(1);
+            wake = wake_producer_unlocked();
+        }
+        if (wake) cv_not_full_.notify_one();
+        return true;
+    }
+
     std::size_t try_dequeue(T* data, std::size_t count) {
         if (count == 0) return 0;
         std::size_t n;
+        bool wake;
         {
             std::lock_guard lk(mtx_);
             std::size_t avail = size_unlocked();
             n = (avail < count) ? avail : count;
-            if (n == 0) return 0;
+            if (n == 0) {
+                consumer_stats_.record_rejection();
+                return 0;
+            }
 
             std::size_t first_segment = (n < (Capacity - head_)) ? n : (Capacity - head_);
-            std::memcpy(data, &buffer_[head_], first_segment * sizeof(T));
-            std::size_t second_segment = n - first_segment;
-            if (second_segment > 0) {
-                std::memcpy(data + first_segment, &buffer_[0], second_segment * sizeof(T));
-            }
+            move_out(data, &buffer_[head_], first_segment);
+            move_out(data + first_segment, &buffer_[0], n - first_segment);
             head_ = (head_ + n) % Capacity;
+            consumer_stats_.record_success(n);
+            wake = wake_producer_unlocked();
         }
-        cv_not_full_.notify_one();
+        if (wake) cv_not_full_.notify_one();
         return n;
     }
 
+    RingSpan<const T> peek() {
+        // Only the single Source reads the occupied region, so the slots stay valid after unlocking
+        std::lock_guard lk(mtx_);
+        const std::size_t n = size_unlocked();
+        const std::size_t first_segment = (n < (Capacity - head_)) ? n : (Capacity - head_);
+        return {
+            Span<const T>(&buffer_[head_], first_segment),
+            Span<const T>(&buffer_[0], n - first_segment)
+        };
+    }
+
+    void consume(std::size_t count) {
+        if (count == 0) return;
+        bool wake;
+        {
+            std::lock_guard lk(mtx_);
+            head_ = (head_ + count) % Capacity;
+            consumer_stats_.record_success(count);
+            wake = wake_producer_unlocked();
+        }
+        if (wake) cv_not_full_.notify_one();
+    }
+
+    template <typename F>
+    std::size_t drain(F&& f, std::size_t max, std::size_t release_every) {
+        std::unique_lock lk(mtx_);
+        const std::size_t limit = std::min(max, size_unlocked());
+        if (limit == 0) {
+            consumer_stats_.record_rejection();
+            return 0;
+        }
+
+        const std::size_t group = (release_every == 0) ? limit : release_every;
+        std::size_t visited = 0;
+        for (;;) {
+            // Other threads sharing this Source may have taken elements while unlocked
+            const std::size_t n = std::min({ limit - visited, group, size_unlocked() });
+            std::size_t done = 0;
+            try {
+                for (; done < n; ++done) {
+                    f(buffer_[head_]);
+                    head_ = next(head_);
+                }
+            } catch (...) {
+                release_drained(lk, done);
+                throw;
+            }
+            release_drained(lk, n);
+            visited += n;
+            if (n == 0 || visited == limit) return visited;
+            lk.lock();
+        }
+    }
+
+    // Account for `count` elements drained under `lk`, unlock, and wake a producer if due
+    void release_drained(std::unique_lock<std::mutex>& lk, std::size_t count) {
+        bool wake = false;
+        if (count != 0) {
+            consumer_stats_.record_success(count);
+            wake = wake_producer_unlocked();
+        }
+        lk.unlock();
+        if (wake) cv_not_full_.notify_one();
+    }
+
     template <typename Rep, typename Period>
     std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
-        T value;
+        std::optional<T> value;
+        bool wake;
         {
             std::unique_lock lk(mtx_);
             auto deadline = std::chrono::steady_clock::now() + timeout;
             while (head_ == tail_) {
-                if (cv_not_empty_.wait_until(lk, deadline) == std::cv_status::timeout) {
+                // Recheck on timeout: with watermarks, elements can appear without a notification
+                if (wait_not_empty(lk, deadline) == std::cv_status::timeout && head_ == tail_) {
                     return std::nullopt;
                 }
             }
-            value = std::move(buffer_[head_]);
+            value.emplace(std::move(buffer_[head_]));
             head_ = next(head_);
+            consumer_stats_.record_success(1);
+            wake = wake_producer_unlocked();
         }
-        cv_not_full_.notify_one();
+        if (wake) cv_not_full_.notify_one();
         return value;
     }
 
@@ -424,10 +667,12 @@ private:
         std::size_t total = 0;
 
         while (total < count) {
+            bool wake;
             {
                 std::unique_lock lk(mtx_);
                 while (size_unlocked() == 0) {
-                    if (cv_not_empty_.wait_until(lk, deadline) == std::cv_status::timeout) {
+                    if (wait_not_empty(lk, deadline) == std::cv_status::timeout
+                        && size_unlocked() == 0) {
                         return total;
                     }
                 }
@@ -436,24 +681,83 @@ private:
                 std::size_t can = (size_unlocked() < remaining) ? size_unlocked() : remaining;
                 std::size_t first_segment = (can < (Capacity - head_)) ? can : (Capacity - head_);
 
-                std::memcpy(data + total, &buffer_[head_], first_segment * sizeof(T));
-                std::size_t second_segment = can - first_segment;
-                if (second_segment > 0) {
-                    std::memcpy(
-                        data + total + first_segment, &buffer_[0], second_segment * sizeof(T)
-                    );
-                }
+                move_out(data + total, &buffer_[head_], first_segment);
+                move_out(data + total + first_segment, &buffer_[0], can - first_segment);
                 head_ = (head_ + can) % Capacity;
                 total += can;
+                consumer_stats_.record_success(can);
+                wake = wake_producer_unlocked();
             }
-            cv_not_full_.notify_one();
+            if (wake) cv_not_full_.notify_one();
         }
         return total;
     }
 
+    QueueStats stats() const {
+        std::lock_guard lk(mtx_);
+        return detail::make_stats(producer_stats_, consumer_stats_);
+    }
+
 private:
     static constexpr std::size_t next(std::size_t i) { return (i + 1) % Capacity; }
 
+    // Copy one contiguous segment into the ring: one `memcpy` for trivially copyable types,
+    // element-wise copy assignment otherwise
+    static void copy_in(T* dst, const T* src, std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count != 0) std::memcpy(dst, src, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) dst[i] = src[i];
+        }
+    }
+
+    // Move one contiguous segment out of the ring, like copy_in()
+    static void move_out(T* dst, T* src, std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count != 0) std::memcpy(dst, src, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) dst[i] = std::move(src[i]);
+        }
+    }
+
+    // Count an enqueue of `count` (> 0) elements; caller holds `mtx_`
+    void record_enqueue_unlocked(std::size_t count) {
+        producer_stats_.record_success(count);
+        producer_stats_.record_occupancy(size_unlocked());
+    }
+
+    // Whether the operation that just changed the occupancy must signal the other side; caller
+    // holds `mtx_` and notifies after unlocking
+    bool wake_consumer_unlocked() const {
+        return consumers_waiting_ != 0 && size_unlocked() > watermarks_.high;
+    }
+
+    bool wake_producer_unlocked() const {
+        return producers_waiting_ != 0 && size_unlocked() < watermarks_.low;
+    }
+
+    // Condition variable waits, counted as one wait iteration each. The waiter counts are only
+    // touched under `mtx_`, which the wait releases and reacquires atomically.
+    template <typename Deadline>
+    std::cv_status wait_not_full(std::unique_lock<std::mutex>& lk, Deadline deadline) {
+        ++producers_waiting_;
+        const auto status = producer_stats_.timed_wait([&] {
+            return cv_not_full_.wait_until(lk, deadline);
+        });
+        --producers_waiting_;
+        return status;
+    }
+
+    template <typename Deadline>
+    std::cv_status wait_not_empty(std::unique_lock<std::mutex>& lk, Deadline deadline) {
+        ++consumers_waiting_;
+        const auto status = consumer_stats_.timed_wait([&] {
+            return cv_not_empty_.wait_until(lk, deadline);
+        });
+        --consumers_waiting_;
+        return status;
+    }
+
     std::size_t size_unlocked() const {
         return (tail_ >= head_) ? (tail_ - head_) : (Capacity - head_ + tail_);
     }
@@ -468,6 +772,12 @@ private:
 
     std::size_t head_;
     std::size_t tail_;
+    std::size_t producers_waiting_ = 0;
+    std::size_t consumers_waiting_ = 0;
+    const Watermarks watermarks_;
+    // Updated under `mtx_`; kept on separate cache lines like the lock-free queues' counters
+    detail::StatsCounters producer_stats_;
+    detail::StatsCounters consumer_stats_;
     std::array<T, Capacity> buffer_;
 };
 
@@ -0,0 +1,398 @@
+#ifndef QBUF_POOL_HPP
+#define QBUF_POOL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <qbuf/heap_buffer.hpp>
+#include <qbuf/spsc.hpp>
+#include <qbuf/wait.hpp>
+#include <stdexcept>
+#include <utility>
+
+namespace qbuf {
+
+namespace detail {
+
+/**
+ * @brief Smallest power of two greater than `count`, i.e. an SPSC ring that holds `count` elements
+ */
+constexpr std::size_t ring_slots_for(std::size_t count) {
+    std::size_t slots = 2;
+    while (slots <= count) slots <<= 1;
+    return slots;
+}
+
+} // namespace detail
+
+/**
+ * @brief Fixed arena of `T` objects passed from one producer to one consumer without allocating
+ *
+ * The pool owns `Capacity` value-initialized objects, allocated once. The producer acquires a
+ * free slot, fills the object in place, and enqueues the slot; only its 32-bit index travels
+ * through an SPSC ring. When the consumer releases a slot its index goes back to the producer
+ * through a second SPSC ring (the return channel), so large messages never touch the global
+ * allocator after construction. Objects are reused as they are: an acquired slot holds whatever
+ * the last user left in it.
+ *
+ * The producer keeps the free indices in a private stack and refills it from the return channel
+ * in bulk only when it runs dry. Both rings have room for every slot, so enqueueing an acquired
+ * slot and releasing a dequeued one never fail; a full queue shows up as an exhausted pool.
+ *
+ * @tparam T The type of pooled objects (default-constructible)
+ * @tparam Capacity Number of slots, i.e. maximum number of messages in flight
+ * @tparam Wait Strategy used by the blocking `acquire`/`dequeue` calls (see qbuf/wait.hpp)
+ */
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+class Pool {
+public:
+    static_assert(Capacity > 0, "Pool capacity must be greater than 0");
+    static_assert(Capacity <= UINT32_MAX, "Pool capacity must fit in 32-bit slot indices");
+
+private:
+    using Index = std::uint32_t;
+    using Ring = SPSC<Index, detail::ring_slots_for(Capacity), Wait>;
+    using RingPair = std::pair<typename Ring::Sink, typename Ring::Source>;
+
+    enum class Owner { producer, consumer };
+
+    explicit Pool(const BufferOptions& options)
+        : Pool(options, Ring::make_queue(), Ring::make_queue()) { }
+
+    Pool(const BufferOptions& options, RingPair messages, RingPair returns)
+        : arena_(Capacity, options)
+        , messages_sink_(std::move(messages.first))
+        , messages_source_(std::move(messages.second))
+        , returns_sink_(std::move(returns.first))
+        , returns_source_(std::move(returns.second))
+        , free_(new Index[Capacity])
+        , free_count_(Capacity) {
+        // Hand out low indices first
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            free_[i] = static_cast<Index>(Capacity - 1 - i);
+        }
+    }
+
+public:
+    // non-copyable
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    // non-movable
+    Pool(Pool&&) = delete;
+    Pool& operator=(Pool&&) = delete;
+
+    /**
+     * @brief Move-only owner of one pool slot; gives the slot back when destroyed
+     *
+     * A slot from `Sink::try_acquire()` / `Sink::acquire()` returns to the producer's free stack
+     * and must be released on the producer thread; a slot from `Source::try_dequeue()` /
+     * `Source::dequeue()` returns through the return channel and must be released on the
+     * consumer thread. Each slot shares ownership of the pool with the handles, so a slot kept
+     * after both handles are gone stays valid and releases into the still-alive pool.
+     */
+    class Slot {
+    public:
+        /// Empty slot, owning nothing
+        Slot() = default;
+
+        Slot(Slot&& other) noexcept
+            : pool_(std::move(other.pool_))
+            , index_(other.index_)
+            , owner_(other.owner_) { }
+
+        Slot& operator=(Slot&& other) noexcept {
+            if (this != &other) {
+                reset();
+                pool_ = std::move(other.pool_);
+                index_ = other.index_;
+                owner_ = other.owner_;
+            }
+            return *this;
+        }
+
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+
+        ~Slot() { reset(); }
+
+        /**
+         * @brief Give the slot back to the pool now; the slot becomes empty
+         */
+        void reset() noexcept {
+            if (pool_ == nullptr) return;
+            pool_->release(index_, owner_);
+            pool_.reset();
+        }
+
+        T* get() const noexcept { return pool_ ? &pool_->arena_[index_] : nullptr; }
+        T& operator*() const noexcept { return pool_->arena_[index_]; }
+        T* operator->() const noexcept { return &pool_->arena_[index_]; }
+        explicit operator bool() const noexcept { return pool_ != nullptr; }
+
+    private:
+        friend class Pool;
+        Slot(std::shared_ptr<Pool> pool, Index index, Owner owner)
+            : pool_(std::move(pool)), index_(index), owner_(owner) { }
+
+        std::shared_ptr<Pool> pool_;
+        Index index_ = 0;
+        Owner owner_ = Owner::producer;
+    };
+
+    /**
+     * @brief Producer-side handle for a pooled queue
+     *
+     * Acquires free slots and enqueues them. Move-only, like the SPSC handles.
+     */
+    class Sink {
+    private:
+        friend class Pool;
+        explicit Sink(std::shared_ptr<Pool<T, Capacity, Wait>> pool) : pool_(pool) { }
+
+    public:
+        // Non-copyable
+        Sink(const Sink&) = delete;
+        Sink& operator=(const Sink&) = delete;
+
+        // Movable
+        Sink(Sink&&) = default;
+        Sink& operator=(Sink&&) = default;
+
+        /**
+         * @brief Take a free slot without blocking
+         *
+         * @return The slot, or std::nullopt if every slot is in flight or held by the consumer
+         */
+        std::optional<Slot> try_acquire() { return pool_->try_acquire(pool_); }
+
+        /**
+         * @brief Block until a slot is free with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param timeout Maximum time to wait for the consumer to release a slot
+         * @return The slot, or std::nullopt if the timeout expired
+         */
+        template <typename Rep, typename Period>
+        std::optional<Slot> acquire(std::chrono::duration<Rep, Period> timeout) {
+            return pool_->acquire(pool_, timeout);
+        }
+
+        /**
+         * @brief Publish an acquired slot to the consumer
+         *
+         * Never fails for a valid slot: the message ring has room for every slot.
+         *
+         * @param slot A non-empty slot acquired from this sink; left empty
+         * @throws std::invalid_argument if `slot` is empty, belongs to another pool, or was
+         * dequeued by the consumer (it is left untouched)
+         */
+        void enqueue(Slot&& slot) { pool_->enqueue(std::move(slot)); }
+
+        /**
+         * @brief Copy a value into a free slot and publish it
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if the pool is exhausted
+         */
+        bool try_enqueue(const T& value) { return pool_->try_enqueue(value); }
+
+        /**
+         * @brief Move a value into a free slot and publish it
+         *
+         * @param value The value to enqueue
+         * @return true if successful, false if the pool is exhausted
+         */
+        bool try_enqueue(T&& value) { return pool_->try_enqueue(std::move(value)); }
+
+        /**
+         * @brief Get the approximate number of published, not yet dequeued messages
+         */
+        std::size_t size() const { return pool_->size(); }
+
+        /**
+         * @brief Check if no message is waiting (approximate)
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Get the number of slots
+         */
+        static constexpr std::size_t capacity() { return Capacity; }
+
+    private:
+        std::shared_ptr<Pool<T, Capacity, Wait>> pool_;
+    };
+
+    /**
+     * @brief Consumer-side handle for a pooled queue
+     *
+     * Dequeues slots in FIFO order; each returns to the producer when released. Move-only.
+     */
+    class Source {
+    private:
+        friend class Pool;
+        explicit Source(std::shared_ptr<Pool<T, Capacity, Wait>> pool) : pool_(pool) { }
+
+    public:
+        // Non-copyable
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+        // Movable
+        Source(Source&&) = default;
+        Source& operator=(Source&&) = default;
+
+        /**
+         * @brief Try to dequeue the next message
+         *
+         * @return The message's slot, or std::nullopt if no message is waiting
+         */
+        std::optional<Slot> try_dequeue() { return pool_->try_dequeue(pool_); }
+
+        /**
+         * @brief Block until a message is available with timeout
+         *
+         * @tparam Rep The arithmetic type representing the timeout duration count
+         * @tparam Period The `std::ratio` type representing the timeout duration period
+         * @param timeout Maximum time to wait for a message
+         * @return The message's slot, or std::nullopt if the timeout expired
+         */
+        template <typename Rep, typename Period>
+        std::optional<Slot> dequeue(std::chrono::duration<Rep, Period> timeout) {
+            return pool_->dequeue(pool_, timeout);
+        }
+
+        /**
+         * @brief Get the approximate number of published, not yet dequeued messages
+         */
+        std::size_t size() const { return pool_->size(); }
+
+        /**
+         * @brief Check if no message is waiting (approximate)
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief Get the number of slots
+         */
+        static constexpr std::size_t capacity() { return Capacity; }
+
+    private:
+        std::shared_ptr<Pool<T, Capacity, Wait>> pool_;
+    };
+
+    /**
+     * @brief Factory method to create a pooled queue
+     *
+     * @param options Allocation options for the object arena (huge pages, NUMA node)
+     * @return std::pair<Sink, Source> A pair of producer and consumer handles
+     * @throws std::runtime_error if `options.numa_node` cannot be bound
+     */
+    static std::pair<Sink, Source> make_pooled_queue(
+        const BufferOptions& options = BufferOptions()
+    ) {
+        std::shared_ptr<Pool> pool(new Pool<T, Capacity, Wait>(options));
+        return { Sink(pool), Source(pool) };
+    }
+
+private:
+    // `self` is the calling handle's reference to this pool, shared with the new slot
+    std::optional<Slot> try_acquire(const std::shared_ptr<Pool>& self) {
+        if (free_count_ == 0 && reclaim() == 0) return std::nullopt;
+        return Slot(self, free_[--free_count_], Owner::producer);
+    }
+
+    template <typename Rep, typename Period>
+    std::optional<Slot> acquire(
+        const std::shared_ptr<Pool>& self, std::chrono::duration<Rep, Period> timeout
+    ) {
+        if (auto slot = try_acquire(self)) return slot;
+        const auto index = returns_source_.dequeue(timeout);
+        if (!index.has_value()) return std::nullopt;
+        return Slot(self, *index, Owner::producer);
+    }
+
+    // Move every returned index onto the producer's free stack
+    std::size_t reclaim() {
+        const std::size_t count =
+            returns_source_.try_dequeue(free_.get() + free_count_, Capacity - free_count_);
+        free_count_ += count;
+        return count;
+    }
+
+    void enqueue(Slot&& slot) {
+        if (slot.pool_.get() != this || slot.owner_ != Owner::producer) {
+            throw std::invalid_argument("Only slots acquired from this sink can be enqueued");
+        }
+        messages_sink_.try_enqueue(slot.index_);
+        slot.pool_.reset();
+    }
+
+    // Fills a free slot without handing out a Slot, so no reference count is touched
+    template <typename U>
+    bool try_enqueue(U&& value) {
+        if (free_count_ == 0 && reclaim() == 0) return false;
+        const Index index = free_[free_count_ - 1];
+        arena_[index] = std::forward<U>(value);
+        --free_count_;
+        messages_sink_.try_enqueue(index);
+        return true;
+    }
+
+    std::optional<Slot> try_dequeue(const std::shared_ptr<Pool>& self) {
+        const auto index = messages_source_.try_dequeue();
+        if (!index.has_value()) return std::nullopt;
+        return Slot(self, *index, Owner::consumer);
+    }
+
+    template <typename Rep, typename Period>
+    std::optional<Slot> dequeue(
+        const std::shared_ptr<Pool>& self, std::chrono::duration<Rep, Period> timeout
+    ) {
+        const auto index = messages_source_.dequeue(timeout);
+        if (!index.has_value()) return std::nullopt;
+        return Slot(self, *index, Owner::consumer);
+    }
+
+    void release(Index index, Owner owner) noexcept {
+        if (owner == Owner::producer) {
+            free_[free_count_++] = index;
+        } else {
+            returns_sink_.try_enqueue(index);
+        }
+    }
+
+    std::size_t size() const { return messages_source_.size(); }
+
+    detail::HeapBuffer<T> arena_;
+    // Slot indices travel producer -> consumer in `messages_*` and back in `returns_*`
+    typename Ring::Sink messages_sink_;
+    typename Ring::Source messages_source_;
+    typename Ring::Sink returns_sink_;
+    typename Ring::Source returns_source_;
+    // Producer-only free stack, on its own cache line
+    alignas(64) std::unique_ptr<Index[]> free_;
+    std::size_t free_count_;
+};
+
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using PoolSink = typename Pool<T, Capacity, Wait>::Sink;
+
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using PoolSource = typename Pool<T, Capacity, Wait>::Source;
+
+/**
+ * @brief Create a pooled queue of `Capacity` `T` slots (see `Pool`)
+ */
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+std::pair<PoolSink<T, Capacity, Wait>, PoolSource<T, Capacity, Wait>> make_pooled_queue(
+    const BufferOptions& options = BufferOptions()
+) {
+    return Pool<T, Capacity, Wait>::make_pooled_queue(options);
+}
+
+} // namespace qbuf
+#endif // QBUF_POOL_HPP
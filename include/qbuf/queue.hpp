@@ -0,0 +1,792 @@
+#ifndef QBUF_QUEUE_HPP
+#define QBUF_QUEUE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <qbuf/copy.hpp>
+#include <qbuf/heap_buffer.hpp>
+#include <qbuf/mmap_spsc.hpp>
+#include <qbuf/wait.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace qbuf {
+
+/**
+ * @brief Value type of a queue: what its `Source::try_dequeue()` returns inside `std::optional`
+ */
+template <typename Q>
+using queue_value_t =
+    typename decltype(std::declval<typename Q::Source&>().try_dequeue())::value_type;
+
+namespace detail {
+
+template <typename Q, typename = void>
+struct is_queue : std::false_type { };
+
+template <typename Q>
+struct is_queue<
+    Q,
+    std::void_t<
+        queue_value_t<Q>,
+        decltype(std::declval<typename Q::Sink&>().try_enqueue(
+            std::declval<const queue_value_t<Q>&>()
+        )),
+        decltype(std::declval<typename Q::Sink&>().try_enqueue(
+            std::declval<const queue_value_t<Q>*>(), std::size_t()
+        )),
+        decltype(std::declval<typename Q::Source&>().try_dequeue(
+            std::declval<queue_value_t<Q>*>(), std::size_t()
+        )),
+        decltype(std::declval<const typename Q::Sink&>().size()),
+        decltype(std::declval<const typename Q::Source&>().empty())>>
+        : std::true_type { };
+
+} // namespace detail
+
+/**
+ * @brief Whether `Q` has the shared queue API
+ *
+ * True for queue classes with `Sink`/`Source` handles offering single and bulk
+ * `try_enqueue`/`try_dequeue` plus `size()`/`empty()`: `SPSC`, `MmapSPSC`, `MutexQueue`, `MPMC`,
+ * `MPSC`, and every `Queue` policy combination. All of them are created with `make_queue(...)`.
+ */
+template <typename Q>
+inline constexpr bool is_queue_v = detail::is_queue<Q>::value;
+
+#if defined(__cpp_concepts)
+template <typename Q>
+concept QueueConcept = is_queue_v<Q>;
+#endif
+
+/**
+ * @brief Storage policy: the ring lives inline in the queue object, in a `std::array`
+ */
+struct InlineStorage {
+    static constexpr const char* name = "inline";
+
+    template <typename T, std::size_t Capacity>
+    class Buffer {
+    public:
+        static constexpr bool is_mirrored = false;
+
+        T* data() { return slots_.data(); }
+        static constexpr std::size_t size() { return Capacity; }
+
+    private:
+        std::array<T, Capacity> slots_ { };
+    };
+};
+
+/**
+ * @brief Storage policy: the ring is a separate 64-byte-aligned heap allocation
+ *
+ * `make_queue(BufferOptions{})` can back it with transparent huge pages or bind it to a NUMA
+ * node, as for `SPSC<T, dynamic_extent>`.
+ */
+struct HeapStorage {
+    static constexpr const char* name = "heap";
+
+    template <typename T, std::size_t Capacity>
+    class Buffer {
+    public:
+        static constexpr bool is_mirrored = false;
+
+        explicit Buffer(const BufferOptions& options = BufferOptions())
+                : slots_(Capacity, options) { }
+
+        T* data() { return slots_.data(); }
+        static constexpr std::size_t size() { return Capacity; }
+
+    private:
+        detail::HeapBuffer<T> slots_;
+    };
+};
+
+/**
+ * @brief Storage policy: a memfd ring mapped twice back to back, as in `MmapSPSC`
+ *
+ * Every bulk transfer is then one contiguous copy, even across the end of the ring.
+ * `make_queue(MmapOptions{})` selects huge pages, pre-faulting, `mlock`, and NUMA placement. The
+ * slot count is rounded up to whole pages, so it may exceed `Capacity`; occupancy is still
+ * limited to `Capacity - 1`. Slots are raw zero-filled memory, so `T` must be trivially copyable.
+ * Outside Linux this falls back to a heap buffer without the mirror.
+ */
+struct MirroredStorage {
+    static constexpr const char* name = "mirrored";
+
+    template <typename T, std::size_t Capacity>
+    class Buffer {
+        static_assert(
+            std::is_trivially_copyable_v<T>, "MirroredStorage requires a trivially copyable T"
+        );
+
+    public:
+#if defined(__linux__)
+        static constexpr bool is_mirrored = true;
+
+        explicit Buffer(const MmapOptions& options = MmapOptions()) {
+            const std::size_t page_size = detail::mapping_page_size(options);
+            slots_ = detail::mirrored_slots<T>(Capacity, page_size);
+            bytes_ = slots_ * sizeof(T);
+            fd_ = detail::create_memfd("qbuf_queue", options);
+            try {
+                if (ftruncate(fd_, static_cast<off_t>(bytes_)) != 0) {
+                    throw std::runtime_error("Failed to set memfd size");
+                }
+                data_ = reinterpret_cast<T*>(detail::map_mirrored(fd_, 0, bytes_, page_size));
+            } catch (...) {
+                close(fd_);
+                throw;
+            }
+            try {
+                detail::bind_to_numa_node(data_, bytes_, options.numa_node);
+                detail::make_resident(data_, 2 * bytes_, options);
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        ~Buffer() { release(); }
+
+        // non-copyable
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        // non-movable
+        Buffer(Buffer&&) = delete;
+        Buffer& operator=(Buffer&&) = delete;
+
+        T* data() { return data_; }
+        std::size_t size() const { return slots_; }
+
+    private:
+        void release() {
+            munmap(data_, 2 * bytes_);
+            close(fd_);
+        }
+
+        T* data_ = nullptr;
+        std::size_t slots_ = 0;
+        std::size_t bytes_ = 0;
+        int fd_ = -1;
+#else
+        static constexpr bool is_mirrored = false;
+
+        // Without mirroring there is nothing to map, so the options go unused
+        explicit Buffer(const MmapOptions& = MmapOptions()) : slots_(Capacity, BufferOptions()) { }
+
+        T* data() { return slots_.data(); }
+        static constexpr std::size_t size() { return Capacity; }
+
+    private:
+        detail::HeapBuffer<T> slots_;
+#endif
+    };
+};
+
+/**
+ * @brief Sync policy: lock-free single producer / single consumer indices, as in `SPSC`
+ *
+ * Head and tail are atomics on their own cache lines and each side caches the other's index,
+ * refreshing it only when the cached value says full (or empty). Blocking calls wait through the
+ * queue's `Wait` strategy.
+ */
+struct LockFreeSync {
+    static constexpr const char* name = "lock-free";
+
+    template <typename Wait>
+    class State {
+    public:
+        State(std::size_t /* mask */, std::size_t /* limit */) { }
+
+        /**
+         * @brief Producer claim of up to `count` free slots at the tail
+         *
+         * The slots become visible to the consumer on `commit()`; a claim that is not committed
+         * publishes nothing.
+         */
+        class Write {
+        public:
+            Write(State& state, std::size_t count, std::size_t mask, std::size_t limit)
+                    : state_(state)
+                    , mask_(mask)
+                    , index_(state.tail_.load(std::memory_order_relaxed)) {
+                std::size_t available = limit - ((index_ - state.cached_head_) & mask);
+                if (available < count) {
+                    state.cached_head_ = state.head_.load(std::memory_order_acquire);
+                    available = limit - ((index_ - state.cached_head_) & mask);
+                }
+                count_ = std::min(count, available);
+            }
+
+            std::size_t index() const { return index_; }
+            std::size_t count() const { return count_; }
+
+            void commit() {
+                state_.tail_.store((index_ + count_) & mask_, std::memory_order_release);
+                state_.not_empty_.notify();
+            }
+
+        private:
+            State& state_;
+            const std::size_t mask_;
+            const std::size_t index_;
+            std::size_t count_;
+        };
+
+        /**
+         * @brief Consumer claim of up to `count` readable slots at the head, released by
+         * `commit()`
+         */
+        class Read {
+        public:
+            Read(State& state, std::size_t count, std::size_t mask)
+                    : state_(state)
+                    , mask_(mask)
+                    , index_(state.head_.load(std::memory_order_relaxed)) {
+                std::size_t available = (state.cached_tail_ - index_) & mask;
+                if (available < count) {
+                    state.cached_tail_ = state.tail_.load(std::memory_order_acquire);
+                    available = (state.cached_tail_ - index_) & mask;
+                }
+                count_ = std::min(count, available);
+            }
+
+            std::size_t index() const { return index_; }
+            std::size_t count() const { return count_; }
+
+            void commit() {
+                state_.head_.store((index_ + count_) & mask_, std::memory_order_release);
+                state_.not_full_.notify();
+            }
+
+        private:
+            State& state_;
+            const std::size_t mask_;
+            const std::size_t index_;
+            std::size_t count_;
+        };
+
+        template <typename Ready, typename Clock, typename Duration>
+        bool wait_writable(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+            return not_full_.wait_until(std::forward<Ready>(ready), deadline);
+        }
+
+        template <typename Ready, typename Clock, typename Duration>
+        bool wait_readable(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+            return not_empty_.wait_until(std::forward<Ready>(ready), deadline);
+        }
+
+        std::size_t size(std::size_t mask) const {
+            const auto head = head_.load(std::memory_order_acquire);
+            const auto tail = tail_.load(std::memory_order_acquire);
+            return (tail - head) & mask;
+        }
+
+    private:
+        // The consumer owns `head_` and `cached_tail_`, the producer `tail_` and `cached_head_`
+        alignas(64) std::atomic<std::size_t> head_ { 0 };
+        alignas(64) std::size_t cached_tail_ = 0;
+        alignas(64) std::atomic<std::size_t> tail_ { 0 };
+        alignas(64) std::size_t cached_head_ = 0;
+        alignas(64) Wait not_full_;
+        alignas(64) Wait not_empty_;
+    };
+};
+
+/**
+ * @brief Sync policy: one mutex around the indices and the copy, as in `MutexQueue`
+ *
+ * A claim holds the lock until it goes out of scope, so several producers (or consumers) may
+ * share one handle. Blocking calls sleep on condition variables that are only signalled when the
+ * other side has a waiter; the `Wait` parameter is not used.
+ */
+struct MutexSync {
+    static constexpr const char* name = "mutex";
+
+    template <typename Wait>
+    class State {
+    public:
+        State(std::size_t mask, std::size_t limit) : mask_(mask), limit_(limit) { }
+
+        /**
+         * @brief Producer claim of up to `count` free slots, holding the lock until destroyed
+         */
+        class Write {
+        public:
+            Write(State& state, std::size_t count, std::size_t mask, std::size_t limit)
+                    : state_(state), lock_(state.mtx_), index_(state.tail_) {
+                count_ = std::min(count, limit - ((index_ - state.head_) & mask));
+            }
+
+            ~Write() {
+                lock_.unlock();
+                if (wake_) state_.cv_not_empty_.notify_one();
+            }
+
+            Write(const Write&) = delete;
+            Write& operator=(const Write&) = delete;
+
+            std::size_t index() const { return index_; }
+            std::size_t count() const { return count_; }
+
+            void commit() {
+                state_.tail_ = (index_ + count_) & state_.mask_;
+                wake_ = state_.consumers_waiting_ != 0;
+            }
+
+        private:
+            State& state_;
+            std::unique_lock<std::mutex> lock_;
+            const std::size_t index_;
+            std::size_t count_;
+            bool wake_ = false;
+        };
+
+        /**
+         * @brief Consumer claim of up to `count` readable slots, holding the lock until destroyed
+         */
+        class Read {
+        public:
+            Read(State& state, std::size_t count, std::size_t mask)
+                    : state_(state), lock_(state.mtx_), index_(state.head_) {
+                count_ = std::min(count, (state.tail_ - index_) & mask);
+            }
+
+            ~Read() {
+                lock_.unlock();
+                if (wake_) state_.cv_not_full_.notify_one();
+            }
+
+            Read(const Read&) = delete;
+            Read& operator=(const Read&) = delete;
+
+            std::size_t index() const { return index_; }
+            std::size_t count() const { return count_; }
+
+            void commit() {
+                state_.head_ = (index_ + count_) & state_.mask_;
+                wake_ = state_.producers_waiting_ != 0;
+            }
+
+        private:
+            State& state_;
+            std::unique_lock<std::mutex> lock_;
+            const std::size_t index_;
+            std::size_t count_;
+            bool wake_ = false;
+        };
+
+        template <typename Ready, typename Clock, typename Duration>
+        bool wait_writable(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+            return wait(ready, deadline, cv_not_full_, producers_waiting_, [this] {
+                return used_unlocked() < limit_;
+            });
+        }
+
+        template <typename Ready, typename Clock, typename Duration>
+        bool wait_readable(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+            return wait(ready, deadline, cv_not_empty_, consumers_waiting_, [this] {
+                return used_unlocked() != 0;
+            });
+        }
+
+        std::size_t size(std::size_t /* mask */) const {
+            std::lock_guard lk(mtx_);
+            return used_unlocked();
+        }
+
+    private:
+        std::size_t used_unlocked() const { return (tail_ - head_) & mask_; }
+
+        // Retry `ready()` (which takes the lock itself) each time `possible()` turns true
+        template <typename Ready, typename Clock, typename Duration, typename Possible>
+        bool wait(
+            Ready& ready, std::chrono::time_point<Clock, Duration> deadline,
+            std::condition_variable& cv, std::size_t& waiting, Possible possible
+        ) {
+            while (!ready()) {
+                std::unique_lock lk(mtx_);
+                ++waiting;
+                const bool woken = cv.wait_until(lk, deadline, possible);
+                --waiting;
+                if (!woken) {
+                    lk.unlock();
+                    return ready();
+                }
+            }
+            return true;
+        }
+
+        const std::size_t mask_;
+        const std::size_t limit_;
+        mutable std::mutex mtx_;
+        std::condition_variable cv_not_full_;
+        std::condition_variable cv_not_empty_;
+        std::size_t head_ = 0;
+        std::size_t tail_ = 0;
+        std::size_t producers_waiting_ = 0;
+        std::size_t consumers_waiting_ = 0;
+    };
+};
+
+/**
+ * @brief Bounded queue assembled from a storage policy and a sync policy at compile time
+ *
+ * `Storage` decides where the ring lives (`InlineStorage`, `HeapStorage`, `MirroredStorage`);
+ * `Sync` decides how producer and consumer coordinate (`LockFreeSync`, `MutexSync`). Each
+ * combination is a separate instantiation, so the policies inline into the same code `SPSC`,
+ * `MmapSPSC`, and `MutexQueue` hand-write: a compile-time mask and plain index math for fixed
+ * storage, one contiguous copy for mirrored storage. `make_queue(args...)` forwards its arguments
+ * to the storage (`BufferOptions` for heap storage, `MmapOptions` for mirrored storage).
+ *
+ * The Sink/Source API matches the other queues for single and bulk, non-blocking and timed
+ * operations. Occupancy is limited to `Capacity - 1`.
+ *
+ * @tparam T The type of elements stored in the queue
+ * @tparam Capacity Number of ring slots (power of two)
+ * @tparam Storage Storage policy
+ * @tparam Sync Sync policy
+ * @tparam Wait Strategy used by the blocking calls of `LockFreeSync` (see qbuf/wait.hpp)
+ */
+template <
+    typename T, std::size_t Capacity, typename Storage = InlineStorage,
+    typename Sync = LockFreeSync, typename Wait = YieldWait>
+class Queue {
+public:
+    static_assert(Capacity > 1, "Queue capacity must be greater than 1");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of 2");
+
+    using storage_policy = Storage;
+    using sync_policy = Sync;
+
+private:
+    using Buffer = typename Storage::template Buffer<T, Capacity>;
+    using State = typename Sync::template State<Wait>;
+    using Write = typename State::Write;
+    using Read = typename State::Read;
+
+    static constexpr std::size_t limit = Capacity - 1;
+
+    template <typename... Args>
+    explicit Queue(Args&&... args)
+            : buffer_(std::forward<Args>(args)...), state_(buffer_.size() - 1, limit) { }
+
+public:
+    // non-copyable
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+    // non-movable
+    Queue(Queue&&) = delete;
+    Queue& operator=(Queue&&) = delete;
+
+    /**
+     * @brief Producer-side handle
+     */
+    class Sink {
+        friend class Queue;
+        explicit Sink(std::shared_ptr<Queue> queue) : queue_(std::move(queue)) { }
+
+    public:
+        // Non-copyable
+        Sink(const Sink&) = delete;
+        Sink& operator=(const Sink&) = delete;
+
+        // Movable
+        Sink(Sink&&) = default;
+        Sink& operator=(Sink&&) = default;
+
+        /**
+         * @brief Try to enqueue a single element
+         *
+         * @return true if successful, false if queue is full
+         */
+        bool try_enqueue(const T& value) { return queue_->try_enqueue(T(value)); }
+
+        /**
+         * @brief Try to enqueue a single element (move semantics); `value` is only moved from
+         * on success
+         *
+         * @return true if successful, false if queue is full
+         */
+        bool try_enqueue(T&& value) { return queue_->try_enqueue(std::move(value)); }
+
+        /**
+         * @brief Try to enqueue up to `count` elements
+         *
+         * @return Number of elements enqueued
+         */
+        std::size_t try_enqueue(const T* data, std::size_t count) {
+            return queue_->try_enqueue(data, count);
+        }
+
+        /**
+         * @brief Enqueue a single element, waiting up to `timeout` for room
+         *
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(T(value), timeout);
+        }
+
+        /**
+         * @brief Enqueue a single element (move semantics), waiting up to `timeout` for room
+         *
+         * @return true if successful, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(std::move(value), timeout);
+        }
+
+        /**
+         * @brief Enqueue all `count` elements, waiting up to `timeout` for room
+         *
+         * @return true if all elements were enqueued, false if timeout expired
+         */
+        template <typename Rep, typename Period>
+        bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->enqueue(data, count, timeout);
+        }
+
+        bool empty() const { return queue_->size() == 0; }
+        std::size_t size() const { return queue_->size(); }
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<Queue> queue_;
+    };
+
+    /**
+     * @brief Consumer-side handle
+     */
+    class Source {
+        friend class Queue;
+        explicit Source(std::shared_ptr<Queue> queue) : queue_(std::move(queue)) { }
+
+    public:
+        // Non-copyable
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+        // Movable
+        Source(Source&&) = default;
+        Source& operator=(Source&&) = default;
+
+        /**
+         * @brief Try to dequeue a single element
+         *
+         * @return The element, or std::nullopt if queue is empty
+         */
+        std::optional<T> try_dequeue() { return queue_->try_dequeue(); }
+
+        /**
+         * @brief Try to dequeue a single element into `out` (move assignment)
+         *
+         * @return true if an element was dequeued, false if queue is empty
+         */
+        bool try_dequeue(T& out) { return queue_->try_dequeue(out); }
+
+        /**
+         * @brief Try to dequeue up to `count` elements
+         *
+         * @return Number of elements dequeued
+         */
+        std::size_t try_dequeue(T* data, std::size_t count) {
+            return queue_->try_dequeue(data, count);
+        }
+
+        /**
+         * @brief Dequeue a single element, waiting up to `timeout` for one to arrive
+         *
+         * @return The element, or std::nullopt if timeout expired
+         */
+        template <typename Rep, typename Period>
+        std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+            return queue_->dequeue(timeout);
+        }
+
+        /**
+         * @brief Dequeue `count` elements, waiting up to `timeout` for them to arrive
+         *
+         * @return Number of elements dequeued (less than `count` if timeout expired)
+         */
+        template <typename Rep, typename Period>
+        std::size_t
+        dequeue(T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+            return queue_->dequeue(data, count, timeout);
+        }
+
+        bool empty() const { return queue_->size() == 0; }
+        std::size_t size() const { return queue_->size(); }
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<Queue> queue_;
+    };
+
+    /**
+     * @brief Create a queue and its handles
+     *
+     * @param args Forwarded to the storage policy's buffer (e.g. `BufferOptions`, `MmapOptions`)
+     * @return std::pair containing (Sink, Source)
+     * @throws whatever the storage throws, e.g. std::runtime_error if a mapping fails
+     */
+    template <typename... Args>
+    static std::pair<Sink, Source> make_queue(Args&&... args) {
+        std::shared_ptr<Queue> queue(new Queue(std::forward<Args>(args)...));
+        return { Sink(queue), Source(queue) };
+    }
+
+private:
+    // Slot index mask; a compile-time constant unless the storage rounds the ring up at runtime
+    std::size_t mask() const { return buffer_.size() - 1; }
+
+    // Contiguous run starting at `index` that a transfer of `count` may use before wrapping
+    std::size_t first_segment(std::size_t index, std::size_t count) const {
+        if constexpr (Buffer::is_mirrored) {
+            return count;
+        } else {
+            return std::min(count, mask() + 1 - index);
+        }
+    }
+
+    static void copy_in(T* dst, const T* src, std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count != 0) detail::copy_to_ring(dst, src, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) dst[i] = src[i];
+        }
+    }
+
+    static void move_out(T* dst, T* src, std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count != 0) std::memcpy(dst, src, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) dst[i] = std::move(src[i]);
+        }
+    }
+
+    bool try_enqueue(T&& value) {
+        Write write(state_, 1, mask(), limit);
+        if (write.count() == 0) return false;
+        buffer_.data()[write.index()] = std::move(value);
+        write.commit();
+        return true;
+    }
+
+    std::size_t try_enqueue(const T* data, std::size_t count) {
+        if (count == 0) return 0;
+        Write write(state_, count, mask(), limit);
+        const std::size_t n = write.count();
+        if (n == 0) return 0;
+
+        const std::size_t first = first_segment(write.index(), n);
+        copy_in(buffer_.data() + write.index(), data, first);
+        copy_in(buffer_.data(), data + first, n - first);
+        write.commit();
+        return n;
+    }
+
+    std::optional<T> try_dequeue() {
+        Read read(state_, 1, mask());
+        if (read.count() == 0) return std::nullopt;
+        std::optional<T> value(std::move(buffer_.data()[read.index()]));
+        read.commit();
+        return value;
+    }
+
+    bool try_dequeue(T& out) {
+        Read read(state_, 1, mask());
+        if (read.count() == 0) return false;
+        out = std::move(buffer_.data()[read.index()]);
+        read.commit();
+        return true;
+    }
+
+    std::size_t try_dequeue(T* data, std::size_t count) {
+        if (count == 0) return 0;
+        Read read(state_, count, mask());
+        const std::size_t n = read.count();
+        if (n == 0) return 0;
+
+        const std::size_t first = first_segment(read.index(), n);
+        move_out(data, buffer_.data() + read.index(), first);
+        move_out(data + first, buffer_.data(), n - first);
+        read.commit();
+        return n;
+    }
+
+    template <typename Rep, typename Period>
+    bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
+        if (try_enqueue(std::move(value))) return true;
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return state_.wait_writable([&] { return try_enqueue(std::move(value)); }, deadline);
+    }
+
+    template <typename Rep, typename Period>
+    bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t total = try_enqueue(data, count);
+        if (total == count) return true;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return state_.wait_writable(
+            [&] {
+                total += try_enqueue(data + total, count - total);
+                return total == count;
+            },
+            deadline
+        );
+    }
+
+    template <typename Rep, typename Period>
+    std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
+        std::optional<T> value = try_dequeue();
+        if (value.has_value()) return value;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        state_.wait_readable(
+            [&] {
+                value = try_dequeue();
+                return value.has_value();
+            },
+            deadline
+        );
+        return value;
+    }
+
+    template <typename Rep, typename Period>
+    std::size_t dequeue(T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t total = try_dequeue(data, count);
+        if (total == count) return total;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        state_.wait_readable(
+            [&] {
+                total += try_dequeue(data + total, count - total);
+                return total == count;
+            },
+            deadline
+        );
+        return total;
+    }
+
+    std::size_t size() const { return state_.size(mask()); }
+
+    Buffer buffer_;
+    State state_;
+};
+
+} // namespace qbuf
+#endif // QBUF_QUEUE_HPP
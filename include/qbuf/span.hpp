@@ -0,0 +1,58 @@
+#ifndef QBUF_SPAN_HPP
+#define QBUF_SPAN_HPP
+
+#include <cstddef>
+
+namespace qbuf {
+
+/**
+ * @brief Non-owning view of a contiguous run of queue slots
+ *
+ * Minimal C++17 stand-in for `std::span`, used by the zero-copy APIs to hand out
+ * direct access to ring memory.
+ *
+ * @tparam T The element type (const-qualified for read-only views)
+ */
+template <typename T>
+class Span {
+public:
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, std::size_t size) noexcept : data_(data), size_(size) { }
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+    constexpr T* begin() const noexcept { return data_; }
+    constexpr T* end() const noexcept { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief View of a ring region split into up to two contiguous segments
+ *
+ * `first` starts at the current index; `second` is non-empty only when the region wraps past
+ * the end of the buffer and continues from slot 0.
+ *
+ * @tparam T The element type (const-qualified for read-only views)
+ */
+template <typename T>
+struct RingSpan {
+    Span<T> first;
+    Span<T> second;
+
+    constexpr std::size_t size() const noexcept { return first.size() + second.size(); }
+    constexpr bool empty() const noexcept { return size() == 0; }
+
+    constexpr T& operator[](std::size_t i) const noexcept {
+        return (i < first.size()) ? first[i] : second[i - first.size()];
+    }
+};
+
+} // namespace qbuf
+#endif // QBUF_SPAN_HPP
@@ -1,33 +1,86 @@
 #ifndef QBUF_SPSC_HPP
 #define QBUF_SPSC_HPP
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <qbuf/copy.hpp>
+#include <qbuf/heap_buffer.hpp>
+#include <qbuf/span.hpp>
+#include <qbuf/stats.hpp>
+#include <qbuf/wait.hpp>
+#include <stdexcept>
 #include <thread>
+#include <type_traits>
 
 namespace qbuf {
 
+/**
+ * @brief Deferred-publish settings for `SPSC::Sink::set_publish_batch()`
+ *
+ * Single-element writes land in their slots at once, but the release store of the tail (and the
+ * cache-line transfer it causes) happens only every `every` writes, once the oldest unpublished
+ * write is `max_delay` old, or on `flush()`. The delay is checked by the next write, so a
+ * producer that goes idle must `flush()`.
+ */
+struct PublishBatch {
+    /** @brief Publish after this many single-element writes (1: every write, the default) */
+    std::size_t every = 1;
+    /** @brief Also publish once the oldest unpublished write is this old (0: no time limit) */
+    std::chrono::nanoseconds max_delay { 0 };
+};
+
 /**
  * @brief Single-Producer Single-Consumer lock-free queue
  *
  * A thread-safe, lock-free queue implementation for single producer and
  * single consumer scenarios.
  *
+ * With `Capacity == dynamic_extent` the capacity is chosen at runtime via `make_queue(capacity)`
+ * and the ring lives in a separate 64-byte-aligned heap allocation; otherwise it is stored
+ * inline in a `std::array`. Both variants share the same code paths.
+ *
  * @tparam T The type of elements stored in the queue
- * @tparam Capacity Maximum number of elements the queue can hold
+ * @tparam Capacity Maximum number of elements the queue can hold, or `dynamic_extent`
+ * @tparam Wait Strategy used by the blocking `enqueue`/`dequeue` calls (see qbuf/wait.hpp)
  */
-template <typename T, std::size_t Capacity>
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
 class SPSC {
 public:
     static_assert(Capacity > 0, "Queue capacity must be greater than 0");
-    static_assert((Capacity & (Capacity - 1)) == 0, "Queue capacity must be a power of 2");
+    static_assert(
+        Capacity == dynamic_extent || (Capacity & (Capacity - 1)) == 0,
+        "Queue capacity must be a power of 2"
+    );
 
 private:
-    SPSC() : head_(0), tail_(0) { }
+    using Buffer = std::conditional_t<
+        Capacity == dynamic_extent, detail::HeapBuffer<T>, std::array<T, Capacity>>;
+
+    SPSC()
+            : head_(0)
+            , cached_tail_(0)
+            , tail_(0)
+            , cached_head_(0)
+            , unpublished_(0)
+            , publish_every_(1)
+            , publish_delay_(0) { }
+
+    SPSC(std::size_t capacity, const BufferOptions& options)
+            : head_(0)
+            , cached_tail_(0)
+            , tail_(0)
+            , cached_head_(0)
+            , unpublished_(0)
+            , publish_every_(1)
+            , publish_delay_(0)
+            , buffer_(capacity, options) { }
 
 public:
     // non-copyable
@@ -46,7 +99,8 @@ public:
     class Sink {
     private:
         friend class SPSC;
-        explicit Sink(std::shared_ptr<SPSC<T, Capacity>> queue) : queue_(queue) { }
+        friend struct detail::AsyncAccess<SPSC>;
+        explicit Sink(std::shared_ptr<SPSC<T, Capacity, Wait>> queue) : queue_(queue) { }
 
     public:
         // Non-copyable
@@ -55,7 +109,20 @@ public:
 
         // Movable
         Sink(Sink&&) = default;
-        Sink& operator=(Sink&&) = default;
+        Sink& operator=(Sink&& other) {
+            if (this != &other) {
+                if (queue_) queue_->flush();
+                queue_ = std::move(other.queue_);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Publish any deferred writes (see `set_publish_batch()`)
+         */
+        ~Sink() {
+            if (queue_) queue_->flush();
+        }
 
         /**
          * @brief Try to enqueue a single element
@@ -73,6 +140,21 @@ public:
          */
         bool try_enqueue(T&& value) { return queue_->try_enqueue(std::move(value)); }
 
+        /**
+         * @brief Try to enqueue an element built from `args` in the tail slot
+         *
+         * A single argument the slot can be assigned from is assigned directly (no temporary
+         * `T`); otherwise a `T` is built and move-assigned. Nothing is built when the queue is
+         * full.
+         *
+         * @param args Constructor arguments for `T`
+         * @return true if successful, false if queue is full
+         */
+        template <typename... Args>
+        bool emplace(Args&&... args) {
+            return queue_->emplace(std::forward<Args>(args)...);
+        }
+
         /**
          * @brief Try to enqueue multiple elements
          *
@@ -84,6 +166,24 @@ public:
             return queue_->try_enqueue(data, count);
         }
 
+        /**
+         * @brief Reserve writable slots directly in the ring buffer
+         *
+         * The returned region holds up to `count` slots and is split into two segments when it
+         * wraps past the end of the buffer. Nothing is visible to the consumer until `commit()`.
+         *
+         * @param count Maximum number of slots to reserve
+         * @return Writable region of `min(count, free slots)` elements (possibly empty)
+         */
+        RingSpan<T> reserve(std::size_t count) { return queue_->reserve(count); }
+
+        /**
+         * @brief Publish the first `count` slots of the last reservation
+         *
+         * @param count Number of slots written; must not exceed the size of the last `reserve()`
+         */
+        void commit(std::size_t count) { queue_->commit(count); }
+
         /**
          * @brief Block until an element can be enqueued with timeout
          *
@@ -141,8 +241,59 @@ public:
          */
         std::size_t size() const { return queue_->size(); }
 
+        /**
+         * @brief Opt in to deferred publishing of single-element writes (write combining)
+         *
+         * Writes still go straight into their slots; only the tail store that makes them
+         * visible is batched, trading consumer latency for fewer cache-line transfers. Bulk
+         * `try_enqueue`, `commit`, every blocking `enqueue`, a full queue and the handle's
+         * destructor always publish everything written so far. Pending writes are published
+         * first.
+         *
+         * @param batch When to publish; `PublishBatch {}` restores publish-on-every-write
+         * @throws std::invalid_argument if `batch.every` is 0
+         */
+        void set_publish_batch(const PublishBatch& batch) { queue_->set_publish_batch(batch); }
+
+        /**
+         * @brief Publish every write made so far with one release store of the tail
+         */
+        void flush() { queue_->flush(); }
+
+        /**
+         * @brief Number of written elements the consumer cannot see yet
+         *
+         * @return Writes since the last publish (always 0 without a publish batch)
+         */
+        std::size_t unpublished() const { return queue_->unpublished_; }
+
+        /**
+         * @brief Snapshot of the queue's counters (all zero unless built with `QBUF_STATS`)
+         */
+        QueueStats stats() const { return queue_->stats(); }
+
+        /**
+         * @brief Get the number of ring slots
+         *
+         * @return Ring capacity; maximum occupancy is one less
+         */
+        std::size_t capacity() const { return queue_->capacity(); }
+
+        /**
+         * @brief Awaitable enqueue for C++20 coroutines (include qbuf/coro.hpp; needs `AsyncWait`)
+         *
+         * `co_await sink.async_enqueue(value)` suspends the coroutine while the queue is full; the
+         * consumer's next dequeue resumes it. No thread blocks.
+         *
+         * @param value The value to enqueue
+         */
+        template <typename Queue = SPSC>
+        detail::EnqueueAwaiter<Queue> async_enqueue(T value) {
+            return detail::EnqueueAwaiter<Queue>(*this, std::move(value));
+        }
+
     private:
-        std::shared_ptr<SPSC<T, Capacity>> queue_;
+        std::shared_ptr<SPSC<T, Capacity, Wait>> queue_;
     };
 
     /**
@@ -154,7 +305,8 @@ public:
     class Source {
     private:
         friend class SPSC;
-        explicit Source(std::shared_ptr<SPSC<T, Capacity>> queue) : queue_(queue) { }
+        friend struct detail::AsyncAccess<SPSC>;
+        explicit Source(std::shared_ptr<SPSC<T, Capacity, Wait>> queue) : queue_(queue) { }
 
     public:
         // Non-copyable
@@ -172,6 +324,51 @@ public:
          */
         std::optional<T> try_dequeue() { return queue_->try_dequeue(); }
 
+        /**
+         * @brief Try to dequeue a single element into `out` (move-assigned)
+         *
+         * Avoids materialising a `std::optional<T>`; `out` can be reused across calls.
+         *
+         * @param out Destination, left untouched if the queue is empty
+         * @return true if successful, false if queue is empty
+         */
+        bool try_dequeue(T& out) { return queue_->try_dequeue(out); }
+
+        /**
+         * @brief Invoke `consume(element)` on the front element in its slot, then release it
+         *
+         * The element is not moved out of the ring; `consume` receives a `T&` and may read it or
+         * move from it. If `consume` throws, the element stays at the front of the queue.
+         *
+         * @param consume Callable taking `T&`
+         * @return true if an element was consumed, false if queue is empty
+         */
+        template <typename F>
+        bool try_consume(F&& consume) {
+            return queue_->try_consume(std::forward<F>(consume));
+        }
+
+        /**
+         * @brief Visit every available element in place, then release them with one head store
+         *
+         * Reads the tail once, calls `f(T&)` on up to `max` elements in FIFO order (both wrap
+         * segments), and publishes the new head once at the end, or every `release_every`
+         * elements so a long drain hands slots back to the producer as it goes. If `f` throws,
+         * the elements visited before the throwing one are released and the exception propagates.
+         *
+         * @param f Callback for each element; it may read the element or move from it
+         * @param max Upper bound on the number of elements visited
+         * @param release_every Publish the head after this many elements (0: only at the end)
+         * @return Number of elements visited
+         */
+        template <typename F>
+        std::size_t drain(
+            F&& f, std::size_t max = std::numeric_limits<std::size_t>::max(),
+            std::size_t release_every = 0
+        ) {
+            return queue_->drain(std::forward<F>(f), max, release_every);
+        }
+
         /**
          * @brief Try to dequeue multiple elements
          *
@@ -183,6 +380,23 @@ public:
             return queue_->try_dequeue(data, count);
         }
 
+        /**
+         * @brief View the readable region in place without dequeuing
+         *
+         * The region is split into two segments when it wraps past the end of the buffer. It stays
+         * valid until the matching `consume()`.
+         *
+         * @return Read-only region of all currently readable elements (possibly empty)
+         */
+        RingSpan<const T> peek() { return queue_->peek(); }
+
+        /**
+         * @brief Release the first `count` elements of the last `peek()` back to the producer
+         *
+         * @param count Number of elements to drop; must not exceed the size of the last `peek()`
+         */
+        void consume(std::size_t count) { queue_->consume(count); }
+
         /**
          * @brief Block until an element can be dequeued with timeout
          *
@@ -228,8 +442,53 @@ public:
          */
         std::size_t size() const { return queue_->size(); }
 
+        /**
+         * @brief Snapshot of the queue's counters (all zero unless built with `QBUF_STATS`)
+         */
+        QueueStats stats() const { return queue_->stats(); }
+
+        /**
+         * @brief Get the number of ring slots
+         *
+         * @return Ring capacity; maximum occupancy is one less
+         */
+        std::size_t capacity() const { return queue_->capacity(); }
+
+        /**
+         * @brief Descriptor that becomes readable when elements arrive (`EventFdWait` only)
+         *
+         * Register it with poll/epoll for `POLLIN` and call `arm_notification()` before each
+         * sleep; without arming, the producer never signals it.
+         */
+        int native_handle() const { return queue_->not_empty_.native_handle(); }
+
+        /**
+         * @brief Ask the producer to signal `native_handle()` on its next publish
+         *
+         * Call after draining the queue, right before sleeping on the descriptor. Marks the
+         * consumer as sleeping and rechecks the queue, so a publish racing with the call is
+         * never missed; the producer clears the mark when it signals. Wakeups may be spurious.
+         *
+         * @return true if the queue is still empty and the caller may sleep, false if elements
+         * are already available (dequeue them instead)
+         */
+        bool arm_notification() {
+            return queue_->not_empty_.arm([this] { return !queue_->empty(); });
+        }
+
+        /**
+         * @brief Awaitable dequeue for C++20 coroutines (include qbuf/coro.hpp; needs `AsyncWait`)
+         *
+         * `co_await source.async_dequeue()` yields the next element, suspending the coroutine
+         * while the queue is empty; the producer's next publish resumes it. No thread blocks.
+         */
+        template <typename Queue = SPSC>
+        detail::DequeueAwaiter<Queue> async_dequeue() {
+            return detail::DequeueAwaiter<Queue>(*this);
+        }
+
     private:
-        std::shared_ptr<SPSC<T, Capacity>> queue_;
+        std::shared_ptr<SPSC<T, Capacity, Wait>> queue_;
     };
 
     /**
@@ -242,37 +501,202 @@ public:
      * @return std::pair<Sink, Source> A pair of producer and consumer handles
      */
     static std::pair<Sink, Source> make_queue() {
-        std::shared_ptr<SPSC> queue(new SPSC<T, Capacity>());
+        static_assert(Capacity != dynamic_extent, "Use make_queue(capacity) for dynamic_extent");
+        std::shared_ptr<SPSC> queue(new SPSC<T, Capacity, Wait>());
+        return { Sink(queue), Source(queue) };
+    }
+
+    /**
+     * @brief Factory method to create a runtime-capacity queue with sink and source handles
+     *
+     * Only available for `SPSC<T, dynamic_extent>`. The ring is allocated separately from the
+     * control block, 64-byte aligned, optionally backed by huge pages and bound to a NUMA node.
+     *
+     * @param capacity Number of ring slots; must be a power of two greater than 1 (max occupancy is
+     * `capacity - 1`)
+     * @param options Buffer allocation options
+     * @return std::pair<Sink, Source> A pair of producer and consumer handles
+     * @throws std::invalid_argument if `capacity` is not a power of two greater than 1
+     * @throws std::length_error if `capacity` slots of `T` do not fit in the address space
+     * @throws std::runtime_error if `options.numa_node` cannot be bound
+     */
+    static std::pair<Sink, Source> make_queue(
+        std::size_t capacity, const BufferOptions& options = BufferOptions()
+    ) {
+        static_assert(Capacity == dynamic_extent, "Fixed-capacity queues use make_queue()");
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("Queue capacity must be a power of 2 greater than 1");
+        }
+        std::shared_ptr<SPSC> queue(new SPSC<T, Capacity, Wait>(capacity, options));
         return { Sink(queue), Source(queue) };
     }
 
 private:
-    static constexpr std::size_t increment(std::size_t idx) { return (idx + 1) & (Capacity - 1); }
+    /**
+     * @brief Number of ring slots (maximum occupancy is one less)
+     *
+     * @return `Capacity` for fixed-capacity queues, the runtime capacity otherwise
+     */
+    std::size_t capacity() const { return buffer_.size(); }
+
+    // Index mask; a compile-time constant for fixed-capacity queues
+    std::size_t mask() const { return capacity() - 1; }
+
+    std::size_t increment(std::size_t idx) const { return (idx + 1) & mask(); }
+
+    std::size_t used_space(std::size_t head, std::size_t tail) const {
+        return (tail - head) & mask();
+    }
+
+    std::size_t free_space(std::size_t tail, std::size_t head) const {
+        return mask() - used_space(head, tail);
+    }
+
+    /**
+     * @brief Copy one contiguous segment into the ring
+     *
+     * Trivially copyable payloads go through a single `memcpy` (or streaming stores past
+     * `QBUF_STREAMING_STORE_THRESHOLD`); other types are copy-assigned element by element.
+     */
+    static void copy_in(T* dst, const T* src, std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count != 0) detail::copy_to_ring(dst, src, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) dst[i] = src[i];
+        }
+    }
+
+    /**
+     * @brief Move one contiguous segment out of the ring
+     *
+     * Trivially copyable payloads go through a single `memcpy`; other types are move-assigned.
+     */
+    static void move_out(T* dst, T* src, std::size_t count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count != 0) std::memcpy(dst, src, count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) dst[i] = std::move(src[i]);
+        }
+    }
 
     /**
      * @brief Try to enqueue a single element
      *
+     * Copy-assigns straight into the slot, so a heavy `T` is copied once (and a slot that still
+     * holds storage, e.g. a string's buffer, can reuse it).
+     *
      * @param value The value to enqueue
      * @return true if successful, false if queue is full
      */
-    bool try_enqueue(const T& value) { return try_enqueue(T(value)); }
+    bool try_enqueue(const T& value) {
+        return try_publish([&](T& slot) { slot = value; });
+    }
 
     /**
      * @brief Try to enqueue a single element (move semantics)
      *
      * @param value The value to enqueue
-     * @return true if successful, false if queue is full
+     * @return true if successful, false if queue is full (`value` is left untouched)
      */
     bool try_enqueue(T&& value) {
-        const auto current_tail = tail_.load(std::memory_order_relaxed);
-        const auto next_tail = increment(current_tail);
+        return try_publish([&](T& slot) { slot = std::move(value); });
+    }
+
+    /**
+     * @brief Try to enqueue an element built from `args` in the tail slot
+     *
+     * Slots are live objects, so a single argument `T` can both be constructed and assigned from
+     * (e.g. a `const char*` for `std::string`) is assigned directly; other arguments build a `T`
+     * that is then move-assigned. Either way `emplace` accepts exactly the argument lists `T`'s
+     * constructors do, as `MmapSPSC::emplace` does. Nothing is built when the queue is full.
+     *
+     * @param args Constructor arguments for `T`
+     * @return true if successful, false if queue is full
+     */
+    template <typename... Args>
+    bool emplace(Args&&... args) {
+        return try_publish([&](T& slot) { assign(slot, std::forward<Args>(args)...); });
+    }
+
+    template <typename Arg>
+    static void assign(T& slot, Arg&& arg) {
+        // Assigning alone would accept e.g. `std::string = char` for an int argument
+        if constexpr (std::is_assignable_v<T&, Arg&&> && std::is_constructible_v<T, Arg&&>) {
+            slot = std::forward<Arg>(arg);
+        } else {
+            T value(std::forward<Arg>(arg));
+            slot = std::move(value);
+        }
+    }
+
+    template <typename... Args>
+    static void assign(T& slot, Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        slot = std::move(value);
+    }
 
-        if (next_tail == head_.load(std::memory_order_acquire)) {
-            return false; // Queue is full
+    void set_publish_batch(const PublishBatch& batch) {
+        if (batch.every == 0) {
+            throw std::invalid_argument("Publish batch must hold at least one element");
         }
+        flush();
+        publish_every_ = batch.every;
+        publish_delay_ = batch.max_delay;
+    }
+
+    /**
+     * @brief Make every write so far visible to the consumer
+     */
+    void flush() {
+        if (unpublished_ != 0) publish_tail(write_tail());
+    }
 
-        buffer_[current_tail] = std::move(value);
+    // Producer's next slot: the published tail plus the writes still deferred
+    std::size_t write_tail() const {
+        return (tail_.load(std::memory_order_relaxed) + unpublished_) & mask();
+    }
+
+    void publish_tail(std::size_t next_tail) {
         tail_.store(next_tail, std::memory_order_release);
+        unpublished_ = 0;
+        not_empty_.notify();
+    }
+
+    // Called after each deferred write; the clock is only read when a delay is configured
+    bool publish_due() {
+        if (publish_delay_.count() == 0) return false;
+        const auto now = std::chrono::steady_clock::now();
+        if (unpublished_ == 1) {
+            first_unpublished_ = now;
+            return false;
+        }
+        return now - first_unpublished_ >= publish_delay_;
+    }
+
+    /**
+     * @brief Claim the tail slot, let `write(slot)` fill it, and publish it
+     *
+     * `write` only runs when there is room. With a publish batch the tail store is deferred.
+     */
+    template <typename Write>
+    bool try_publish(Write&& write) {
+        const auto current_tail = write_tail();
+        const auto next_tail = increment(current_tail);
+
+        if (next_tail == cached_head_) {
+            // Cached head says full; refresh from the consumer before giving up
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (next_tail == cached_head_) {
+                flush(); // the consumer must see a full ring, or neither side can move
+                producer_stats_.record_rejection();
+                return false; // Queue is full
+            }
+        }
+
+        write(buffer_[current_tail]);
+        if (++unpublished_ >= publish_every_ || publish_due()) publish_tail(next_tail);
+        producer_stats_.record_success(1);
+        producer_stats_.record_occupancy(used_space(cached_head_, next_tail));
         return true;
     }
 
@@ -289,56 +713,68 @@ private:
     std::size_t try_enqueue(const T* data, std::size_t count) {
         if (count == 0) return 0;
 
-        const auto current_tail = tail_.load(std::memory_order_relaxed);
-        const auto current_head = head_.load(std::memory_order_acquire);
+        const auto current_tail = write_tail();
 
-        // Calculate available space
-        std::size_t available;
-        if (current_tail >= current_head) {
-            available = (Capacity - 1) - (current_tail - current_head);
-        } else {
-            available = current_head - current_tail - 1;
+        // Calculate available space, refreshing the cached head only if it is insufficient
+        std::size_t available = free_space(current_tail, cached_head_);
+        if (available < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            available = free_space(current_tail, cached_head_);
         }
 
         // Limit enqueue to available space
-        std::size_t to_enqueue = (count < available) ? count : available;
+        const std::size_t to_enqueue = (count < available) ? count : available;
+        if (to_enqueue == 0) {
+            flush();
+            producer_stats_.record_rejection();
+            return 0;
+        }
 
-        if (to_enqueue == 0) return 0;
+        // First segment runs to the end of the buffer, second wraps around to slot 0
+        const std::size_t first_segment = std::min(to_enqueue, capacity() - current_tail);
+        copy_in(&buffer_[current_tail], data, first_segment);
+        copy_in(buffer_.data(), data + first_segment, to_enqueue - first_segment);
 
-        std::size_t enqueued_total = 0;
-        std::size_t src_idx = 0;
-        std::size_t tail_idx = current_tail;
+        const auto next_tail = (current_tail + to_enqueue) & mask();
+        publish_tail(next_tail);
+        producer_stats_.record_success(to_enqueue);
+        producer_stats_.record_occupancy(used_space(cached_head_, next_tail));
+        return to_enqueue;
+    }
 
-        // First segment: write until end of buffer or until head
-        std::size_t first_seg_size;
-        if (current_tail >= current_head) {
-            // Normal case: write from tail to end of buffer
-            first_seg_size = std::min(to_enqueue, Capacity - tail_idx);
-        } else {
-            // Wrap case: write from tail up to (but not past) head
-            first_seg_size = std::min(to_enqueue, current_head - tail_idx - 1);
-        }
+    /**
+     * @brief Reserve up to `count` writable slots starting at the tail
+     *
+     * @param count Maximum number of slots to reserve
+     * @return Writable region split into up to two segments at the wrap point
+     */
+    RingSpan<T> reserve(std::size_t count) {
+        const auto current_tail = write_tail();
 
-        for (std::size_t i = 0; i < first_seg_size; ++i) {
-            buffer_[tail_idx + i] = data[src_idx + i];
+        std::size_t available = free_space(current_tail, cached_head_);
+        if (available < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            available = free_space(current_tail, cached_head_);
         }
-        enqueued_total = first_seg_size;
-        tail_idx = (tail_idx + first_seg_size) & (Capacity - 1);
-        to_enqueue -= first_seg_size;
-        src_idx += first_seg_size;
 
-        // Second segment: if we wrapped and still have elements to enqueue
-        if (to_enqueue > 0) {
-            std::size_t second_seg_size = std::min(to_enqueue, current_head - 1);
-            for (std::size_t i = 0; i < second_seg_size; ++i) {
-                buffer_[i] = data[src_idx + i];
-            }
-            enqueued_total += second_seg_size;
-            tail_idx = second_seg_size;
-        }
+        const std::size_t n = (count < available) ? count : available;
+        const std::size_t first = std::min(n, capacity() - current_tail);
+        return { Span<T>(&buffer_[current_tail], first), Span<T>(buffer_.data(), n - first) };
+    }
 
-        tail_.store(tail_idx, std::memory_order_release);
-        return enqueued_total;
+    /**
+     * @brief Publish `count` reserved slots with a single release store of the tail
+     *
+     * @param count Number of slots to publish
+     */
+    void commit(std::size_t count) {
+        const auto current_tail = write_tail();
+        const auto next_tail = (current_tail + count) & mask();
+        publish_tail(next_tail);
+        if (count != 0) {
+            producer_stats_.record_success(count);
+            producer_stats_.record_occupancy(used_space(cached_head_, next_tail));
+        }
     }
 
     /**
@@ -347,15 +783,47 @@ private:
      * @return std::optional containing the value if successful, std::nullopt if queue is empty
      */
     std::optional<T> try_dequeue() {
+        std::optional<T> value;
+        try_consume([&](T& slot) { value.emplace(std::move(slot)); });
+        return value;
+    }
+
+    /**
+     * @brief Try to dequeue a single element into `out` (move-assigned)
+     *
+     * @param out Destination, left untouched if the queue is empty
+     * @return true if successful, false if queue is empty
+     */
+    bool try_dequeue(T& out) {
+        return try_consume([&](T& slot) { out = std::move(slot); });
+    }
+
+    /**
+     * @brief Invoke `consume(slot)` on the front element in place, then release its slot
+     *
+     * If `consume` throws, the element stays at the front of the queue.
+     *
+     * @param consume Callable taking `T&`; it may read the element or move from it
+     * @return true if an element was consumed, false if queue is empty
+     */
+    template <typename Consume>
+    bool try_consume(Consume&& consume) {
         const auto current_head = head_.load(std::memory_order_relaxed);
 
-        if (current_head == tail_.load(std::memory_order_acquire)) {
-            return std::nullopt; // Queue is empty
+        if (current_head == cached_tail_) {
+            // Cached tail says empty; refresh from the producer before giving up
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (current_head == cached_tail_) {
+                consumer_stats_.record_rejection();
+                return false; // Queue is empty
+            }
         }
 
-        T value = std::move(buffer_[current_head]);
+        consume(buffer_[current_head]);
         head_.store(increment(current_head), std::memory_order_release);
-        return value;
+        not_full_.notify();
+        consumer_stats_.record_success(1);
+        return true;
     }
 
     /**
@@ -372,64 +840,106 @@ private:
         if (count == 0) return 0;
 
         const auto current_head = head_.load(std::memory_order_relaxed);
-        const auto current_tail = tail_.load(std::memory_order_acquire);
 
-        // Calculate available elements
-        std::size_t available;
-        if (current_tail >= current_head) {
-            available = current_tail - current_head;
-        } else {
-            available = Capacity - current_head + current_tail;
+        // Calculate available elements, refreshing the cached tail only if it is insufficient
+        std::size_t available = used_space(current_head, cached_tail_);
+        if (available < count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            available = used_space(current_head, cached_tail_);
         }
 
         // Limit dequeue to available elements
-        std::size_t to_dequeue = (count < available) ? count : available;
+        const std::size_t to_dequeue = (count < available) ? count : available;
+        if (to_dequeue == 0) {
+            consumer_stats_.record_rejection();
+            return 0;
+        }
 
-        if (to_dequeue == 0) return 0;
+        // First segment runs to the end of the buffer, second wraps around to slot 0
+        const std::size_t first_segment = std::min(to_dequeue, capacity() - current_head);
+        move_out(data, &buffer_[current_head], first_segment);
+        move_out(data + first_segment, buffer_.data(), to_dequeue - first_segment);
 
-        std::size_t head_idx = current_head;
-        std::size_t dequeued = 0;
+        head_.store((current_head + to_dequeue) & mask(), std::memory_order_release);
+        not_full_.notify();
+        consumer_stats_.record_success(to_dequeue);
+        return to_dequeue;
+    }
 
-        // First segment: from current_head to end of buffer (or wrap point)
-        if (current_tail >= current_head) {
-            // Normal case: elements are contiguous from head to tail
-            std::size_t first_segment = std::min(to_dequeue, current_tail - head_idx);
-            for (std::size_t i = 0; i < first_segment; ++i) {
-                data[i] = std::move(buffer_[head_idx + i]);
-            }
-            head_idx += first_segment;
-            dequeued = first_segment;
-            to_dequeue -= first_segment;
-        } else {
-            // Wrap case: elements go from head to end, then from start to tail
-            std::size_t first_segment = std::min(to_dequeue, Capacity - head_idx);
-            for (std::size_t i = 0; i < first_segment; ++i) {
-                data[i] = std::move(buffer_[head_idx + i]);
-            }
-            head_idx = (head_idx + first_segment) & (Capacity - 1);
-            dequeued = first_segment;
-            to_dequeue -= first_segment;
+    /**
+     * @brief View all readable elements starting at the head
+     *
+     * @return Read-only region split into up to two segments at the wrap point
+     */
+    RingSpan<const T> peek() {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+
+        const std::size_t n = used_space(current_head, cached_tail_);
+        const std::size_t first = std::min(n, capacity() - current_head);
+        return {
+            Span<const T>(&buffer_[current_head], first), Span<const T>(buffer_.data(), n - first)
+        };
+    }
+
+    /**
+     * @brief Advance the head past `count` peeked elements with a single release store
+     *
+     * @param count Number of elements to release
+     */
+    void consume(std::size_t count) {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        head_.store((current_head + count) & mask(), std::memory_order_release);
+        not_full_.notify();
+        if (count != 0) consumer_stats_.record_success(count);
+    }
+
+    /**
+     * @brief Call `f(T&)` on up to `max` readable elements in place, releasing them in groups
+     *
+     * @return Number of elements visited
+     */
+    template <typename F>
+    std::size_t drain(F&& f, std::size_t max, std::size_t release_every) {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+
+        const std::size_t n = std::min(max, used_space(current_head, cached_tail_));
+        if (n == 0) {
+            consumer_stats_.record_rejection();
+            return 0;
         }
 
-        // Second segment: if we wrapped and still need elements
-        if (to_dequeue > 0 && head_idx == 0) {
-            std::size_t second_segment = std::min(to_dequeue, current_tail);
-            for (std::size_t i = 0; i < second_segment; ++i) {
-                data[dequeued + i] = std::move(buffer_[i]);
+        std::size_t visited = 0;
+        std::size_t released = 0;
+        auto visit = [&](T* slots, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                f(slots[i]);
+                if (++visited - released == release_every) {
+                    consume(release_every);
+                    released = visited;
+                }
             }
-            head_idx = second_segment;
-            dequeued += second_segment;
+        };
+        try {
+            // Up to two segments: from the head to the end of the buffer, then from the start
+            const std::size_t first = std::min(n, capacity() - current_head);
+            visit(&buffer_[current_head], first);
+            visit(buffer_.data(), n - first);
+        } catch (...) {
+            if (visited != released) consume(visited - released);
+            throw;
         }
-
-        head_.store(head_idx, std::memory_order_release);
-        return dequeued;
+        if (visited != released) consume(visited - released);
+        return n;
     }
 
     /**
      * @brief Block until an element can be enqueued with timeout
      *
      * Blocks the calling thread until the element is successfully enqueued or
-     * the timeout expires. Uses a busy-wait with yielding to minimize latency.
+     * the timeout expires. Waiting is delegated to the `Wait` strategy; the clock is
+     * not read at all when the first attempt succeeds.
      *
      * @tparam Rep The arithmetic type representing the timeout duration count
      * @tparam Period The `std::ratio` type representing the timeout duration period
@@ -439,21 +949,21 @@ private:
      */
     template <typename Rep, typename Period>
     bool enqueue(const T& value, std::chrono::duration<Rep, Period> timeout) {
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        while (!try_enqueue(value)) {
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return false;
-            }
-            std::this_thread::yield();
+        bool enqueued = try_enqueue(value);
+        if (!enqueued) {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            enqueued =
+                producer_stats_.wait_until(not_full_, [&] { return try_enqueue(value); }, deadline);
         }
-        return true;
+        flush();
+        return enqueued;
     }
 
     /**
      * @brief Block until an element can be enqueued with timeout (move semantics)
      *
      * Blocks the calling thread until the element is successfully enqueued or
-     * the timeout expires. Uses a busy-wait with yielding to minimize latency.
+     * the timeout expires. Waiting is delegated to the `Wait` strategy.
      *
      * @tparam Rep The arithmetic type representing the timeout duration count
      * @tparam Period The `std::ratio` type representing the timeout duration period
@@ -463,14 +973,15 @@ private:
      */
     template <typename Rep, typename Period>
     bool enqueue(T&& value, std::chrono::duration<Rep, Period> timeout) {
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        while (!try_enqueue(std::move(value))) {
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return false;
-            }
-            std::this_thread::yield();
+        bool enqueued = try_enqueue(std::move(value));
+        if (!enqueued) {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            enqueued = producer_stats_.wait_until(
+                not_full_, [&] { return try_enqueue(std::move(value)); }, deadline
+            );
         }
-        return true;
+        flush();
+        return enqueued;
     }
 
     /**
@@ -488,30 +999,26 @@ private:
      */
     template <typename Rep, typename Period>
     bool enqueue(const T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
-        if (count == 0) return true;
-
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        std::size_t total_enqueued = 0;
-        while (total_enqueued < count) {
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return false;
-            }
-
-            std::size_t enqueued = try_enqueue(data + total_enqueued, count - total_enqueued);
-            total_enqueued += enqueued;
-
-            if (total_enqueued < count) {
-                std::this_thread::yield();
-            }
-        }
-        return true;
+        flush(); // bulk writes publish themselves; this covers `count == 0`
+        std::size_t total_enqueued = try_enqueue(data, count);
+        if (total_enqueued == count) return true;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        return producer_stats_.wait_until(
+            not_full_,
+            [&] {
+                total_enqueued += try_enqueue(data + total_enqueued, count - total_enqueued);
+                return total_enqueued == count;
+            },
+            deadline
+        );
     }
 
     /**
      * @brief Block until an element can be dequeued with timeout
      *
      * Blocks the calling thread until an element is successfully dequeued or
-     * the timeout expires. Uses a busy-wait with yielding to minimize latency.
+     * the timeout expires. Waiting is delegated to the `Wait` strategy.
      *
      * @tparam Rep The arithmetic type representing the timeout duration count
      * @tparam Period The `std::ratio` type representing the timeout duration period
@@ -520,17 +1027,19 @@ private:
      */
     template <typename Rep, typename Period>
     std::optional<T> dequeue(std::chrono::duration<Rep, Period> timeout) {
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        while (true) {
-            auto value = try_dequeue();
-            if (value.has_value()) {
-                return value;
-            }
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return std::nullopt;
-            }
-            std::this_thread::yield();
-        }
+        std::optional<T> value = try_dequeue();
+        if (value.has_value()) return value;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        consumer_stats_.wait_until(
+            not_empty_,
+            [&] {
+                value = try_dequeue();
+                return value.has_value();
+            },
+            deadline
+        );
+        return value;
     }
 
     /**
@@ -548,22 +1057,18 @@ private:
      */
     template <typename Rep, typename Period>
     std::size_t dequeue(T* data, std::size_t count, std::chrono::duration<Rep, Period> timeout) {
-        if (count == 0) return 0;
-
-        auto deadline = std::chrono::steady_clock::now() + timeout;
-        std::size_t total_dequeued = 0;
-        while (total_dequeued < count) {
-            if (std::chrono::steady_clock::now() >= deadline) {
-                return total_dequeued;
-            }
-
-            std::size_t dequeued = try_dequeue(data + total_dequeued, count - total_dequeued);
-            total_dequeued += dequeued;
-
-            if (total_dequeued < count) {
-                std::this_thread::yield();
-            }
-        }
+        std::size_t total_dequeued = try_dequeue(data, count);
+        if (total_dequeued == count) return total_dequeued;
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        consumer_stats_.wait_until(
+            not_empty_,
+            [&] {
+                total_dequeued += try_dequeue(data + total_dequeued, count - total_dequeued);
+                return total_dequeued == count;
+            },
+            deadline
+        );
         return total_dequeued;
     }
 
@@ -584,19 +1089,41 @@ private:
     std::size_t size() const {
         const auto head = head_.load(std::memory_order_acquire);
         const auto tail = tail_.load(std::memory_order_acquire);
-        return (tail >= head) ? (tail - head) : (Capacity - head + tail);
+        return used_space(head, tail);
     }
 
+    QueueStats stats() const { return detail::make_stats(producer_stats_, consumer_stats_); }
+
+    // qbuf/coro.hpp reaches the wait objects and occupancy checks through this
+    friend struct detail::AsyncAccess<SPSC>;
+
+    // Each index and its opposite side's cached copy live on separate cache lines. The producer
+    // owns `tail_` and `cached_head_`; the consumer owns `head_` and `cached_tail_`. The shared
+    // index is only reloaded when the cached copy says the queue is full (or empty).
     alignas(64) std::atomic<std::size_t> head_;
+    alignas(64) std::size_t cached_tail_; // consumer-local copy of tail_
     alignas(64) std::atomic<std::size_t> tail_;
-    std::array<T, Capacity> buffer_;
+    alignas(64) std::size_t cached_head_; // producer-local copy of head_
+    // Producer-local deferred publish state: writes past `tail_` and when to publish them
+    std::size_t unpublished_;
+    std::size_t publish_every_;
+    std::chrono::nanoseconds publish_delay_;
+    std::chrono::steady_clock::time_point first_unpublished_;
+    // Waiting producers park on `not_full_`, waiting consumers on `not_empty_`
+    alignas(64) Wait not_full_;
+    alignas(64) Wait not_empty_;
+    // Written only by the producer / only by the consumer; each on its own cache line when
+    // QBUF_STATS is defined, empty otherwise
+    detail::StatsCounters producer_stats_;
+    detail::StatsCounters consumer_stats_;
+    alignas(64) Buffer buffer_;
 };
 
-template <typename T, std::size_t Capacity>
-using SpscSource = typename SPSC<T, Capacity>::Source;
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using SpscSource = typename SPSC<T, Capacity, Wait>::Source;
 
-template <typename T, std::size_t Capacity>
-using SpscSink = typename SPSC<T, Capacity>::Sink;
+template <typename T, std::size_t Capacity, typename Wait = YieldWait>
+using SpscSink = typename SPSC<T, Capacity, Wait>::Sink;
 
 } // namespace qbuf
 #endif // QBUF_SPSC_HPP
@@ -0,0 +1,188 @@
+#ifndef QBUF_STATS_HPP
+#define QBUF_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace qbuf {
+
+/**
+ * @brief Number of batch size buckets in `SideStats::batch_sizes`
+ *
+ * Bucket `i` counts calls that moved between `2^i` and `2^(i+1) - 1` elements; the last bucket
+ * also holds everything larger.
+ */
+inline constexpr std::size_t stats_batch_buckets = 16;
+
+/**
+ * @brief Counters for one side (producer or consumer) of a queue
+ */
+struct SideStats {
+    std::uint64_t calls = 0;           ///< Successful calls; each moved at least one element
+    std::uint64_t elements = 0;        ///< Elements moved by those calls
+    std::uint64_t rejections = 0;      ///< Attempts that found the queue full / empty
+    std::uint64_t wait_iterations = 0; ///< Retries (wake-ups for MutexQueue) in blocking calls
+    std::uint64_t wait_ns = 0;         ///< Time spent waiting in blocking calls
+    std::array<std::uint64_t, stats_batch_buckets> batch_sizes {}; ///< Log2 histogram per call
+};
+
+/**
+ * @brief Snapshot returned by `Sink::stats()` / `Source::stats()`
+ *
+ * Counters are only maintained when the library is built with `QBUF_STATS` defined; otherwise
+ * `enabled` is false and every counter reads zero. The snapshot is not atomic as a whole: each
+ * counter is read once, while the owning side may still be updating the others.
+ *
+ * `QBUF_STATS` changes the layout of the queue classes, so it must be defined the same way in
+ * every translation unit of a program. MmapSPSC keeps them outside the shared control block.
+ */
+struct QueueStats {
+    bool enabled = false;
+    SideStats producer;
+    SideStats consumer;
+    std::uint64_t high_water_mark = 0; ///< Highest occupancy seen by the producer after a publish
+};
+
+namespace detail {
+
+#if defined(QBUF_STATS)
+inline constexpr bool stats_enabled = true;
+
+/**
+ * @brief Live counters for one side of a queue, on a cache line of their own
+ *
+ * Each instance has a single writer (the owning side, or whoever holds MutexQueue's lock), so
+ * updates are a relaxed load and store rather than a read-modify-write; readers on other
+ * threads see every counter tear-free.
+ */
+class alignas(64) StatsCounters {
+public:
+    /// One call moved `count` (> 0) elements
+    void record_success(std::size_t count) noexcept {
+        add(calls_, 1);
+        add(elements_, count);
+        add(batch_sizes_[bucket(count)], 1);
+    }
+
+    void record_rejection() noexcept { add(rejections_, 1); }
+
+    void record_occupancy(std::size_t used) noexcept {
+        if (used > high_water_mark_.load(std::memory_order_relaxed)) {
+            high_water_mark_.store(used, std::memory_order_relaxed);
+        }
+    }
+
+    /// Run a wait strategy's `wait_until`, counting retries and the time spent inside
+    template <typename Wait, typename Ready, typename Clock, typename Duration>
+    bool wait_until(Wait& wait, Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        const auto start = std::chrono::steady_clock::now();
+        std::uint64_t iterations = 0;
+        const bool result = wait.wait_until(
+            [&] {
+                ++iterations;
+                return ready();
+            },
+            deadline
+        );
+        record_wait(iterations, start);
+        return result;
+    }
+
+    /// Run one blocking wait step (e.g. a condition variable wait) and count it
+    template <typename F>
+    auto timed_wait(F&& wait) {
+        const auto start = std::chrono::steady_clock::now();
+        auto result = wait();
+        record_wait(1, start);
+        return result;
+    }
+
+    SideStats snapshot() const noexcept {
+        SideStats stats;
+        stats.calls = calls_.load(std::memory_order_relaxed);
+        stats.elements = elements_.load(std::memory_order_relaxed);
+        stats.rejections = rejections_.load(std::memory_order_relaxed);
+        stats.wait_iterations = wait_iterations_.load(std::memory_order_relaxed);
+        stats.wait_ns = wait_ns_.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < stats_batch_buckets; ++i) {
+            stats.batch_sizes[i] = batch_sizes_[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    std::uint64_t high_water_mark() const noexcept {
+        return high_water_mark_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t n) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static std::size_t bucket(std::size_t count) noexcept {
+        std::size_t i = 0;
+        while (i + 1 < stats_batch_buckets && (count >> (i + 1)) != 0) ++i;
+        return i;
+    }
+
+    void record_wait(std::uint64_t iterations, std::chrono::steady_clock::time_point start) {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        add(wait_iterations_, iterations);
+        add(wait_ns_, static_cast<std::uint64_t>(ns));
+    }
+
+    std::atomic<std::uint64_t> calls_ { 0 };
+    std::atomic<std::uint64_t> elements_ { 0 };
+    std::atomic<std::uint64_t> rejections_ { 0 };
+    std::atomic<std::uint64_t> wait_iterations_ { 0 };
+    std::atomic<std::uint64_t> wait_ns_ { 0 };
+    std::atomic<std::uint64_t> high_water_mark_ { 0 };
+    std::array<std::atomic<std::uint64_t>, stats_batch_buckets> batch_sizes_ {};
+};
+#else
+inline constexpr bool stats_enabled = false;
+
+/**
+ * @brief Stand-in used without `QBUF_STATS`: every call compiles away
+ */
+class StatsCounters {
+public:
+    void record_success(std::size_t) noexcept { }
+    void record_rejection() noexcept { }
+    void record_occupancy(std::size_t) noexcept { }
+
+    template <typename Wait, typename Ready, typename Clock, typename Duration>
+    bool wait_until(Wait& wait, Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        return wait.wait_until(std::forward<Ready>(ready), deadline);
+    }
+
+    template <typename F>
+    auto timed_wait(F&& wait) {
+        return wait();
+    }
+
+    SideStats snapshot() const noexcept { return { }; }
+    std::uint64_t high_water_mark() const noexcept { return 0; }
+};
+#endif
+
+/**
+ * @brief Assemble a `QueueStats` snapshot from the two sides' counters
+ */
+inline QueueStats make_stats(const StatsCounters& producer, const StatsCounters& consumer) {
+    QueueStats stats;
+    stats.enabled = stats_enabled;
+    stats.producer = producer.snapshot();
+    stats.consumer = consumer.snapshot();
+    stats.high_water_mark = producer.high_water_mark();
+    return stats;
+}
+
+} // namespace detail
+} // namespace qbuf
+#endif // QBUF_STATS_HPP
@@ -0,0 +1,295 @@
+#ifndef QBUF_THREAD_POOL_HPP
+#define QBUF_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <qbuf/mutex_queue.hpp>
+#include <qbuf/ws_deque.hpp>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace qbuf {
+
+/**
+ * @brief Reference work-stealing scheduler: one WsDeque per worker plus a shared injection queue
+ *
+ * Tasks submitted from inside a task (fork) go to the calling worker's own deque, where the
+ * worker pops them newest first and other workers steal them oldest first. Tasks submitted from
+ * any other thread go to a `MutexQueue` injection queue that every worker drains when its own
+ * deque runs dry, before it tries to steal. A worker that finds no task for a while parks in a
+ * timed dequeue on the injection queue, so an external submission wakes it at once and stealable
+ * work is picked up within `idle_timeout`.
+ *
+ * Each task is one heap-allocated `std::function<void()>`. An exception thrown by a task is
+ * caught on its worker; the first one is kept and rethrown by the next `wait_idle()`, later ones
+ * are dropped. When a worker's deque is full the forked task runs inline instead, and a full
+ * injection queue blocks the submitting thread until a worker makes room.
+ */
+class ThreadPool {
+public:
+    /** @brief Maximum number of tasks queued in each worker's deque */
+    static constexpr std::size_t deque_capacity = 4096;
+    /** @brief Maximum number of externally submitted tasks waiting to be picked up */
+    static constexpr std::size_t injection_capacity = 4096;
+    /** @brief Failed searches an idle worker spends yielding before it parks */
+    static constexpr int spin_rounds = 64;
+    /** @brief Longest a parked worker sleeps before looking for stealable work again */
+    static constexpr std::chrono::microseconds idle_timeout { 100 };
+
+    /**
+     * @brief Start the worker threads
+     *
+     * @param workers Number of worker threads (default: one per hardware thread)
+     * @throws std::invalid_argument if `workers` is 0
+     */
+    explicit ThreadPool(std::size_t workers = default_workers())
+        : pending_(0), injected_(0), stopping_(false) {
+        if (workers == 0) {
+            throw std::invalid_argument("ThreadPool needs at least one worker");
+        }
+        auto [sink, source] = Injection::make_queue();
+        injection_sink_ = std::make_unique<InjectionSink>(std::move(sink));
+        injection_source_ = std::make_unique<InjectionSource>(std::move(source));
+
+        // Every deque exists before the first worker goes looking for a victim
+        workers_.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            auto [owner, stealer] = Deque::make_queue();
+            workers_.push_back(std::make_unique<Worker>(std::move(owner), std::move(stealer)));
+        }
+        for (std::size_t i = 0; i < workers; ++i) {
+            workers_[i]->thread = std::thread([this, i]() { work(i); });
+        }
+    }
+
+    /**
+     * @brief Wait for every submitted task to finish, then stop and join the workers
+     *
+     * No task may be submitted from another thread once destruction has begun. A pool cannot
+     * join the thread it runs on, so destroying it from one of its own tasks terminates the
+     * program instead of deadlocking. A task exception not yet collected by `wait_idle()` is
+     * discarded.
+     */
+    ~ThreadPool() {
+        if (current_pool_ == this) std::terminate();
+        wait_pending();
+        stopping_.store(true, std::memory_order_release);
+        for (auto& worker : workers_) worker->thread.join();
+    }
+
+    // non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    // non-movable
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * @brief Schedule a task
+     *
+     * From one of this pool's workers the task is pushed on that worker's deque (or run inline
+     * if the deque is full); from any other thread it goes through the injection queue.
+     *
+     * @param task Callable invoked as `task()` on some worker
+     */
+    template <typename F>
+    void submit(F&& task) {
+        auto* boxed = new Task(std::forward<F>(task));
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        if (current_pool_ == this) {
+            if (!workers_[current_index_]->owner.push(boxed)) run(boxed);
+            return;
+        }
+        injected_.fetch_add(1, std::memory_order_relaxed);
+        while (!injection_sink_->enqueue(boxed, std::chrono::milliseconds(1))) { }
+    }
+
+    /**
+     * @brief Block until every submitted task, including tasks they forked, has finished
+     *
+     * Must not be called from a task; use `wait_until()` to join inside a task.
+     *
+     * @throws std::logic_error if called from one of this pool's tasks
+     * @throws Any exception thrown by a task since the previous `wait_idle()` (the first one)
+     */
+    void wait_idle() {
+        if (current_pool_ == this) {
+            throw std::logic_error("ThreadPool::wait_idle() called from one of its own tasks");
+        }
+        wait_pending();
+        std::exception_ptr error;
+        {
+            std::scoped_lock lk(idle_mutex_);
+            error = std::exchange(error_, nullptr);
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    /**
+     * @brief Wait until `done()` returns true
+     *
+     * On a worker of this pool, runs other tasks while waiting, so a task can join the children
+     * it forked without holding its worker hostage. Elsewhere, yields between checks.
+     *
+     * @param done Predicate polled between tasks
+     */
+    template <typename Predicate>
+    void wait_until(Predicate&& done) {
+        while (!done()) {
+            Task* task = (current_pool_ == this) ? find_task(current_index_) : nullptr;
+            if (task != nullptr) {
+                run(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of worker threads
+     *
+     * @return Number of workers
+     */
+    std::size_t workers() const { return workers_.size(); }
+
+    /**
+     * @brief Get the number of tasks submitted but not yet finished
+     *
+     * @return Approximate number of pending tasks
+     */
+    std::size_t pending() const { return pending_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Default number of workers: one per hardware thread, at least one
+     *
+     * @return `std::thread::hardware_concurrency()`, or 1 if unknown
+     */
+    static std::size_t default_workers() {
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+private:
+    using Task = std::function<void()>;
+    using Deque = WsDeque<Task*, deque_capacity>;
+    using Injection = MutexQueue<Task*, injection_capacity>;
+    using InjectionSink = Injection::Sink;
+    using InjectionSource = Injection::Source;
+
+    struct Worker {
+        Worker(Deque::Owner owner, Deque::Stealer stealer)
+            : owner(std::move(owner)), stealer(std::move(stealer)) { }
+
+        Deque::Owner owner; // used by this worker only
+        Deque::Stealer stealer; // used by every other worker
+        std::thread thread;
+    };
+
+    void work(std::size_t index) {
+        current_pool_ = this;
+        current_index_ = index;
+        int idle_rounds = 0;
+        while (!stopping_.load(std::memory_order_acquire)) {
+            Task* task = find_task(index);
+            if (task == nullptr) {
+                if (++idle_rounds < spin_rounds) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                task = take_injected(idle_timeout);
+                if (task == nullptr) continue;
+            }
+            idle_rounds = 0;
+            run(task);
+        }
+        current_pool_ = nullptr;
+    }
+
+    // Own deque first (newest, still in cache), then external submissions, then the oldest task
+    // of each other worker, starting at a random victim
+    Task* find_task(std::size_t index) {
+        if (auto task = workers_[index]->owner.pop()) return *task;
+        if (Task* task = take_injected()) return task;
+
+        const std::size_t count = workers_.size();
+        const std::size_t start = next_random() % count;
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t victim = (start + i) % count;
+            if (victim == index) continue;
+            if (auto task = workers_[victim]->stealer.steal()) return *task;
+        }
+        return nullptr;
+    }
+
+    // `injected_` lets idle workers skip the injection queue's mutex while it is empty
+    Task* take_injected() {
+        if (injected_.load(std::memory_order_relaxed) == 0) return nullptr;
+        auto task = injection_source_->try_dequeue();
+        if (!task) return nullptr;
+        injected_.fetch_sub(1, std::memory_order_relaxed);
+        return *task;
+    }
+
+    template <typename Rep, typename Period>
+    Task* take_injected(std::chrono::duration<Rep, Period> timeout) {
+        auto task = injection_source_->dequeue(timeout);
+        if (!task) return nullptr;
+        injected_.fetch_sub(1, std::memory_order_relaxed);
+        return *task;
+    }
+
+    void wait_pending() {
+        std::unique_lock lk(idle_mutex_);
+        idle_cv_.wait(lk, [this]() { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+
+    // A throwing task still counts as finished; only its first exception is kept
+    void run(Task* task) {
+        try {
+            (*task)();
+        } catch (...) {
+            std::scoped_lock lk(idle_mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+        delete task;
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::scoped_lock lk(idle_mutex_);
+            idle_cv_.notify_all();
+        }
+    }
+
+    // xorshift64 per thread: victim selection only needs to spread thieves apart
+    static std::uint64_t next_random() {
+        static thread_local std::uint64_t state =
+            0x9E3779B97F4A7C15ull ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    static inline thread_local ThreadPool* current_pool_ = nullptr;
+    static inline thread_local std::size_t current_index_ = 0;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unique_ptr<InjectionSink> injection_sink_;
+    std::unique_ptr<InjectionSource> injection_source_;
+    std::atomic<std::size_t> pending_;
+    std::atomic<std::size_t> injected_;
+    std::atomic<bool> stopping_;
+    std::mutex idle_mutex_; // also guards `error_`
+    std::condition_variable idle_cv_;
+    std::exception_ptr error_;
+};
+
+} // namespace qbuf
+#endif // QBUF_THREAD_POOL_HPP
@@ -0,0 +1,351 @@
+#ifndef QBUF_WAIT_HPP
+#define QBUF_WAIT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace qbuf {
+
+namespace detail {
+
+/**
+ * @brief Hint to the CPU that the caller is in a spin-wait loop
+ *
+ * Emits `pause` on x86 and `yield` on AArch64; a no-op elsewhere.
+ */
+inline void cpu_relax() noexcept {
+#if defined(__SSE2__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+#if defined(__linux__)
+/**
+ * @brief Sleep on `word` while it still holds `expected`, for at most `timeout`
+ *
+ * @param shared Use a process-shared futex (the word lives in memory mapped by several processes)
+ */
+inline void futex_wait(
+    std::atomic<std::uint32_t>& word, std::uint32_t expected, std::chrono::nanoseconds timeout,
+    bool shared
+) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    const int op = shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE;
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, expected, &ts, nullptr, 0);
+}
+
+/**
+ * @brief Wake every thread sleeping on `word`
+ *
+ * @param shared Must match the `shared` flag the waiters used
+ */
+inline void futex_wake_all(std::atomic<std::uint32_t>& word, bool shared) {
+    const int op = shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE;
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+// Coroutine support, defined in qbuf/coro.hpp (C++20). Declared here so the C++17 queue handles
+// can name the awaiters returned by `async_enqueue()` / `async_dequeue()`.
+template <typename Queue>
+struct AsyncAccess;
+template <typename Queue>
+class EnqueueAwaiter;
+template <typename Queue>
+class DequeueAwaiter;
+
+} // namespace detail
+
+/**
+ * @brief Wait strategy that yields the time slice between attempts
+ *
+ * Matches the historical behavior of the blocking queue APIs and is the default strategy.
+ *
+ * A wait strategy provides two operations. `wait_until(ready, deadline)` retries `ready()` until
+ * it returns true (returns true) or `deadline` passes (returns the result of a final attempt).
+ * `notify()` is called by the opposite side after every publish and must be cheap when nobody
+ * waits. Queues hold one strategy object per direction (not full / not empty).
+ * `process_shared` tells whether the strategy still works when the object lives in memory shared
+ * between processes (see `MmapSPSC::create_shared()`).
+ */
+struct YieldWait {
+    static constexpr bool process_shared = true;
+
+    template <typename Ready, typename Clock, typename Duration>
+    bool wait_until(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        while (!ready()) {
+            if (Clock::now() >= deadline) return ready();
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    void notify() noexcept { }
+};
+
+/**
+ * @brief Wait strategy that spins on the CPU with `pause` hints and never enters the kernel
+ *
+ * Lowest wake-up latency at the cost of a fully busy core. The clock is only read once per
+ * `SpinsPerCheck` attempts.
+ *
+ * @tparam SpinsPerCheck Number of attempts between deadline checks
+ */
+template <std::size_t SpinsPerCheck = 64>
+struct BasicSpinWait {
+    static constexpr bool process_shared = true;
+
+    template <typename Ready, typename Clock, typename Duration>
+    bool wait_until(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        while (true) {
+            for (std::size_t i = 0; i < SpinsPerCheck; ++i) {
+                if (ready()) return true;
+                detail::cpu_relax();
+            }
+            if (Clock::now() >= deadline) return ready();
+        }
+    }
+
+    void notify() noexcept { }
+};
+
+using SpinWait = BasicSpinWait<>;
+
+/**
+ * @brief Wait strategy with exponential backoff: `pause` spins, then yields, then short sleeps
+ *
+ * Each round doubles the number of `pause` hints up to `2^SpinRounds`, then yields for
+ * `YieldRounds` rounds, then sleeps for a growing interval capped at `MaxSleepUs`. The clock is
+ * read once per round.
+ *
+ * @tparam SpinRounds Rounds spent spinning before yielding
+ * @tparam YieldRounds Rounds spent yielding before sleeping
+ * @tparam MaxSleepUs Upper bound for a single sleep, in microseconds
+ */
+template <
+    std::size_t SpinRounds = 10, std::size_t YieldRounds = 8, std::size_t MaxSleepUs = 1000>
+struct BasicBackoffWait {
+    static constexpr bool process_shared = true;
+
+    template <typename Ready, typename Clock, typename Duration>
+    bool wait_until(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        for (std::size_t round = 0;; ++round) {
+            if (ready()) return true;
+            const auto now = Clock::now();
+            if (now >= deadline) return ready();
+
+            if (round < SpinRounds) {
+                for (std::size_t i = 0; i < (std::size_t(1) << round); ++i) detail::cpu_relax();
+            } else if (round < SpinRounds + YieldRounds) {
+                std::this_thread::yield();
+            } else {
+                const std::size_t sleep_round = round - SpinRounds - YieldRounds;
+                const std::size_t shift = std::min<std::size_t>(sleep_round, 10);
+                const auto sleep = std::chrono::duration_cast<typename Clock::duration>(
+                    std::chrono::microseconds(std::min(MaxSleepUs, std::size_t(1) << shift))
+                );
+                std::this_thread::sleep_for(std::min(deadline - now, sleep));
+            }
+        }
+    }
+
+    void notify() noexcept { }
+};
+
+using BackoffWait = BasicBackoffWait<>;
+
+/**
+ * @brief Wait strategy that spins briefly, then parks the thread on a futex
+ *
+ * A parked waiter advertises itself in `waiters_` and sleeps on `epoch_`. `notify()` only
+ * enters the kernel when it sees a waiter, so the uncontended publish path costs a fence and a
+ * relaxed load but no syscall. On non-Linux platforms parking degrades to short sleeps.
+ *
+ * @tparam SpinCount Attempts (with `pause` hints) before parking
+ * @tparam ProcessShared Use process-shared futexes, required when the queue's control block is
+ * mapped by several processes; private futexes are cheaper otherwise
+ */
+template <std::size_t SpinCount = 1024, bool ProcessShared = false>
+class BasicParkingWait {
+public:
+    static constexpr bool process_shared = ProcessShared;
+
+    template <typename Ready, typename Clock, typename Duration>
+    bool wait_until(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        for (std::size_t i = 0; i < SpinCount; ++i) {
+            if (ready()) return true;
+            detail::cpu_relax();
+        }
+
+        while (true) {
+            const std::uint32_t epoch = epoch_.load(std::memory_order_acquire);
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+            // Pairs with the fence in notify(): either we see the publish or it sees us
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (ready()) {
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            const auto now = Clock::now();
+            if (now >= deadline) {
+                waiters_.fetch_sub(1, std::memory_order_relaxed);
+                return ready();
+            }
+
+            const auto remaining =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+#if defined(__linux__)
+            detail::futex_wait(epoch_, epoch, remaining, ProcessShared);
+#else
+            (void)epoch;
+            std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+                remaining, std::chrono::microseconds(50)
+            ));
+#endif
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void notify() noexcept {
+        // Order the caller's publish before the waiter check (see wait_until)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) return;
+
+        epoch_.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+        detail::futex_wake_all(epoch_, ProcessShared);
+#endif
+    }
+
+private:
+    std::atomic<std::uint32_t> epoch_ { 0 };
+    std::atomic<std::uint32_t> waiters_ { 0 };
+};
+
+using ParkingWait = BasicParkingWait<>;
+using SharedParkingWait = BasicParkingWait<1024, true>;
+
+#if defined(__linux__)
+/**
+ * @brief Wait strategy backed by an eventfd, so a waiter can sleep in its own poll/epoll loop
+ *
+ * `native_handle()` becomes readable when the opposite side publishes while the waiter is armed.
+ * `arm(ready)` clears the descriptor, raises the armed flag and rechecks `ready()`; `notify()`
+ * only writes to the descriptor when it finds the flag raised and takes it down, so only the
+ * first publish after the waiter found the queue empty pays for a syscall. Wakeups may be
+ * spurious: retry the queue and re-arm. The blocking calls follow the same protocol with
+ * `poll()`.
+ *
+ * @tparam SpinCount Attempts (with `pause` hints) before the blocking calls poll the descriptor
+ * @tparam ProcessShared Create the descriptor without `EFD_CLOEXEC`, for control blocks shared
+ * with child processes. The control block stores the descriptor number, so the other processes
+ * must inherit it at the same number, e.g. by forking after `create_shared()`.
+ * @throws std::runtime_error from the constructor if the eventfd cannot be created
+ */
+template <std::size_t SpinCount = 1024, bool ProcessShared = false>
+class BasicEventFdWait {
+public:
+    static constexpr bool process_shared = ProcessShared;
+
+    BasicEventFdWait() : fd_(eventfd(0, EFD_NONBLOCK | (ProcessShared ? 0 : EFD_CLOEXEC))) {
+        if (fd_ == -1) throw std::runtime_error("Failed to create eventfd");
+    }
+
+    ~BasicEventFdWait() { close(fd_); }
+
+    // Owns the descriptor
+    BasicEventFdWait(const BasicEventFdWait&) = delete;
+    BasicEventFdWait& operator=(const BasicEventFdWait&) = delete;
+
+    /**
+     * @brief Descriptor to register with poll/epoll/select for `POLLIN`
+     */
+    int native_handle() const noexcept { return fd_; }
+
+    /**
+     * @brief Prepare to sleep on `native_handle()`
+     *
+     * @return true if the caller may sleep until the descriptor is readable, false if `ready()`
+     * already holds (the flag is taken down again)
+     */
+    template <typename Ready>
+    bool arm(Ready&& ready) {
+        std::uint64_t count;
+        [[maybe_unused]] const auto drained = read(fd_, &count, sizeof(count));
+        armed_.store(1, std::memory_order_relaxed);
+        // Pairs with the fence in notify(): either we see the publish or it sees the flag
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready()) return true;
+        armed_.store(0, std::memory_order_relaxed);
+        return false;
+    }
+
+    template <typename Ready, typename Clock, typename Duration>
+    bool wait_until(Ready&& ready, std::chrono::time_point<Clock, Duration> deadline) {
+        for (std::size_t i = 0; i < SpinCount; ++i) {
+            if (ready()) return true;
+            detail::cpu_relax();
+        }
+
+        while (arm(ready)) {
+            const auto now = Clock::now();
+            if (now >= deadline) {
+                armed_.store(0, std::memory_order_relaxed);
+                return ready();
+            }
+            // Round up so a short remainder does not turn into a busy loop
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+            const auto timeout = std::min<std::chrono::milliseconds::rep>(
+                remaining.count(), INT_MAX
+            );
+            pollfd entry { fd_, POLLIN, 0 };
+            poll(&entry, 1, static_cast<int>(timeout));
+        }
+        return true;
+    }
+
+    void notify() noexcept {
+        // Order the caller's publish before the flag check (see arm)
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (armed_.load(std::memory_order_relaxed) == 0) return;
+        if (armed_.exchange(0, std::memory_order_relaxed) == 0) return;
+
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = write(fd_, &one, sizeof(one));
+    }
+
+private:
+    int fd_;
+    std::atomic<std::uint32_t> armed_ { 0 };
+};
+
+using EventFdWait = BasicEventFdWait<>;
+using SharedEventFdWait = BasicEventFdWait<1024, true>;
+#endif
+
+} // namespace qbuf
+#endif // QBUF_WAIT_HPP
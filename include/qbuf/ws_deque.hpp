@@ -0,0 +1,253 @@
+#ifndef QBUF_WS_DEQUE_HPP
+#define QBUF_WS_DEQUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace qbuf {
+
+/**
+ * @brief Bounded Chase-Lev work-stealing deque
+ *
+ * The owner thread pushes and pops at the bottom like a stack (most recently pushed first,
+ * which keeps its working set in cache); any number of thieves steal the oldest element at the
+ * top. The owner's push and its pop of all but the last element touch only `bottom_` and plain
+ * slot stores; taking the last element and every steal race with one CAS on `top_`. Memory
+ * orderings follow the C11 formulation of Lê, Pop, Cohen and Zappa Nardelli, "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * A thief reads its slot before the CAS that claims it, so the owner may be overwriting that
+ * slot at the same time; slots are therefore `std::atomic<T>`, and `T` must be trivially
+ * copyable and lock-free as an atomic (pointers, indices, small handles). Unlike the original
+ * algorithm the buffer does not grow: `push()` fails when `Capacity` elements are queued.
+ *
+ * @tparam T The type of elements stored in the deque (typically a task pointer)
+ * @tparam Capacity Maximum number of elements the deque can hold (power of two)
+ */
+template <typename T, std::size_t Capacity>
+class WsDeque {
+public:
+    static_assert(Capacity > 1, "Deque capacity must be greater than 1");
+    static_assert((Capacity & (Capacity - 1)) == 0, "Deque capacity must be a power of 2");
+    static_assert(std::is_trivially_copyable_v<T>, "WsDeque requires a trivially copyable type");
+    static_assert(std::atomic<T>::is_always_lock_free, "WsDeque requires a lock-free atomic<T>");
+
+private:
+    WsDeque() : top_(0), bottom_(0) { }
+
+public:
+    // non-copyable
+    WsDeque(const WsDeque&) = delete;
+    WsDeque& operator=(const WsDeque&) = delete;
+    // non-movable
+    WsDeque(WsDeque&&) = delete;
+    WsDeque& operator=(WsDeque&&) = delete;
+
+    /**
+     * @brief Owner-side handle: push and pop at the bottom
+     *
+     * Intended for use by the single owner thread.
+     */
+    class Owner {
+    private:
+        friend class WsDeque;
+        explicit Owner(std::shared_ptr<WsDeque> deque) : deque_(std::move(deque)) { }
+
+    public:
+        // Non-copyable
+        Owner(const Owner&) = delete;
+        Owner& operator=(const Owner&) = delete;
+
+        // Movable
+        Owner(Owner&&) = default;
+        Owner& operator=(Owner&&) = default;
+
+        /**
+         * @brief Push an element at the bottom
+         *
+         * @param value The value to push
+         * @return true if successful, false if the deque is full
+         */
+        bool push(const T& value) { return deque_->push(value); }
+
+        /**
+         * @brief Pop the most recently pushed element from the bottom
+         *
+         * @return std::optional containing the value if successful, std::nullopt if the deque is
+         * empty (or a thief took the last element)
+         */
+        std::optional<T> pop() { return deque_->pop(); }
+
+        /**
+         * @brief Check if the deque is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return deque_->size() == 0; }
+
+        /**
+         * @brief Get approximate size of the deque
+         *
+         * @return Approximate number of elements in the deque
+         */
+        std::size_t size() const { return deque_->size(); }
+
+        /**
+         * @brief Get the maximum number of elements the deque can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<WsDeque> deque_;
+    };
+
+    /**
+     * @brief Thief-side handle: steal from the top
+     *
+     * Copyable: every thief thread may hold its own copy.
+     */
+    class Stealer {
+    private:
+        friend class WsDeque;
+        explicit Stealer(std::shared_ptr<WsDeque> deque) : deque_(std::move(deque)) { }
+
+    public:
+        // Copyable
+        Stealer(const Stealer&) = default;
+        Stealer& operator=(const Stealer&) = default;
+
+        // Movable
+        Stealer(Stealer&&) = default;
+        Stealer& operator=(Stealer&&) = default;
+
+        /**
+         * @brief Steal the oldest element from the top
+         *
+         * Does not retry: losing the race to another thief (or to the owner popping the last
+         * element) also returns std::nullopt, so schedulers can move on to the next victim.
+         *
+         * @return std::optional containing the value if successful, std::nullopt if the deque
+         * was empty or the race was lost
+         */
+        std::optional<T> steal() { return deque_->steal(); }
+
+        /**
+         * @brief Check if the deque is empty
+         *
+         * @return true if empty, false otherwise
+         */
+        bool empty() const { return deque_->size() == 0; }
+
+        /**
+         * @brief Get approximate size of the deque
+         *
+         * @return Approximate number of elements in the deque
+         */
+        std::size_t size() const { return deque_->size(); }
+
+        /**
+         * @brief Get the maximum number of elements the deque can hold
+         *
+         * @return `Capacity`
+         */
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        std::shared_ptr<WsDeque> deque_;
+    };
+
+    /**
+     * @brief Factory method to create a deque with its owner and a stealer handle
+     *
+     * Copy the Stealer to hand one to each thief.
+     *
+     * @return std::pair<Owner, Stealer> The owner handle and a thief handle
+     */
+    static std::pair<Owner, Stealer> make_queue() {
+        std::shared_ptr<WsDeque> deque(new WsDeque());
+        return { Owner(deque), Stealer(deque) };
+    }
+
+private:
+    static constexpr std::int64_t mask = static_cast<std::int64_t>(Capacity - 1);
+
+    bool push(const T& value) {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<std::int64_t>(Capacity)) return false;
+
+        slots_[bottom & mask].store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::optional<T> pop() {
+        // Claim the bottom slot first, then look at the top: thieves that read `bottom_` after
+        // the fence see the claim and back off
+        const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed); // was empty
+            return std::nullopt;
+        }
+        std::optional<T> value = slots_[bottom & mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last element: settle the race with thieves on `top_`
+            if (!top_.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+                )) {
+                value.reset();
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    std::optional<T> steal() {
+        auto top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) return std::nullopt;
+
+        const T value = slots_[top & mask].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(
+                top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+            )) {
+            return std::nullopt; // another thief, or the owner's pop of the last element, won
+        }
+        return value;
+    }
+
+    std::size_t size() const {
+        const auto bottom = bottom_.load(std::memory_order_acquire);
+        const auto top = top_.load(std::memory_order_acquire);
+        return (bottom > top) ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    // Thieves contend on `top_`; only the owner writes `bottom_`. Signed, since `pop()` may take
+    // `bottom_` one below `top_` on an empty deque.
+    alignas(64) std::atomic<std::int64_t> top_;
+    alignas(64) std::atomic<std::int64_t> bottom_;
+    alignas(64) std::array<std::atomic<T>, Capacity> slots_;
+};
+
+template <typename T, std::size_t Capacity>
+using WsOwner = typename WsDeque<T, Capacity>::Owner;
+
+template <typename T, std::size_t Capacity>
+using WsStealer = typename WsDeque<T, Capacity>::Stealer;
+
+} // namespace qbuf
+#endif // QBUF_WS_DEQUE_HPP
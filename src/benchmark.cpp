@@ -1,18 +1,108 @@
+#include <array>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <qbuf/broadcast.hpp>
+#include <qbuf/byte_spsc.hpp>
+#include <qbuf/mesh.hpp>
 #include <qbuf/mmap_spsc.hpp>
+#include <qbuf/mpmc.hpp>
+#include <qbuf/mpsc.hpp>
 #include <qbuf/mutex_queue.hpp>
+#include <qbuf/pool.hpp>
+#include <qbuf/queue.hpp>
 #include <qbuf/spsc.hpp>
+#include <qbuf/thread_pool.hpp>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace qbuf;
 
+// Where benchmark threads and queue memory go (--producer-cpu, --consumer-cpu, --numa-node);
+// -1 leaves the choice to the OS. Applies to the one-producer/one-consumer runs.
+struct Placement {
+    int producer_cpu = -1;
+    int consumer_cpu = -1;
+    int numa_node = -1;
+};
+
+Placement placement;
+
+// Pin the calling thread to `cpu` (no-op for -1)
+void pin_to_cpu(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "Warning: Failed to pin thread to CPU " << cpu << std::endl;
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+// CPUs this process may run on, in ascending order
+std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+#endif
+    for (unsigned cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+        cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+// Buffer options for the dynamic-capacity runs, carrying --numa-node
+BufferOptions buffer_options() {
+    BufferOptions options;
+    options.numa_node = placement.numa_node;
+    return options;
+}
+
+// Enqueue-to-dequeue latency percentiles, in nanoseconds
+struct LatencyStats {
+    double p50_ns;
+    double p90_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+};
+
 // Structure to hold benchmark results
 struct BenchmarkResult {
     std::string queue_type;
@@ -22,6 +112,11 @@ struct BenchmarkResult {
     int batch_size;
     double elapsed_us;
     double ops_per_sec;
+    std::optional<LatencyStats> latency {}; // only set by the --latency runs
+    std::size_t payload_bytes = sizeof(int);
+
+    // Payload bandwidth: each message counts once (ops_per_sec counts enqueue and dequeue)
+    double gb_per_sec() const { return ops_per_sec / 2.0 * payload_bytes / 1e9; }
 };
 
 // Simple timer class
@@ -31,100 +126,224 @@ public:
 
     double elapsed_ms() const {
         auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
-        return duration.count() / 1000.0;
+        return std::chrono::duration<double, std::milli>(end - start_).count();
     }
 
     double elapsed_us() const {
         auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
-        return duration.count();
+        return std::chrono::duration<double, std::micro>(end - start_).count();
     }
 
 private:
     std::chrono::high_resolution_clock::time_point start_;
 };
 
-// Benchmark: Individual enqueue/dequeue operations
-template <std::size_t Capacity>
-BenchmarkResult benchmark_individual_ops(int iterations, int batch_size) {
-    std::cout << "\n=== Benchmark: Individual Operations ===" << std::endl;
-    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
+// Log-bucketed latency histogram in the style of HdrHistogram. Values below 64 ns are recorded
+// exactly; above that every power of two is split into 64 linear sub-buckets, so a reported
+// percentile is within 1/64 (~1.6%) of the recorded value.
+class LatencyHistogram {
+public:
+    LatencyHistogram() : counts_(sub_bucket_count * 59, 0) { }
 
-    auto [sink, source] = SPSC<int, Capacity>::make_queue();
+    void record(std::uint64_t ns) {
+        ++counts_[index_of(ns)];
+        ++total_;
+        max_ = std::max(max_, ns);
+    }
 
-    // Producer thread
-    Timer timer;
-    std::thread producer([sink = std::move(sink), iterations, batch_size]() mutable {
-        for (int iter = 0; iter < iterations; ++iter) {
-            for (int i = 0; i < batch_size; ++i) {
-                while (!sink.try_enqueue(iter * batch_size + i)) {
-                    std::this_thread::yield();
-                }
-            }
+    // Highest value equivalent to the bucket holding the `percentile`-th recorded value
+    std::uint64_t value_at(double percentile) const {
+        if (total_ == 0) return 0;
+        auto rank = static_cast<std::uint64_t>(
+            std::ceil(percentile / 100.0 * static_cast<double>(total_))
+        );
+        rank = std::max<std::uint64_t>(rank, 1);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < counts_.size(); ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(highest_in_bucket(i), max_);
         }
-    });
+        return max_;
+    }
 
-    // Consumer thread
-    std::thread consumer([source = std::move(source), iterations, batch_size]() mutable {
-        int total_consumed = 0;
-        int target = iterations * batch_size;
-        while (total_consumed < target) {
-            auto value = source.try_dequeue();
-            if (value.has_value()) {
-                ++total_consumed;
-            } else {
-                std::this_thread::yield();
-            }
-        }
-    });
+    LatencyStats stats() const {
+        return {
+            static_cast<double>(value_at(50.0)), static_cast<double>(value_at(90.0)),
+            static_cast<double>(value_at(99.0)), static_cast<double>(value_at(99.9)),
+            static_cast<double>(max_)
+        };
+    }
 
-    producer.join();
-    consumer.join();
+private:
+    static constexpr int sub_bucket_bits = 6;
+    static constexpr std::size_t sub_bucket_count = std::size_t(1) << sub_bucket_bits;
+
+    static std::size_t index_of(std::uint64_t ns) {
+        if (ns < sub_bucket_count) return static_cast<std::size_t>(ns);
+        const int msb = 63 - __builtin_clzll(ns);
+        const int shift = msb - sub_bucket_bits;
+        const std::size_t group = static_cast<std::size_t>(shift + 1);
+        const auto sub = static_cast<std::size_t>((ns >> shift) - sub_bucket_count);
+        return group * sub_bucket_count + sub;
+    }
 
-    double elapsed = timer.elapsed_us();
-    double ops_per_sec = (iterations * batch_size * 2.0) / (elapsed / 1e6);
+    static std::uint64_t highest_in_bucket(std::size_t index) {
+        if (index < sub_bucket_count) return index;
+        const int shift = static_cast<int>(index / sub_bucket_count) - 1;
+        const std::uint64_t sub = sub_bucket_count + index % sub_bucket_count;
+        return ((sub + 1) << shift) - 1;
+    }
 
-    std::cout << "Total ops (enq+deq): " << (iterations * batch_size * 2) << std::endl;
-    std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
-    std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t total_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+// Trivially copyable payload of exactly `Bytes` bytes, standing in for a fixed-layout message
+template <std::size_t Bytes>
+struct Payload {
+    static_assert(Bytes >= 8 && Bytes % 8 == 0, "Payload size must be a multiple of 8 bytes");
+    std::array<std::uint64_t, Bytes / 8> words;
+};
+
+// How the benchmarks build values of a payload type, and how many bytes each one carries
+template <typename T>
+struct PayloadTraits;
+
+template <>
+struct PayloadTraits<int> {
+    static constexpr std::size_t bytes = sizeof(int);
+    static int make(int i) { return i; }
+};
+
+template <std::size_t Bytes>
+struct PayloadTraits<Payload<Bytes>> {
+    static constexpr std::size_t bytes = Bytes;
+    static Payload<Bytes> make(int i) {
+        Payload<Bytes> payload {};
+        payload.words[0] = static_cast<std::uint64_t>(i);
+        return payload;
+    }
+};
 
-    return { "SPSC", "Individual", Capacity, iterations, batch_size, elapsed, ops_per_sec };
+// Non-trivial payload: every copy allocates, the string is too long for the small-string buffer
+template <>
+struct PayloadTraits<std::string> {
+    static constexpr std::size_t bytes = 64;
+    static std::string make(int i) {
+        std::string value(bytes, 'x');
+        const std::string id = std::to_string(i);
+        value.replace(0, id.size(), id);
+        return value;
+    }
+};
+
+// Queues built on the SPSC-shaped handles expose stats(); MPMC and MPSC do not
+template <typename Handle, typename = void>
+struct HasStats : std::false_type { };
+
+template <typename Handle>
+struct HasStats<Handle, std::void_t<decltype(std::declval<const Handle&>().stats())>>
+    : std::true_type { };
+
+// Sinks that can defer their tail publish (SPSC with a publish batch) expose flush()
+template <typename Handle, typename = void>
+struct HasFlush : std::false_type { };
+
+template <typename Handle>
+struct HasFlush<Handle, std::void_t<decltype(std::declval<Handle&>().flush())>>
+    : std::true_type { };
+
+// Publish the producer's last partial batch so the consumer can finish the run
+template <typename SinkT>
+void flush_sink(SinkT& sink) {
+    if constexpr (HasFlush<SinkT>::value) sink.flush();
 }
 
-// Benchmark: Bulk enqueue/dequeue operations
-template <std::size_t Capacity>
-BenchmarkResult benchmark_bulk_ops(int iterations, int batch_size) {
-    std::cout << "\n=== Benchmark: Bulk Operations ===" << std::endl;
-    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
+void print_side_stats(const char* side, const SideStats& stats) {
+    const double avg_batch =
+        stats.calls ? static_cast<double>(stats.elements) / static_cast<double>(stats.calls) : 0.0;
+    std::cout << "  " << side << ": " << stats.calls << " calls, avg batch " << std::fixed
+              << std::setprecision(1) << avg_batch << ", " << stats.rejections
+              << " rejections, " << stats.wait_iterations << " wait iterations ("
+              << std::setprecision(0) << stats.wait_ns / 1e3 << " μs)" << std::endl;
+    std::cout << "    batch sizes (log2 buckets):";
+    for (std::size_t i = 0; i < stats_batch_buckets; ++i) {
+        if (stats.batch_sizes[i] == 0) continue;
+        std::cout << " [" << (std::size_t(1) << i) << "+]=" << stats.batch_sizes[i];
+    }
+    std::cout << std::endl;
+}
+
+// Print the queue's counters when the benchmark is built with QBUF_STATS
+// (-DQBUF_BENCHMARK_STATS=ON)
+template <typename Handle>
+void print_queue_stats(const Handle& handle) {
+    if constexpr (HasStats<Handle>::value) {
+        const QueueStats stats = handle.stats();
+        if (!stats.enabled) return;
+        std::cout << "Queue stats (high-water mark " << stats.high_water_mark << "):" << std::endl;
+        print_side_stats("producer", stats.producer);
+        print_side_stats("consumer", stats.consumer);
+    }
+}
 
-    auto [sink, source] = SPSC<int, Capacity>::make_queue();
+// Benchmark: one producer and one consumer moving `iterations * batch_size` values of `T`,
+// element by element or with the bulk calls. Works with every queue exposing the SPSC-shaped
+// `try_enqueue` / `try_dequeue` API; the handles are moved in and used by reference.
+template <typename T, typename SinkT, typename SourceT>
+BenchmarkResult run_throughput(
+    const std::string& queue_type, std::size_t capacity, SinkT sink, SourceT source,
+    int iterations, int batch_size, bool bulk
+) {
+    const std::string operation_type = bulk ? "Bulk" : "Individual";
+    std::cout << "\n=== Benchmark: " << operation_type << " Operations (" << queue_type
+              << ") ===" << std::endl;
+    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size
+              << ", Payload: " << PayloadTraits<T>::bytes << " B" << std::endl;
+
+    // Built once, so the producer measures the copy into the queue and not payload construction
+    std::vector<T> batch;
+    batch.reserve(batch_size);
+    for (int i = 0; i < batch_size; ++i) batch.push_back(PayloadTraits<T>::make(i));
 
     // Producer thread
     Timer timer;
-    std::thread producer([sink = std::move(sink), iterations, batch_size]() mutable {
-        std::vector<int> batch(batch_size);
+    std::thread producer([&sink, &batch, iterations, bulk]() {
+        pin_to_cpu(placement.producer_cpu);
         for (int iter = 0; iter < iterations; ++iter) {
-            for (int i = 0; i < batch_size; ++i) {
-                batch[i] = iter * batch_size + i;
+            if (!bulk) {
+                for (const T& value : batch) {
+                    while (!sink.try_enqueue(value)) {
+                        std::this_thread::yield();
+                    }
+                }
+                continue;
             }
             std::size_t enqueued = 0;
-            while (enqueued < batch_size) {
-                enqueued += sink.try_enqueue(batch.data() + enqueued, batch_size - enqueued);
-                if (enqueued < batch_size) {
+            while (enqueued < batch.size()) {
+                enqueued += sink.try_enqueue(batch.data() + enqueued, batch.size() - enqueued);
+                if (enqueued < batch.size()) {
                     std::this_thread::yield();
                 }
             }
         }
+        flush_sink(sink);
     });
 
     // Consumer thread
-    std::thread consumer([source = std::move(source), iterations, batch_size]() mutable {
-        std::vector<int> batch(batch_size);
-        int total_consumed = 0;
-        int target = iterations * batch_size;
+    std::thread consumer([&source, iterations, batch_size, bulk]() {
+        pin_to_cpu(placement.consumer_cpu);
+        std::vector<T> received(bulk ? batch_size : 0);
+        const std::size_t target = static_cast<std::size_t>(iterations) * batch_size;
+        std::size_t total_consumed = 0;
         while (total_consumed < target) {
-            std::size_t dequeued = source.try_dequeue(batch.data(), batch_size);
+            std::size_t dequeued = 0;
+            if (bulk) {
+                dequeued = source.try_dequeue(received.data(), received.size());
+            } else {
+                dequeued = source.try_dequeue().has_value() ? 1 : 0;
+            }
             total_consumed += dequeued;
             if (dequeued == 0) {
                 std::this_thread::yield();
@@ -136,26 +355,112 @@ BenchmarkResult benchmark_bulk_ops(int iterations, int batch_size) {
     consumer.join();
 
     double elapsed = timer.elapsed_us();
-    double ops_per_sec = (iterations * batch_size * 2.0) / (elapsed / 1e6);
+    const double total_ops = static_cast<double>(iterations) * batch_size * 2.0;
+    double ops_per_sec = total_ops / (elapsed / 1e6);
+    BenchmarkResult result {
+        queue_type, operation_type, capacity, iterations, batch_size, elapsed, ops_per_sec,
+        std::nullopt, PayloadTraits<T>::bytes
+    };
 
-    std::cout << "Total ops (enq+deq): " << (iterations * batch_size * 2) << std::endl;
-    std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
+    std::cout << "Total ops (enq+deq): " << std::fixed << std::setprecision(0) << total_ops
+              << std::endl;
+    std::cout << "Time: " << std::setprecision(2) << elapsed << " μs" << std::endl;
     std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
+    std::cout << "Bandwidth: " << std::fixed << std::setprecision(3) << result.gb_per_sec()
+              << " GB/s" << std::endl;
+    print_queue_stats(source);
+
+    return result;
+}
+
+// Benchmark: individual (or, with `bulk`, batched) enqueue/dequeue through any queue created by
+// `Queue::make_queue(args...)`
+template <typename Queue, typename... Args>
+BenchmarkResult benchmark_ops(
+    const std::string& queue_type, std::size_t capacity, int iterations, int batch_size, bool bulk,
+    Args&&... args
+) {
+    static_assert(is_queue_v<Queue>, "benchmark_ops() needs the shared queue API");
+    auto [sink, source] = Queue::make_queue(std::forward<Args>(args)...);
+    return run_throughput<queue_value_t<Queue>>(
+        queue_type, capacity, std::move(sink), std::move(source), iterations, batch_size, bulk
+    );
+}
 
-    return { "SPSC", "Bulk", Capacity, iterations, batch_size, elapsed, ops_per_sec };
+// Individual then bulk runs of one queue type, each on a fresh queue
+template <typename Queue, typename... Args>
+void benchmark_ops(
+    std::vector<BenchmarkResult>& results, const std::string& queue_type, std::size_t capacity,
+    int iterations, int batch_size, const Args&... args
+) {
+    for (bool bulk : { false, true }) {
+        results.push_back(
+            benchmark_ops<Queue>(queue_type, capacity, iterations, batch_size, bulk, args...)
+        );
+    }
 }
 
-// Benchmark: Individual enqueue/dequeue operations (MutexQueue)
+// Reference SPSC ring without cached indices: every operation acquire-loads the opposite side's
+// index, as `SPSC` did before caching. Used only as a baseline for cross-core traffic.
+template <typename T, std::size_t Capacity>
+class UncachedSPSC {
+public:
+    class Sink {
+    public:
+        explicit Sink(std::shared_ptr<UncachedSPSC> queue) : queue_(std::move(queue)) { }
+
+        bool try_enqueue(const T& value) {
+            const auto tail = queue_->tail_.load(std::memory_order_relaxed);
+            const auto next_tail = (tail + 1) & (Capacity - 1);
+            if (next_tail == queue_->head_.load(std::memory_order_acquire)) return false;
+            queue_->buffer_[tail] = value;
+            queue_->tail_.store(next_tail, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::shared_ptr<UncachedSPSC> queue_;
+    };
+
+    class Source {
+    public:
+        explicit Source(std::shared_ptr<UncachedSPSC> queue) : queue_(std::move(queue)) { }
+
+        std::optional<T> try_dequeue() {
+            const auto head = queue_->head_.load(std::memory_order_relaxed);
+            if (head == queue_->tail_.load(std::memory_order_acquire)) return std::nullopt;
+            T value = std::move(queue_->buffer_[head]);
+            queue_->head_.store((head + 1) & (Capacity - 1), std::memory_order_release);
+            return value;
+        }
+
+    private:
+        std::shared_ptr<UncachedSPSC> queue_;
+    };
+
+    static std::pair<Sink, Source> make_queue() {
+        auto queue = std::make_shared<UncachedSPSC>();
+        return { Sink(queue), Source(queue) };
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> head_ { 0 };
+    alignas(64) std::atomic<std::size_t> tail_ { 0 };
+    alignas(64) std::array<T, Capacity> buffer_ {};
+};
+
+// Benchmark: Individual enqueue/dequeue operations (SPSC without cached indices)
 template <std::size_t Capacity>
-BenchmarkResult benchmark_individual_ops_mutex(int iterations, int batch_size) {
-    std::cout << "\n=== Benchmark: Individual Operations (MutexQueue) ===" << std::endl;
+BenchmarkResult benchmark_individual_ops_uncached(int iterations, int batch_size) {
+    std::cout << "\n=== Benchmark: Individual Operations (uncached indices) ===" << std::endl;
     std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
 
-    auto [sink, source] = MutexQueue<int, Capacity>::make_queue();
+    auto [sink, source] = UncachedSPSC<int, Capacity>::make_queue();
 
     // Producer thread
     Timer timer;
     std::thread producer([sink = std::move(sink), iterations, batch_size]() mutable {
+        pin_to_cpu(placement.producer_cpu);
         for (int iter = 0; iter < iterations; ++iter) {
             for (int i = 0; i < batch_size; ++i) {
                 while (!sink.try_enqueue(iter * batch_size + i)) {
@@ -167,6 +472,7 @@ BenchmarkResult benchmark_individual_ops_mutex(int iterations, int batch_size) {
 
     // Consumer thread
     std::thread consumer([source = std::move(source), iterations, batch_size]() mutable {
+        pin_to_cpu(placement.consumer_cpu);
         int total_consumed = 0;
         int target = iterations * batch_size;
         while (total_consumed < target) {
@@ -189,45 +495,46 @@ BenchmarkResult benchmark_individual_ops_mutex(int iterations, int batch_size) {
     std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
     std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
 
-    return { "MutexQueue", "Individual", Capacity, iterations, batch_size, elapsed, ops_per_sec };
+    return {
+        "SPSC (uncached)", "Individual", Capacity, iterations, batch_size, elapsed, ops_per_sec
+    };
 }
 
-// Benchmark: Bulk enqueue/dequeue operations (MutexQueue)
-template <std::size_t Capacity>
-BenchmarkResult benchmark_bulk_ops_mutex(int iterations, int batch_size) {
-    std::cout << "\n=== Benchmark: Bulk Operations (MutexQueue) ===" << std::endl;
+// Blocking enqueue/dequeue run shared by the wait strategy and MutexQueue watermark rows. Reports
+// process CPU time next to wall time so the cost of idle waiting can be compared. The consumer
+// waits in 1 ms slices so a tail left below a MutexQueue high watermark cannot stall the run.
+template <typename SinkT, typename SourceT>
+BenchmarkResult run_blocking(
+    const std::string& queue_type, std::size_t capacity, SinkT sink, SourceT source,
+    int iterations, int batch_size
+) {
+    std::cout << "\n=== Benchmark: Blocking Operations (" << queue_type << ") ===" << std::endl;
     std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
 
-    auto [sink, source] = MutexQueue<int, Capacity>::make_queue();
-
     // Producer thread
+    const std::clock_t cpu_start = std::clock();
     Timer timer;
     std::thread producer([sink = std::move(sink), iterations, batch_size]() mutable {
+        pin_to_cpu(placement.producer_cpu);
         std::vector<int> batch(batch_size);
         for (int iter = 0; iter < iterations; ++iter) {
             for (int i = 0; i < batch_size; ++i) {
                 batch[i] = iter * batch_size + i;
             }
-            std::size_t enqueued = 0;
-            while (enqueued < batch_size) {
-                enqueued += sink.try_enqueue(batch.data() + enqueued, batch_size - enqueued);
-                if (enqueued < batch_size) {
-                    std::this_thread::yield();
-                }
-            }
+            sink.enqueue(batch.data(), batch_size, std::chrono::seconds(10));
         }
     });
 
     // Consumer thread
     std::thread consumer([source = std::move(source), iterations, batch_size]() mutable {
+        pin_to_cpu(placement.consumer_cpu);
         std::vector<int> batch(batch_size);
-        int total_consumed = 0;
-        int target = iterations * batch_size;
-        while (total_consumed < target) {
-            std::size_t dequeued = source.try_dequeue(batch.data(), batch_size);
-            total_consumed += dequeued;
-            if (dequeued == 0) {
-                std::this_thread::yield();
+        for (int iter = 0; iter < iterations; ++iter) {
+            std::size_t received = 0;
+            while (received < batch.size()) {
+                received += source.dequeue(
+                    batch.data() + received, batch.size() - received, std::chrono::milliseconds(1)
+                );
             }
         }
     });
@@ -236,104 +543,378 @@ BenchmarkResult benchmark_bulk_ops_mutex(int iterations, int batch_size) {
     consumer.join();
 
     double elapsed = timer.elapsed_us();
+    double cpu_us = 1e6 * static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
     double ops_per_sec = (iterations * batch_size * 2.0) / (elapsed / 1e6);
 
     std::cout << "Total ops (enq+deq): " << (iterations * batch_size * 2) << std::endl;
     std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
+    std::cout << "CPU time: " << cpu_us << " μs (" << (100.0 * cpu_us / elapsed) << "% of wall)"
+              << std::endl;
     std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
 
-    return { "MutexQueue", "Bulk", Capacity, iterations, batch_size, elapsed, ops_per_sec };
+    return { queue_type, "Blocking", capacity, iterations, batch_size, elapsed, ops_per_sec };
+}
+
+// Benchmark: Blocking enqueue/dequeue with a selectable wait strategy
+template <std::size_t Capacity, typename Wait>
+BenchmarkResult benchmark_blocking_ops(
+    const std::string& wait_name, int iterations, int batch_size
+) {
+    auto [sink, source] = SPSC<int, Capacity, Wait>::make_queue();
+    return run_blocking(
+        "SPSC (wait=" + wait_name + ")", Capacity, std::move(sink), std::move(source), iterations,
+        batch_size
+    );
+}
+
+// Benchmark: Blocking MutexQueue operations, waking on every change or in watermark batches
+// (producers below a quarter full, consumers above half full)
+template <std::size_t Capacity>
+BenchmarkResult benchmark_blocking_ops_mutex(bool watermarks, int iterations, int batch_size) {
+    const Watermarks marks =
+        watermarks ? Watermarks { Capacity / 4, Capacity / 2 } : Watermarks { };
+    auto [sink, source] = MutexQueue<int, Capacity>::make_queue(marks);
+    return run_blocking(
+        watermarks ? "MutexQueue (watermarks)" : "MutexQueue", Capacity, std::move(sink),
+        std::move(source), iterations, batch_size
+    );
+}
+
+#if defined(__linux__)
+// Benchmark: round trips between two processes over a pair of shared MmapSPSC queues. A forked
+// child echoes every value back; the parent measures the whole exchange.
+template <std::size_t Capacity>
+BenchmarkResult benchmark_ipc_ping_pong(int iterations) {
+    std::cout << "\n=== Benchmark: IPC Ping-Pong (MmapSPSC, shared) ===" << std::endl;
+    std::cout << "Round trips: " << iterations << std::endl;
+
+    using Queue = MmapSPSC<std::uint64_t, Capacity, SharedParkingWait>;
+    const int ping_fd = Queue::create_shared();
+    const int pong_fd = Queue::create_shared();
+
+    const pid_t child = fork();
+    if (child < 0) {
+        throw std::runtime_error("fork failed");
+    }
+    if (child == 0) {
+        pin_to_cpu(placement.consumer_cpu);
+        auto ping = Queue::attach_source(ping_fd);
+        auto pong = Queue::attach_sink(pong_fd);
+        for (int i = 0; i < iterations; ++i) {
+            auto value = ping.dequeue(std::chrono::seconds(10));
+            if (!value.has_value() || !pong.enqueue(*value, std::chrono::seconds(10))) _exit(1);
+        }
+        _exit(0);
+    }
+
+    auto ping = Queue::attach_sink(ping_fd);
+    auto pong = Queue::attach_source(pong_fd);
+    close(ping_fd);
+    close(pong_fd);
+
+    // One untimed exchange so both sides have faulted in their mappings
+    ping.enqueue(std::uint64_t { 0 }, std::chrono::seconds(10));
+    pong.dequeue(std::chrono::seconds(10));
+
+    // Run the timed side on its own thread so it can be pinned without pinning main()
+    double elapsed = 0;
+    std::thread pinger([&ping, &pong, &elapsed, iterations]() {
+        pin_to_cpu(placement.producer_cpu);
+        Timer timer;
+        for (int i = 1; i < iterations; ++i) {
+            ping.enqueue(static_cast<std::uint64_t>(i), std::chrono::seconds(10));
+            pong.dequeue(std::chrono::seconds(10));
+        }
+        elapsed = timer.elapsed_us();
+    });
+    pinger.join();
+    waitpid(child, nullptr, 0);
+
+    const int timed = iterations - 1;
+    double ops_per_sec = timed / (elapsed / 1e6);
+
+    std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
+    std::cout << "Round trip: " << (1000.0 * elapsed / timed) << " ns" << std::endl;
+    std::cout << "Throughput: " << std::scientific << ops_per_sec << " round trips/sec"
+              << std::endl;
+
+    return { "MmapSPSC (shared)", "IPC ping-pong", Capacity, timed, 1, elapsed, ops_per_sec };
+}
+#endif
+
+// Run the blocking benchmark for one wait strategy, or all of them for "all"
+template <std::size_t Capacity>
+void benchmark_wait_strategies(
+    std::vector<BenchmarkResult>& results, const std::string& wait, int iterations, int batch_size
+) {
+    if (wait == "all" || wait == "yield") {
+        results.push_back(
+            benchmark_blocking_ops<Capacity, YieldWait>("yield", iterations, batch_size)
+        );
+    }
+    if (wait == "all" || wait == "spin") {
+        results.push_back(
+            benchmark_blocking_ops<Capacity, SpinWait>("spin", iterations, batch_size)
+        );
+    }
+    if (wait == "all" || wait == "backoff") {
+        results.push_back(
+            benchmark_blocking_ops<Capacity, BackoffWait>("backoff", iterations, batch_size)
+        );
+    }
+    if (wait == "all" || wait == "park") {
+        results.push_back(
+            benchmark_blocking_ops<Capacity, ParkingWait>("park", iterations, batch_size)
+        );
+    }
 }
 
-// Benchmark: Individual enqueue/dequeue operations (MmapSPSC)
+// Benchmark: MPMC with `threads` producers and `threads` consumers. The total work is the same
+// as for the single-threaded-per-side runs; producers split the iterations between them.
 template <std::size_t Capacity>
-BenchmarkResult benchmark_individual_ops_mmap(int iterations, int batch_size) {
-    std::cout << "\n=== Benchmark: Individual Operations (MmapSPSC) ===" << std::endl;
+BenchmarkResult benchmark_mpmc(int threads, int iterations, int batch_size) {
+    std::cout << "\n=== Benchmark: MPMC Operations (" << threads << " producers, " << threads
+              << " consumers) ===" << std::endl;
     std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
 
-    auto [sink, source] = MmapSPSC<int, Capacity>::create();
+    auto [sink, source] = MPMC<int, Capacity>::make_queue();
+    const int target = iterations * batch_size;
+    std::atomic<int> total_consumed { 0 };
 
-    // Producer thread
     Timer timer;
-    std::thread producer([sink = std::move(sink), iterations, batch_size]() mutable {
-        for (int iter = 0; iter < iterations; ++iter) {
-            for (int i = 0; i < batch_size; ++i) {
-                while (!sink.try_enqueue(iter * batch_size + i)) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        // Producer threads
+        const int first = iterations * t / threads;
+        const int last = iterations * (t + 1) / threads;
+        workers.emplace_back([sink = sink, first, last, batch_size]() mutable {
+            std::vector<int> batch(batch_size);
+            for (int iter = first; iter < last; ++iter) {
+                for (int i = 0; i < batch_size; ++i) {
+                    batch[i] = iter * batch_size + i;
+                }
+                std::size_t enqueued = 0;
+                while (enqueued < batch.size()) {
+                    enqueued += sink.try_enqueue(batch.data() + enqueued, batch.size() - enqueued);
+                    if (enqueued < batch.size()) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+    for (int t = 0; t < threads; ++t) {
+        // Consumer threads
+        workers.emplace_back([source = source, &total_consumed, target, batch_size]() mutable {
+            std::vector<int> batch(batch_size);
+            while (total_consumed.load(std::memory_order_relaxed) < target) {
+                std::size_t dequeued = source.try_dequeue(batch.data(), batch_size);
+                if (dequeued == 0) {
                     std::this_thread::yield();
+                    continue;
                 }
+                total_consumed.fetch_add(static_cast<int>(dequeued), std::memory_order_relaxed);
             }
-        }
-    });
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
 
-    // Consumer thread
-    std::thread consumer([source = std::move(source), iterations, batch_size]() mutable {
-        int total_consumed = 0;
-        int target = iterations * batch_size;
-        while (total_consumed < target) {
-            auto value = source.try_dequeue();
-            if (value.has_value()) {
-                ++total_consumed;
-            } else {
-                std::this_thread::yield();
-            }
-        }
-    });
+    double elapsed = timer.elapsed_us();
+    double ops_per_sec = (iterations * batch_size * 2.0) / (elapsed / 1e6);
 
-    producer.join();
-    consumer.join();
+    std::cout << "Total ops (enq+deq): " << (iterations * batch_size * 2) << std::endl;
+    std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
+    std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
 
-    double elapsed = timer.elapsed_us();
+    const std::string name =
+        "MPMC (" + std::to_string(threads) + "P/" + std::to_string(threads) + "C)";
+    return { name, "Bulk", Capacity, iterations, batch_size, elapsed, ops_per_sec };
+}
+
+// Reports an N producers x N consumers run in the format of benchmark_mpmc()
+BenchmarkResult many_to_many_result(
+    const std::string& queue_type, int threads, std::size_t capacity, int iterations,
+    int batch_size, double elapsed
+) {
     double ops_per_sec = (iterations * batch_size * 2.0) / (elapsed / 1e6);
 
     std::cout << "Total ops (enq+deq): " << (iterations * batch_size * 2) << std::endl;
     std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
     std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
 
-    return { "MmapSPSC", "Individual", Capacity, iterations, batch_size, elapsed, ops_per_sec };
+    const std::string name =
+        queue_type + " (" + std::to_string(threads) + "P/" + std::to_string(threads) + "C)";
+    return { name, "Bulk", capacity, iterations, batch_size, elapsed, ops_per_sec };
 }
 
-// Benchmark: Bulk enqueue/dequeue operations (MmapSPSC)
+// Benchmark: Mesh of `threads` x `threads` SPSC lanes. Producers route each batch by its
+// iteration number, so consumers see an even share; `capacity` is reported as the lane
+// capacity times the number of inbound lanes, like one shared ring of that size.
+template <std::size_t LaneCapacity>
+BenchmarkResult benchmark_mesh(int threads, int iterations, int batch_size) {
+    std::cout << "\n=== Benchmark: Mesh Operations (" << threads << " producers, " << threads
+              << " consumers) ===" << std::endl;
+    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
+
+    auto [sinks, sources] = Mesh<int, LaneCapacity>::make_queue(threads, threads);
+    const int target = iterations * batch_size;
+    std::atomic<int> total_consumed { 0 };
+
+    Timer timer;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        // Producer threads
+        const int first = iterations * t / threads;
+        const int last = iterations * (t + 1) / threads;
+        workers.emplace_back([&sink = sinks[t], first, last, batch_size]() {
+            std::vector<int> batch(batch_size);
+            for (int iter = first; iter < last; ++iter) {
+                for (int i = 0; i < batch_size; ++i) {
+                    batch[i] = iter * batch_size + i;
+                }
+                auto& lane = sink.route(iter);
+                std::size_t enqueued = 0;
+                while (enqueued < batch.size()) {
+                    enqueued += lane.try_enqueue(batch.data() + enqueued, batch.size() - enqueued);
+                    if (enqueued < batch.size()) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+    for (int t = 0; t < threads; ++t) {
+        // Consumer threads
+        workers.emplace_back([&source = sources[t], &total_consumed, target, batch_size]() {
+            std::vector<int> batch(batch_size);
+            while (total_consumed.load(std::memory_order_relaxed) < target) {
+                std::size_t dequeued = source.try_dequeue(batch.data(), batch_size);
+                if (dequeued == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                total_consumed.fetch_add(static_cast<int>(dequeued), std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return many_to_many_result(
+        "Mesh", threads, LaneCapacity * threads, iterations, batch_size, timer.elapsed_us()
+    );
+}
+
+// Benchmark: MutexQueue with `threads` producers and `threads` consumers sharing its one Sink
+// and one Source
 template <std::size_t Capacity>
-BenchmarkResult benchmark_bulk_ops_mmap(int iterations, int batch_size) {
-    std::cout << "\n=== Benchmark: Bulk Operations (MmapSPSC) ===" << std::endl;
+BenchmarkResult benchmark_mutex_many(int threads, int iterations, int batch_size) {
+    std::cout << "\n=== Benchmark: MutexQueue Operations (" << threads << " producers, "
+              << threads << " consumers) ===" << std::endl;
     std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
 
-    auto [sink, source] = MmapSPSC<int, Capacity>::create();
+    auto [sink, source] = MutexQueue<int, Capacity>::make_queue();
+    const int target = iterations * batch_size;
+    std::atomic<int> total_consumed { 0 };
 
-    // Producer thread
     Timer timer;
-    std::thread producer([sink = std::move(sink), iterations, batch_size]() mutable {
-        std::vector<int> batch(batch_size);
-        for (int iter = 0; iter < iterations; ++iter) {
-            for (int i = 0; i < batch_size; ++i) {
-                batch[i] = iter * batch_size + i;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        // Producer threads
+        const int first = iterations * t / threads;
+        const int last = iterations * (t + 1) / threads;
+        workers.emplace_back([&sink = sink, first, last, batch_size]() {
+            std::vector<int> batch(batch_size);
+            for (int iter = first; iter < last; ++iter) {
+                for (int i = 0; i < batch_size; ++i) {
+                    batch[i] = iter * batch_size + i;
+                }
+                std::size_t enqueued = 0;
+                while (enqueued < batch.size()) {
+                    enqueued += sink.try_enqueue(batch.data() + enqueued, batch.size() - enqueued);
+                    if (enqueued < batch.size()) {
+                        std::this_thread::yield();
+                    }
+                }
             }
-            std::size_t enqueued = 0;
-            while (enqueued < batch_size) {
-                enqueued += sink.try_enqueue(batch.data() + enqueued, batch_size - enqueued);
-                if (enqueued < batch_size) {
+        });
+    }
+    for (int t = 0; t < threads; ++t) {
+        // Consumer threads
+        workers.emplace_back([&source = source, &total_consumed, target, batch_size]() {
+            std::vector<int> batch(batch_size);
+            while (total_consumed.load(std::memory_order_relaxed) < target) {
+                std::size_t dequeued = source.try_dequeue(batch.data(), batch_size);
+                if (dequeued == 0) {
                     std::this_thread::yield();
+                    continue;
                 }
+                total_consumed.fetch_add(static_cast<int>(dequeued), std::memory_order_relaxed);
             }
-        }
-    });
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
 
-    // Consumer thread
-    std::thread consumer([source = std::move(source), iterations, batch_size]() mutable {
-        std::vector<int> batch(batch_size);
-        int total_consumed = 0;
-        int target = iterations * batch_size;
-        while (total_consumed < target) {
-            std::size_t dequeued = source.try_dequeue(batch.data(), batch_size);
-            total_consumed += dequeued;
-            if (dequeued == 0) {
-                std::this_thread::yield();
+    return many_to_many_result(
+        "MutexQueue", threads, Capacity, iterations, batch_size, timer.elapsed_us()
+    );
+}
+
+// Benchmark: N producers feeding one consumer. `ProducerRef` adapts the handle for each producer
+// thread: a copy for MPSC, a shared reference for MutexQueue, whose single Sink is locked inside.
+template <std::size_t Capacity, typename SinkT, typename SourceT, typename ProducerRef>
+BenchmarkResult run_fan_in(
+    const std::string& queue_type, SinkT& sink, SourceT& source, ProducerRef producer_ref,
+    int producers, int iterations, int batch_size
+) {
+    std::cout << "\n=== Benchmark: " << queue_type << " fan-in (" << producers
+              << " producers, 1 consumer) ===" << std::endl;
+    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
+
+    Timer timer;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < producers; ++t) {
+        // Producer threads
+        const int first = iterations * t / producers;
+        const int last = iterations * (t + 1) / producers;
+        workers.emplace_back([handle = producer_ref(sink), first, last, batch_size]() mutable {
+            std::vector<int> batch(batch_size);
+            for (int iter = first; iter < last; ++iter) {
+                for (int i = 0; i < batch_size; ++i) {
+                    batch[i] = iter * batch_size + i;
+                }
+                std::size_t enqueued = 0;
+                while (enqueued < batch.size()) {
+                    enqueued += handle.get().try_enqueue(
+                        batch.data() + enqueued, batch.size() - enqueued
+                    );
+                    if (enqueued < batch.size()) {
+                        std::this_thread::yield();
+                    }
+                }
             }
-        }
-    });
+        });
+    }
 
-    producer.join();
-    consumer.join();
+    // Consumer runs on this thread and drains whole batches
+    std::vector<int> batch(batch_size);
+    int total_consumed = 0;
+    int target = iterations * batch_size;
+    while (total_consumed < target) {
+        std::size_t dequeued = source.try_dequeue(batch.data(), batch_size);
+        total_consumed += dequeued;
+        if (dequeued == 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
 
     double elapsed = timer.elapsed_us();
     double ops_per_sec = (iterations * batch_size * 2.0) / (elapsed / 1e6);
@@ -342,18 +923,399 @@ BenchmarkResult benchmark_bulk_ops_mmap(int iterations, int batch_size) {
     std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
     std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
 
-    return { "MmapSPSC", "Bulk", Capacity, iterations, batch_size, elapsed, ops_per_sec };
+    const std::string name = queue_type + " (" + std::to_string(producers) + "P/1C)";
+    return { name, "Bulk", Capacity, iterations, batch_size, elapsed, ops_per_sec };
 }
 
-// Helper function to escape CSV fields
-std::string escape_csv_field(const std::string& field) {
-    // If the field contains comma, quote, or newline, wrap it in quotes and escape quotes
-    bool needs_escape = false;
-    for (auto& c : field) {
-        if (c == ',' || c == '"' || c == '\n' || c == '\r') {
-            needs_escape = true;
-            break;
-        }
+// Holds its own copy of a copyable producer handle
+template <typename SinkT>
+struct OwnedHandle {
+    SinkT sink;
+    SinkT& get() { return sink; }
+};
+
+// Benchmark: MPSC fan-in, one Sink copy per producer
+template <std::size_t Capacity>
+BenchmarkResult benchmark_mpsc(int producers, int iterations, int batch_size) {
+    auto [sink, source] = MPSC<int, Capacity>::make_queue();
+    using SinkT = typename MPSC<int, Capacity>::Sink;
+    auto copy = [](SinkT& s) { return OwnedHandle<SinkT> { s }; };
+    return run_fan_in<Capacity>("MPSC", sink, source, copy, producers, iterations, batch_size);
+}
+
+// Benchmark: MutexQueue fan-in, all producers share the one Sink
+template <std::size_t Capacity>
+BenchmarkResult benchmark_mpsc_mutex(int producers, int iterations, int batch_size) {
+    auto [sink, source] = MutexQueue<int, Capacity>::make_queue();
+    using SinkT = typename MutexQueue<int, Capacity>::Sink;
+    auto share = [](SinkT& s) { return std::ref(s); };
+    return run_fan_in<Capacity>(
+        "MutexQueue", sink, source, share, producers, iterations, batch_size
+    );
+}
+
+// Producer side of a fan-out run: `send(data, count)` enqueues as much of a batch as fits
+template <typename Send>
+void produce_batches(int iterations, int batch_size, Send send) {
+    std::vector<int> batch(batch_size);
+    for (int iter = 0; iter < iterations; ++iter) {
+        for (int i = 0; i < batch_size; ++i) {
+            batch[i] = iter * batch_size + i;
+        }
+        std::size_t enqueued = 0;
+        while (enqueued < batch.size()) {
+            enqueued += send(batch.data() + enqueued, batch.size() - enqueued);
+            if (enqueued < batch.size()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+// Reports a fan-out run. Each message counts one enqueue plus one dequeue per reader that
+// received it; `lost` messages (lossy readers that were overrun) count only the enqueue.
+BenchmarkResult fan_out_result(
+    const std::string& queue_type, int readers, std::size_t capacity, int iterations,
+    int batch_size, double elapsed, std::uint64_t lost
+) {
+    const double messages = static_cast<double>(iterations) * batch_size;
+    const double total_ops = messages * (1 + readers) - static_cast<double>(lost);
+    const double ops_per_sec = total_ops / (elapsed / 1e6);
+    std::cout << "Total ops (enq+deq): " << std::fixed << std::setprecision(0) << total_ops
+              << std::endl;
+    std::cout << "Time: " << std::setprecision(2) << elapsed << " μs" << std::endl;
+    std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
+    if (lost != 0) std::cout << "Lost (all readers): " << lost << std::endl;
+
+    const std::string name = queue_type + " (1P/" + std::to_string(readers) + "R)";
+    return { name, batch_size == 1 ? "Individual" : "Bulk", capacity, iterations, batch_size,
+             elapsed, ops_per_sec };
+}
+
+// Benchmark: one producer publishing every message once to `readers` Broadcast readers. In
+// lossy mode the producer is never held back, so slow readers lose messages instead.
+template <std::size_t Capacity, BroadcastMode Mode>
+BenchmarkResult benchmark_broadcast(int readers, int iterations, int batch_size) {
+    const std::string queue_type =
+        (Mode == BroadcastMode::lossy) ? "LossyBroadcast" : "Broadcast";
+    std::cout << "\n=== Benchmark: " << queue_type << " (1 producer, " << readers
+              << " readers) ===" << std::endl;
+    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
+
+    auto [sink, sources] = Broadcast<int, Capacity, Mode>::make_queue(readers);
+    const std::uint64_t target = static_cast<std::uint64_t>(iterations) * batch_size;
+    std::vector<std::uint64_t> lost(readers);
+
+    Timer timer;
+    std::vector<std::thread> workers;
+    for (int r = 0; r < readers; ++r) {
+        // Reader threads, until each has passed every message (received or lost)
+        workers.emplace_back([&source = sources[r], &lost = lost[r], target, batch_size]() {
+            std::vector<int> batch(batch_size);
+            while (source.position() < target) {
+                if (source.try_dequeue(batch.data(), batch.size()) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            lost = source.lost();
+        });
+    }
+    produce_batches(iterations, batch_size, [&sink = sink](const int* data, std::size_t count) {
+        return sink.try_enqueue(data, count);
+    });
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::uint64_t total_lost = 0;
+    for (std::uint64_t reader_lost : lost) total_lost += reader_lost;
+    return fan_out_result(
+        queue_type, readers, Capacity, iterations, batch_size, timer.elapsed_us(), total_lost
+    );
+}
+
+// Benchmark: the same fan-out with one SPSC per reader; the producer copies every message into
+// each queue in turn
+template <std::size_t Capacity>
+BenchmarkResult benchmark_spsc_fan_out(int readers, int iterations, int batch_size) {
+    std::cout << "\n=== Benchmark: SPSC x " << readers << " (1 producer, " << readers
+              << " readers) ===" << std::endl;
+    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size << std::endl;
+
+    std::vector<SpscSink<int, Capacity>> sinks;
+    std::vector<SpscSource<int, Capacity>> sources;
+    for (int r = 0; r < readers; ++r) {
+        auto [sink, source] = SPSC<int, Capacity>::make_queue();
+        sinks.push_back(std::move(sink));
+        sources.push_back(std::move(source));
+    }
+    const int target = iterations * batch_size;
+
+    Timer timer;
+    std::vector<std::thread> workers;
+    for (int r = 0; r < readers; ++r) {
+        // Reader threads
+        workers.emplace_back([&source = sources[r], target, batch_size]() {
+            std::vector<int> batch(batch_size);
+            for (int consumed = 0; consumed < target;) {
+                const std::size_t dequeued = source.try_dequeue(batch.data(), batch.size());
+                consumed += static_cast<int>(dequeued);
+                if (dequeued == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    produce_batches(iterations, batch_size, [&sinks](const int* data, std::size_t count) {
+        // Each queue gets the whole batch before the producer moves on
+        for (auto& sink : sinks) {
+            std::size_t enqueued = 0;
+            while (enqueued < count) {
+                enqueued += sink.try_enqueue(data + enqueued, count - enqueued);
+                if (enqueued < count) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        return count;
+    });
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return fan_out_result(
+        "SPSC x N", readers, Capacity, iterations, batch_size, timer.elapsed_us(), 0
+    );
+}
+
+// Baseline scheduler for the fork-join runs: the same boxed tasks as ThreadPool, but every
+// worker pops from, and every fork pushes to, one shared MutexQueue
+template <std::size_t Capacity>
+class SharedQueuePool {
+public:
+    explicit SharedQueuePool(int workers) : pending_(0), stopping_(false) {
+        auto [sink, source] = MutexQueue<Task*, Capacity>::make_queue();
+        sink_ = std::make_unique<typename MutexQueue<Task*, Capacity>::Sink>(std::move(sink));
+        source_ =
+            std::make_unique<typename MutexQueue<Task*, Capacity>::Source>(std::move(source));
+        for (int i = 0; i < workers; ++i) {
+            workers_.emplace_back([this]() {
+                while (!stopping_.load(std::memory_order_acquire)) {
+                    if (auto task = source_->dequeue(std::chrono::microseconds(100))) {
+                        run(*task);
+                    }
+                }
+            });
+        }
+    }
+
+    ~SharedQueuePool() {
+        wait_idle();
+        stopping_.store(true, std::memory_order_release);
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Like ThreadPool::submit(), a fork that finds the queue full runs inline
+    template <typename F>
+    void submit(F&& task) {
+        auto* boxed = new Task(std::forward<F>(task));
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        if (!sink_->try_enqueue(boxed)) {
+            run(boxed);
+        }
+    }
+
+    void wait_idle() {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    using Task = std::function<void()>;
+
+    void run(Task* task) {
+        (*task)();
+        delete task;
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    std::unique_ptr<typename MutexQueue<Task*, Capacity>::Sink> sink_;
+    std::unique_ptr<typename MutexQueue<Task*, Capacity>::Source> source_;
+    std::atomic<std::size_t> pending_;
+    std::atomic<bool> stopping_;
+    std::vector<std::thread> workers_;
+};
+
+// Forks two children per task down to `depth`, touching one shared counter per leaf
+template <typename Scheduler>
+void spawn_tree(Scheduler& pool, std::atomic<int>& leaves, int depth) {
+    if (depth == 0) {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pool.submit([&pool, &leaves, depth]() { spawn_tree(pool, leaves, depth - 1); });
+    pool.submit([&pool, &leaves, depth]() { spawn_tree(pool, leaves, depth - 1); });
+}
+
+// Benchmark: a binary tree of 2^(depth+1) - 1 tasks forked from one externally submitted root.
+// "ops" are tasks run, so ops/sec is the scheduler's task throughput; `capacity` is the task
+// queue size (per worker for ThreadPool).
+template <typename Scheduler>
+BenchmarkResult benchmark_fork_join(
+    const std::string& queue_type, int workers, std::size_t capacity, int depth
+) {
+    std::cout << "\n=== Benchmark: " << queue_type << " fork-join (" << workers
+              << " workers) ===" << std::endl;
+    const int tasks = (1 << (depth + 1)) - 1;
+    std::cout << "Tree depth: " << depth << ", Tasks: " << tasks << std::endl;
+
+    std::atomic<int> leaves { 0 };
+    Scheduler pool(workers);
+    Timer timer;
+    pool.submit([&pool, &leaves, depth]() { spawn_tree(pool, leaves, depth); });
+    pool.wait_idle();
+    const double elapsed = timer.elapsed_us();
+    if (leaves.load() != (1 << depth)) {
+        std::cerr << "Error: " << queue_type << " ran " << leaves.load() << " of " << (1 << depth)
+                  << " leaf tasks" << std::endl;
+    }
+
+    double ops_per_sec = tasks / (elapsed / 1e6);
+    std::cout << "Tasks: " << tasks << std::endl;
+    std::cout << "Time: " << std::fixed << std::setprecision(2) << elapsed << " μs" << std::endl;
+    std::cout << "Throughput: " << std::scientific << ops_per_sec << " tasks/sec" << std::endl;
+
+    const std::string name = queue_type + " (" + std::to_string(workers) + " workers)";
+    return { name, "Fork-join", capacity, tasks, 1, elapsed, ops_per_sec };
+}
+
+// Nanoseconds on the steady clock; producers stamp payloads with it
+inline std::uint64_t now_ns() {
+    const auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count()
+    );
+}
+
+// Benchmark: enqueue-to-dequeue latency. The producer stamps every message of a batch with the
+// time it starts enqueueing the batch; the consumer records `now - stamp` per message. With
+// `rate` > 0 the producer paces batches to that many messages per second, so the histogram shows
+// latency below saturation rather than queueing delay.
+template <typename SinkT, typename SourceT>
+BenchmarkResult run_latency(
+    const std::string& queue_type, std::size_t capacity, SinkT sink, SourceT source,
+    int iterations, int batch_size, double rate
+) {
+    std::cout << "\n=== Benchmark: Latency (" << queue_type << ") ===" << std::endl;
+    std::cout << "Iterations: " << iterations << ", Batch Size: " << batch_size;
+    if (rate > 0) std::cout << ", Rate: " << std::fixed << std::setprecision(0) << rate << " msg/s";
+    std::cout << std::endl;
+
+    Timer timer;
+    std::thread producer([&sink, iterations, batch_size, rate]() {
+        pin_to_cpu(placement.producer_cpu);
+        std::vector<std::uint64_t> batch(batch_size);
+        const std::uint64_t start = now_ns();
+        const double batch_interval_ns = (rate > 0) ? 1e9 * batch_size / rate : 0.0;
+        for (int iter = 0; iter < iterations; ++iter) {
+            if (rate > 0) {
+                const auto due = start + static_cast<std::uint64_t>(iter * batch_interval_ns);
+                while (now_ns() < due) std::this_thread::yield();
+            }
+            const std::uint64_t stamp = now_ns();
+            if (batch_size == 1) {
+                while (!sink.try_enqueue(stamp)) std::this_thread::yield();
+                continue;
+            }
+            std::fill(batch.begin(), batch.end(), stamp);
+            std::size_t sent = 0;
+            while (sent < batch.size()) {
+                const std::size_t n = sink.try_enqueue(batch.data() + sent, batch.size() - sent);
+                if (n == 0) std::this_thread::yield();
+                sent += n;
+            }
+        }
+        flush_sink(sink);
+    });
+
+    LatencyHistogram histogram;
+    std::thread consumer([&source, &histogram, iterations, batch_size]() {
+        pin_to_cpu(placement.consumer_cpu);
+        std::vector<std::uint64_t> batch(batch_size);
+        const std::size_t target = static_cast<std::size_t>(iterations) * batch_size;
+        std::size_t consumed = 0;
+        while (consumed < target) {
+            const std::size_t n = source.try_dequeue(batch.data(), batch.size());
+            if (n == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            const std::uint64_t now = now_ns();
+            for (std::size_t i = 0; i < n; ++i) histogram.record(now - batch[i]);
+            consumed += n;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    double elapsed = timer.elapsed_us();
+    double ops_per_sec = (iterations * batch_size * 2.0) / (elapsed / 1e6);
+    const LatencyStats latency = histogram.stats();
+
+    std::cout << "Latency: p50 " << std::fixed << std::setprecision(0) << latency.p50_ns
+              << " ns, p90 " << latency.p90_ns << " ns, p99 " << latency.p99_ns << " ns, p99.9 "
+              << latency.p999_ns << " ns, max " << latency.max_ns << " ns" << std::endl;
+    std::cout << "Time: " << std::setprecision(2) << elapsed << " μs" << std::endl;
+    std::cout << "Throughput: " << std::scientific << ops_per_sec << " ops/sec" << std::endl;
+    print_queue_stats(source);
+
+    std::string operation_type = "Latency";
+    if (rate > 0) operation_type += " (" + std::to_string(static_cast<long long>(rate)) + "/s)";
+    return {
+        queue_type, operation_type, capacity, iterations, batch_size, elapsed, ops_per_sec,
+        latency, sizeof(std::uint64_t)
+    };
+}
+
+// Latency runs for the three SPSC-shaped queues at one capacity
+template <std::size_t Capacity>
+void benchmark_latency_queues(
+    std::vector<BenchmarkResult>& results, int iterations, int batch_size, double rate
+) {
+    {
+        auto [sink, source] = SPSC<std::uint64_t, Capacity>::make_queue();
+        results.push_back(run_latency(
+            "SPSC", Capacity, std::move(sink), std::move(source), iterations, batch_size, rate
+        ));
+    }
+    {
+        auto [sink, source] = MmapSPSC<std::uint64_t, Capacity>::create(placement.numa_node);
+        results.push_back(run_latency(
+            "MmapSPSC", Capacity, std::move(sink), std::move(source), iterations, batch_size, rate
+        ));
+    }
+    {
+        auto [sink, source] = MutexQueue<std::uint64_t, Capacity>::make_queue();
+        results.push_back(run_latency(
+            "MutexQueue", Capacity, std::move(sink), std::move(source), iterations, batch_size,
+            rate
+        ));
+    }
+}
+
+// Helper function to escape CSV fields
+std::string escape_csv_field(const std::string& field) {
+    // If the field contains comma, quote, or newline, wrap it in quotes and escape quotes
+    bool needs_escape = false;
+    for (auto& c : field) {
+        if (c == ',' || c == '"' || c == '\n' || c == '\r') {
+            needs_escape = true;
+            break;
+        }
     }
 
     if (needs_escape) {
@@ -381,7 +1343,8 @@ bool write_csv(const std::string& filename, const std::vector<BenchmarkResult>&
     }
 
     // Write CSV header
-    file << "queue_type,operation_type,capacity,iterations,batch_size,elapsed_us,ops_per_sec\r\n";
+    file << "queue_type,operation_type,capacity,iterations,batch_size,elapsed_us,ops_per_sec,"
+            "payload_bytes,gb_per_sec,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\r\n";
 
     // Write data rows
     for (const auto& result : results) {
@@ -389,7 +1352,18 @@ bool write_csv(const std::string& filename, const std::vector<BenchmarkResult>&
              << escape_csv_field(result.operation_type) << "," << result.capacity << ","
              << result.iterations << "," << result.batch_size << "," << std::fixed
              << std::setprecision(2) << result.elapsed_us << "," << std::scientific
-             << std::setprecision(6) << result.ops_per_sec << "\r\n";
+             << std::setprecision(6) << result.ops_per_sec << "," << result.payload_bytes << ","
+             << std::fixed << std::setprecision(3) << result.gb_per_sec();
+        // Latency columns stay empty for throughput runs
+        if (result.latency.has_value()) {
+            const LatencyStats& latency = *result.latency;
+            file << std::fixed << std::setprecision(0) << "," << latency.p50_ns << ","
+                 << latency.p90_ns << "," << latency.p99_ns << "," << latency.p999_ns << ","
+                 << latency.max_ns;
+        } else {
+            file << ",,,,,";
+        }
+        file << "\r\n";
     }
 
     // Check for write errors before reporting success
@@ -401,21 +1375,26 @@ bool write_csv(const std::string& filename, const std::vector<BenchmarkResult>&
     return true;
 }
 
+// Batch configurations shared by the throughput and latency runs: (iterations, batch size)
+std::vector<std::pair<int, int>> batch_configs() {
+    return {
+        { 1000000, 1 }, // Many individual ops
+        { 100000, 10 }, // Small batches
+        { 10000, 100 }, // Medium batches
+        { 1000, 1000 }, // Large batches
+        { 100, 10000 }, // Very large batches
+    };
+}
+
 // Benchmark with varying batch sizes
-std::vector<BenchmarkResult> benchmark_comparison() {
+std::vector<BenchmarkResult> benchmark_comparison(const std::string& wait) {
     std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
     std::cout << "║           SPSC vs MutexQueue Performance Comparison        ║" << std::endl;
     std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
 
     std::vector<BenchmarkResult> results;
 
-    std::vector<std::pair<int, int>> configs = {
-        { 1000000, 1 }, // Many individual ops
-        { 100000, 10 }, // Small batches
-        { 10000, 100 }, // Medium batches
-        { 1000, 1000 }, // Large batches
-        { 100, 10000 }, // Very large batches
-    };
+    const std::vector<std::pair<int, int>> configs = batch_configs();
 
     std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
     std::cout << "│ Config: varied batch sizes                                  │" << std::endl;
@@ -429,8 +1408,11 @@ std::vector<BenchmarkResult> benchmark_comparison() {
                   << " batch size" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
 
-        results.push_back(benchmark_individual_ops<64>(iterations, batch_size));
-        results.push_back(benchmark_bulk_ops<64>(iterations, batch_size));
+        benchmark_ops<SPSC<int, 64>>(results, "SPSC", 64, iterations, batch_size);
+        results.push_back(benchmark_individual_ops_uncached<64>(iterations, batch_size));
+        benchmark_ops<SPSC<int, dynamic_extent>>(
+            results, "SPSC (dynamic)", 64, iterations, batch_size, 64, buffer_options()
+        );
     }
 
     std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
@@ -445,8 +1427,9 @@ std::vector<BenchmarkResult> benchmark_comparison() {
                   << " batch size" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
 
-        results.push_back(benchmark_individual_ops_mutex<64>(iterations, batch_size));
-        results.push_back(benchmark_bulk_ops_mutex<64>(iterations, batch_size));
+        benchmark_ops<MutexQueue<int, 64>>(results, "MutexQueue", 64, iterations, batch_size);
+        results.push_back(benchmark_blocking_ops_mutex<64>(false, iterations, batch_size));
+        results.push_back(benchmark_blocking_ops_mutex<64>(true, iterations, batch_size));
     }
 
     std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
@@ -461,8 +1444,9 @@ std::vector<BenchmarkResult> benchmark_comparison() {
                   << " batch size" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
 
-        results.push_back(benchmark_individual_ops_mmap<64>(iterations, batch_size));
-        results.push_back(benchmark_bulk_ops_mmap<64>(iterations, batch_size));
+        benchmark_ops<MmapSPSC<int, 64>>(
+            results, "MmapSPSC", 64, iterations, batch_size, placement.numa_node
+        );
     }
 
     std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
@@ -477,8 +1461,11 @@ std::vector<BenchmarkResult> benchmark_comparison() {
                   << " batch size" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
 
-        results.push_back(benchmark_individual_ops<4096>(iterations, batch_size));
-        results.push_back(benchmark_bulk_ops<4096>(iterations, batch_size));
+        benchmark_ops<SPSC<int, 4096>>(results, "SPSC", 4096, iterations, batch_size);
+        results.push_back(benchmark_individual_ops_uncached<4096>(iterations, batch_size));
+        benchmark_ops<SPSC<int, dynamic_extent>>(
+            results, "SPSC (dynamic)", 4096, iterations, batch_size, 4096, buffer_options()
+        );
     }
 
     std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
@@ -493,8 +1480,9 @@ std::vector<BenchmarkResult> benchmark_comparison() {
                   << " batch size" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
 
-        results.push_back(benchmark_individual_ops_mutex<4096>(iterations, batch_size));
-        results.push_back(benchmark_bulk_ops_mutex<4096>(iterations, batch_size));
+        benchmark_ops<MutexQueue<int, 4096>>(results, "MutexQueue", 4096, iterations, batch_size);
+        results.push_back(benchmark_blocking_ops_mutex<4096>(false, iterations, batch_size));
+        results.push_back(benchmark_blocking_ops_mutex<4096>(true, iterations, batch_size));
     }
 
     std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
@@ -509,8 +1497,106 @@ std::vector<BenchmarkResult> benchmark_comparison() {
                   << " batch size" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
 
-        results.push_back(benchmark_individual_ops_mmap<4096>(iterations, batch_size));
-        results.push_back(benchmark_bulk_ops_mmap<4096>(iterations, batch_size));
+        benchmark_ops<MmapSPSC<int, 4096>>(
+            results, "MmapSPSC", 4096, iterations, batch_size, placement.numa_node
+        );
+    }
+
+    std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│ Config: blocking enqueue/dequeue                            │" << std::endl;
+    std::cout << "│ Queue capacity: 64                                          │" << std::endl;
+    std::cout << "│ Implementation: SPSC, wait strategy from --wait             │" << std::endl;
+    std::cout << "└─────────────────────────────────────────────────────────────┘" << std::endl;
+
+    std::vector<std::pair<int, int>> blocking_configs = {
+        { 100000, 1 },
+        { 10000, 100 },
+    };
+
+    for (const auto& [iterations, batch_size] : blocking_configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        benchmark_wait_strategies<64>(results, wait, iterations, batch_size);
+    }
+
+    std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│ Config: 1-16 producer and consumer threads                  │" << std::endl;
+    std::cout << "│ Queue capacity: 4096                                        │" << std::endl;
+    std::cout << "│ Implementation: MPMC (lock-free, per-slot sequence)         │" << std::endl;
+    std::cout << "└─────────────────────────────────────────────────────────────┘" << std::endl;
+
+    std::vector<std::pair<int, int>> mpmc_configs = {
+        { 1000000, 1 },
+        { 10000, 100 },
+    };
+
+    for (const auto& [iterations, batch_size] : mpmc_configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        for (int threads : { 1, 2, 4, 8, 16 }) {
+            results.push_back(benchmark_mpmc<4096>(threads, iterations, batch_size));
+        }
+    }
+
+    std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│ Config: 1-16 producers, 1 consumer                          │" << std::endl;
+    std::cout << "│ Queue capacity: 4096                                        │" << std::endl;
+    std::cout << "│ Implementation: MPSC vs MutexQueue                          │" << std::endl;
+    std::cout << "└─────────────────────────────────────────────────────────────┘" << std::endl;
+
+    for (const auto& [iterations, batch_size] : mpmc_configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        for (int producers : { 1, 2, 4, 8, 16 }) {
+            results.push_back(benchmark_mpsc<4096>(producers, iterations, batch_size));
+            results.push_back(benchmark_mpsc_mutex<4096>(producers, iterations, batch_size));
+        }
+    }
+
+#if defined(__linux__)
+    std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│ Config: producer and consumer in separate processes         │" << std::endl;
+    std::cout << "│ Queue capacity: 1024                                        │" << std::endl;
+    std::cout << "│ Implementation: MmapSPSC::create_shared + SharedParkingWait │" << std::endl;
+    std::cout << "└─────────────────────────────────────────────────────────────┘" << std::endl;
+
+    results.push_back(benchmark_ipc_ping_pong<1024>(100000));
+#endif
+
+    // Large batches: the double-mapped ring copies each batch in one contiguous pass
+    std::vector<std::pair<int, int>> large_configs = {
+        { 1000, 1024 },
+        { 250, 4096 },
+        { 60, 16384 },
+    };
+
+    std::cout << "\n┌─────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│ Config: large batch sizes                                   │" << std::endl;
+    std::cout << "│ Queue capacity: 65536                                       │" << std::endl;
+    std::cout << "│ Implementation: SPSC vs MmapSPSC (bulk)                     │" << std::endl;
+    std::cout << "└─────────────────────────────────────────────────────────────┘" << std::endl;
+
+    for (const auto& [iterations, batch_size] : large_configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        results.push_back(
+            benchmark_ops<SPSC<int, 65536>>("SPSC", 65536, iterations, batch_size, true)
+        );
+        results.push_back(benchmark_ops<MmapSPSC<int, 65536>>(
+            "MmapSPSC", 65536, iterations, batch_size, true, placement.numa_node
+        ));
     }
 
     std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
@@ -520,39 +1606,1531 @@ std::vector<BenchmarkResult> benchmark_comparison() {
     return results;
 }
 
-int main(int argc, char* argv[]) {
-    std::cout << "Queue Performance Benchmark: SPSC vs MutexQueue vs MmapSPSC\n" << std::endl;
+// Matrix mode axes; CLI filters pick a subset of each
+const std::vector<std::string> matrix_queues = { "spsc", "mmap", "mutex", "mpmc", "mpsc" };
+const std::vector<std::string> matrix_payloads = { "8", "64", "256", "1024", "4096", "string" };
+const std::vector<std::string> matrix_capacities = { "1024", "65536", "1048576" };
+const std::vector<std::string> matrix_batches = { "1", "32", "1024" };
+
+// Rings larger than this are skipped (e.g. 1M slots of 4 KiB)
+constexpr std::size_t matrix_max_ring_bytes = std::size_t(256) << 20;
+// Each case moves at most this many messages and this many payload bytes
+constexpr std::size_t matrix_max_messages = std::size_t(1) << 20;
+constexpr std::size_t matrix_max_bytes = std::size_t(256) << 20;
+
+// Comma-separated selections from --queue, --payload, --capacity, --batch ("all" = every value)
+struct MatrixFilter {
+    std::string queue = "all";
+    std::string payload = "all";
+    std::string capacity = "all";
+    std::string batch = "all";
+
+    static bool selects(const std::string& list, const std::string& value) {
+        if (list == "all") return true;
+        std::stringstream items(list);
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            if (item == value) return true;
+        }
+        return false;
+    }
+};
 
-    // Parse command-line arguments
-    std::string csv_path;
-    for (int i = 1; i < argc; ++i) {
-        if (std::strcmp(argv[i], "--csv") == 0) {
-            if (i + 1 >= argc) {
-                std::cerr << "Error: --csv requires a file path argument" << std::endl;
-                return 1;
-            }
-            csv_path = argv[++i];
-            // Early validation: try to open the file for writing
-            std::ofstream test_file(csv_path);
-            if (!test_file.is_open()) {
-                std::cerr << "Error: Cannot write to CSV file: " << csv_path << std::endl;
-                return 1;
-            }
-        } else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
-            std::cout << "Usage: " << argv[0] << " [OPTIONS]\n\n";
-            std::cout << "Options:\n";
-            std::cout << "  --csv <path>    Write benchmark results to a CSV file\n";
-            std::cout << "  --help, -h      Show this help message\n";
-            return 0;
-        } else {
-            std::cerr << "Error: Unknown option: " << argv[i] << std::endl;
-            std::cerr << "Use --help for usage information." << std::endl;
-            return 1;
+// Matrix cell: every selected queue for one payload type, capacity, and batch size
+template <typename T, std::size_t Capacity>
+void benchmark_matrix_queues(
+    std::vector<BenchmarkResult>& results, const MatrixFilter& filter, int batch_size
+) {
+    const std::size_t messages =
+        std::min(matrix_max_messages, matrix_max_bytes / PayloadTraits<T>::bytes);
+    const int iterations = static_cast<int>(std::max<std::size_t>(messages / batch_size, 1));
+    const bool bulk = batch_size > 1;
+
+    if (MatrixFilter::selects(filter.queue, "spsc")) {
+        results.push_back(
+            benchmark_ops<SPSC<T, Capacity>>("SPSC", Capacity, iterations, batch_size, bulk)
+        );
+    }
+    if (MatrixFilter::selects(filter.queue, "mmap")) {
+        results.push_back(benchmark_ops<MmapSPSC<T, Capacity>>(
+            "MmapSPSC", Capacity, iterations, batch_size, bulk, placement.numa_node
+        ));
+    }
+    if (MatrixFilter::selects(filter.queue, "mutex")) {
+        results.push_back(benchmark_ops<MutexQueue<T, Capacity>>(
+            "MutexQueue", Capacity, iterations, batch_size, bulk
+        ));
+    }
+    if (MatrixFilter::selects(filter.queue, "mpmc")) {
+        results.push_back(benchmark_ops<MPMC<T, Capacity>>(
+            "MPMC (1P/1C)", Capacity, iterations, batch_size, bulk
+        ));
+    }
+    if (MatrixFilter::selects(filter.queue, "mpsc")) {
+        results.push_back(benchmark_ops<MPSC<T, Capacity>>(
+            "MPSC (1P/1C)", Capacity, iterations, batch_size, bulk
+        ));
+    }
+}
+
+// Matrix row: one payload type at one capacity, over the selected batch sizes
+template <typename T, std::size_t Capacity>
+void benchmark_matrix_capacity(
+    std::vector<BenchmarkResult>& results, const MatrixFilter& filter, const std::string& payload
+) {
+    if (!MatrixFilter::selects(filter.capacity, std::to_string(Capacity))) return;
+
+    std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << "Payload: " << payload << " (" << PayloadTraits<T>::bytes
+              << " B), capacity: " << Capacity << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+    if constexpr (Capacity * sizeof(T) > matrix_max_ring_bytes) {
+        std::cout << "Skipped: ring would exceed " << (matrix_max_ring_bytes >> 20) << " MiB"
+                  << std::endl;
+    } else {
+        for (const std::string& batch : matrix_batches) {
+            if (!MatrixFilter::selects(filter.batch, batch)) continue;
+            benchmark_matrix_queues<T, Capacity>(results, filter, std::stoi(batch));
         }
     }
+}
 
-    // Run benchmarks
-    auto results = benchmark_comparison();
+template <typename T>
+void benchmark_matrix_payload(
+    std::vector<BenchmarkResult>& results, const MatrixFilter& filter, const std::string& payload
+) {
+    if (!MatrixFilter::selects(filter.payload, payload)) return;
+    benchmark_matrix_capacity<T, 1024>(results, filter, payload);
+    benchmark_matrix_capacity<T, 65536>(results, filter, payload);
+    benchmark_matrix_capacity<T, 1048576>(results, filter, payload);
+}
+
+// Matrix mode: payload type x capacity x batch size x queue, restricted by `filter`
+std::vector<BenchmarkResult> benchmark_matrix(const MatrixFilter& filter) {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║         Payload x Capacity x Batch Size Matrix             ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    benchmark_matrix_payload<Payload<8>>(results, filter, "8");
+    benchmark_matrix_payload<Payload<64>>(results, filter, "64");
+    benchmark_matrix_payload<Payload<256>>(results, filter, "256");
+    benchmark_matrix_payload<Payload<1024>>(results, filter, "1024");
+    benchmark_matrix_payload<Payload<4096>>(results, filter, "4096");
+    benchmark_matrix_payload<std::string>(results, filter, "string");
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Sweep mode: SPSC throughput for every (producer CPU, consumer CPU) pair the process may use
+std::vector<BenchmarkResult> benchmark_cpu_sweep() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║            SPSC Throughput by CPU Placement                ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    const std::vector<int> cpus = allowed_cpus();
+    std::vector<BenchmarkResult> results;
+
+    for (int producer_cpu : cpus) {
+        for (int consumer_cpu : cpus) {
+            placement.producer_cpu = producer_cpu;
+            placement.consumer_cpu = consumer_cpu;
+            BenchmarkResult result =
+                benchmark_ops<SPSC<int, 4096>>("SPSC", 4096, 1000000, 1, false);
+            result.queue_type = "SPSC (cpu " + std::to_string(producer_cpu) + "->"
+                + std::to_string(consumer_cpu) + ")";
+            results.push_back(result);
+        }
+    }
+    placement.producer_cpu = -1;
+    placement.consumer_cpu = -1;
+
+    // Matrix: rows are producer CPUs, columns consumer CPUs, cells Mops/sec
+    std::cout << "\nMops/sec (rows: producer CPU, columns: consumer CPU)" << std::endl;
+    std::cout << std::setw(6) << "";
+    for (int cpu : cpus) std::cout << std::setw(8) << cpu;
+    std::cout << std::endl;
+    std::size_t index = 0;
+    for (int producer_cpu : cpus) {
+        std::cout << std::setw(6) << producer_cpu;
+        for (std::size_t c = 0; c < cpus.size(); ++c) {
+            std::cout << std::setw(8) << std::fixed << std::setprecision(1)
+                      << results[index++].ops_per_sec / 1e6;
+        }
+        std::cout << std::endl;
+    }
+
+    return results;
+}
+
+// Large messages: SPSC of heap-allocated payloads (a `new` on the producer, a `delete` on the
+// consumer) versus a Pool whose slots flow back to the producer. Both sides write and check the
+// whole payload, so the difference is the allocator round trip.
+constexpr std::size_t pool_capacity = 256;
+
+template <std::size_t Bytes>
+void fill_payload(Payload<Bytes>& payload, std::uint64_t value) {
+    std::fill(payload.words.begin(), payload.words.end(), value);
+}
+
+template <std::size_t Bytes>
+bool check_payload(const Payload<Bytes>& payload, std::uint64_t value) {
+    return payload.words.front() == value && payload.words.back() == value;
+}
+
+template <std::size_t Bytes>
+BenchmarkResult finish_pool_run(
+    const std::string& queue_type, const Timer& timer, int iterations, std::size_t failures
+) {
+    const double elapsed = timer.elapsed_us();
+    const double ops_per_sec = (iterations * 2.0) / (elapsed / 1e6);
+    BenchmarkResult result {
+        queue_type, "Individual", pool_capacity, iterations, 1, elapsed, ops_per_sec, std::nullopt,
+        Bytes
+    };
+    if (failures != 0) std::cerr << "Error: " << failures << " corrupted messages" << std::endl;
+    std::cout << queue_type << ": " << std::fixed << std::setprecision(2) << elapsed << " μs, "
+              << std::scientific << ops_per_sec << " ops/sec, " << std::fixed
+              << std::setprecision(3) << result.gb_per_sec() << " GB/s" << std::endl;
+    return result;
+}
+
+template <std::size_t Bytes>
+BenchmarkResult benchmark_unique_ptr_payload(int iterations) {
+    using Message = std::unique_ptr<Payload<Bytes>>;
+    auto [sink, source] = SPSC<Message, pool_capacity>::make_queue();
+    std::size_t failures = 0;
+
+    Timer timer;
+    std::thread producer([&sink = sink, iterations]() {
+        pin_to_cpu(placement.producer_cpu);
+        for (int i = 0; i < iterations; ++i) {
+            Message message(new Payload<Bytes>);
+            fill_payload(*message, static_cast<std::uint64_t>(i));
+            while (!sink.try_enqueue(std::move(message))) std::this_thread::yield();
+        }
+    });
+    std::thread consumer([&source = source, &failures, iterations]() {
+        pin_to_cpu(placement.consumer_cpu);
+        for (int i = 0; i < iterations;) {
+            auto message = source.try_dequeue();
+            if (!message.has_value()) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (!check_payload(**message, static_cast<std::uint64_t>(i))) ++failures;
+            ++i;
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    return finish_pool_run<Bytes>("SPSC (unique_ptr)", timer, iterations, failures);
+}
+
+template <std::size_t Bytes>
+BenchmarkResult benchmark_pooled_payload(int iterations) {
+    auto [sink, source] = make_pooled_queue<Payload<Bytes>, pool_capacity>(buffer_options());
+    std::size_t failures = 0;
+
+    Timer timer;
+    std::thread producer([&sink = sink, iterations]() {
+        pin_to_cpu(placement.producer_cpu);
+        for (int i = 0; i < iterations; ++i) {
+            auto slot = sink.try_acquire();
+            while (!slot.has_value()) {
+                std::this_thread::yield();
+                slot = sink.try_acquire();
+            }
+            fill_payload(**slot, static_cast<std::uint64_t>(i));
+            sink.enqueue(std::move(*slot));
+        }
+    });
+    std::thread consumer([&source = source, &failures, iterations]() {
+        pin_to_cpu(placement.consumer_cpu);
+        for (int i = 0; i < iterations;) {
+            auto slot = source.try_dequeue();
+            if (!slot.has_value()) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (!check_payload(**slot, static_cast<std::uint64_t>(i))) ++failures;
+            ++i;
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    return finish_pool_run<Bytes>("Pool", timer, iterations, failures);
+}
+
+template <std::size_t Bytes>
+void benchmark_pool_payload(std::vector<BenchmarkResult>& results) {
+    // About 1 GiB of payload per run
+    const int iterations = static_cast<int>((std::size_t(1) << 30) / Bytes);
+    std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << "Payload: " << Bytes << " B, " << iterations << " messages" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+    results.push_back(benchmark_unique_ptr_payload<Bytes>(iterations));
+    results.push_back(benchmark_pooled_payload<Bytes>(iterations));
+}
+
+// Pool mode: pooled slots versus heap-allocated messages at 1 KiB to 64 KiB
+std::vector<BenchmarkResult> benchmark_pool() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║          Pooled Slots vs unique_ptr Messages               ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    benchmark_pool_payload<1024>(results);
+    benchmark_pool_payload<4096>(results);
+    benchmark_pool_payload<16384>(results);
+    benchmark_pool_payload<65536>(results);
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// How a single-element run hands values over: through a temporary `T` and a returned optional
+// (the pre-emplace API), straight into the slot and into a reused out-parameter, or through
+// emplace() and a try_consume() callback that reads the element where it lies
+enum class HandOff { temporary, direct, in_place };
+
+const char* hand_off_name(HandOff hand_off) {
+    switch (hand_off) {
+    case HandOff::temporary:
+        return "T(value) + optional";
+    case HandOff::direct:
+        return "try_enqueue + try_dequeue(T&)";
+    case HandOff::in_place:
+        return "emplace + try_consume";
+    }
+    return "";
+}
+
+// The consumer folds one field of every element into a checksum, so each style reads the data
+std::uint64_t payload_tag(const std::string& value) {
+    return value.size() + static_cast<unsigned char>(value.front());
+}
+
+template <std::size_t Bytes>
+std::uint64_t payload_tag(const Payload<Bytes>& payload) {
+    return payload.words.front();
+}
+
+template <typename T, typename SinkT, typename SourceT>
+BenchmarkResult benchmark_hand_off(
+    const std::string& queue_type, std::size_t capacity, SinkT sink, SourceT source,
+    HandOff hand_off, int messages
+) {
+    std::vector<T> batch;
+    for (int i = 0; i < 64; ++i) batch.push_back(PayloadTraits<T>::make(i));
+    std::uint64_t expected = 0;
+    for (int i = 0; i < messages; ++i) expected += payload_tag(batch[i % batch.size()]);
+
+    Timer timer;
+    std::thread producer([&sink, &batch, hand_off, messages]() {
+        pin_to_cpu(placement.producer_cpu);
+        for (int i = 0; i < messages; ++i) {
+            const T& value = batch[i % batch.size()];
+            if (hand_off == HandOff::temporary) {
+                while (!sink.try_enqueue(T(value))) std::this_thread::yield();
+            } else if (hand_off == HandOff::direct) {
+                while (!sink.try_enqueue(value)) std::this_thread::yield();
+            } else {
+                while (!sink.emplace(value)) std::this_thread::yield();
+            }
+        }
+    });
+    std::uint64_t checksum = 0;
+    std::thread consumer([&source, &checksum, hand_off, messages]() {
+        pin_to_cpu(placement.consumer_cpu);
+        T out {};
+        for (int i = 0; i < messages;) {
+            bool got = false;
+            if (hand_off == HandOff::temporary) {
+                if (auto value = source.try_dequeue()) {
+                    checksum += payload_tag(*value);
+                    got = true;
+                }
+            } else if (hand_off == HandOff::direct) {
+                got = source.try_dequeue(out);
+                if (got) checksum += payload_tag(out);
+            } else {
+                got = source.try_consume([&checksum](T& value) { checksum += payload_tag(value); });
+            }
+            if (got) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    const double elapsed = timer.elapsed_us();
+    const double ops_per_sec = (messages * 2.0) / (elapsed / 1e6);
+    BenchmarkResult result {
+        queue_type, hand_off_name(hand_off), capacity, messages, 1, elapsed, ops_per_sec,
+        std::nullopt, PayloadTraits<T>::bytes
+    };
+    if (checksum != expected) std::cerr << "Error: checksum mismatch" << std::endl;
+    std::cout << std::left << std::setw(32) << hand_off_name(hand_off) << std::right << std::fixed
+              << std::setprecision(2) << elapsed << " μs, " << std::scientific << ops_per_sec
+              << " ops/sec" << std::endl;
+    return result;
+}
+
+template <typename T>
+void benchmark_hand_off_payload(
+    std::vector<BenchmarkResult>& results, const std::string& payload, int messages
+) {
+    constexpr std::size_t capacity = 1024;
+    constexpr HandOff hand_offs[] = { HandOff::temporary, HandOff::direct, HandOff::in_place };
+    std::cout << "\nSPSC, " << payload << ":" << std::endl;
+    for (HandOff hand_off : hand_offs) {
+        auto [sink, source] = SPSC<T, capacity>::make_queue();
+        results.push_back(benchmark_hand_off<T>(
+            "SPSC (" + payload + ")", capacity, std::move(sink), std::move(source), hand_off,
+            messages
+        ));
+    }
+    std::cout << "\nMmapSPSC, " << payload << ":" << std::endl;
+    for (HandOff hand_off : hand_offs) {
+        auto [sink, source] = MmapSPSC<T, capacity>::create(placement.numa_node);
+        results.push_back(benchmark_hand_off<T>(
+            "MmapSPSC (" + payload + ")", capacity, std::move(sink), std::move(source), hand_off,
+            messages
+        ));
+    }
+}
+
+// In-place mode: the optional-returning, copy-through-a-temporary API against try_dequeue(T&),
+// emplace() and try_consume() for heap-backed strings and 256-byte trivially copyable payloads
+std::vector<BenchmarkResult> benchmark_in_place() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║        Element Hand-Off: Temporaries vs In-Place           ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    constexpr int messages = 2000000;
+    std::vector<BenchmarkResult> results;
+    benchmark_hand_off_payload<std::string>(results, "string", messages);
+    benchmark_hand_off_payload<Payload<256>>(results, "256 B", messages);
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Consumer side of one drain run: a `try_dequeue()` loop when `drain` is false, otherwise
+// `Source::drain()` releasing the head once per call (`release_every == 0`) or in groups. The
+// producer feeds the queue with bulk enqueues so the consumer is the side being measured.
+template <typename SinkT, typename SourceT>
+BenchmarkResult run_drain(
+    const std::string& queue_type, std::size_t capacity, SinkT sink, SourceT source,
+    int messages, bool drain, std::size_t release_every
+) {
+    std::string operation_type = drain ? "Drain" : "try_dequeue loop";
+    if (drain && release_every != 0) {
+        operation_type += " (release every " + std::to_string(release_every) + ")";
+    }
+
+    std::vector<int> batch(256);
+    for (std::size_t i = 0; i < batch.size(); ++i) batch[i] = static_cast<int>(i);
+    const int batches = messages / static_cast<int>(batch.size());
+
+    Timer timer;
+    std::thread producer([&sink, &batch, batches]() {
+        pin_to_cpu(placement.producer_cpu);
+        for (int b = 0; b < batches; ++b) {
+            std::size_t enqueued = 0;
+            while (enqueued < batch.size()) {
+                enqueued += sink.try_enqueue(batch.data() + enqueued, batch.size() - enqueued);
+                if (enqueued < batch.size()) std::this_thread::yield();
+            }
+        }
+    });
+    std::uint64_t checksum = 0;
+    std::thread consumer([&source, &checksum, drain, release_every, batches, &batch]() {
+        pin_to_cpu(placement.consumer_cpu);
+        const std::size_t target = static_cast<std::size_t>(batches) * batch.size();
+        std::size_t consumed = 0;
+        while (consumed < target) {
+            std::size_t n = 0;
+            if (drain) {
+                n = source.drain(
+                    [&checksum](int& value) { checksum += static_cast<std::uint64_t>(value); },
+                    std::numeric_limits<std::size_t>::max(), release_every
+                );
+            } else {
+                while (auto value = source.try_dequeue()) {
+                    checksum += static_cast<std::uint64_t>(*value);
+                    ++n;
+                }
+            }
+            consumed += n;
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    const double elapsed = timer.elapsed_us();
+    const int total = batches * static_cast<int>(batch.size());
+    const double ops_per_sec = (total * 2.0) / (elapsed / 1e6);
+    const std::uint64_t expected = static_cast<std::uint64_t>(batches) * (255 * 256 / 2);
+    if (checksum != expected) std::cerr << "Error: checksum mismatch" << std::endl;
+    std::cout << std::left << std::setw(32) << operation_type << std::right << std::fixed
+              << std::setprecision(2) << elapsed << " μs, " << std::scientific << ops_per_sec
+              << " ops/sec" << std::endl;
+    return {
+        queue_type, operation_type, capacity, total, 1, elapsed, ops_per_sec, std::nullopt,
+        sizeof(int)
+    };
+}
+
+template <typename Queue, typename... Args>
+void benchmark_drain_queue(
+    std::vector<BenchmarkResult>& results, const std::string& queue_type, std::size_t capacity,
+    int messages, const Args&... args
+) {
+    std::cout << "\n" << queue_type << ":" << std::endl;
+    const std::pair<bool, std::size_t> runs[] = { { false, 0 }, { true, 0 }, { true, 64 } };
+    for (const auto& [drain, release_every] : runs) {
+        auto [sink, source] = Queue::make_queue(args...);
+        results.push_back(run_drain(
+            queue_type, capacity, std::move(sink), std::move(source), messages, drain,
+            release_every
+        ));
+    }
+}
+
+// Drain mode: per-element try_dequeue() loops against one drain() call per wakeup
+std::vector<BenchmarkResult> benchmark_drain() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║          Consumer Drain vs try_dequeue() Loops             ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    constexpr int messages = 10000000;
+    constexpr std::size_t capacity = 4096;
+    std::vector<BenchmarkResult> results;
+    benchmark_drain_queue<SPSC<int, capacity>>(results, "SPSC", capacity, messages);
+    benchmark_drain_queue<MmapSPSC<int, capacity>>(
+        results, "MmapSPSC", capacity, messages, placement.numa_node
+    );
+    benchmark_drain_queue<MutexQueue<int, capacity>>(results, "MutexQueue", capacity, messages);
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Publish-batch mode: SPSC single-element enqueues publishing the tail every N writes (and once
+// with a 10 μs budget), saturated throughput next to latency at a paced 1M msg/s
+std::vector<BenchmarkResult> benchmark_publish_batch() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║       Deferred Tail Publish: Throughput vs Latency         ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    constexpr std::size_t capacity = 4096;
+    const std::vector<PublishBatch> batches = {
+        { 1, {} }, { 4, {} }, { 16, {} }, { 64, {} }, { 64, std::chrono::microseconds(10) }
+    };
+    std::vector<BenchmarkResult> results;
+    for (const PublishBatch& batch : batches) {
+        std::string queue_type = "SPSC (publish every " + std::to_string(batch.every);
+        if (batch.max_delay.count() != 0) {
+            queue_type += ", " + std::to_string(batch.max_delay.count() / 1000) + " us";
+        }
+        queue_type += ")";
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << queue_type << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+        {
+            auto [sink, source] = SPSC<int, capacity>::make_queue();
+            sink.set_publish_batch(batch);
+            results.push_back(run_throughput<int>(
+                queue_type, capacity, std::move(sink), std::move(source), 100000, 100, false
+            ));
+        }
+        {
+            auto [sink, source] = SPSC<std::uint64_t, capacity>::make_queue();
+            sink.set_publish_batch(batch);
+            results.push_back(run_latency(
+                queue_type, capacity, std::move(sink), std::move(source), 200000, 1, 1e6
+            ));
+        }
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Variable-length records: sizes follow a fixed pseudo-random sequence in [min_size, max_size]
+struct RecordSizes {
+    std::size_t min_size;
+    std::size_t max_size;
+
+    std::size_t operator()(std::uint64_t seq) const {
+        return min_size + (seq * 7919) % (max_size - min_size + 1);
+    }
+
+    std::size_t average(int messages) const {
+        std::size_t total = 0;
+        for (int i = 0; i < messages; ++i) total += (*this)(static_cast<std::uint64_t>(i));
+        return total / static_cast<std::size_t>(messages);
+    }
+};
+
+BenchmarkResult finish_record_run(
+    const std::string& queue_type, const std::string& operation_type, std::size_t capacity,
+    const Timer& timer, int messages, const RecordSizes& sizes, std::size_t failures
+) {
+    const double elapsed = timer.elapsed_us();
+    const double ops_per_sec = (messages * 2.0) / (elapsed / 1e6);
+    BenchmarkResult result {
+        queue_type, operation_type, capacity, messages, 1, elapsed, ops_per_sec, std::nullopt,
+        sizes.average(messages)
+    };
+    if (failures != 0) std::cerr << "Error: " << failures << " corrupted records" << std::endl;
+    std::cout << queue_type << " (" << operation_type << "): " << std::fixed << std::setprecision(2)
+              << elapsed << " μs, " << std::scientific << ops_per_sec << " ops/sec, "
+              << std::fixed << std::setprecision(3) << result.gb_per_sec() << " GB/s" << std::endl;
+    return result;
+}
+
+// ByteSPSC: records written in place; the consumer drains all of them per head store, or walks
+// them one `front()` / `pop()` at a time
+template <std::size_t RingBytes>
+BenchmarkResult benchmark_byte_ring(int messages, const RecordSizes& sizes, bool drain) {
+    auto [sink, source] = ByteSPSC<RingBytes>::create(placement.numa_node);
+    std::size_t failures = 0;
+
+    Timer timer;
+    std::thread producer([&sink = sink, &sizes, messages]() {
+        pin_to_cpu(placement.producer_cpu);
+        for (int i = 0; i < messages; ++i) {
+            const std::size_t size = sizes(static_cast<std::uint64_t>(i));
+            auto record = sink.reserve(size);
+            while (record.data() == nullptr) {
+                std::this_thread::yield();
+                record = sink.reserve(size);
+            }
+            std::memset(record.data(), i & 0xff, size);
+            sink.commit();
+        }
+    });
+    std::thread consumer([&source = source, &sizes, &failures, messages, drain]() {
+        pin_to_cpu(placement.consumer_cpu);
+        int next = 0;
+        auto check = [&](Span<const std::byte> record) {
+            const std::size_t size = sizes(static_cast<std::uint64_t>(next));
+            if (record.size() != size || record[size - 1] != std::byte(next & 0xff)) ++failures;
+            ++next;
+        };
+        while (next < messages) {
+            std::size_t received = 0;
+            if (drain) {
+                received = source.drain(check);
+            } else if (auto record = source.front()) {
+                check(*record);
+                source.pop();
+                received = 1;
+            }
+            if (received == 0) std::this_thread::yield();
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    return finish_record_run(
+        "ByteSPSC", drain ? "Drain" : "Front/pop", RingBytes, timer, messages, sizes, failures
+    );
+}
+
+// Baseline: every record padded to the maximum size in an MmapSPSC of fixed-size slots, written
+// and read in place with reserve/commit and peek/consume
+template <std::size_t MaxBytes, std::size_t Slots>
+BenchmarkResult benchmark_padded_records(int messages, const RecordSizes& sizes) {
+    using Record = Payload<MaxBytes + 8>; // size word + payload
+    auto [sink, source] = MmapSPSC<Record, Slots>::create(placement.numa_node);
+    std::size_t failures = 0;
+
+    Timer timer;
+    std::thread producer([&sink = sink, &sizes, messages]() {
+        pin_to_cpu(placement.producer_cpu);
+        for (int i = 0; i < messages; ++i) {
+            auto slots = sink.reserve(1);
+            while (slots.empty()) {
+                std::this_thread::yield();
+                slots = sink.reserve(1);
+            }
+            const std::size_t size = sizes(static_cast<std::uint64_t>(i));
+            slots[0].words[0] = size;
+            std::memset(&slots[0].words[1], i & 0xff, size);
+            sink.commit(1);
+        }
+    });
+    std::thread consumer([&source = source, &sizes, &failures, messages]() {
+        pin_to_cpu(placement.consumer_cpu);
+        int next = 0;
+        while (next < messages) {
+            const auto records = source.peek();
+            for (const Record& record : records) {
+                const std::size_t size = sizes(static_cast<std::uint64_t>(next));
+                const auto* bytes = reinterpret_cast<const unsigned char*>(&record.words[1]);
+                if (record.words[0] != size || bytes[size - 1] != (next & 0xff)) ++failures;
+                ++next;
+            }
+            source.consume(records.size());
+            if (records.empty()) std::this_thread::yield();
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    return finish_record_run(
+        "MmapSPSC (padded)", "Peek/consume", Slots, timer, messages, sizes, failures
+    );
+}
+
+// Bytes mode: variable-length records through ByteSPSC versus slots padded to the maximum size
+std::vector<BenchmarkResult> benchmark_bytes() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║          Variable-Length Records (ByteSPSC)                ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    constexpr int messages = 200000;
+    std::vector<BenchmarkResult> results;
+
+    const RecordSizes small { 20, 256 };
+    std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << "Record sizes: 20-256 B, " << messages << " records, 1 MiB rings" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+    results.push_back(benchmark_byte_ring<1 << 20>(messages, small, true));
+    results.push_back(benchmark_byte_ring<1 << 20>(messages, small, false));
+    results.push_back(benchmark_padded_records<256, 4096>(messages, small));
+
+    const RecordSizes wire { 20, 9000 };
+    std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << "Record sizes: 20-9000 B, " << messages << " records, ~1 MiB rings" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+    results.push_back(benchmark_byte_ring<1 << 20>(messages, wire, true));
+    results.push_back(benchmark_byte_ring<1 << 20>(messages, wire, false));
+    results.push_back(benchmark_padded_records<9000, 128>(messages, wire));
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+#if defined(__linux__)
+// Producer side of the wakeup runs: one stamped value every `gap_ns`, so the consumer finds the
+// queue empty between messages
+template <typename SinkT>
+void produce_stamped(SinkT& sink, int messages, std::uint64_t gap_ns) {
+    const std::uint64_t start = now_ns();
+    for (int i = 0; i < messages; ++i) {
+        const std::uint64_t due = start + static_cast<std::uint64_t>(i) * gap_ns;
+        while (now_ns() < due) std::this_thread::yield();
+        const std::uint64_t stamp = now_ns();
+        while (!sink.try_enqueue(stamp)) std::this_thread::yield();
+    }
+}
+
+// Consumer side: records `now - stamp` per message, re-checking the queue in a yield loop or
+// sleeping in epoll on `Source::native_handle()`. Returns the consumer thread's CPU time in μs.
+template <typename SourceT>
+double consume_stamped(SourceT& source, int messages, bool sleep, LatencyHistogram& histogram) {
+    int epoll_fd = -1;
+    if (sleep) {
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        epoll_event event {};
+        event.events = EPOLLIN;
+        if (epoll_fd == -1
+            || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, source.native_handle(), &event) != 0) {
+            throw std::runtime_error("Failed to register the queue with epoll");
+        }
+    }
+
+    timespec cpu_start {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+    for (int received = 0; received < messages;) {
+        if (auto stamp = source.try_dequeue()) {
+            histogram.record(now_ns() - *stamp);
+            ++received;
+        } else if (!sleep) {
+            std::this_thread::yield();
+        } else if (source.arm_notification()) {
+            epoll_event ready {};
+            epoll_wait(epoll_fd, &ready, 1, 1000);
+        }
+    }
+    timespec cpu_end {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+    if (epoll_fd != -1) close(epoll_fd);
+    return 1e6 * static_cast<double>(cpu_end.tv_sec - cpu_start.tv_sec)
+        + 1e-3 * static_cast<double>(cpu_end.tv_nsec - cpu_start.tv_nsec);
+}
+
+BenchmarkResult report_wakeup(
+    const std::string& queue_type, std::size_t capacity, bool sleep, int messages,
+    double elapsed, double consumer_cpu_us, const LatencyHistogram& histogram
+) {
+    const LatencyStats latency = histogram.stats();
+    std::cout << "Latency: p50 " << std::fixed << std::setprecision(0) << latency.p50_ns
+              << " ns, p99 " << latency.p99_ns << " ns, p99.9 " << latency.p999_ns
+              << " ns, max " << latency.max_ns << " ns" << std::endl;
+    std::cout << "Consumer CPU time: " << std::setprecision(2) << consumer_cpu_us << " μs ("
+              << (100.0 * consumer_cpu_us / elapsed) << "% of wall)" << std::endl;
+
+    const double ops_per_sec = (messages * 2.0) / (elapsed / 1e6);
+    const std::string operation_type = sleep ? "Wakeup (epoll)" : "Wakeup (yield loop)";
+    return {
+        queue_type, operation_type, capacity, messages, 1, elapsed, ops_per_sec, latency,
+        sizeof(std::uint64_t)
+    };
+}
+
+// Benchmark: latency of sparse messages with the consumer polling versus sleeping in epoll
+template <typename Queue, std::size_t Capacity>
+BenchmarkResult benchmark_wakeup(
+    const std::string& queue_type, bool sleep, int messages, std::uint64_t gap_ns
+) {
+    std::cout << "\n=== Benchmark: Wakeup (" << queue_type << ", "
+              << (sleep ? "epoll" : "yield loop") << ") ===" << std::endl;
+    auto [sink, source] = Queue::make_queue();
+
+    Timer timer;
+    std::thread producer([&sink = sink, messages, gap_ns]() {
+        pin_to_cpu(placement.producer_cpu);
+        produce_stamped(sink, messages, gap_ns);
+    });
+    LatencyHistogram histogram;
+    double consumer_cpu_us = 0;
+    std::thread consumer([&source = source, &histogram, &consumer_cpu_us, sleep, messages]() {
+        pin_to_cpu(placement.consumer_cpu);
+        consumer_cpu_us = consume_stamped(source, messages, sleep, histogram);
+    });
+    producer.join();
+    consumer.join();
+    return report_wakeup(
+        queue_type, Capacity, sleep, messages, timer.elapsed_us(), consumer_cpu_us, histogram
+    );
+}
+
+// Same with the producer in a forked process, over a shared MmapSPSC and its inherited eventfd
+template <std::size_t Capacity>
+BenchmarkResult benchmark_wakeup_shared(bool sleep, int messages, std::uint64_t gap_ns) {
+    std::cout << "\n=== Benchmark: Wakeup (MmapSPSC (shared), "
+              << (sleep ? "epoll" : "yield loop") << ") ===" << std::endl;
+    using Queue = MmapSPSC<std::uint64_t, Capacity, SharedEventFdWait>;
+    const int fd = Queue::create_shared();
+
+    Timer timer;
+    const pid_t child = fork();
+    if (child < 0) {
+        throw std::runtime_error("fork failed");
+    }
+    if (child == 0) {
+        pin_to_cpu(placement.producer_cpu);
+        auto sink = Queue::attach_sink(fd);
+        produce_stamped(sink, messages, gap_ns);
+        _exit(0);
+    }
+
+    auto source = Queue::attach_source(fd);
+    close(fd);
+    LatencyHistogram histogram;
+    double consumer_cpu_us = 0;
+    std::thread consumer([&source, &histogram, &consumer_cpu_us, sleep, messages]() {
+        pin_to_cpu(placement.consumer_cpu);
+        consumer_cpu_us = consume_stamped(source, messages, sleep, histogram);
+    });
+    consumer.join();
+    waitpid(child, nullptr, 0);
+    return report_wakeup(
+        "MmapSPSC (shared)", Capacity, sleep, messages, timer.elapsed_us(), consumer_cpu_us,
+        histogram
+    );
+}
+
+// Wakeup mode: what sleeping on the eventfd adds to the latency of a sparse stream
+std::vector<BenchmarkResult> benchmark_eventfd() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║            Eventfd Wakeup Latency (EventFdWait)            ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    constexpr int messages = 20000;
+    constexpr std::uint64_t gap_ns = 20000;
+    std::cout << messages << " messages, one every " << gap_ns / 1000 << " μs" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    using Spsc = SPSC<std::uint64_t, 1024, EventFdWait>;
+    results.push_back(benchmark_wakeup<Spsc, 1024>("SPSC", false, messages, gap_ns));
+    results.push_back(benchmark_wakeup<Spsc, 1024>("SPSC", true, messages, gap_ns));
+    results.push_back(benchmark_wakeup_shared<1024>(false, messages, gap_ns));
+    results.push_back(benchmark_wakeup_shared<1024>(true, messages, gap_ns));
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+long minor_faults() {
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+// Benchmark: creation time of a fresh MmapSPSC and its first two laps. Each lap fills the ring
+// with timed individual enqueues and drains it; page faults only show up in the first one.
+template <std::size_t Capacity>
+void benchmark_cold_start(
+    std::vector<BenchmarkResult>& results, const std::string& label, MmapOptions options
+) {
+    using Queue = MmapSPSC<std::uint64_t, Capacity>;
+    const std::string queue_type = "MmapSPSC (" + label + ")";
+    std::cout << "\n=== Benchmark: Cold Start (" << queue_type << ") ===" << std::endl;
+    options.numa_node = placement.numa_node;
+
+    Timer create_timer;
+    std::optional<std::pair<typename Queue::Sink, typename Queue::Source>> queue;
+    try {
+        queue.emplace(Queue::create(options));
+    } catch (const std::runtime_error& e) {
+        std::cout << "Skipped: " << e.what() << std::endl;
+        return;
+    }
+    const double create_us = create_timer.elapsed_us();
+    std::cout << "Create: " << std::fixed << std::setprecision(1) << create_us << " μs"
+              << std::endl;
+    auto& [sink, source] = *queue;
+
+    constexpr int elements = static_cast<int>(Capacity - 1);
+    for (const char* lap : { "First lap", "Second lap" }) {
+        LatencyHistogram histogram;
+        const long faults_before = minor_faults();
+        Timer timer;
+        for (int i = 0; i < elements; ++i) {
+            const std::uint64_t start = now_ns();
+            if (!sink.try_enqueue(static_cast<std::uint64_t>(i))) std::abort();
+            histogram.record(now_ns() - start);
+        }
+        for (int i = 0; i < elements; ++i) {
+            if (source.try_dequeue() != static_cast<std::uint64_t>(i)) std::abort();
+        }
+        const double elapsed = timer.elapsed_us();
+        const long faults = minor_faults() - faults_before;
+
+        const LatencyStats latency = histogram.stats();
+        std::cout << lap << ": " << std::setprecision(0) << elapsed << " μs, " << faults
+                  << " page faults; enqueue p50 " << latency.p50_ns << " ns, p99.9 "
+                  << latency.p999_ns << " ns, max " << latency.max_ns << " ns" << std::endl;
+        results.push_back({
+            queue_type, lap, Capacity, elements, 1, elapsed, (elements * 2.0) / (elapsed / 1e6),
+            latency, sizeof(std::uint64_t)
+        });
+    }
+}
+
+// Cold-start mode: what pre-faulting, locking and huge pages take off a fresh ring's first lap
+std::vector<BenchmarkResult> benchmark_cold_start() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║             Cold Start (MmapSPSC, 8 MiB ring)              ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    constexpr std::size_t capacity = 1 << 20;
+    std::vector<BenchmarkResult> results;
+    MmapOptions options;
+    benchmark_cold_start<capacity>(results, "4 KiB pages", options);
+    options.populate = true;
+    benchmark_cold_start<capacity>(results, "populate", options);
+    options.populate = false;
+    options.lock = true;
+    benchmark_cold_start<capacity>(results, "mlock", options);
+    options.lock = false;
+    options.huge_page_size = huge_page_2mb;
+    benchmark_cold_start<capacity>(results, "2 MiB pages", options);
+    options.populate = true;
+    benchmark_cold_start<capacity>(results, "2 MiB pages, populate", options);
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Benchmark: MmapSPSC journaled to a file in the current directory (removed afterwards), so the
+// sync policy's cost shows up against the memfd-backed rows
+template <std::size_t Capacity>
+BenchmarkResult benchmark_journal(
+    const std::string& label, const JournalOptions& options, int iterations, int batch_size,
+    bool bulk
+) {
+    const std::string path = "qbuf_benchmark_" + std::to_string(getpid()) + ".journal";
+    unlink(path.c_str());
+    auto [sink, source] = MmapSPSC<int, Capacity>::open_journal(path.c_str(), options);
+    BenchmarkResult result = run_throughput<int>(
+        "MmapSPSC (journal, " + label + ")", Capacity, std::move(sink), std::move(source),
+        iterations, batch_size, bulk
+    );
+    unlink(path.c_str());
+    return result;
+}
+
+// Journal mode: throughput of a file-backed MmapSPSC under each sync policy and method
+std::vector<BenchmarkResult> benchmark_journal() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║           Journal Sync Policies (MmapSPSC, 4096)           ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    const auto every = [](std::size_t messages, SyncMethod method) {
+        JournalOptions options;
+        options.policy = SyncPolicy::every_n;
+        options.every_messages = messages;
+        options.method = method;
+        return options;
+    };
+    const auto interval = [](std::chrono::microseconds period) {
+        JournalOptions options;
+        options.policy = SyncPolicy::interval;
+        options.interval = period;
+        return options;
+    };
+    const std::vector<std::pair<std::string, JournalOptions>> policies = {
+        { "no sync", JournalOptions {} },
+        { "fdatasync every 1", every(1, SyncMethod::fdatasync) },
+        { "fdatasync every 64", every(64, SyncMethod::fdatasync) },
+        { "msync every 64", every(64, SyncMethod::msync) },
+        { "fdatasync every 1024", every(1024, SyncMethod::fdatasync) },
+        { "fdatasync every 1 ms", interval(std::chrono::milliseconds(1)) },
+        { "fdatasync every 10 ms", interval(std::chrono::milliseconds(10)) },
+    };
+
+    // Fewer messages than the other modes: a sync per message runs at disk speed
+    std::vector<BenchmarkResult> results;
+    const std::vector<std::pair<int, int>> configs = { { 20000, 1 }, { 2000, 64 } };
+    for (const auto& [iterations, batch_size] : configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        const bool bulk = batch_size > 1;
+        results.push_back(benchmark_ops<MmapSPSC<int, 4096>>(
+            "MmapSPSC", 4096, iterations, batch_size, bulk, placement.numa_node
+        ));
+        for (const auto& [label, options] : policies) {
+            results.push_back(
+                benchmark_journal<4096>(label, options, iterations, batch_size, bulk)
+            );
+        }
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+#endif
+
+// Every storage x sync combination of the policy-based `Queue`
+template <std::size_t Capacity>
+using PolicyQueues = std::tuple<
+    Queue<int, Capacity, InlineStorage, LockFreeSync>,
+    Queue<int, Capacity, HeapStorage, LockFreeSync>,
+    Queue<int, Capacity, MirroredStorage, LockFreeSync>,
+    Queue<int, Capacity, InlineStorage, MutexSync>,
+    Queue<int, Capacity, HeapStorage, MutexSync>,
+    Queue<int, Capacity, MirroredStorage, MutexSync>>;
+
+template <typename... Queues>
+void benchmark_policy_queues(
+    std::vector<BenchmarkResult>& results, std::size_t capacity, int iterations, int batch_size,
+    std::tuple<Queues...>*
+) {
+    (benchmark_ops<Queues>(
+         results,
+         std::string("Queue<") + Queues::storage_policy::name + ", " + Queues::sync_policy::name +
+             ">",
+         capacity, iterations, batch_size
+     ),
+     ...);
+}
+
+// One capacity: every policy combination next to the hand-written queue it corresponds to
+template <std::size_t Capacity>
+void benchmark_policies(std::vector<BenchmarkResult>& results, int iterations, int batch_size) {
+    benchmark_ops<SPSC<int, Capacity>>(results, "SPSC", Capacity, iterations, batch_size);
+    benchmark_ops<MutexQueue<int, Capacity>>(
+        results, "MutexQueue", Capacity, iterations, batch_size
+    );
+    benchmark_ops<MmapSPSC<int, Capacity>>(
+        results, "MmapSPSC", Capacity, iterations, batch_size, placement.numa_node
+    );
+    benchmark_policy_queues(
+        results, Capacity, iterations, batch_size, static_cast<PolicyQueues<Capacity>*>(nullptr)
+    );
+}
+
+// Policies mode: what the generic storage and synchronization policies cost against the
+// hand-written SPSC, MutexQueue and MmapSPSC
+std::vector<BenchmarkResult> benchmark_policies() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║              Policy-Based Queue vs Hand-Written            ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    const std::vector<std::pair<int, int>> configs = { { 1000000, 1 }, { 10000, 100 } };
+    for (const auto& [iterations, batch_size] : configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        benchmark_policies<64>(results, iterations, batch_size);
+        benchmark_policies<4096>(results, iterations, batch_size);
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Broadcast mode: one producer fanning out to 1-8 readers via Broadcast (lossless and lossy)
+// and via one SPSC per reader
+std::vector<BenchmarkResult> benchmark_broadcast() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║           Broadcast: 1 Producer, 1-8 Readers (4096)        ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    const std::vector<std::pair<int, int>> configs = { { 1000000, 1 }, { 10000, 100 } };
+    for (const auto& [iterations, batch_size] : configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        for (int readers : { 1, 2, 4, 8 }) {
+            results.push_back(benchmark_broadcast<4096, BroadcastMode::lossless>(
+                readers, iterations, batch_size
+            ));
+            results.push_back(
+                benchmark_broadcast<4096, BroadcastMode::lossy>(readers, iterations, batch_size)
+            );
+            results.push_back(benchmark_spsc_fan_out<4096>(readers, iterations, batch_size));
+        }
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Fork-join mode: task throughput of ThreadPool (a WsDeque per worker) against workers sharing
+// one MutexQueue, at 1-8 workers
+std::vector<BenchmarkResult> benchmark_fork_join() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║      Fork-Join Tasks: ThreadPool vs Shared MutexQueue      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    for (int depth : { 12, 18 }) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: tree depth " << depth << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        for (int workers : { 1, 2, 4, 8 }) {
+            results.push_back(benchmark_fork_join<ThreadPool>(
+                "ThreadPool", workers, ThreadPool::deque_capacity, depth
+            ));
+            results.push_back(benchmark_fork_join<SharedQueuePool<4096>>(
+                "Shared MutexQueue", workers, 4096, depth
+            ));
+        }
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Mesh mode: N producers x N consumers through a Mesh of SPSC lanes, one MPMC, and one
+// MutexQueue, at 1-8 threads per side
+std::vector<BenchmarkResult> benchmark_mesh() {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║        N Producers x N Consumers: Mesh vs MPMC vs Mutex    ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+    const std::vector<std::pair<int, int>> configs = { { 1000000, 1 }, { 10000, 100 } };
+    for (const auto& [iterations, batch_size] : configs) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        for (int threads : { 1, 2, 4, 8 }) {
+            results.push_back(benchmark_mesh<1024>(threads, iterations, batch_size));
+            results.push_back(benchmark_mpmc<4096>(threads, iterations, batch_size));
+            results.push_back(benchmark_mutex_many<4096>(threads, iterations, batch_size));
+        }
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+// Latency mode: per-message enqueue-to-dequeue latency for SPSC, MmapSPSC, and MutexQueue
+std::vector<BenchmarkResult> benchmark_latency(double rate) {
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║              Enqueue-to-Dequeue Latency (ns)               ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& [iterations, batch_size] : batch_configs()) {
+        std::cout << "\n─────────────────────────────────────────────────────────────" << std::endl;
+        std::cout << "Configuration: " << iterations << " iterations * " << batch_size
+                  << " batch size" << std::endl;
+        std::cout << "─────────────────────────────────────────────────────────────" << std::endl;
+
+        benchmark_latency_queues<64>(results, iterations, batch_size, rate);
+        benchmark_latency_queues<4096>(results, iterations, batch_size, rate);
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                    Benchmark Complete                      ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════╝" << std::endl;
+
+    return results;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "Queue Performance Benchmark: SPSC vs MutexQueue vs MmapSPSC\n" << std::endl;
+
+    // Parse command-line arguments
+    std::string csv_path;
+    std::string wait = "all";
+    bool latency = false;
+    bool cpu_sweep = false;
+    bool pool = false;
+    bool in_place = false;
+    bool drain = false;
+    bool publish_batch = false;
+    bool bytes = false;
+    bool eventfd = false;
+    bool cold_start = false;
+    bool journal = false;
+    bool policies = false;
+    bool broadcast = false;
+    bool mesh = false;
+    bool fork_join = false;
+    bool matrix = false;
+    MatrixFilter filter;
+    double rate = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --csv requires a file path argument" << std::endl;
+                return 1;
+            }
+            csv_path = argv[++i];
+            // Early validation: try to open the file for writing
+            std::ofstream test_file(csv_path);
+            if (!test_file.is_open()) {
+                std::cerr << "Error: Cannot write to CSV file: " << csv_path << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--wait") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --wait requires a strategy argument" << std::endl;
+                return 1;
+            }
+            wait = argv[++i];
+            if (wait != "all" && wait != "yield" && wait != "spin" && wait != "backoff"
+                && wait != "park") {
+                std::cerr << "Error: Unknown wait strategy: " << wait << std::endl;
+                return 1;
+            }
+        } else if (
+            std::strcmp(argv[i], "--producer-cpu") == 0
+            || std::strcmp(argv[i], "--consumer-cpu") == 0
+            || std::strcmp(argv[i], "--numa-node") == 0
+        ) {
+            const char* option = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << option << " requires a number argument" << std::endl;
+                return 1;
+            }
+            char* end = nullptr;
+            const long value = std::strtol(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0' || value < 0) {
+                std::cerr << "Error: Invalid " << option << " value: " << argv[i] << std::endl;
+                return 1;
+            }
+            if (std::strcmp(option, "--numa-node") == 0) {
+                placement.numa_node = static_cast<int>(value);
+                continue;
+            }
+            const std::vector<int> cpus = allowed_cpus();
+            if (std::find(cpus.begin(), cpus.end(), value) == cpus.end()) {
+                std::cerr << "Error: CPU " << value << " is not available to this process"
+                          << std::endl;
+                return 1;
+            }
+            if (std::strcmp(option, "--producer-cpu") == 0) {
+                placement.producer_cpu = static_cast<int>(value);
+            } else {
+                placement.consumer_cpu = static_cast<int>(value);
+            }
+        } else if (std::strcmp(argv[i], "--matrix") == 0) {
+            matrix = true;
+        } else if (
+            std::strncmp(argv[i], "--queue", 7) == 0 || std::strncmp(argv[i], "--payload", 9) == 0
+            || std::strncmp(argv[i], "--capacity", 10) == 0
+            || std::strncmp(argv[i], "--batch", 7) == 0
+        ) {
+            // Matrix filters accept both "--queue=spsc" and "--queue spsc"
+            std::string option = argv[i];
+            std::string value;
+            const auto equals = option.find('=');
+            if (equals != std::string::npos) {
+                value = option.substr(equals + 1);
+                option.resize(equals);
+            } else if (i + 1 < argc) {
+                value = argv[++i];
+            }
+
+            const std::vector<std::string>* allowed = nullptr;
+            std::string* target = nullptr;
+            if (option == "--queue") {
+                allowed = &matrix_queues;
+                target = &filter.queue;
+            } else if (option == "--payload") {
+                allowed = &matrix_payloads;
+                target = &filter.payload;
+            } else if (option == "--capacity") {
+                allowed = &matrix_capacities;
+                target = &filter.capacity;
+            } else if (option == "--batch") {
+                allowed = &matrix_batches;
+                target = &filter.batch;
+            } else {
+                std::cerr << "Error: Unknown option: " << argv[i] << std::endl;
+                return 1;
+            }
+            if (value.empty()) {
+                std::cerr << "Error: " << option << " requires a value" << std::endl;
+                return 1;
+            }
+            std::stringstream items(value);
+            std::string item;
+            while (std::getline(items, item, ',')) {
+                if (item != "all"
+                    && std::find(allowed->begin(), allowed->end(), item) == allowed->end()) {
+                    std::cerr << "Error: Unknown " << option << " value: " << item << std::endl;
+                    return 1;
+                }
+            }
+            *target = value;
+            matrix = true;
+        } else if (std::strcmp(argv[i], "--cpu-sweep") == 0) {
+            cpu_sweep = true;
+        } else if (std::strcmp(argv[i], "--pool") == 0) {
+            pool = true;
+        } else if (std::strcmp(argv[i], "--in-place") == 0) {
+            in_place = true;
+        } else if (std::strcmp(argv[i], "--drain") == 0) {
+            drain = true;
+        } else if (std::strcmp(argv[i], "--publish-batch") == 0) {
+            publish_batch = true;
+        } else if (std::strcmp(argv[i], "--bytes") == 0) {
+            bytes = true;
+        } else if (std::strcmp(argv[i], "--eventfd") == 0) {
+#if defined(__linux__)
+            eventfd = true;
+#else
+            std::cerr << "Error: --eventfd requires Linux" << std::endl;
+            return 1;
+#endif
+        } else if (std::strcmp(argv[i], "--cold-start") == 0) {
+#if defined(__linux__)
+            cold_start = true;
+#else
+            std::cerr << "Error: --cold-start requires Linux" << std::endl;
+            return 1;
+#endif
+        } else if (std::strcmp(argv[i], "--journal") == 0) {
+#if defined(__linux__)
+            journal = true;
+#else
+            std::cerr << "Error: --journal requires Linux" << std::endl;
+            return 1;
+#endif
+        } else if (std::strcmp(argv[i], "--mesh") == 0) {
+            mesh = true;
+        } else if (std::strcmp(argv[i], "--fork-join") == 0) {
+            fork_join = true;
+        } else if (std::strcmp(argv[i], "--broadcast") == 0) {
+            broadcast = true;
+        } else if (std::strcmp(argv[i], "--policies") == 0) {
+            policies = true;
+        } else if (std::strcmp(argv[i], "--latency") == 0) {
+            latency = true;
+        } else if (std::strcmp(argv[i], "--rate") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: --rate requires a messages-per-second argument" << std::endl;
+                return 1;
+            }
+            char* end = nullptr;
+            rate = std::strtod(argv[++i], &end);
+            if (end == argv[i] || *end != '\0' || rate <= 0) {
+                std::cerr << "Error: Invalid rate: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            std::cout << "Usage: " << argv[0] << " [OPTIONS]\n\n";
+            std::cout << "Options:\n";
+            std::cout << "  --csv <path>    Write benchmark results to a CSV file\n";
+            std::cout << "  --wait <name>   Wait strategy for the blocking runs: yield, spin,\n";
+            std::cout << "                  backoff, park, or all (default)\n";
+            std::cout << "  --latency       Measure per-message latency percentiles instead of\n";
+            std::cout << "                  throughput\n";
+            std::cout << "  --rate <n>      Latency mode: pace the producer to n messages/sec\n";
+            std::cout << "  --producer-cpu <n>, --consumer-cpu <n>\n";
+            std::cout << "                  Pin the producer / consumer thread to CPU n\n";
+            std::cout << "  --numa-node <n> Bind MmapSPSC and dynamic SPSC rings to NUMA node n\n";
+            std::cout << "  --cpu-sweep     Measure SPSC throughput for every producer/consumer\n";
+            std::cout << "                  CPU pair\n";
+            std::cout << "  --pool          Compare Pool slots with SPSC<unique_ptr> messages of\n";
+            std::cout << "                  1 KiB to 64 KiB\n";
+            std::cout << "  --in-place      Compare emplace, try_dequeue(T&) and try_consume\n";
+            std::cout << "                  with the optional-returning API, string and 256 B\n";
+            std::cout << "  --drain         Compare Source::drain() with try_dequeue() loops on\n";
+            std::cout << "                  SPSC, MmapSPSC and MutexQueue\n";
+            std::cout << "  --publish-batch Measure SPSC throughput and paced latency when the\n";
+            std::cout << "                  tail is published every 1-64 writes\n";
+            std::cout << "  --bytes         Compare ByteSPSC variable-length records with padded\n";
+            std::cout << "                  fixed-size slots\n";
+            std::cout << "  --eventfd       Measure the wakeup latency of consumers sleeping in\n";
+            std::cout << "                  epoll on Source::native_handle()\n";
+            std::cout << "  --cold-start    Measure MmapSPSC creation and first-lap cost with\n";
+            std::cout << "                  pre-faulted, locked and huge page rings\n";
+            std::cout << "  --journal       Measure file-backed MmapSPSC journals under each\n";
+            std::cout << "                  sync policy (writes a file in the current directory)\n";
+            std::cout << "  --mesh          Compare Mesh, MPMC and MutexQueue with 1-8 producers\n";
+            std::cout << "                  and consumers\n";
+            std::cout << "  --fork-join     Compare ThreadPool work stealing with a shared\n";
+            std::cout << "                  MutexQueue on fork-join task trees, 1-8 workers\n";
+            std::cout << "  --broadcast     Fan one producer out to 1-8 readers with Broadcast,\n";
+            std::cout << "                  LossyBroadcast and one SPSC per reader\n";
+            std::cout << "  --policies      Compare every storage x sync combination of Queue\n";
+            std::cout << "                  with SPSC, MutexQueue and MmapSPSC\n";
+            std::cout << "  --matrix        Run the payload x capacity x batch size matrix\n";
+            std::cout << "  --queue=<list>  Matrix filter: spsc, mmap, mutex, mpmc, mpsc\n";
+            std::cout << "  --payload=<list>\n";
+            std::cout << "                  Matrix filter: 8, 64, 256, 1024, 4096 (bytes), "
+                         "string\n";
+            std::cout << "  --capacity=<list>\n";
+            std::cout << "                  Matrix filter: 1024, 65536, 1048576\n";
+            std::cout << "  --batch=<list>  Matrix filter: 1, 32, 1024\n";
+            std::cout << "                  Lists are comma-separated; any filter implies "
+                         "--matrix\n";
+            std::cout << "  --help, -h      Show this help message\n";
+            return 0;
+        } else {
+            std::cerr << "Error: Unknown option: " << argv[i] << std::endl;
+            std::cerr << "Use --help for usage information." << std::endl;
+            return 1;
+        }
+    }
+
+    // Run benchmarks
+    if (rate > 0 && !latency) {
+        std::cerr << "Error: --rate is only used with --latency" << std::endl;
+        return 1;
+    }
+    // Probe the node once so a bad --numa-node fails here instead of mid-run
+    if (placement.numa_node >= 0) {
+        try {
+            SPSC<int, dynamic_extent>::make_queue(64, buffer_options());
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Cannot use NUMA node " << placement.numa_node << ": " << e.what()
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    if (cpu_sweep) {
+        results = benchmark_cpu_sweep();
+    } else if (pool) {
+        results = benchmark_pool();
+    } else if (in_place) {
+        results = benchmark_in_place();
+    } else if (drain) {
+        results = benchmark_drain();
+    } else if (publish_batch) {
+        results = benchmark_publish_batch();
+    } else if (bytes) {
+        results = benchmark_bytes();
+#if defined(__linux__)
+    } else if (eventfd) {
+        results = benchmark_eventfd();
+    } else if (cold_start) {
+        results = benchmark_cold_start();
+    } else if (journal) {
+        results = benchmark_journal();
+#endif
+    } else if (mesh) {
+        results = benchmark_mesh();
+    } else if (fork_join) {
+        results = benchmark_fork_join();
+    } else if (broadcast) {
+        results = benchmark_broadcast();
+    } else if (policies) {
+        results = benchmark_policies();
+    } else if (matrix) {
+        results = benchmark_matrix(filter);
+    } else if (latency) {
+        results = benchmark_latency(rate);
+    } else {
+        results = benchmark_comparison(wait);
+    }
 
     // Write CSV if requested
     if (!csv_path.empty()) {
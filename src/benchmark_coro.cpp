@@ -0,0 +1,115 @@
+// Coroutine vs thread ping-pong latency; built as C++20 (see CMakeLists.txt)
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <qbuf/coro.hpp>
+#include <qbuf/spsc.hpp>
+#include <qbuf/wait.hpp>
+#include <string>
+#include <thread>
+
+using namespace qbuf;
+
+constexpr std::size_t capacity = 64;
+
+// Eager, fire-and-forget coroutine
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return { }; }
+        std::suspend_never initial_suspend() noexcept { return { }; }
+        std::suspend_never final_suspend() noexcept { return { }; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+void print_round_trip(const std::string& label, int rounds, std::chrono::nanoseconds elapsed) {
+    std::cout << std::left << std::setw(32) << label << std::right << std::fixed
+              << std::setprecision(1) << static_cast<double>(elapsed.count()) / rounds
+              << " ns/round trip" << std::endl;
+}
+
+template <typename Source, typename Sink>
+Detached echo(Source& in, Sink& out, int rounds) {
+    for (int i = 0; i < rounds; ++i) co_await out.async_enqueue(co_await in.async_dequeue());
+}
+
+template <typename Sink, typename Source>
+Detached serve(Sink& out, Source& in, int rounds, std::atomic<bool>& done) {
+    for (int i = 0; i < rounds; ++i) {
+        co_await out.async_enqueue(i);
+        if (co_await in.async_dequeue() != i) std::abort();
+    }
+    done.store(true, std::memory_order_release);
+}
+
+// Both ends are coroutines on this thread; every hop is a suspend plus an inline resume
+void benchmark_coroutines(int rounds) {
+    auto [ping_sink, ping_source] = SPSC<int, capacity, AsyncWait>::make_queue();
+    auto [pong_sink, pong_source] = SPSC<int, capacity, AsyncWait>::make_queue();
+    std::atomic<bool> done { false };
+
+    const auto start = std::chrono::steady_clock::now();
+    echo(ping_source, pong_sink, rounds);
+    serve(ping_sink, pong_source, rounds, done);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (!done.load(std::memory_order_acquire)) std::abort();
+    print_round_trip("coroutines (AsyncWait)", rounds, elapsed);
+}
+
+// One OS thread per end, blocking enqueue()/dequeue() under the given wait strategy
+template <typename Wait>
+void benchmark_threads(const std::string& label, int rounds) {
+    auto [ping_sink, ping_source] = SPSC<int, capacity, Wait>::make_queue();
+    auto [pong_sink, pong_source] = SPSC<int, capacity, Wait>::make_queue();
+    constexpr auto timeout = std::chrono::seconds(10);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread echo_thread([&in = ping_source, &out = pong_sink, rounds, timeout]() {
+        for (int i = 0; i < rounds; ++i) {
+            auto value = in.dequeue(timeout);
+            if (!value.has_value() || !out.enqueue(*value, timeout)) std::abort();
+        }
+    });
+    for (int i = 0; i < rounds; ++i) {
+        if (!ping_sink.enqueue(i, timeout)) std::abort();
+        auto value = pong_source.dequeue(timeout);
+        if (!value.has_value() || *value != i) std::abort();
+    }
+    echo_thread.join();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    print_round_trip(label, rounds, elapsed);
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = 200000;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--rounds" && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [--rounds N]\n"
+                      << "  --rounds N   Ping-pong round trips per run (default: 200000)"
+                      << std::endl;
+            return 0;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (rounds <= 0) {
+        std::cerr << "--rounds must be positive" << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== Ping-pong latency (" << rounds << " round trips, capacity " << capacity
+              << ") ===" << std::endl;
+    benchmark_coroutines(rounds);
+    benchmark_threads<YieldWait>("threads (YieldWait)", rounds);
+    benchmark_threads<ParkingWait>("threads (ParkingWait)", rounds);
+    return 0;
+}
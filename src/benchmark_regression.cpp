@@ -0,0 +1,562 @@
+// Throughput regression harness: a fixed suite of warmed-up, repeated runs summarised per
+// configuration and compared against a baseline CSV; built as its own target (see CMakeLists.txt)
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <qbuf/mmap_spsc.hpp>
+#include <qbuf/mpmc.hpp>
+#include <qbuf/mpsc.hpp>
+#include <qbuf/mutex_queue.hpp>
+#include <qbuf/queue.hpp>
+#include <qbuf/spsc.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace qbuf;
+
+// Exit status when at least one configuration regressed against the baseline
+constexpr int regression_exit_code = 2;
+
+struct Options {
+    int repetitions = 5;
+    int warmup = 1;
+    std::size_t messages = 1000000;
+    double threshold = 0.05; // relative slowdown below which a difference is never flagged
+    std::string filter;
+    std::string csv_path;
+    std::string json_path;
+    std::string baseline_path;
+};
+
+// One repetition: a producer and a consumer thread moving `messages` ints, element by element
+// or in `batch_size` bulk calls; returns enqueue+dequeue operations per second
+template <typename Queue, typename... Args>
+double measure(std::size_t messages, int batch_size, Args... args) {
+    static_assert(is_queue_v<Queue>, "measure() needs the shared queue API");
+    auto [sink, source] = Queue::make_queue(args...);
+    const bool bulk = batch_size > 1;
+    const std::size_t batches = messages / static_cast<std::size_t>(batch_size);
+    const std::size_t total = batches * static_cast<std::size_t>(batch_size);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producer([&sink = sink, batches, batch_size, bulk]() {
+        std::vector<int> batch(batch_size);
+        std::iota(batch.begin(), batch.end(), 0);
+        for (std::size_t b = 0; b < batches; ++b) {
+            if (!bulk) {
+                while (!sink.try_enqueue(batch[0])) std::this_thread::yield();
+                continue;
+            }
+            std::size_t sent = 0;
+            while (sent < batch.size()) {
+                sent += sink.try_enqueue(batch.data() + sent, batch.size() - sent);
+                if (sent < batch.size()) std::this_thread::yield();
+            }
+        }
+    });
+    std::thread consumer([&source = source, total, batch_size, bulk]() {
+        std::vector<int> received(batch_size);
+        std::size_t consumed = 0;
+        while (consumed < total) {
+            std::size_t n = 0;
+            if (bulk) {
+                n = source.try_dequeue(received.data(), received.size());
+            } else {
+                n = source.try_dequeue().has_value() ? 1 : 0;
+            }
+            consumed += n;
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+    producer.join();
+    consumer.join();
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(total) * 2.0 / elapsed.count();
+}
+
+// One row of the suite; keys match the `benchmark` CSV columns of the same name
+struct Config {
+    std::string queue_type;
+    std::string operation_type;
+    std::size_t capacity;
+    int batch_size;
+    std::function<double(std::size_t messages)> run;
+};
+
+template <std::size_t Capacity>
+void add_configs(std::vector<Config>& suite) {
+    for (int batch_size : { 1, 100 }) {
+        const std::string operation_type = batch_size > 1 ? "Bulk" : "Individual";
+        auto add = [&](const std::string& queue_type, auto run) {
+            suite.push_back({ queue_type, operation_type, Capacity, batch_size,
+                              [run, batch_size](std::size_t messages) {
+                                  return run(messages, batch_size);
+                              } });
+        };
+        add("SPSC", measure<SPSC<int, Capacity>>);
+        add("MmapSPSC", [](std::size_t messages, int batch_size) {
+            return measure<MmapSPSC<int, Capacity>>(messages, batch_size, -1);
+        });
+        add("MutexQueue", measure<MutexQueue<int, Capacity>>);
+        add("MPMC (1P/1C)", measure<MPMC<int, Capacity>>);
+        add("MPSC (1P/1C)", measure<MPSC<int, Capacity>>);
+    }
+}
+
+// Robust summary of one configuration's repetitions (operations per second)
+struct Summary {
+    std::size_t repetitions = 0;
+    double median = 0;
+    double mean = 0;
+    double stddev = 0; // sample standard deviation; 0 for a single repetition
+    double min = 0;
+    double max = 0;
+};
+
+Summary summarize(std::vector<double> samples) {
+    Summary summary;
+    summary.repetitions = samples.size();
+    if (samples.empty()) return summary;
+    std::sort(samples.begin(), samples.end());
+    const std::size_t n = samples.size();
+    summary.median = (n % 2 == 1) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    if (n > 1) {
+        double squares = 0;
+        for (double sample : samples) squares += (sample - summary.mean) * (sample - summary.mean);
+        summary.stddev = std::sqrt(squares / (n - 1));
+    }
+    summary.min = samples.front();
+    summary.max = samples.back();
+    return summary;
+}
+
+// One-sided 95% critical value of Student's t distribution
+double t_critical(double df) {
+    static const double table[] = { 6.314, 2.920, 2.353, 2.132, 2.015,
+                                    1.943, 1.895, 1.860, 1.833, 1.812 };
+    if (df < 1) return table[0];
+    if (df <= 10) return table[static_cast<int>(df) - 1];
+    if (df <= 15) return 1.753;
+    if (df <= 20) return 1.725;
+    if (df <= 30) return 1.697;
+    return 1.645;
+}
+
+enum class Verdict { unchanged, regression, improvement, no_baseline };
+
+const char* verdict_name(Verdict verdict) {
+    switch (verdict) {
+    case Verdict::unchanged:
+        return "ok";
+    case Verdict::regression:
+        return "regression";
+    case Verdict::improvement:
+        return "improvement";
+    case Verdict::no_baseline:
+        return "new";
+    }
+    return "";
+}
+
+struct Comparison {
+    Summary baseline;
+    double change = 0; // relative change of the median, negative when slower
+    std::optional<double> t; // Welch's t for baseline mean minus current mean
+    Verdict verdict = Verdict::no_baseline;
+};
+
+// A difference counts when the median moved by at least `threshold` and, if both sides have
+// repeated samples, Welch's t-test on the means agrees at 95%. A baseline with one sample per
+// configuration (a plain `benchmark --csv` run) is judged on the threshold alone.
+Comparison compare(const Summary& baseline, const Summary& current, double threshold) {
+    Comparison comparison;
+    comparison.baseline = baseline;
+    if (baseline.median <= 0) return comparison;
+    comparison.change = (current.median - baseline.median) / baseline.median;
+
+    bool significant = true;
+    if (baseline.repetitions > 1 && current.repetitions > 1) {
+        const double vb = baseline.stddev * baseline.stddev / baseline.repetitions;
+        const double vc = current.stddev * current.stddev / current.repetitions;
+        if (vb + vc > 0) {
+            const double t = (baseline.mean - current.mean) / std::sqrt(vb + vc);
+            const double df = (vb + vc) * (vb + vc)
+                / (vb * vb / (baseline.repetitions - 1) + vc * vc / (current.repetitions - 1));
+            comparison.t = t;
+            significant = std::abs(t) > t_critical(df);
+        }
+    }
+    if (significant && comparison.change <= -threshold) {
+        comparison.verdict = Verdict::regression;
+    } else if (significant && comparison.change >= threshold) {
+        comparison.verdict = Verdict::improvement;
+    } else {
+        comparison.verdict = Verdict::unchanged;
+    }
+    return comparison;
+}
+
+struct Result {
+    const Config* config;
+    std::vector<double> samples;
+    Summary summary;
+    Comparison comparison;
+};
+
+using Key = std::tuple<std::string, std::string, std::size_t, int>;
+
+Key key_of(const Config& config) {
+    return { config.queue_type, config.operation_type, config.capacity, config.batch_size };
+}
+
+std::string escape_csv_field(const std::string& field) {
+    if (field.find_first_of(",\"\r\n") == std::string::npos) return field;
+    std::string escaped = "\"";
+    for (char c : field) {
+        if (c == '"') escaped += '"';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+// Split one CSV record, honouring quoted fields with doubled quotes
+std::vector<std::string> split_csv_line(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+// Read a baseline written by this harness (`--csv`, one summary row per configuration) or by
+// `benchmark --csv` (one row per run; repeated rows of a configuration become its samples)
+std::optional<std::map<Key, Summary>> read_baseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Failed to open baseline: " << path << std::endl;
+        return std::nullopt;
+    }
+    std::string line;
+    if (!std::getline(file, line)) {
+        std::cerr << "Error: Empty baseline: " << path << std::endl;
+        return std::nullopt;
+    }
+    const std::vector<std::string> header = split_csv_line(line);
+    auto column = [&header](const char* name) -> int {
+        const auto it = std::find(header.begin(), header.end(), name);
+        return it == header.end() ? -1 : static_cast<int>(it - header.begin());
+    };
+    const int queue_col = column("queue_type");
+    const int operation_col = column("operation_type");
+    const int capacity_col = column("capacity");
+    const int batch_col = column("batch_size");
+    const int mean_col = column("mean_ops_per_sec");
+    const int value_col = (mean_col >= 0) ? mean_col : column("ops_per_sec");
+    if (queue_col < 0 || operation_col < 0 || capacity_col < 0 || batch_col < 0 || value_col < 0) {
+        std::cerr << "Error: Baseline " << path << " lacks the queue_type, operation_type, "
+                  << "capacity, batch_size and ops_per_sec columns" << std::endl;
+        return std::nullopt;
+    }
+    const int median_col = column("median_ops_per_sec");
+    const int stddev_col = column("stddev_ops_per_sec");
+    const int repetitions_col = column("repetitions");
+    const int min_col = column("min_ops_per_sec");
+    const int max_col = column("max_ops_per_sec");
+
+    std::map<Key, Summary> summaries;
+    std::map<Key, std::vector<double>> samples;
+    while (std::getline(file, line)) {
+        const std::vector<std::string> fields = split_csv_line(line);
+        if (fields.size() < header.size()) continue;
+        try {
+            const Key key { fields[queue_col], fields[operation_col],
+                            static_cast<std::size_t>(std::stoull(fields[capacity_col])),
+                            std::stoi(fields[batch_col]) };
+            const double value = std::stod(fields[value_col]);
+            if (mean_col < 0) {
+                samples[key].push_back(value);
+                continue;
+            }
+            Summary summary;
+            summary.mean = value;
+            summary.median = (median_col >= 0) ? std::stod(fields[median_col]) : value;
+            summary.stddev = (stddev_col >= 0) ? std::stod(fields[stddev_col]) : 0;
+            summary.repetitions =
+                (repetitions_col >= 0) ? std::stoul(fields[repetitions_col]) : 1;
+            summary.min = (min_col >= 0) ? std::stod(fields[min_col]) : value;
+            summary.max = (max_col >= 0) ? std::stod(fields[max_col]) : value;
+            summaries[key] = summary;
+        } catch (const std::exception&) {
+            // Rows without numbers (e.g. latency-only runs) cannot be compared
+        }
+    }
+    for (const auto& [key, values] : samples) summaries[key] = summarize(values);
+    return summaries;
+}
+
+bool write_csv(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Failed to open CSV file: " << path << std::endl;
+        return false;
+    }
+    file << "queue_type,operation_type,capacity,batch_size,repetitions,median_ops_per_sec,"
+            "mean_ops_per_sec,stddev_ops_per_sec,min_ops_per_sec,max_ops_per_sec\r\n";
+    for (const Result& result : results) {
+        const Summary& s = result.summary;
+        file << escape_csv_field(result.config->queue_type) << ","
+             << escape_csv_field(result.config->operation_type) << "," << result.config->capacity
+             << "," << result.config->batch_size << "," << s.repetitions << "," << std::scientific
+             << std::setprecision(6) << s.median << "," << s.mean << "," << s.stddev << ","
+             << s.min << "," << s.max << "\r\n";
+    }
+    if (!file.good()) {
+        std::cerr << "Error: Failed to write to CSV file: " << path << std::endl;
+        return false;
+    }
+    std::cout << "\nCSV results written to: " << path << std::endl;
+    return true;
+}
+
+std::string json_string(const std::string& value) {
+    std::string escaped = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped + "\"";
+}
+
+void write_json_summary(std::ostream& out, const Summary& s, const char* indent) {
+    out << indent << "\"repetitions\": " << s.repetitions << ",\n"
+        << indent << "\"median_ops_per_sec\": " << s.median << ",\n"
+        << indent << "\"mean_ops_per_sec\": " << s.mean << ",\n"
+        << indent << "\"stddev_ops_per_sec\": " << s.stddev << ",\n"
+        << indent << "\"min_ops_per_sec\": " << s.min << ",\n"
+        << indent << "\"max_ops_per_sec\": " << s.max;
+}
+
+bool write_json(
+    const std::string& path, const Options& options, const std::vector<Result>& results,
+    bool has_baseline, int regressions
+) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Error: Failed to open JSON file: " << path << std::endl;
+        return false;
+    }
+    out << std::setprecision(6) << std::scientific;
+    out << "{\n"
+        << "  \"repetitions\": " << options.repetitions << ",\n"
+        << "  \"warmup\": " << options.warmup << ",\n"
+        << "  \"messages\": " << options.messages << ",\n"
+        << "  \"threshold\": " << options.threshold << ",\n"
+        << "  \"baseline\": "
+        << (has_baseline ? json_string(options.baseline_path) : std::string("null")) << ",\n"
+        << "  \"regressions\": " << regressions << ",\n"
+        << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\n"
+            << "      \"queue_type\": " << json_string(result.config->queue_type) << ",\n"
+            << "      \"operation_type\": " << json_string(result.config->operation_type)
+            << ",\n"
+            << "      \"capacity\": " << result.config->capacity << ",\n"
+            << "      \"batch_size\": " << result.config->batch_size << ",\n"
+            << "      \"samples_ops_per_sec\": [";
+        for (std::size_t j = 0; j < result.samples.size(); ++j) {
+            out << (j == 0 ? "" : ", ") << result.samples[j];
+        }
+        out << "],\n";
+        write_json_summary(out, result.summary, "      ");
+        const Comparison& comparison = result.comparison;
+        out << ",\n      \"status\": " << json_string(verdict_name(comparison.verdict));
+        if (comparison.verdict != Verdict::no_baseline) {
+            out << ",\n      \"change\": " << comparison.change << ",\n      \"t\": ";
+            if (comparison.t.has_value()) {
+                out << *comparison.t;
+            } else {
+                out << "null";
+            }
+            out << ",\n      \"baseline\": {\n";
+            write_json_summary(out, comparison.baseline, "        ");
+            out << "\n      }";
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    if (!out.good()) {
+        std::cerr << "Error: Failed to write to JSON file: " << path << std::endl;
+        return false;
+    }
+    std::cout << "JSON results written to: " << path << std::endl;
+    return true;
+}
+
+void print_result(const Result& result, bool has_baseline) {
+    const Summary& s = result.summary;
+    std::ostringstream label;
+    label << result.config->queue_type << " " << result.config->operation_type << " cap "
+          << result.config->capacity << " batch " << result.config->batch_size;
+    std::cout << std::left << std::setw(42) << label.str() << std::right << std::scientific
+              << std::setprecision(3) << " median " << s.median << "  min " << s.min << "  sd "
+              << std::fixed << std::setprecision(1)
+              << (s.mean > 0 ? 100.0 * s.stddev / s.mean : 0.0) << "%";
+    if (has_baseline) {
+        const Comparison& comparison = result.comparison;
+        std::cout << "  ";
+        if (comparison.verdict != Verdict::no_baseline) {
+            std::cout << std::showpos << 100.0 * comparison.change << "%" << std::noshowpos
+                      << " ";
+        }
+        std::cout << verdict_name(comparison.verdict);
+    }
+    std::cout << std::endl;
+}
+
+bool parse_number(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end != text && *end == '\0';
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        double number = 0;
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            std::cout << "Usage: " << argv[0] << " [OPTIONS]\n\n";
+            std::cout << "Options:\n";
+            std::cout << "  --repetitions <n> Timed runs per configuration (default 5)\n";
+            std::cout << "  --warmup <n>      Untimed runs before them (default 1)\n";
+            std::cout << "  --messages <n>    Messages per run (default 1000000)\n";
+            std::cout << "  --filter <text>   Only configurations whose queue type contains text\n";
+            std::cout << "  --csv <path>      Write one summary row per configuration (usable as\n";
+            std::cout << "                    a baseline)\n";
+            std::cout << "  --json <path>     Write samples, summaries and verdicts as JSON\n";
+            std::cout << "  --baseline <path> Compare with a CSV from --csv or benchmark --csv;\n";
+            std::cout << "                    exits with status 2 when anything regressed\n";
+            std::cout << "  --threshold <pct> Smallest median change flagged (default 5)\n";
+            std::cout << "  --help, -h        Show this help message\n";
+            return 0;
+        }
+        if (!has_value) {
+            std::cerr << "Error: Unknown option or missing value: " << argv[i] << std::endl;
+            std::cerr << "Use --help for usage information." << std::endl;
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(argv[i - 1], "--repetitions") == 0 && parse_number(value, number)
+            && number >= 1) {
+            options.repetitions = static_cast<int>(number);
+        } else if (std::strcmp(argv[i - 1], "--warmup") == 0 && parse_number(value, number)
+                   && number >= 0) {
+            options.warmup = static_cast<int>(number);
+        } else if (std::strcmp(argv[i - 1], "--messages") == 0 && parse_number(value, number)
+                   && number >= 100) {
+            options.messages = static_cast<std::size_t>(number);
+        } else if (std::strcmp(argv[i - 1], "--threshold") == 0 && parse_number(value, number)
+                   && number >= 0) {
+            options.threshold = number / 100.0;
+        } else if (std::strcmp(argv[i - 1], "--filter") == 0) {
+            options.filter = value;
+        } else if (std::strcmp(argv[i - 1], "--csv") == 0) {
+            options.csv_path = value;
+        } else if (std::strcmp(argv[i - 1], "--json") == 0) {
+            options.json_path = value;
+        } else if (std::strcmp(argv[i - 1], "--baseline") == 0) {
+            options.baseline_path = value;
+        } else {
+            std::cerr << "Error: Invalid option: " << argv[i - 1] << " " << value << std::endl;
+            std::cerr << "Use --help for usage information." << std::endl;
+            return 1;
+        }
+    }
+
+    std::optional<std::map<Key, Summary>> baseline;
+    if (!options.baseline_path.empty()) {
+        baseline = read_baseline(options.baseline_path);
+        if (!baseline.has_value()) return 1;
+    }
+
+    std::vector<Config> suite;
+    add_configs<64>(suite);
+    add_configs<4096>(suite);
+
+    std::cout << "Regression suite: " << options.warmup << " warmup + " << options.repetitions
+              << " timed runs of " << options.messages << " messages per configuration\n"
+              << std::endl;
+    std::vector<Result> results;
+    int regressions = 0;
+    for (const Config& config : suite) {
+        if (config.queue_type.find(options.filter) == std::string::npos) continue;
+        for (int i = 0; i < options.warmup; ++i) config.run(options.messages);
+
+        Result result { &config, {}, {}, {} };
+        for (int i = 0; i < options.repetitions; ++i) {
+            result.samples.push_back(config.run(options.messages));
+        }
+        result.summary = summarize(result.samples);
+        if (baseline.has_value()) {
+            const auto it = baseline->find(key_of(config));
+            if (it != baseline->end()) {
+                result.comparison = compare(it->second, result.summary, options.threshold);
+            }
+            if (result.comparison.verdict == Verdict::regression) ++regressions;
+        }
+        print_result(result, baseline.has_value());
+        results.push_back(std::move(result));
+    }
+
+    if (!options.csv_path.empty() && !write_csv(options.csv_path, results)) return 1;
+    if (!options.json_path.empty()
+        && !write_json(options.json_path, options, results, baseline.has_value(), regressions)) {
+        return 1;
+    }
+    if (baseline.has_value()) {
+        std::cout << "\n" << regressions << " regression(s) against " << options.baseline_path
+                  << std::endl;
+        if (regressions != 0) return regression_exit_code;
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+#include "assert.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <qbuf/broadcast.hpp>
+#include <qbuf/queue.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+static_assert(is_queue_v<Broadcast<int, 8>>);
+static_assert(is_queue_v<LossyBroadcast<int, 8>>);
+
+void test_broadcast_every_reader_sees_everything() {
+    std::cout << "Testing every reader sees every element..." << std::endl;
+    auto [sink, sources] = Broadcast<int, 8>::make_queue(3);
+    assert(sources.size() == 3);
+    assert(sink.readers() == 3);
+
+    assert(sink.empty());
+    for (auto& source : sources) {
+        assert(source.empty());
+        assert(!source.try_dequeue().has_value());
+    }
+
+    assert(sink.try_enqueue(1));
+    assert(sink.try_enqueue(2));
+    assert(sink.size() == 2);
+    for (auto& source : sources) {
+        assert(source.size() == 2);
+        assert(source.try_dequeue().value() == 1);
+        assert(source.try_dequeue().value() == 2);
+        assert(source.position() == 2);
+        assert(source.empty());
+    }
+    assert(sink.empty());
+
+    // Bulk transfers across the end of the ring, each reader with its own batch size
+    int next = 2;
+    std::vector<int> expected(sources.size(), 2);
+    std::vector<int> in(5);
+    std::vector<int> out(8);
+    for (int round = 0; round < 200; ++round) {
+        for (int& value : in) value = ++next;
+        assert(sink.try_enqueue(in.data(), in.size()) == in.size());
+        for (std::size_t r = 0; r < sources.size(); ++r) {
+            std::size_t remaining = in.size();
+            while (remaining != 0) {
+                const std::size_t want = std::min(r + 1, remaining);
+                const std::size_t n = sources[r].try_dequeue(out.data(), want);
+                assert(n != 0);
+                for (std::size_t i = 0; i < n; ++i) assert(out[i] == ++expected[r]);
+                remaining -= n;
+            }
+        }
+    }
+    for (auto& source : sources) assert(source.lost() == 0);
+
+    std::cout << "  PASSED: every reader sees every element" << std::endl;
+}
+
+void test_broadcast_slowest_reader_limits_producer() {
+    std::cout << "Testing slowest reader limits the producer..." << std::endl;
+    auto [sink, sources] = Broadcast<int, 8>::make_queue(2);
+    auto& fast = sources[0];
+    auto& slow = sources[1];
+
+    // Every slot is usable
+    for (int i = 0; i < 8; ++i) {
+        assert(sink.try_enqueue(i));
+        assert(fast.try_dequeue().value() == i);
+    }
+    assert(!sink.try_enqueue(8));
+    int rejected[3] = { 8, 9, 10 };
+    assert(sink.try_enqueue(rejected, 3) == 0);
+    assert(sink.size() == 8);
+
+    // Room opens only as the slow reader advances
+    int out[3];
+    assert(slow.try_dequeue(out, 3) == 3);
+    assert(out[0] == 0 && out[2] == 2);
+    assert(sink.try_enqueue(rejected, 3) == 3);
+    assert(!sink.try_enqueue(11));
+
+    // Refused rvalues are not moved from
+    auto [string_sink, string_sources] = Broadcast<std::string, 2>::make_queue(1);
+    assert(string_sink.try_enqueue(std::string("a")));
+    assert(string_sink.try_enqueue(std::string("b")));
+    std::string refused(32, 'c');
+    assert(!string_sink.try_enqueue(std::move(refused)));
+    assert(refused == std::string(32, 'c'));
+
+    std::cout << "  PASSED: slowest reader limits the producer" << std::endl;
+}
+
+void test_broadcast_detach() {
+    std::cout << "Testing detached readers..." << std::endl;
+    auto [sink, sources] = Broadcast<int, 4>::make_queue(3);
+    for (int i = 0; i < 4; ++i) assert(sink.try_enqueue(i));
+    assert(!sink.try_enqueue(4));
+
+    // The other readers drain; the stalled one still holds the producer back
+    for (std::size_t r = 1; r < sources.size(); ++r) {
+        int out[4];
+        assert(sources[r].try_dequeue(out, 4) == 4);
+    }
+    assert(!sink.try_enqueue(4));
+
+    // Dropping the stalled reader releases the ring
+    sources[0] = std::move(sources[2]);
+    assert(sink.readers() == 2);
+    assert(sink.try_enqueue(4));
+    assert(sources[0].try_dequeue().value() == 4);
+    assert(sources[1].try_dequeue().value() == 4);
+
+    sources.clear();
+    assert(sink.readers() == 0);
+    for (int i = 0; i < 100; ++i) assert(sink.try_enqueue(i));
+
+    bool threw = false;
+    try {
+        Broadcast<int, 4>::make_queue(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "  PASSED: detached readers" << std::endl;
+}
+
+void test_broadcast_timeouts() {
+    std::cout << "Testing timeouts..." << std::endl;
+    auto [sink, sources] = Broadcast<int, 4>::make_queue(2);
+    const auto timeout = std::chrono::milliseconds(5);
+
+    assert(!sources[0].dequeue(timeout).has_value());
+    int out[4];
+    assert(sources[0].dequeue(out, 4, timeout) == 0);
+
+    int in[4] = { 0, 1, 2, 3 };
+    assert(sink.enqueue(in, 4, timeout));
+    assert(!sink.enqueue(4, timeout));
+    assert(sources[0].dequeue(out, 4, timeout) == 4);
+    assert(!sink.enqueue(4, timeout)); // the second reader has not moved
+    assert(sources[1].dequeue(timeout).value() == 0);
+    assert(sink.enqueue(4, timeout));
+    assert(sources[0].dequeue(out, 2, timeout) == 1);
+    assert(out[0] == 4);
+
+    std::cout << "  PASSED: timeouts" << std::endl;
+}
+
+void test_broadcast_concurrent() {
+    std::cout << "Testing concurrent readers..." << std::endl;
+    auto [sink, sources] = Broadcast<int, 64, BroadcastMode::lossless, ParkingWait>::make_queue(4);
+    constexpr int count = 100000;
+    const auto timeout = std::chrono::seconds(10);
+
+    std::vector<std::thread> readers;
+    for (std::size_t r = 0; r < sources.size(); ++r) {
+        readers.emplace_back([&source = sources[r], r, timeout]() {
+            int batch[7];
+            for (int next = 0; next < count;) {
+                if (r % 2 == 0) {
+                    auto value = source.dequeue(timeout);
+                    assert(value.has_value() && *value == next++);
+                } else {
+                    const std::size_t want = std::min(7, count - next);
+                    assert(source.dequeue(batch, want, timeout) == want);
+                    for (std::size_t i = 0; i < want; ++i) assert(batch[i] == next++);
+                }
+            }
+            assert(source.empty());
+        });
+    }
+
+    int batch[5];
+    for (int i = 0; i < count;) {
+        if (i % 2 == 0 || i + 5 > count) {
+            assert(sink.enqueue(i++, timeout));
+        } else {
+            for (int& value : batch) value = i++;
+            assert(sink.enqueue(batch, 5, timeout));
+        }
+    }
+    for (auto& reader : readers) reader.join();
+    assert(sink.empty());
+
+    std::cout << "  PASSED: concurrent readers" << std::endl;
+}
+
+void test_broadcast_lossy_overrun() {
+    std::cout << "Testing lossy overrun..." << std::endl;
+    auto [sink, sources] = LossyBroadcast<std::uint64_t, 8>::make_queue(2);
+
+    // The producer never waits for readers
+    for (std::uint64_t i = 0; i < 20; ++i) assert(sink.try_enqueue(i));
+    std::uint64_t in[4] = { 20, 21, 22, 23 };
+    assert(sink.try_enqueue(in, 4) == 4);
+    assert(sink.size() == 8);
+
+    // A reader that fell behind starts again at the oldest element still in the ring
+    auto& reader = sources[0];
+    assert(reader.size() == 8);
+    assert(reader.try_dequeue().value() == 16);
+    assert(reader.lost() == 16);
+    assert(reader.position() == 17);
+    std::uint64_t out[16];
+    assert(reader.try_dequeue(out, 16) == 7);
+    for (std::uint64_t i = 0; i < 7; ++i) assert(out[i] == 17 + i);
+    assert(reader.empty());
+    assert(reader.lost() == 16);
+
+    // Bulk reads skip the same way; the other reader was unaffected until now
+    assert(sources[1].try_dequeue(out, 16) == 8);
+    assert(out[0] == 16 && out[7] == 23);
+    assert(sources[1].lost() == 16);
+
+    // Readers that keep up lose nothing
+    for (std::uint64_t i = 24; i < 30; ++i) assert(sink.try_enqueue(i));
+    assert(reader.try_dequeue(out, 16) == 6);
+    assert(out[0] == 24 && reader.lost() == 16);
+
+    std::cout << "  PASSED: lossy overrun" << std::endl;
+}
+
+void test_broadcast_lossy_concurrent() {
+    std::cout << "Testing lossy concurrent readers..." << std::endl;
+    // Every word carries the sequence number, so a torn copy shows up as mismatched words
+    using Message = std::array<std::uint64_t, 8>;
+    auto [sink, sources] = LossyBroadcast<Message, 16>::make_queue(3);
+    constexpr std::uint64_t count = 200000;
+
+    std::vector<std::thread> readers;
+    for (std::size_t r = 0; r < sources.size(); ++r) {
+        readers.emplace_back([&source = sources[r], r]() {
+            std::vector<Message> batch(r + 1);
+            std::uint64_t received = 0;
+            while (source.position() < count) {
+                const std::uint64_t start = source.position();
+                const std::uint64_t lost_before = source.lost();
+                const std::size_t n = source.try_dequeue(batch.data(), batch.size());
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // Elements arrive in order; all skipped positions are counted as lost
+                const std::uint64_t first = start + (source.lost() - lost_before);
+                assert(batch[0][0] >= first);
+                for (std::size_t i = 0; i < n; ++i) {
+                    for (std::uint64_t word : batch[i]) assert(word == batch[i][0]);
+                    if (i > 0) assert(batch[i][0] > batch[i - 1][0]);
+                }
+                assert(batch[n - 1][0] == source.position() - 1);
+                received += n;
+            }
+            assert(received + source.lost() == count);
+        });
+    }
+
+    Message message;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        message.fill(i);
+        assert(sink.try_enqueue(message));
+    }
+    for (auto& reader : readers) reader.join();
+
+    std::cout << "  PASSED: lossy concurrent readers" << std::endl;
+}
+
+void run_all_broadcast_tests() {
+    std::cout << "\n=== Running Broadcast Tests ===" << std::endl;
+
+    test_broadcast_every_reader_sees_everything();
+    test_broadcast_slowest_reader_limits_producer();
+    test_broadcast_detach();
+    test_broadcast_timeouts();
+    test_broadcast_concurrent();
+    test_broadcast_lossy_overrun();
+    test_broadcast_lossy_concurrent();
+
+    std::cout << "\n=== All Broadcast tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_broadcast_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,225 @@
+#include "assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <qbuf/byte_spsc.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+// Deterministic record contents: byte `i` of record `seq` is (seq + i) mod 251
+void fill_record(std::byte* data, std::size_t size, std::uint64_t seq) {
+    for (std::size_t i = 0; i < size; ++i) data[i] = std::byte((seq + i) % 251);
+}
+
+bool check_record(Span<const std::byte> record, std::size_t size, std::uint64_t seq) {
+    if (record.size() != size) return false;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (record[i] != std::byte((seq + i) % 251)) return false;
+    }
+    return true;
+}
+
+std::string to_string(Span<const std::byte> record) {
+    return std::string(reinterpret_cast<const char*>(record.data()), record.size());
+}
+
+void test_byte_basic_operations() {
+    std::cout << "Testing byte ring basic operations..." << std::endl;
+    auto [sink, source] = ByteSPSC<4096>::create();
+    assert(source.empty());
+    assert(!source.front().has_value());
+
+    assert(sink.try_enqueue("hello", 5));
+    assert(sink.try_enqueue("", 0));
+    assert(sink.try_enqueue("variable-length message", 23));
+    // Header word plus payload rounded up to 8 bytes, per record
+    assert(source.size() == 16 + 8 + 32);
+
+    auto record = source.front();
+    assert(record.has_value());
+    assert(to_string(*record) == "hello");
+    assert(reinterpret_cast<std::uintptr_t>(record->data()) % ByteSPSC<4096>::alignment == 0);
+    source.pop();
+
+    record = source.front();
+    assert(record.has_value() && record->size() == 0);
+    source.pop();
+
+    char out[64];
+    auto size = source.try_dequeue(out, 10);
+    assert(!size.has_value()); // too small; the record stays
+    size = source.try_dequeue(out, sizeof(out));
+    assert(size.has_value() && *size == 23);
+    assert(std::string(out, *size) == "variable-length message");
+    assert(source.empty());
+    std::cout << "  PASSED: byte ring basic operations" << std::endl;
+}
+
+void test_byte_reserve_commit() {
+    std::cout << "Testing byte ring reserve/commit..." << std::endl;
+    auto [sink, source] = ByteSPSC<4096>::create();
+
+    auto region = sink.reserve(100);
+    assert(region.data() != nullptr && region.size() == 100);
+    assert(reinterpret_cast<std::uintptr_t>(region.data()) % 8 == 0);
+    std::memcpy(region.data(), "abc", 3);
+    assert(source.empty()); // not visible before commit
+    sink.commit(3);
+
+    auto record = source.front();
+    assert(record.has_value() && to_string(*record) == "abc");
+    source.pop();
+
+    // A later reserve replaces an uncommitted one; commit without a reservation is a no-op
+    sink.reserve(50);
+    region = sink.reserve(8);
+    std::memcpy(region.data(), "12345678", 8);
+    sink.commit();
+    sink.commit();
+    record = source.front();
+    assert(record.has_value() && to_string(*record) == "12345678");
+    source.pop();
+    assert(source.empty());
+    std::cout << "  PASSED: byte ring reserve/commit" << std::endl;
+}
+
+void test_byte_full_ring() {
+    std::cout << "Testing byte ring full and oversized records..." << std::endl;
+    using Ring = ByteSPSC<4096>;
+    auto [sink, source] = Ring::create();
+
+    std::vector<std::byte> big(Ring::max_record_size);
+    assert(sink.reserve(Ring::max_record_size + 1).data() == nullptr);
+    assert(!sink.try_enqueue(big.data(), big.size() + 1));
+
+    assert(sink.try_enqueue(big.data(), big.size()));
+    assert(!sink.try_enqueue(big.data(), 0)); // no room left even for a header word
+
+    assert(source.try_dequeue(big.data(), big.size()).has_value());
+    assert(sink.try_enqueue(big.data(), 0));
+
+    // 511 usable words minus the empty record, 4 words per 24-byte record
+    std::size_t count = 0;
+    while (sink.try_enqueue(big.data(), 24)) ++count;
+    assert(count == 510 / 4);
+    std::cout << "  PASSED: byte ring full and oversized records" << std::endl;
+}
+
+void test_byte_wrap_around() {
+    std::cout << "Testing byte ring wrap-around..." << std::endl;
+    auto [sink, source] = ByteSPSC<4096>::create();
+    std::vector<std::byte> scratch(1024);
+
+    // Odd sizes walk the records across the end of the ring many times
+    for (std::uint64_t seq = 0; seq < 5000; ++seq) {
+        const std::size_t size = (seq * 37) % 1000;
+        fill_record(scratch.data(), size, seq);
+        assert(sink.try_enqueue(scratch.data(), size));
+        const auto record = source.front();
+        assert(record.has_value() && check_record(*record, size, seq));
+        source.pop();
+    }
+    assert(source.empty());
+    std::cout << "  PASSED: byte ring wrap-around" << std::endl;
+}
+
+void test_byte_drain() {
+    std::cout << "Testing byte ring drain..." << std::endl;
+    auto [sink, source] = ByteSPSC<4096>::create();
+    for (int i = 0; i < 10; ++i) {
+        const std::string message = "record " + std::to_string(i);
+        assert(sink.try_enqueue(message.data(), message.size()));
+    }
+
+    std::vector<std::string> seen;
+    auto collect = [&](Span<const std::byte> record) { seen.push_back(to_string(record)); };
+    assert(source.drain(collect, 3) == 3);
+    assert(seen.size() == 3 && seen[0] == "record 0" && seen[2] == "record 2");
+
+    assert(source.drain(collect) == 7);
+    assert(seen.size() == 10 && seen[9] == "record 9");
+    assert(source.empty());
+    assert(source.drain(collect) == 0);
+
+    // Records before a throwing callback are released, the throwing one is kept
+    for (int i = 0; i < 3; ++i) assert(sink.try_enqueue(&i, sizeof(i)));
+    int visited = 0;
+    bool thrown = false;
+    try {
+        source.drain([&](Span<const std::byte>) {
+            if (visited++ == 1) throw std::runtime_error("stop");
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    int value = -1;
+    assert(source.try_dequeue(&value, sizeof(value)).has_value() && value == 1);
+    std::cout << "  PASSED: byte ring drain" << std::endl;
+}
+
+void test_byte_concurrent() {
+    std::cout << "Testing byte ring concurrent producer/consumer..." << std::endl;
+    auto [sink, source] = ByteSPSC<65536>::create();
+    constexpr std::uint64_t count = 100000;
+
+    // Wire-message sizes from 20 B to about 9 KB
+    auto size_of = [](std::uint64_t seq) { return 20 + (seq * 7919) % 9000; };
+
+    std::thread producer([&sink = sink, size_of]() {
+        for (std::uint64_t seq = 0; seq < count; ++seq) {
+            const std::size_t size = size_of(seq);
+            auto region = sink.reserve(size);
+            while (region.data() == nullptr) {
+                std::this_thread::yield();
+                region = sink.reserve(size);
+            }
+            fill_record(region.data(), size, seq);
+            sink.commit();
+        }
+    });
+
+    std::uint64_t next = 0;
+    while (next < count) {
+        const std::size_t drained = source.drain([&](Span<const std::byte> record) {
+            assert(check_record(record, size_of(next), next));
+            ++next;
+        });
+        if (drained == 0) std::this_thread::yield();
+    }
+    producer.join();
+    assert(source.empty());
+    std::cout << "  PASSED: byte ring concurrent producer/consumer" << std::endl;
+}
+
+void run_all_byte_spsc_tests() {
+    std::cout << "\n=== Running ByteSPSC Tests ===" << std::endl;
+
+    test_byte_basic_operations();
+    test_byte_reserve_commit();
+    test_byte_full_ring();
+    test_byte_wrap_around();
+    test_byte_drain();
+    test_byte_concurrent();
+
+    std::cout << "\n=== All ByteSPSC tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_byte_spsc_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
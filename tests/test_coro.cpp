@@ -0,0 +1,211 @@
+// Built as C++20 (see CMakeLists.txt)
+#include "assert.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <iostream>
+#include <qbuf/coro.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+// Minimal eager, fire-and-forget coroutine: runs until its first suspension on creation and frees
+// its frame when it finishes
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return { }; }
+        std::suspend_never initial_suspend() noexcept { return { }; }
+        std::suspend_never final_suspend() noexcept { return { }; }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template <typename Source>
+Detached consume(Source& source, int count, std::vector<int>& out, std::atomic<bool>& done) {
+    for (int i = 0; i < count; ++i) out.push_back(co_await source.async_dequeue());
+    done.store(true, std::memory_order_release);
+}
+
+template <typename Sink>
+Detached produce(Sink& sink, int count, std::atomic<bool>& done) {
+    for (int i = 0; i < count; ++i) co_await sink.async_enqueue(i);
+    done.store(true, std::memory_order_release);
+}
+
+void test_coro_dequeue_resumed_by_publish() {
+    std::cout << "Testing async_dequeue resumed by publish..." << std::endl;
+    auto [sink, source] = SPSC<int, 8, AsyncWait>::make_queue();
+    std::vector<int> received;
+    std::atomic<bool> done { false };
+
+    // Suspends immediately: the queue is empty
+    consume(source, 3, received, done);
+    assert(received.empty() && !done);
+
+    // Each publish resumes the coroutine inline, which takes the element and suspends again
+    assert(sink.try_enqueue(10));
+    assert(received.size() == 1 && received[0] == 10);
+    assert(sink.try_enqueue(11));
+    assert(sink.try_enqueue(12));
+    assert(done);
+    assert((received == std::vector<int> { 10, 11, 12 }));
+    assert(source.empty());
+    std::cout << "  PASSED: async_dequeue resumed by publish" << std::endl;
+}
+
+void test_coro_ready_without_suspending() {
+    std::cout << "Testing async operations that complete without suspending..." << std::endl;
+    auto [sink, source] = SPSC<int, 8, AsyncWait>::make_queue();
+    std::atomic<bool> produced { false };
+    std::atomic<bool> consumed { false };
+    std::vector<int> received;
+
+    produce(sink, 5, produced);
+    assert(produced);
+    consume(source, 5, received, consumed);
+    assert(consumed);
+    assert((received == std::vector<int> { 0, 1, 2, 3, 4 }));
+    std::cout << "  PASSED: async operations that complete without suspending" << std::endl;
+}
+
+void test_coro_enqueue_resumed_by_dequeue() {
+    std::cout << "Testing async_enqueue resumed by dequeue..." << std::endl;
+    auto [sink, source] = SPSC<int, 4, AsyncWait>::make_queue();
+    std::atomic<bool> done { false };
+
+    // Three slots are usable; the fourth enqueue suspends
+    produce(sink, 6, done);
+    assert(!done);
+    assert(source.size() == 3);
+
+    for (int i = 0; i < 6; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value() && *value == i);
+    }
+    assert(done);
+    assert(source.empty());
+    std::cout << "  PASSED: async_enqueue resumed by dequeue" << std::endl;
+}
+
+// Two coroutines bouncing a counter over a pair of queues on one thread
+template <typename Source, typename Sink>
+Detached pong(Source& in, Sink& out, int rounds) {
+    for (int i = 0; i < rounds; ++i) co_await out.async_enqueue(co_await in.async_dequeue() + 1);
+}
+
+template <typename Sink, typename Source>
+Detached ping(Sink& out, Source& in, int rounds, int& last, std::atomic<bool>& done) {
+    int value = 0;
+    for (int i = 0; i < rounds; ++i) {
+        co_await out.async_enqueue(value);
+        value = co_await in.async_dequeue();
+    }
+    last = value;
+    done.store(true, std::memory_order_release);
+}
+
+void test_coro_ping_pong() {
+    std::cout << "Testing coroutine ping-pong..." << std::endl;
+    auto [ping_sink, ping_source] = SPSC<int, 2, AsyncWait>::make_queue();
+    auto [pong_sink, pong_source] = SPSC<int, 2, AsyncWait>::make_queue();
+    constexpr int rounds = 10000;
+    int last = -1;
+    std::atomic<bool> done { false };
+
+    pong(ping_source, pong_sink, rounds);
+    ping(ping_sink, pong_source, rounds, last, done);
+    assert(done);
+    assert(last == rounds);
+    std::cout << "  PASSED: coroutine ping-pong" << std::endl;
+}
+
+void test_coro_cross_thread() {
+    std::cout << "Testing coroutine resumed from another thread..." << std::endl;
+    auto [sink, source] = SPSC<int, 16, AsyncWait>::make_queue();
+    constexpr int count = 100000;
+    std::vector<int> received;
+    received.reserve(count);
+    std::atomic<bool> done { false };
+
+    consume(source, count, received, done);
+    std::thread producer([&sink = sink]() {
+        for (int i = 0; i < count; ++i) {
+            while (!sink.try_enqueue(i)) std::this_thread::yield();
+        }
+    });
+    producer.join();
+
+    assert(done.load(std::memory_order_acquire));
+    for (int i = 0; i < count; ++i) assert(received[i] == i);
+    std::cout << "  PASSED: coroutine resumed from another thread" << std::endl;
+}
+
+void test_coro_mmap_spsc() {
+    std::cout << "Testing MmapSPSC awaitables..." << std::endl;
+    auto [sink, source] = MmapSPSC<std::string, 4, AsyncWait>::create();
+    std::vector<std::string> received;
+    std::atomic<bool> done { false };
+
+    [](auto& source, std::vector<std::string>& out, std::atomic<bool>& done) -> Detached {
+        for (int i = 0; i < 5; ++i) out.push_back(co_await source.async_dequeue());
+        done = true;
+    }(source, received, done);
+    assert(received.empty());
+
+    std::atomic<bool> produced { false };
+    [](auto& sink, std::atomic<bool>& produced) -> Detached {
+        for (int i = 0; i < 5; ++i) co_await sink.async_enqueue("message " + std::to_string(i));
+        produced = true;
+    }(sink, produced);
+    assert(produced && done);
+    assert(received.size() == 5 && received[4] == "message 4");
+    std::cout << "  PASSED: MmapSPSC awaitables" << std::endl;
+}
+
+void test_coro_blocking_calls_still_work() {
+    std::cout << "Testing blocking calls with AsyncWait..." << std::endl;
+    auto [sink, source] = SPSC<int, 4, AsyncWait>::make_queue();
+    assert(!source.dequeue(std::chrono::milliseconds(2)).has_value());
+
+    std::thread producer([&sink = sink]() {
+        for (int i = 0; i < 1000; ++i) assert(sink.enqueue(i, std::chrono::seconds(10)));
+    });
+    for (int i = 0; i < 1000; ++i) {
+        auto value = source.dequeue(std::chrono::seconds(10));
+        assert(value.has_value() && *value == i);
+    }
+    producer.join();
+    std::cout << "  PASSED: blocking calls with AsyncWait" << std::endl;
+}
+
+void run_all_coro_tests() {
+    std::cout << "\n=== Running Coroutine Tests ===" << std::endl;
+
+    test_coro_dequeue_resumed_by_publish();
+    test_coro_ready_without_suspending();
+    test_coro_enqueue_resumed_by_dequeue();
+    test_coro_ping_pong();
+    test_coro_cross_thread();
+    test_coro_mmap_spsc();
+    test_coro_blocking_calls_still_work();
+
+    std::cout << "\n=== All Coroutine tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_coro_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
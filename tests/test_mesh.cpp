@@ -0,0 +1,258 @@
+#include "assert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <qbuf/mesh.hpp>
+#include <qbuf/queue.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+static_assert(is_queue_v<Mesh<int, 8>>);
+
+void test_mesh_routing() {
+    std::cout << "Testing key routing..." << std::endl;
+    auto [sinks, sources] = Mesh<int, 8>::make_queue(2, 3);
+    assert(sinks.size() == 2 && sources.size() == 3);
+    assert(sinks[0].consumers() == 3 && sources[0].producers() == 2);
+    assert(sinks[0].capacity() == 3 * 7 && sources[0].capacity() == 2 * 7);
+
+    // Key k goes to consumer k % 3, whichever producer sends it
+    for (int key = 0; key < 6; ++key) {
+        assert(sinks[0].route(key).try_enqueue(key));
+        assert(sinks[1].route(key).try_enqueue(100 + key));
+    }
+    assert(sinks[0].size() == 6);
+    for (int c = 0; c < 3; ++c) {
+        assert(sources[c].size() == 4);
+        // Each producer's lane keeps its order
+        assert(sources[c].lane(0).try_dequeue().value() == c);
+        assert(sources[c].lane(0).try_dequeue().value() == c + 3);
+        assert(sources[c].lane(1).try_dequeue().value() == 100 + c);
+        assert(sources[c].lane(1).try_dequeue().value() == 103 + c);
+        assert(sources[c].empty());
+    }
+
+    // The lane is a plain SPSC sink, zero-copy calls included
+    auto span = sinks[1].lane(2).reserve(2);
+    assert(span.size() == 2);
+    span[0] = 7;
+    span[1] = 8;
+    sinks[1].lane(2).commit(2);
+    int out[4];
+    assert(sources[2].try_dequeue(out, 4) == 2);
+    assert(out[0] == 7 && out[1] == 8);
+
+    std::cout << "  PASSED: key routing" << std::endl;
+}
+
+void test_mesh_round_robin_quantum() {
+    std::cout << "Testing round-robin polling with a lane quantum..." << std::endl;
+    MeshOptions options;
+    options.lane_quantum = 4;
+    auto [sinks, sources] = Mesh<int, 64>::make_queue(3, 1, options);
+    for (int p = 0; p < 3; ++p) {
+        for (int i = 0; i < 20; ++i) assert(sinks[p].route(0).try_enqueue(p * 100 + i));
+    }
+
+    // One batch takes at most 4 elements per lane per visit, rotating over the lanes
+    int out[12];
+    assert(sources[0].try_dequeue(out, 12) == 12);
+    for (int visit = 0; visit < 3; ++visit) {
+        for (int i = 0; i < 4; ++i) assert(out[visit * 4 + i] == visit * 100 + i);
+    }
+
+    // The next poll resumes after the lane served last; single dequeues rotate too
+    assert(sources[0].try_dequeue().value() == 4);
+    assert(sources[0].try_dequeue().value() == 104);
+    assert(sources[0].try_dequeue().value() == 204);
+
+    // A lone busy lane is still drained within one call
+    auto [busy_sinks, busy_sources] = Mesh<int, 64>::make_queue(3, 1, options);
+    for (int i = 0; i < 30; ++i) assert(busy_sinks[1].route(0).try_enqueue(i));
+    int drained[40];
+    assert(busy_sources[0].try_dequeue(drained, 40) == 30);
+    for (int i = 0; i < 30; ++i) assert(drained[i] == i);
+    assert(busy_sources[0].try_dequeue(drained, 40) == 0);
+
+    std::cout << "  PASSED: round-robin polling with a lane quantum" << std::endl;
+}
+
+void test_mesh_priority_and_starvation() {
+    std::cout << "Testing priority polling and the starvation limit..." << std::endl;
+    MeshOptions options;
+    options.policy = PollPolicy::priority;
+    options.starvation_limit = 0;
+    auto [sinks, sources] = Mesh<int, 64>::make_queue(2, 1, options);
+    for (int i = 0; i < 10; ++i) {
+        assert(sinks[0].route(0).try_enqueue(i));
+        assert(sinks[1].route(0).try_enqueue(100 + i));
+    }
+
+    // Strict priority: producer 0 is drained before producer 1 is looked at
+    int out[15];
+    assert(sources[0].try_dequeue(out, 5) == 5);
+    assert(out[4] == 4);
+    assert(sources[0].try_dequeue(out, 15) == 15);
+    assert(out[4] == 9 && out[5] == 100 && out[14] == 109);
+
+    // With a starvation limit, every third poll is a round-robin pass
+    options.starvation_limit = 3;
+    options.lane_quantum = 1;
+    auto [aged_sinks, aged_sources] = Mesh<int, 64>::make_queue(2, 1, options);
+    for (int i = 0; i < 10; ++i) {
+        assert(aged_sinks[0].route(0).try_enqueue(i));
+        assert(aged_sinks[1].route(0).try_enqueue(100 + i));
+    }
+    std::vector<int> order;
+    for (int poll = 0; poll < 6; ++poll) order.push_back(aged_sources[0].try_dequeue().value());
+    assert((order == std::vector<int> { 0, 1, 2, 3, 4, 100 }));
+
+    std::cout << "  PASSED: priority polling and the starvation limit" << std::endl;
+}
+
+void test_mesh_keyless_spread() {
+    std::cout << "Testing keyless enqueues..." << std::endl;
+    auto [sinks, sources] = Mesh<std::string, 4>::make_queue(1, 4);
+    auto& sink = sinks[0];
+
+    // Singles rotate over the consumers
+    for (int i = 0; i < 8; ++i) assert(sink.try_enqueue(std::to_string(i)));
+    for (int c = 0; c < 4; ++c) {
+        assert(sources[c].try_dequeue().value() == std::to_string(c));
+        assert(sources[c].try_dequeue().value() == std::to_string(c + 4));
+    }
+
+    // Full lanes are skipped; a refused value is offered to the next lane intact
+    for (int i = 0; i < 3; ++i) assert(sink.route(0).try_enqueue("full"));
+    std::string value = "spread";
+    for (int i = 0; i < 9; ++i) assert(sink.try_enqueue(value));
+    assert(sources[0].size() == 3);
+    std::string moved(32, 'm');
+    assert(!sink.try_enqueue(std::move(moved)));
+    assert(moved == std::string(32, 'm'));
+    assert(!sink.enqueue("late", std::chrono::milliseconds(5)));
+
+    // Bulk enqueues put as much as fits on each lane in turn
+    auto [bulk_sinks, bulk_sources] = Mesh<int, 8>::make_queue(1, 2);
+    int in[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    assert(bulk_sinks[0].try_enqueue(in, 10) == 10);
+    int out[8];
+    assert(bulk_sources[0].try_dequeue(out, 8) == 7);
+    assert(out[0] == 0 && out[6] == 6);
+    assert(bulk_sources[1].try_dequeue(out, 8) == 3);
+    assert(out[0] == 7 && out[2] == 9);
+
+    std::cout << "  PASSED: keyless enqueues" << std::endl;
+}
+
+void test_mesh_timeouts_and_errors() {
+    std::cout << "Testing timeouts and invalid arguments..." << std::endl;
+    auto [sinks, sources] = Mesh<int, 4>::make_queue(2, 1);
+    const auto timeout = std::chrono::milliseconds(5);
+    assert(!sources[0].dequeue(timeout).has_value());
+    int out[4];
+    assert(sources[0].dequeue(out, 4, timeout) == 0);
+
+    int in[3] = { 1, 2, 3 };
+    assert(sinks[0].enqueue(in, 3, timeout));
+    assert(!sinks[0].enqueue(in, 1, timeout));
+    assert(sinks[1].route(0).enqueue(4, timeout));
+    assert(sources[0].dequeue(out, 4, timeout) == 4);
+
+    bool threw = false;
+    try {
+        Mesh<int, 4>::make_queue(0, 1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    MeshOptions options;
+    options.lane_quantum = 0;
+    threw = false;
+    try {
+        Mesh<int, 4>::make_queue(1, 1, options);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "  PASSED: timeouts and invalid arguments" << std::endl;
+}
+
+void test_mesh_concurrent() {
+    std::cout << "Testing concurrent producers and consumers..." << std::endl;
+    constexpr int producers = 3;
+    constexpr int consumers = 2;
+    constexpr int per_producer = 30000;
+    auto [sinks, sources] = Mesh<int, 64>::make_queue(producers, consumers);
+    const auto timeout = std::chrono::seconds(10);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&sink = sinks[p], p, timeout]() {
+            for (int i = 0; i < per_producer; ++i) {
+                const int value = p * per_producer + i;
+                assert(sink.route(value).enqueue(value, timeout));
+            }
+        });
+    }
+    std::atomic<int> received { 0 };
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&source = sources[c], &received, c, timeout]() {
+            std::vector<int> last(producers, -1);
+            int batch[16];
+            const int expected = producers * per_producer / consumers;
+            for (int count = 0; count < expected;) {
+                const std::size_t want = std::min(16, expected - count);
+                const std::size_t n = source.dequeue(batch, want, timeout);
+                assert(n == want);
+                for (std::size_t i = 0; i < n; ++i) {
+                    // Routed by key, and in order per producer
+                    assert(batch[i] % consumers == c);
+                    const int producer = batch[i] / per_producer;
+                    assert(batch[i] > last[producer]);
+                    last[producer] = batch[i];
+                }
+                count += static_cast<int>(n);
+            }
+            received.fetch_add(expected);
+            assert(source.empty());
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    assert(received.load() == producers * per_producer);
+
+    std::cout << "  PASSED: concurrent producers and consumers" << std::endl;
+}
+
+void run_all_mesh_tests() {
+    std::cout << "\n=== Running Mesh Tests ===" << std::endl;
+
+    test_mesh_routing();
+    test_mesh_round_robin_quantum();
+    test_mesh_priority_and_starvation();
+    test_mesh_keyless_spread();
+    test_mesh_timeouts_and_errors();
+    test_mesh_concurrent();
+
+    std::cout << "\n=== All Mesh tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_mesh_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
@@ -1,9 +1,19 @@
 #include "assert.hpp"
 
 #include <chrono>
+#include <cstdlib>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <poll.h>
 #include <qbuf/mmap_spsc.hpp>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
 #include <thread>
+#include <unistd.h>
 #include <vector>
 
 using namespace qbuf;
@@ -51,6 +61,35 @@ void test_mmap_full_queue() {
     std::cout << "  PASSED: test_mmap_full_queue" << std::endl;
 }
 
+void test_mmap_cached_index_refresh() {
+    std::cout << "Testing test_mmap_cached_index_refresh..." << std::endl;
+
+    auto [sink, source] = MmapSPSC<int, 8>::create();
+
+    for (int i = 0; i < 7; ++i) {
+        assert(sink.try_enqueue(i));
+    }
+    assert(!sink.try_enqueue(999));
+
+    for (int i = 0; i < 3; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value());
+        assert(value.value() == i);
+    }
+
+    std::vector<int> input = { 7, 8, 9, 10 };
+    assert(sink.try_enqueue(input.data(), input.size()) == 3);
+
+    std::vector<int> output(8, 0);
+    assert(source.try_dequeue(output.data(), output.size()) == 7);
+    for (int i = 0; i < 7; ++i) {
+        assert(output[i] == i + 3);
+    }
+    assert(!source.try_dequeue().has_value());
+
+    std::cout << "  PASSED: test_mmap_cached_index_refresh" << std::endl;
+}
+
 void test_mmap_bulk_operations() {
     std::cout << "Testing test_mmap_bulk_operations..." << std::endl;
 
@@ -100,6 +139,778 @@ void test_mmap_bulk_wraparound() {
     std::cout << "  PASSED: test_mmap_bulk_wraparound" << std::endl;
 }
 
+// Short strings point into themselves, so they must never be built or destroyed via the mirror
+void test_mmap_bulk_wraparound_strings() {
+    std::cout << "Testing test_mmap_bulk_wraparound_strings..." << std::endl;
+
+    auto [sink, source] = MmapSPSC<std::string, 128>::create();
+    const std::size_t ring = 128; // 128 32-byte strings (libstdc++) fill one page exactly
+
+    // Move the indices near the end of the ring so the next runs cross it
+    for (std::size_t i = 0; i + 30 < ring; ++i) assert(sink.try_enqueue(std::string("x")));
+    for (std::size_t i = 0; i + 30 < ring; ++i) assert(source.try_dequeue().has_value());
+
+    std::vector<std::string> input;
+    for (int i = 0; i < 100; ++i) input.push_back(std::to_string(i));
+    assert(sink.try_enqueue(input.data(), input.size()) == input.size());
+    for (int i = 0; i < 50; ++i) assert(source.try_dequeue().value() == input[i]);
+    std::vector<std::string> output(50);
+    assert(source.try_dequeue(output.data(), output.size()) == output.size());
+    for (int i = 0; i < 50; ++i) assert(output[i] == input[i + 50]);
+
+    // Single enqueues across the wrap, read back with one bulk dequeue
+    for (int i = 0; i < 100; ++i) assert(sink.try_enqueue(input[i]));
+    output.resize(100);
+    assert(source.try_dequeue(output.data(), output.size()) == output.size());
+    assert(output == input);
+
+    // Heap-allocated strings across the wrap as well
+    const std::vector<std::string> batch(90, std::string(64, 'l'));
+    for (int round = 0; round < 3; ++round) {
+        assert(sink.try_enqueue(batch.data(), batch.size()) == batch.size());
+        std::vector<std::string> received(batch.size());
+        assert(source.try_dequeue(received.data(), received.size()) == received.size());
+        assert(received == batch);
+    }
+    assert(source.empty());
+
+    std::cout << "  PASSED: test_mmap_bulk_wraparound_strings" << std::endl;
+}
+
+void test_mmap_reserve_commit() {
+    std::cout << "Testing test_mmap_reserve_commit..." << std::endl;
+
+    auto [sink, source] = MmapSPSC<int, 16>::create();
+
+    auto span = sink.reserve(10);
+    assert(span.size() == 10);
+    for (std::size_t i = 0; i < span.size(); ++i) {
+        span[i] = static_cast<int>(i);
+    }
+    assert(source.empty());
+    sink.commit(10);
+
+    std::vector<int> output(16, 0);
+    assert(source.try_dequeue(output.data(), 10) == 10);
+    for (int i = 0; i < 10; ++i) {
+        assert(output[i] == i);
+    }
+
+    // Reserve across the wrap point until all 15 usable slots are written
+    std::size_t written = 0;
+    while (written < 15) {
+        span = sink.reserve(15 - written);
+        assert(!span.empty());
+        for (std::size_t i = 0; i < span.size(); ++i) {
+            span[i] = 100 + static_cast<int>(written + i);
+        }
+        sink.commit(span.size());
+        written += span.size();
+    }
+    assert(sink.reserve(1).empty());
+
+    assert(source.try_dequeue(output.data(), 16) == 15);
+    for (int i = 0; i < 15; ++i) {
+        assert(output[i] == 100 + i);
+    }
+
+    std::cout << "  PASSED: test_mmap_reserve_commit" << std::endl;
+}
+
+void test_mmap_peek_consume() {
+    std::cout << "Testing test_mmap_peek_consume..." << std::endl;
+
+    auto [sink, source] = MmapSPSC<std::unique_ptr<int>, 8>::create();
+
+    assert(source.peek().empty());
+    for (int i = 0; i < 5; ++i) {
+        assert(sink.try_enqueue(std::make_unique<int>(i)));
+    }
+
+    auto view = source.peek();
+    assert(view.size() == 5);
+    for (int i = 0; i < 5; ++i) {
+        assert(*view[i] == i);
+    }
+    assert(source.size() == 5);
+    source.consume(5);
+    assert(source.empty());
+
+    // Head is at 5; read back across the wrap point until all elements are consumed
+    for (int i = 0; i < 7; ++i) {
+        assert(sink.try_enqueue(std::make_unique<int>(10 + i)));
+    }
+    int expected = 10;
+    while (!source.empty()) {
+        view = source.peek();
+        assert(!view.empty());
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            assert(*view[i] == expected++);
+        }
+        source.consume(view.size());
+    }
+    assert(expected == 17);
+
+    std::cout << "  PASSED: test_mmap_peek_consume" << std::endl;
+}
+
+void test_mmap_drain() {
+    std::cout << "Testing test_mmap_drain..." << std::endl;
+
+    auto [sink, source] = MmapSPSC<std::shared_ptr<int>, 8>::create();
+    assert(source.drain([](std::shared_ptr<int>&) { assert(false); }) == 0);
+
+    // Head at 5, so the readable range runs through the mirror past the end of the ring
+    for (int i = 0; i < 5; ++i) assert(sink.try_enqueue(std::make_shared<int>(i)));
+    assert(source.drain([](std::shared_ptr<int>&) { }) == 5);
+    auto shared = std::make_shared<int>(-1);
+    for (int i = 0; i < 6; ++i) assert(sink.try_enqueue(std::make_shared<int>(i)));
+    assert(sink.try_enqueue(shared));
+
+    // Each element is destroyed right after its callback; slots come back every 3 elements
+    int expected = 0;
+    std::vector<std::size_t> used;
+    assert(source.drain(
+        [&](std::shared_ptr<int>& value) {
+            if (expected < 6) assert(*value == expected);
+            ++expected;
+            used.push_back(sink.size());
+        },
+        std::numeric_limits<std::size_t>::max(), 3
+    ) == 7);
+    assert(used == std::vector<std::size_t>({ 7, 7, 7, 4, 4, 4, 1 }));
+    assert(shared.use_count() == 1);
+    assert(source.empty());
+
+    // Bounded drain, then a throwing callback leaves the throwing element queued
+    for (int i = 0; i < 4; ++i) assert(sink.try_enqueue(std::make_shared<int>(i)));
+    assert(source.drain([](std::shared_ptr<int>&) { }, 1) == 1);
+    bool threw = false;
+    try {
+        source.drain([](std::shared_ptr<int>& value) {
+            if (*value == 2) throw std::runtime_error("failed");
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(source.size() == 2);
+    assert(*source.try_dequeue().value() == 2);
+    assert(*source.try_dequeue().value() == 3);
+
+    // Self-referential short strings drained across the wrap (128 slots fill one page)
+    auto [string_sink, string_source] = MmapSPSC<std::string, 128>::create();
+    for (int i = 0; i < 100; ++i) assert(string_sink.try_enqueue(std::string("x")));
+    assert(string_source.drain([](std::string&) { }) == 100);
+    for (int i = 0; i < 100; ++i) assert(string_sink.try_enqueue(std::to_string(i)));
+    int next = 0;
+    assert(string_source.drain(
+        [&](std::string& value) { assert(value == std::to_string(next++)); },
+        std::numeric_limits<std::size_t>::max(), 16
+    ) == 100);
+    assert(next == 100);
+    assert(string_source.empty());
+
+    std::cout << "  PASSED: test_mmap_drain" << std::endl;
+}
+
+void test_mmap_contiguous_across_wrap() {
+    std::cout << "Testing test_mmap_contiguous_across_wrap..." << std::endl;
+
+    // 4096 ints span whole pages on common page sizes, so the ring wraps at slot 4096
+    auto [sink, source] = MmapSPSC<int, 4096>::create();
+
+    std::vector<int> input(4000);
+    std::vector<int> output(4000);
+    for (std::size_t i = 0; i < input.size(); ++i) input[i] = static_cast<int>(i);
+    assert(sink.try_enqueue(input.data(), 4000) == 4000);
+    assert(source.try_dequeue(output.data(), 4000) == 4000);
+    assert(output == input);
+
+    // Reservation crosses the wrap point but is still a single span
+    auto span = sink.reserve(1000);
+    assert(span.size() == 1000);
+    for (std::size_t i = 0; i < span.size(); ++i) span[i] = static_cast<int>(1000 + i);
+    sink.commit(span.size());
+
+    // Peek across the wrap point is a single span, too
+    auto view = source.peek();
+    assert(view.size() == 1000);
+    for (std::size_t i = 0; i < view.size(); ++i) assert(view[i] == static_cast<int>(1000 + i));
+
+    // Bulk read/write across the wrap point goes through the mirror
+    assert(source.try_dequeue(output.data(), 500) == 500);
+    for (int i = 0; i < 500; ++i) assert(output[i] == 1000 + i);
+    assert(sink.try_enqueue(input.data(), 3000) == 3000);
+    assert(source.try_dequeue(output.data(), 4000) == 3500);
+    for (int i = 0; i < 500; ++i) assert(output[i] == 1500 + i);
+    for (int i = 0; i < 3000; ++i) assert(output[500 + i] == i);
+
+    std::cout << "  PASSED: test_mmap_contiguous_across_wrap" << std::endl;
+}
+
+namespace {
+// 12-byte element whose size is not a power of two
+struct Triple {
+    int a;
+    int b;
+    int c;
+};
+} // namespace
+
+void test_mmap_odd_element_size() {
+    std::cout << "Testing test_mmap_odd_element_size..." << std::endl;
+
+    auto [sink, source] = MmapSPSC<Triple, 64>::create();
+
+    // Cycle many times around the ring with bulk operations of varying sizes
+    std::vector<Triple> batch(50);
+    std::vector<Triple> output(50);
+    int next_in = 0;
+    int next_out = 0;
+    for (int round = 0; round < 2000; ++round) {
+        const std::size_t n = 1 + (round % 50);
+        for (std::size_t i = 0; i < n; ++i) {
+            batch[i] = { next_in, -next_in, next_in * 2 };
+            ++next_in;
+        }
+        assert(sink.try_enqueue(batch.data(), n) == n);
+        assert(source.try_dequeue(output.data(), n) == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            assert(output[i].a == next_out);
+            assert(output[i].b == -next_out);
+            assert(output[i].c == next_out * 2);
+            ++next_out;
+        }
+    }
+
+    std::cout << "  PASSED: test_mmap_odd_element_size" << std::endl;
+}
+
+void test_mmap_parking_wait() {
+    std::cout << "Testing test_mmap_parking_wait..." << std::endl;
+    auto [sink, source] = MmapSPSC<int, 8, BasicParkingWait<0>>::create();
+    constexpr int num_elements = 20000;
+
+    std::thread producer([sink = std::move(sink)]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            assert(sink.enqueue(i, std::chrono::seconds(5)));
+        }
+    });
+
+    for (int i = 0; i < num_elements; ++i) {
+        auto value = source.dequeue(std::chrono::seconds(5));
+        assert(value.has_value());
+        assert(value.value() == i);
+    }
+    producer.join();
+
+    auto start = std::chrono::steady_clock::now();
+    assert(!source.dequeue(std::chrono::milliseconds(20)).has_value());
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    std::cout << "  PASSED: test_mmap_parking_wait" << std::endl;
+}
+
+void test_mmap_numa_node() {
+    std::cout << "Testing test_mmap_numa_node..." << std::endl;
+    auto [sink, source] = MmapSPSC<int, 4096>::create(0);
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4000; ++i) assert(sink.try_enqueue(i));
+        for (int i = 0; i < 4000; ++i) assert(source.try_dequeue().value() == i);
+    }
+
+#if defined(__linux__)
+    bool threw = false;
+    try {
+        MmapSPSC<int, 4096>::create(1000);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+#endif
+
+    std::cout << "  PASSED: test_mmap_numa_node" << std::endl;
+}
+
+#if defined(__linux__)
+long minor_faults() {
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+// Page faults taken by one lap of individual enqueue/dequeue through a 4 MiB ring
+long first_lap_faults(const MmapOptions& options) {
+    auto [sink, source] = MmapSPSC<std::uint64_t, 1 << 19>::create(options);
+    const long before = minor_faults();
+    for (std::uint64_t i = 0; i < (1 << 19) - 1; ++i) assert(sink.try_enqueue(i));
+    for (std::uint64_t i = 0; i < (1 << 19) - 1; ++i) assert(source.try_dequeue().value() == i);
+    return minor_faults() - before;
+}
+#endif
+
+void test_mmap_populate() {
+    std::cout << "Testing test_mmap_populate..." << std::endl;
+#if defined(__linux__)
+    const long cold = first_lap_faults(MmapOptions());
+    MmapOptions populate;
+    populate.populate = true;
+    const long warm = first_lap_faults(populate);
+    // 4 MiB is 1024 regular pages; a pre-faulted ring should take next to none of those faults
+    assert(cold >= 512);
+    assert(warm < cold / 8);
+#endif
+    std::cout << "  PASSED: test_mmap_populate" << std::endl;
+}
+
+void test_mmap_lock() {
+    std::cout << "Testing test_mmap_lock..." << std::endl;
+    MmapOptions options;
+    options.lock = true;
+    try {
+        auto [sink, source] = MmapSPSC<int, 4096>::create(options);
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 4000; ++i) assert(sink.try_enqueue(i));
+            for (int i = 0; i < 4000; ++i) assert(source.try_dequeue().value() == i);
+        }
+    } catch (const std::runtime_error& e) {
+        // No CAP_IPC_LOCK and a small RLIMIT_MEMLOCK
+        std::cout << "  SKIPPED: " << e.what() << std::endl;
+        return;
+    }
+    std::cout << "  PASSED: test_mmap_lock" << std::endl;
+}
+
+void test_mmap_huge_pages() {
+    std::cout << "Testing test_mmap_huge_pages..." << std::endl;
+    MmapOptions invalid;
+    invalid.huge_page_size = 64 * 1024;
+    bool threw = false;
+    try {
+        MmapSPSC<int, 64>::create(invalid);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+#if defined(__linux__)
+    MmapOptions options;
+    options.huge_page_size = huge_page_2mb;
+    options.populate = true;
+    try {
+        // 4-byte slots: the ring rounds up to one 2 MiB page of 512Ki slots
+        auto [sink, source] = MmapSPSC<int, 1024>::create(options);
+        std::vector<int> batch(1000);
+        std::vector<int> out(1000);
+        int next = 0;
+        int expected = 0;
+        // Three laps through the ring, with bulk transfers straddling its end
+        while (expected < 3 * (1 << 19)) {
+            for (int& value : batch) value = next++;
+            assert(sink.try_enqueue(batch.data(), batch.size()) == batch.size());
+            assert(source.try_dequeue(out.data(), out.size()) == out.size());
+            for (int value : out) assert(value == expected++);
+        }
+        assert(source.empty());
+    } catch (const std::runtime_error& e) {
+        // No huge pages reserved (vm.nr_hugepages)
+        std::cout << "  SKIPPED: " << e.what() << std::endl;
+        return;
+    }
+#endif
+    std::cout << "  PASSED: test_mmap_huge_pages" << std::endl;
+}
+
+void test_mmap_shared_attach() {
+    std::cout << "Testing test_mmap_shared_attach..." << std::endl;
+    using Queue = MmapSPSC<int, 16, SharedParkingWait>;
+    const int fd = Queue::create_shared();
+    {
+        auto sink = Queue::attach_sink(fd);
+        auto source = Queue::attach_source(fd);
+
+        // Each handle maps the region separately; data flows through the shared pages
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < 15; ++i) assert(sink.try_enqueue(round * 100 + i));
+            assert(!sink.try_enqueue(-1));
+            assert(source.size() == 15);
+            for (int i = 0; i < 15; ++i) assert(source.try_dequeue().value() == round * 100 + i);
+            assert(source.empty());
+        }
+
+        // Only one handle per role
+        bool threw = false;
+        try {
+            Queue::attach_sink(fd);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Roles are released when the handles go away, and the indices persist in the region
+    {
+        auto sink = Queue::attach_sink(fd);
+        assert(sink.try_enqueue(7));
+    }
+    {
+        auto source = Queue::attach_source(fd);
+        assert(source.try_dequeue().value() == 7);
+    }
+    close(fd);
+
+    std::cout << "  PASSED: test_mmap_shared_attach" << std::endl;
+}
+
+void test_mmap_shared_mismatch() {
+    std::cout << "Testing test_mmap_shared_mismatch..." << std::endl;
+    const int fd = MmapSPSC<int, 1024, SharedParkingWait>::create_shared();
+
+    bool threw = false;
+    try {
+        MmapSPSC<long, 512, SharedParkingWait>::attach_source(fd); // same byte size, other type
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        MmapSPSC<int, 2048, SharedParkingWait>::attach_source(fd);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // A failed attach does not claim the role
+    auto source = MmapSPSC<int, 1024, SharedParkingWait>::attach_source(fd);
+    assert(source.empty());
+    close(fd);
+
+    std::cout << "  PASSED: test_mmap_shared_mismatch" << std::endl;
+}
+
+void test_mmap_shared_named() {
+    std::cout << "Testing test_mmap_shared_named..." << std::endl;
+    using Queue = MmapSPSC<std::uint64_t, 64>;
+    const std::string name = "/qbuf_test_" + std::to_string(getpid());
+
+    const int fd = Queue::create_shared(name.c_str());
+    auto sink = Queue::attach_sink(fd);
+    close(fd);
+
+    const int opened = Queue::open_shared(name.c_str());
+    auto source = Queue::attach_source(opened);
+    close(opened);
+    Queue::unlink_shared(name.c_str());
+
+    std::uint64_t data[40];
+    for (std::uint64_t i = 0; i < 40; ++i) data[i] = i * i;
+    assert(sink.try_enqueue(data, 40) == 40);
+    std::uint64_t out[40] = { };
+    assert(source.try_dequeue(out, 40) == 40);
+    for (std::uint64_t i = 0; i < 40; ++i) assert(out[i] == i * i);
+
+    bool threw = false;
+    try {
+        Queue::open_shared(name.c_str());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "  PASSED: test_mmap_shared_named" << std::endl;
+}
+
+void test_mmap_shared_fork() {
+    std::cout << "Testing test_mmap_shared_fork..." << std::endl;
+    using Queue = MmapSPSC<int, 64, SharedParkingWait>;
+    constexpr int num_elements = 20000;
+    const int fd = Queue::create_shared();
+
+    const pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        // Producer process: exit code reports success
+        auto sink = Queue::attach_sink(fd);
+        int batch[8];
+        for (int i = 0; i < num_elements; i += 8) {
+            for (int k = 0; k < 8; ++k) batch[k] = i + k;
+            if (!sink.enqueue(batch, 8, std::chrono::seconds(10))) _exit(1);
+        }
+        _exit(0);
+    }
+
+    auto source = Queue::attach_source(fd);
+    close(fd);
+    for (int i = 0; i < num_elements; ++i) {
+        auto value = source.dequeue(std::chrono::seconds(10));
+        assert(value.has_value());
+        assert(value.value() == i);
+    }
+
+    int status = 0;
+    assert(waitpid(child, &status, 0) == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(source.empty());
+
+    std::cout << "  PASSED: test_mmap_shared_fork" << std::endl;
+}
+
+std::string journal_path(const char* tag) {
+    return "/tmp/qbuf_test_" + std::string(tag) + "_" + std::to_string(getpid()) + ".journal";
+}
+
+void test_mmap_journal_recovery() {
+    std::cout << "Testing test_mmap_journal_recovery..." << std::endl;
+    using Queue = MmapSPSC<std::uint64_t, 1024>;
+    const std::string path = journal_path("recovery");
+    unlink(path.c_str());
+
+    {
+        auto [sink, source] = Queue::open_journal(path.c_str());
+        assert(sink.empty());
+        // Appends through reserve/commit and the copying calls alike
+        auto span = sink.reserve(100);
+        assert(span.size() == 100);
+        for (std::uint64_t i = 0; i < 100; ++i) span[i] = i;
+        sink.commit(100);
+        std::uint64_t more[50];
+        for (std::uint64_t i = 0; i < 50; ++i) more[i] = 100 + i;
+        assert(sink.try_enqueue(more, 50) == 50);
+        assert(source.try_dequeue().value() == 0);
+        auto view = source.peek();
+        assert(view.size() == 149);
+        source.consume(29);
+    }
+
+    // Both cursors come back from the file
+    {
+        auto [sink, source] = Queue::open_journal(path.c_str());
+        assert(source.size() == 120);
+        assert(source.try_dequeue().value() == 30);
+        assert(sink.try_enqueue(std::uint64_t(150)));
+        std::uint64_t out[200];
+        assert(source.try_dequeue(out, 200) == 120);
+        assert(out[0] == 31 && out[118] == 149 && out[119] == 150);
+        assert(source.empty());
+
+        // Keep going across the end of the ring
+        for (std::uint64_t round = 0; round < 10; ++round) {
+            for (std::uint64_t i = 0; i < 700; ++i) assert(sink.try_enqueue(round * 1000 + i));
+            for (std::uint64_t i = 0; i < 700; ++i) {
+                assert(source.try_dequeue().value() == round * 1000 + i);
+            }
+        }
+        assert(sink.try_enqueue(std::uint64_t(42)));
+    }
+    {
+        auto [sink, source] = Queue::open_journal(path.c_str());
+        assert(source.size() == 1);
+        assert(source.try_dequeue().value() == 42);
+    }
+    unlink(path.c_str());
+
+    std::cout << "  PASSED: test_mmap_journal_recovery" << std::endl;
+}
+
+void test_mmap_journal_errors() {
+    std::cout << "Testing test_mmap_journal_errors..." << std::endl;
+    const std::string path = journal_path("errors");
+    unlink(path.c_str());
+
+    {
+        auto [sink, source] = MmapSPSC<int, 1024>::open_journal(path.c_str());
+        assert(sink.try_enqueue(1));
+
+        // One owner at a time
+        bool threw = false;
+        try {
+            MmapSPSC<int, 1024>::open_journal(path.c_str());
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Another element size or capacity is rejected, and the file is left alone
+    bool threw = false;
+    try {
+        MmapSPSC<std::uint64_t, 1024>::open_journal(path.c_str());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        MmapSPSC<int, 4096>::open_journal(path.c_str());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    {
+        auto [sink, source] = MmapSPSC<int, 1024>::open_journal(path.c_str());
+        assert(source.try_dequeue().value() == 1);
+    }
+
+    JournalOptions options;
+    options.policy = SyncPolicy::every_n;
+    options.every_messages = 0;
+    threw = false;
+    try {
+        MmapSPSC<int, 1024>::open_journal(path.c_str(), options);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        MmapSPSC<int, 1024>::open_journal("/nonexistent-dir/qbuf.journal");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    unlink(path.c_str());
+
+    std::cout << "  PASSED: test_mmap_journal_errors" << std::endl;
+}
+
+void test_mmap_journal_sync_policies() {
+    std::cout << "Testing test_mmap_journal_sync_policies..." << std::endl;
+    const std::string path = journal_path("sync");
+
+    JournalOptions every;
+    every.policy = SyncPolicy::every_n;
+    every.every_messages = 16;
+    JournalOptions interval;
+    interval.policy = SyncPolicy::interval;
+    interval.interval = std::chrono::microseconds(200);
+    interval.method = SyncMethod::msync;
+    JournalOptions each;
+    each.policy = SyncPolicy::every_n;
+    each.method = SyncMethod::msync;
+
+    std::uint64_t next = 0;
+    for (const JournalOptions& options : { every, interval, each }) {
+        unlink(path.c_str());
+        {
+            auto [sink, source] = MmapSPSC<std::uint64_t, 512>::open_journal(path.c_str(), options);
+            std::uint64_t batch[10];
+            for (int round = 0; round < 20; ++round) {
+                for (auto& value : batch) value = next++;
+                assert(sink.try_enqueue(batch, 10) == 10);
+                assert(sink.try_enqueue(next++));
+                auto span = sink.reserve(3);
+                for (auto& value : span) value = next++;
+                sink.commit(span.size());
+                if (round % 5 == 0) std::this_thread::sleep_for(std::chrono::microseconds(300));
+                source.sync();
+                std::uint64_t out[14];
+                assert(source.try_dequeue(out, 14) == 14);
+                assert(out[13] == next - 1);
+            }
+            sink.sync();
+        }
+        auto [sink, source] = MmapSPSC<std::uint64_t, 512>::open_journal(path.c_str(), options);
+        assert(source.empty());
+    }
+    unlink(path.c_str());
+
+    // Memory-backed queues accept the calls as no-ops
+    auto [sink, source] = MmapSPSC<int, 64>::create();
+    sink.sync();
+    source.sync();
+
+    std::cout << "  PASSED: test_mmap_journal_sync_policies" << std::endl;
+}
+
+void test_mmap_journal_crash() {
+    std::cout << "Testing test_mmap_journal_crash..." << std::endl;
+    using Queue = MmapSPSC<std::uint64_t, 4096>;
+    const std::string path = journal_path("crash");
+    unlink(path.c_str());
+
+    const pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        // Producer dies without unmapping, syncing or releasing anything
+        auto [sink, source] = Queue::open_journal(path.c_str());
+        for (std::uint64_t i = 0; i < 1000; ++i) {
+            if (!sink.try_enqueue(i)) _exit(1);
+        }
+        for (std::uint64_t i = 0; i < 400; ++i) {
+            if (source.try_dequeue() != i) _exit(1);
+        }
+        std::abort();
+    }
+    int status = 0;
+    assert(waitpid(child, &status, 0) == child);
+    assert(WIFSIGNALED(status));
+
+    // The file lock died with the process; the page cache still has every write
+    auto [sink, source] = Queue::open_journal(path.c_str());
+    assert(source.size() == 600);
+    for (std::uint64_t i = 400; i < 1000; ++i) assert(source.try_dequeue().value() == i);
+    assert(source.empty());
+    unlink(path.c_str());
+
+    std::cout << "  PASSED: test_mmap_journal_crash" << std::endl;
+}
+
+void test_mmap_eventfd_notification() {
+    std::cout << "Testing test_mmap_eventfd_notification..." << std::endl;
+    auto [sink, source] = MmapSPSC<int, 64, EventFdWait>::create();
+    pollfd entry { source.native_handle(), POLLIN, 0 };
+
+    assert(source.arm_notification());
+    assert(poll(&entry, 1, 0) == 0);
+    assert(sink.try_enqueue(5));
+    assert(poll(&entry, 1, 0) == 1);
+    assert(source.try_dequeue() == 5);
+
+    std::cout << "  PASSED: test_mmap_eventfd_notification" << std::endl;
+}
+
+void test_mmap_shared_eventfd_fork() {
+    std::cout << "Testing test_mmap_shared_eventfd_fork..." << std::endl;
+    using Queue = MmapSPSC<int, 64, SharedEventFdWait>;
+    constexpr int num_elements = 5000;
+    const int fd = Queue::create_shared();
+
+    // The child inherits the eventfd at the same descriptor number
+    const pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        auto sink = Queue::attach_sink(fd);
+        for (int i = 0; i < num_elements; ++i) {
+            if (!sink.enqueue(i, std::chrono::seconds(10))) _exit(1);
+            if (i % 500 == 0) usleep(1000);
+        }
+        _exit(0);
+    }
+
+    auto source = Queue::attach_source(fd);
+    close(fd);
+    pollfd entry { source.native_handle(), POLLIN, 0 };
+    int next = 0;
+    while (next < num_elements) {
+        while (auto value = source.try_dequeue()) {
+            assert(*value == next);
+            ++next;
+        }
+        if (next < num_elements && source.arm_notification()) assert(poll(&entry, 1, 10000) == 1);
+    }
+
+    int status = 0;
+    assert(waitpid(child, &status, 0) == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    std::cout << "  PASSED: test_mmap_shared_eventfd_fork" << std::endl;
+}
+
 void test_mmap_blocking_enqueue() {
     std::cout << "Testing test_mmap_blocking_enqueue..." << std::endl;
 
@@ -330,6 +1141,48 @@ void test_mmap_blocking_rvalue_enqueue_with_movable_type() {
     std::cout << "  PASSED: test_mmap_blocking_rvalue_enqueue_with_movable_type" << std::endl;
 }
 
+void test_mmap_in_place_operations() {
+    std::cout << "Testing test_mmap_in_place_operations..." << std::endl;
+
+    auto [sink, source] = MmapSPSC<MoveOnlyContainer<int>, 4>::create();
+
+    // emplace constructs in the slot and try_consume reads it there: no moves at all
+    assert(sink.emplace(1));
+    int moves = -1;
+    assert(source.try_consume([&](MoveOnlyContainer<int>& value) {
+        assert(value.data() == 1);
+        moves = value.moved();
+    }));
+    assert(moves == 0);
+
+    // try_dequeue(T&) moves once, into the caller's object
+    assert(sink.emplace(2));
+    MoveOnlyContainer<int> out(0);
+    assert(source.try_dequeue(out));
+    assert(out.data() == 2 && out.moved() == 1);
+
+    // Full queue: nothing is constructed; empty queue: nothing is written
+    for (int i = 0; i < 3; ++i) assert(sink.emplace(10 + i));
+    assert(!sink.emplace(99));
+    bool threw = false;
+    try {
+        source.try_consume([](MoveOnlyContainer<int>&) { throw std::runtime_error("failed"); });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(source.size() == 3);
+    for (int i = 0; i < 3; ++i) {
+        assert(source.try_dequeue(out));
+        assert(out.data() == 10 + i);
+    }
+    assert(!source.try_dequeue(out));
+    assert(out.data() == 12);
+    assert(!source.try_consume([](MoveOnlyContainer<int>&) { assert(false); }));
+
+    std::cout << "  PASSED: test_mmap_in_place_operations" << std::endl;
+}
+
 void test_mmap_producer_consumer_stress() {
     constexpr std::size_t total_items = 100000;
     std::cout << "Testing test_mmap_producer_consumer_stress..." << std::endl;
@@ -370,14 +1223,37 @@ void run_all_mmap_spsc_tests() {
 
     test_mmap_basic_enqueue_dequeue();
     test_mmap_full_queue();
+    test_mmap_cached_index_refresh();
     test_mmap_bulk_operations();
     test_mmap_bulk_wraparound();
+    test_mmap_bulk_wraparound_strings();
+    test_mmap_reserve_commit();
+    test_mmap_peek_consume();
+    test_mmap_drain();
+    test_mmap_contiguous_across_wrap();
+    test_mmap_odd_element_size();
+    test_mmap_parking_wait();
+    test_mmap_numa_node();
+    test_mmap_populate();
+    test_mmap_lock();
+    test_mmap_huge_pages();
+    test_mmap_shared_attach();
+    test_mmap_shared_mismatch();
+    test_mmap_shared_named();
+    test_mmap_shared_fork();
+    test_mmap_journal_recovery();
+    test_mmap_journal_errors();
+    test_mmap_journal_sync_policies();
+    test_mmap_journal_crash();
+    test_mmap_eventfd_notification();
+    test_mmap_shared_eventfd_fork();
     test_mmap_blocking_enqueue();
     test_mmap_blocking_dequeue();
     test_mmap_blocking_bulk_enqueue();
     test_mmap_timeout();
     test_mmap_move_semantics();
     test_mmap_blocking_rvalue_enqueue_with_movable_type();
+    test_mmap_in_place_operations();
     test_mmap_producer_consumer_stress();
 
     std::cout << "\n=== All MmapSPSC tests passed ===" << std::endl;
@@ -0,0 +1,217 @@
+#include "assert.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <qbuf/mpmc.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+void test_mpmc_basic_operations() {
+    std::cout << "Testing basic operations..." << std::endl;
+    auto [sink, source] = MPMC<int, 8>::make_queue();
+
+    // Test empty queue
+    assert(source.empty());
+    assert(source.size() == 0);
+    assert(!source.try_dequeue().has_value());
+
+    // Test push and pop single element
+    assert(sink.try_enqueue(42));
+    assert(!source.empty());
+    assert(source.size() == 1);
+
+    auto value = source.try_dequeue();
+    assert(value.has_value());
+    assert(value.value() == 42);
+    assert(source.empty());
+
+    std::cout << "  PASSED: basic operations" << std::endl;
+}
+
+void test_mpmc_full_queue() {
+    std::cout << "Testing full queue..." << std::endl;
+    auto [sink, source] = MPMC<int, 4>::make_queue();
+
+    // Every slot is usable
+    for (int i = 0; i < 4; ++i) {
+        assert(sink.try_enqueue(i));
+    }
+    assert(!sink.try_enqueue(99));
+    assert(sink.size() == 4);
+
+    for (int i = 0; i < 4; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value());
+        assert(value.value() == i);
+    }
+    assert(source.empty());
+
+    std::cout << "  PASSED: full queue" << std::endl;
+}
+
+void test_mpmc_bulk_wrap_around() {
+    std::cout << "Testing bulk wrap-around..." << std::endl;
+    auto [sink, source] = MPMC<int, 8>::make_queue();
+
+    int input[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    int output[8] = { };
+
+    // Advance positions so the next runs straddle the end of the ring
+    assert(sink.try_enqueue(input, 5) == 5);
+    assert(source.try_dequeue(output, 5) == 5);
+
+    assert(sink.try_enqueue(input, 8) == 8);
+    assert(sink.try_enqueue(input, 1) == 0); // full
+
+    assert(source.try_dequeue(output, 3) == 3);
+    assert(source.try_dequeue(output + 3, 8) == 5);
+    for (int i = 0; i < 8; ++i) {
+        assert(output[i] == i);
+    }
+    assert(source.try_dequeue(output, 8) == 0);
+
+    std::cout << "  PASSED: bulk wrap-around" << std::endl;
+}
+
+void test_mpmc_handles_are_copyable() {
+    std::cout << "Testing copyable handles..." << std::endl;
+    auto [sink, source] = MPMC<std::string, 8>::make_queue();
+
+    auto sink_copy = sink;
+    auto source_copy = source;
+    assert(sink.try_enqueue(std::string("a")));
+    assert(sink_copy.try_enqueue(std::string("b")));
+    assert(source_copy.try_dequeue().value() == "a");
+    assert(source.try_dequeue().value() == "b");
+
+    std::cout << "  PASSED: copyable handles" << std::endl;
+}
+
+void test_mpmc_timeouts() {
+    std::cout << "Testing timeouts..." << std::endl;
+    auto [sink, source] = MPMC<int, 2>::make_queue();
+
+    auto start = std::chrono::steady_clock::now();
+    assert(!source.dequeue(std::chrono::milliseconds(20)).has_value());
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    assert(sink.try_enqueue(1));
+    assert(sink.try_enqueue(2));
+    start = std::chrono::steady_clock::now();
+    assert(!sink.enqueue(3, std::chrono::milliseconds(20)));
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    int data[4] = { 3, 4, 5, 6 };
+    assert(!sink.enqueue(data, 4, std::chrono::milliseconds(10)));
+
+    int out[4];
+    assert(source.dequeue(out, 4, std::chrono::milliseconds(10)) == 2);
+    assert(out[0] == 1 && out[1] == 2);
+
+    std::cout << "  PASSED: timeouts" << std::endl;
+}
+
+// Every produced value must be consumed exactly once, and each producer's values in order
+template <typename Wait>
+void check_mpmc_concurrent(int num_producers, int num_consumers) {
+    auto [sink, source] = MPMC<int, 64, Wait>::make_queue();
+    constexpr int per_producer = 5000;
+    const int total = num_producers * per_producer;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < num_producers; ++p) {
+        threads.emplace_back([sink = sink, p]() mutable {
+            int batch[3];
+            for (int i = 0; i < per_producer;) {
+                if (i % 2 == 0 || i + 3 > per_producer) {
+                    assert(sink.enqueue(p * per_producer + i, std::chrono::seconds(10)));
+                    ++i;
+                } else {
+                    for (int k = 0; k < 3; ++k) batch[k] = p * per_producer + i + k;
+                    assert(sink.enqueue(batch, 3, std::chrono::seconds(10)));
+                    i += 3;
+                }
+            }
+        });
+    }
+
+    std::atomic<int> consumed { 0 };
+    std::vector<std::vector<int>> received(num_consumers);
+    for (int c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([source = source, &consumed, &received, c, total]() mutable {
+            int batch[4];
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                const std::size_t n = source.try_dequeue(batch, 4);
+                if (n == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                received[c].insert(received[c].end(), batch, batch + n);
+                consumed.fetch_add(static_cast<int>(n), std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    std::vector<int> all;
+    for (const auto& values : received) {
+        // Positions are claimed in order, so each consumer sees a producer's values ascending
+        std::vector<int> last(num_producers, -1);
+        for (int value : values) {
+            const int p = value / per_producer;
+            assert(value > last[p]);
+            last[p] = value;
+        }
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    assert(static_cast<int>(all.size()) == total);
+    for (int i = 0; i < total; ++i) {
+        assert(all[i] == i);
+    }
+    assert(source.empty());
+}
+
+void test_mpmc_concurrent() {
+    std::cout << "Testing concurrent producers and consumers..." << std::endl;
+
+    check_mpmc_concurrent<YieldWait>(1, 1);
+    check_mpmc_concurrent<YieldWait>(4, 1);
+    check_mpmc_concurrent<YieldWait>(1, 4);
+    check_mpmc_concurrent<YieldWait>(4, 4);
+    check_mpmc_concurrent<ParkingWait>(4, 4);
+
+    std::cout << "  PASSED: concurrent producers and consumers" << std::endl;
+}
+
+void run_all_mpmc_tests() {
+    std::cout << "\n=== Running MPMC Tests ===" << std::endl;
+
+    test_mpmc_basic_operations();
+    test_mpmc_full_queue();
+    test_mpmc_bulk_wrap_around();
+    test_mpmc_handles_are_copyable();
+    test_mpmc_timeouts();
+    test_mpmc_concurrent();
+
+    std::cout << "\n=== All MPMC tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_mpmc_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,251 @@
+#include "assert.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <qbuf/mpsc.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+void test_mpsc_basic_operations() {
+    std::cout << "Testing basic operations..." << std::endl;
+    auto [sink, source] = MPSC<int, 8>::make_queue();
+
+    // Test empty queue
+    assert(source.empty());
+    assert(source.size() == 0);
+    assert(!source.try_dequeue().has_value());
+
+    // Test push and pop single element
+    assert(sink.try_enqueue(42));
+    assert(!source.empty());
+    assert(source.size() == 1);
+
+    auto value = source.try_dequeue();
+    assert(value.has_value());
+    assert(value.value() == 42);
+    assert(source.empty());
+
+    std::cout << "  PASSED: basic operations" << std::endl;
+}
+
+void test_mpsc_full_queue() {
+    std::cout << "Testing full queue..." << std::endl;
+    auto [sink, source] = MPSC<int, 4>::make_queue();
+
+    // Every slot is usable
+    for (int i = 0; i < 4; ++i) {
+        assert(sink.try_enqueue(i));
+    }
+    assert(!sink.try_enqueue(99));
+    int data[2] = { 5, 6 };
+    assert(sink.try_enqueue(data, 2) == 0);
+    assert(sink.size() == 4);
+
+    for (int i = 0; i < 4; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value());
+        assert(value.value() == i);
+    }
+    assert(source.empty());
+
+    std::cout << "  PASSED: full queue" << std::endl;
+}
+
+void test_mpsc_bulk_drain() {
+    std::cout << "Testing bulk drain..." << std::endl;
+    auto [sink, source] = MPSC<int, 8>::make_queue();
+
+    int input[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    int output[8] = { };
+
+    // Advance positions so the next runs straddle the end of the ring
+    assert(sink.try_enqueue(input, 5) == 5);
+    assert(source.try_dequeue(output, 8) == 5);
+
+    assert(sink.try_enqueue(input, 8) == 8);
+    assert(sink.try_enqueue(input, 1) == 0); // full
+
+    assert(source.try_dequeue(output, 3) == 3);
+    assert(source.try_dequeue(output + 3, 8) == 5);
+    for (int i = 0; i < 8; ++i) {
+        assert(output[i] == i);
+    }
+    assert(source.try_dequeue(output, 8) == 0);
+
+    std::cout << "  PASSED: bulk drain" << std::endl;
+}
+
+void test_mpsc_with_strings() {
+    std::cout << "Testing with strings..." << std::endl;
+    auto [sink, source] = MPSC<std::string, 4>::make_queue();
+
+    auto other = sink;
+    assert(sink.enqueue(std::string("a"), std::chrono::milliseconds(10)));
+    assert(other.enqueue(std::string("b"), std::chrono::milliseconds(10)));
+
+    std::string out[2];
+    assert(source.dequeue(out, 2, std::chrono::milliseconds(10)) == 2);
+    assert(out[0] == "a" && out[1] == "b");
+
+    std::cout << "  PASSED: with strings" << std::endl;
+}
+
+void test_mpsc_timeouts() {
+    std::cout << "Testing timeouts..." << std::endl;
+    auto [sink, source] = MPSC<int, 2>::make_queue();
+
+    auto start = std::chrono::steady_clock::now();
+    assert(!source.dequeue(std::chrono::milliseconds(20)).has_value());
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    assert(sink.enqueue(1, std::chrono::milliseconds(10)));
+    assert(sink.enqueue(2, std::chrono::milliseconds(10)));
+    start = std::chrono::steady_clock::now();
+    assert(!sink.enqueue(3, std::chrono::milliseconds(20)));
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    int data[4] = { 3, 4, 5, 6 };
+    assert(!sink.enqueue(data, 4, std::chrono::milliseconds(10)));
+
+    int out[4];
+    assert(source.dequeue(out, 4, std::chrono::milliseconds(10)) == 2);
+    assert(out[0] == 1 && out[1] == 2);
+
+    std::cout << "  PASSED: timeouts" << std::endl;
+}
+
+// Producers racing for the last free slot against a stalled consumer: one wins, the rest time out
+template <typename Wait>
+void check_mpsc_last_slot_race(int num_producers) {
+    auto [sink, source] = MPSC<int, 4, Wait>::make_queue();
+    for (int i = 0; i < 3; ++i) assert(sink.try_enqueue(i));
+
+    constexpr auto timeout = std::chrono::milliseconds(20);
+    std::atomic<int> succeeded { 0 };
+    std::atomic<bool> late { false };
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([sink = sink, p, timeout, &succeeded, &late]() mutable {
+            const auto start = std::chrono::steady_clock::now();
+            if (p % 2 == 0) {
+                if (sink.enqueue(100 + p, timeout)) succeeded.fetch_add(1);
+            } else {
+                const int batch[1] = { 100 + p };
+                if (sink.enqueue(batch, 1, timeout)) succeeded.fetch_add(1);
+            }
+            if (std::chrono::steady_clock::now() - start > timeout + std::chrono::seconds(1)) {
+                late.store(true);
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+
+    assert(succeeded.load() == 1);
+    assert(!late.load());
+    assert(source.size() == 4);
+    int out[4];
+    assert(source.try_dequeue(out, 4) == 4);
+    assert(out[0] == 0 && out[1] == 1 && out[2] == 2 && out[3] >= 100);
+}
+
+void test_mpsc_last_slot_race() {
+    std::cout << "Testing timed enqueues racing for the last slot..." << std::endl;
+
+    for (int round = 0; round < 20; ++round) {
+        check_mpsc_last_slot_race<YieldWait>(8);
+        check_mpsc_last_slot_race<ParkingWait>(8);
+    }
+
+    std::cout << "  PASSED: timed enqueues racing for the last slot" << std::endl;
+}
+
+// Each producer's values must arrive in order, and every value exactly once
+template <typename Wait>
+void check_mpsc_concurrent(int num_producers) {
+    auto [sink, source] = MPSC<int, 64, Wait>::make_queue();
+    constexpr int per_producer = 5000;
+    const int total = num_producers * per_producer;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([sink = sink, p]() mutable {
+            int batch[3];
+            for (int i = 0; i < per_producer;) {
+                const int value = p * per_producer + i;
+                if (i % 3 == 0) {
+                    assert(sink.enqueue(value, std::chrono::seconds(10)));
+                    ++i;
+                } else if (i % 3 == 1 || i + 3 > per_producer) {
+                    while (!sink.try_enqueue(value)) std::this_thread::yield();
+                    ++i;
+                } else {
+                    for (int k = 0; k < 3; ++k) batch[k] = value + k;
+                    assert(sink.enqueue(batch, 3, std::chrono::seconds(10)));
+                    i += 3;
+                }
+            }
+        });
+    }
+
+    std::vector<int> last(num_producers, -1);
+    std::vector<int> counts(num_producers, 0);
+    int batch[16];
+    for (int received = 0; received < total;) {
+        const std::size_t n = source.dequeue(batch, 16, std::chrono::milliseconds(1));
+        for (std::size_t i = 0; i < n; ++i) {
+            const int p = batch[i] / per_producer;
+            assert(batch[i] > last[p]);
+            last[p] = batch[i];
+            ++counts[p];
+        }
+        received += static_cast<int>(n);
+    }
+
+    for (auto& producer : producers) producer.join();
+    for (int p = 0; p < num_producers; ++p) {
+        assert(counts[p] == per_producer);
+    }
+    assert(source.empty());
+}
+
+void test_mpsc_concurrent() {
+    std::cout << "Testing concurrent producers..." << std::endl;
+
+    check_mpsc_concurrent<YieldWait>(1);
+    check_mpsc_concurrent<YieldWait>(4);
+    check_mpsc_concurrent<YieldWait>(8);
+    check_mpsc_concurrent<ParkingWait>(4);
+
+    std::cout << "  PASSED: concurrent producers" << std::endl;
+}
+
+void run_all_mpsc_tests() {
+    std::cout << "\n=== Running MPSC Tests ===" << std::endl;
+
+    test_mpsc_basic_operations();
+    test_mpsc_full_queue();
+    test_mpsc_bulk_drain();
+    test_mpsc_with_strings();
+    test_mpsc_timeouts();
+    test_mpsc_last_slot_race();
+    test_mpsc_concurrent();
+
+    std::cout << "\n=== All MPSC tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_mpsc_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
@@ -3,7 +3,10 @@
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <qbuf/mutex_queue.hpp>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -323,6 +326,132 @@ void test_mutex_bulk_concurrent() {
     std::cout << "  PASSED: concurrent bulk operations" << std::endl;
 }
 
+void test_mutex_reserve_commit() {
+    std::cout << "Testing MutexQueue reserve/commit..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 8>::make_queue();
+
+    auto region = sink.reserve(5);
+    assert(region.size() == 5);
+    for (std::size_t i = 0; i < region.size(); ++i) {
+        region[i] = static_cast<int>(i);
+    }
+    assert(source.empty());
+
+    sink.commit(3);
+    assert(source.size() == 3);
+    std::vector<int> output(8, 0);
+    assert(source.try_dequeue(output.data(), 3) == 3);
+    for (int i = 0; i < 3; ++i) {
+        assert(output[i] == i);
+    }
+
+    // Wrapped reservation: 5 slots at the end of the buffer, 2 from the start
+    region = sink.reserve(100);
+    assert(region.size() == 7);
+    assert(region.first.size() == 5);
+    assert(region.second.size() == 2);
+    for (std::size_t i = 0; i < region.size(); ++i) {
+        region[i] = 100 + static_cast<int>(i);
+    }
+    sink.commit(region.size());
+    assert(sink.reserve(1).empty());
+
+    assert(source.try_dequeue(output.data(), 8) == 7);
+    for (int i = 0; i < 7; ++i) {
+        assert(output[i] == 100 + i);
+    }
+
+    std::cout << "  PASSED: MutexQueue reserve/commit" << std::endl;
+}
+
+void test_mutex_peek_consume() {
+    std::cout << "Testing MutexQueue peek/consume..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 8>::make_queue();
+
+    assert(source.peek().empty());
+    for (int i = 0; i < 3; ++i) {
+        assert(sink.try_enqueue(i));
+    }
+
+    auto view = source.peek();
+    assert(view.size() == 3);
+    assert(view[0] == 0);
+    assert(view[2] == 2);
+    assert(source.size() == 3);
+    source.consume(3);
+    assert(source.empty());
+
+    // Wrapped view: head is at 3, so 5 slots before the end and 2 after
+    for (int i = 0; i < 7; ++i) {
+        assert(sink.try_enqueue(10 + i));
+    }
+    view = source.peek();
+    assert(view.size() == 7);
+    assert(view.first.size() == 5);
+    assert(view.second.size() == 2);
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        assert(view[i] == 10 + static_cast<int>(i));
+    }
+    source.consume(view.size());
+    assert(source.empty());
+
+    std::cout << "  PASSED: MutexQueue peek/consume" << std::endl;
+}
+
+void test_mutex_drain() {
+    std::cout << "Testing MutexQueue drain..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 8>::make_queue();
+    assert(source.drain([](int&) { assert(false); }) == 0);
+
+    // Head at 3, so the drained elements wrap past the end of the buffer
+    for (int i = 0; i < 3; ++i) assert(sink.try_enqueue(i));
+    assert(source.drain([](int&) { }) == 3);
+    for (int i = 0; i < 7; ++i) assert(sink.try_enqueue(10 + i));
+
+    std::vector<int> seen;
+    assert(source.drain([&](int& value) { seen.push_back(value); }, 2) == 2);
+    assert(source.drain([&](int& value) { seen.push_back(value); }, 100, 2) == 5);
+    assert(seen == std::vector<int>({ 10, 11, 12, 13, 14, 15, 16 }));
+    assert(source.empty());
+
+    // A throwing callback releases what it visited before the throw
+    for (int i = 0; i < 4; ++i) assert(sink.try_enqueue(i));
+    bool threw = false;
+    try {
+        source.drain([](int& value) {
+            if (value == 2) throw std::runtime_error("consumer failed");
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(source.size() == 2);
+    assert(source.try_dequeue().value() == 2);
+
+    // Move-only elements, drained while a producer blocks on a full queue
+    auto [ptr_sink, ptr_source] = MutexQueue<std::unique_ptr<int>, 4>::make_queue();
+    constexpr int count = 1000;
+    std::thread producer([&ptr_sink = ptr_sink]() {
+        for (int i = 0; i < count; ++i) {
+            assert(ptr_sink.enqueue(std::make_unique<int>(i), std::chrono::seconds(5)));
+        }
+    });
+    int expected = 0;
+    while (expected < count) {
+        const std::size_t n = ptr_source.drain(
+            [&](std::unique_ptr<int>& value) {
+                const auto taken = std::move(value);
+                assert(*taken == expected++);
+            },
+            64, 1
+        );
+        if (n == 0) std::this_thread::yield();
+    }
+    producer.join();
+
+    std::cout << "  PASSED: MutexQueue drain" << std::endl;
+}
+
 void test_mutex_blocking_enqueue() {
     std::cout << "Testing blocking enqueue..." << std::endl;
     auto [sink, source] = MutexQueue<int, 8>::make_queue();
@@ -1077,6 +1206,217 @@ void test_mutex_sink_source_concurrent() {
     std::cout << "  PASSED: MutexSink and MutexSource concurrent" << std::endl;
 }
 
+void test_mutex_watermarks_invalid() {
+    std::cout << "Testing watermark validation..." << std::endl;
+    bool threw = false;
+    try {
+        MutexQueue<int, 8>::make_queue(Watermarks { 0, 0 });
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Occupancy never exceeds Capacity - 1, so consumers would never be woken
+    threw = false;
+    try {
+        MutexQueue<int, 8>::make_queue(Watermarks { 4, 7 });
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    MutexQueue<int, 8>::make_queue(Watermarks { 8, 6 });
+    std::cout << "  PASSED: watermark validation" << std::endl;
+}
+
+void test_mutex_high_watermark() {
+    std::cout << "Testing high watermark wakes consumers in batches..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 16>::make_queue(Watermarks { 16, 4 });
+    std::atomic<bool> woken { false };
+
+    std::thread consumer([&source = source, &woken]() {
+        auto value = source.dequeue(std::chrono::seconds(10));
+        assert(value.has_value() && *value == 0);
+        woken = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // At or below the watermark the sleeping consumer is left alone
+    for (int i = 0; i < 4; ++i) assert(sink.try_enqueue(i));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(!woken);
+
+    assert(sink.try_enqueue(4));
+    consumer.join();
+    assert(woken);
+    assert(source.size() == 4);
+    std::cout << "  PASSED: high watermark wakes consumers in batches" << std::endl;
+}
+
+void test_mutex_low_watermark() {
+    std::cout << "Testing low watermark wakes producers in batches..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 8>::make_queue(Watermarks { 3, 0 });
+    for (int i = 0; i < 7; ++i) assert(sink.try_enqueue(i));
+    std::atomic<bool> woken { false };
+
+    std::thread producer([&sink = sink, &woken]() {
+        assert(sink.enqueue(7, std::chrono::seconds(10)));
+        woken = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // The producer sleeps until occupancy drops below 3
+    for (int i = 0; i < 4; ++i) assert(source.try_dequeue() == i);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(!woken);
+
+    assert(source.try_dequeue() == 4);
+    producer.join();
+    assert(woken);
+    assert(source.size() == 3);
+    std::cout << "  PASSED: low watermark wakes producers in batches" << std::endl;
+}
+
+void test_mutex_watermark_timeout_takes_data() {
+    std::cout << "Testing watermark waiters take data at their timeout..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 16>::make_queue(Watermarks { 16, 8 });
+
+    std::thread producer([&sink = sink]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(sink.try_enqueue(42));
+    });
+    // Not woken (one element is below the watermark), but the element is there at the timeout
+    auto value = source.dequeue(std::chrono::milliseconds(50));
+    producer.join();
+    assert(value.has_value() && *value == 42);
+
+    int data[4] = { 1, 2, 3, 4 };
+    assert(sink.try_enqueue(data, 2) == 2);
+    assert(source.dequeue(data, 4, std::chrono::milliseconds(20)) == 2);
+    std::cout << "  PASSED: watermark waiters take data at their timeout" << std::endl;
+}
+
+void test_mutex_watermark_stream() {
+    std::cout << "Testing watermark blocking stream..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 64>::make_queue(Watermarks { 16, 32 });
+    constexpr int num_elements = 100000;
+
+    std::thread producer([&sink = sink]() {
+        for (int i = 0; i < num_elements; ++i) assert(sink.enqueue(i, std::chrono::seconds(10)));
+    });
+    for (int next = 0; next < num_elements;) {
+        // Short timeouts bound the wait for a tail that stays below the high watermark
+        int batch[16];
+        const std::size_t n = source.dequeue(batch, 16, std::chrono::milliseconds(1));
+        for (std::size_t i = 0; i < n; ++i) assert(batch[i] == next++);
+    }
+    producer.join();
+    assert(source.empty());
+    std::cout << "  PASSED: watermark blocking stream" << std::endl;
+}
+
+void test_mutex_string_single() {
+    std::cout << "Testing std::string single operations..." << std::endl;
+    auto [sink, source] = MutexQueue<std::string, 4>::make_queue();
+
+    assert(sink.try_enqueue(std::string(100, 'a')));
+    assert(sink.try_enqueue("short"));
+    auto first = source.try_dequeue();
+    assert(first.has_value() && *first == std::string(100, 'a'));
+
+    // try_dequeue(T&) reuses the caller's object and leaves it untouched when empty
+    std::string out = "unchanged";
+    assert(source.try_dequeue(out));
+    assert(out == "short");
+    assert(!source.try_dequeue(out));
+    assert(out == "short");
+
+    assert(sink.enqueue("timed", std::chrono::milliseconds(10)));
+    auto timed = source.dequeue(std::chrono::milliseconds(10));
+    assert(timed.has_value() && *timed == "timed");
+    assert(!source.dequeue(std::chrono::milliseconds(1)).has_value());
+    std::cout << "  PASSED: std::string single operations" << std::endl;
+}
+
+void test_mutex_string_bulk_wrap_around() {
+    std::cout << "Testing std::string bulk operations with wrap-around..." << std::endl;
+    auto [sink, source] = MutexQueue<std::string, 8>::make_queue();
+    auto make = [](int i) { return "payload-" + std::to_string(i) + std::string(40, 'x'); };
+
+    std::vector<std::string> batch;
+    for (int i = 0; i < 5; ++i) batch.push_back(make(i));
+    assert(sink.try_enqueue(batch.data(), batch.size()) == 5);
+    // Bulk enqueue copies: the caller's strings are intact
+    assert(batch[4] == make(4));
+
+    std::vector<std::string> out(8);
+    assert(source.try_dequeue(out.data(), 3) == 3);
+    assert(out[0] == make(0) && out[2] == make(2));
+
+    // Tail wraps: 2 elements left, 5 free slots
+    batch.clear();
+    for (int i = 5; i < 12; ++i) batch.push_back(make(i));
+    assert(sink.try_enqueue(batch.data(), batch.size()) == 5);
+    assert(source.size() == 7);
+
+    assert(source.dequeue(out.data(), 8, std::chrono::milliseconds(1)) == 7);
+    for (int i = 0; i < 7; ++i) assert(out[i] == make(i + 3));
+    assert(source.empty());
+    std::cout << "  PASSED: std::string bulk operations with wrap-around" << std::endl;
+}
+
+void test_mutex_shared_ptr_lifetime() {
+    std::cout << "Testing shared_ptr payload lifetime..." << std::endl;
+    auto tracked = std::make_shared<int>(42);
+    {
+        auto [sink, source] = MutexQueue<std::shared_ptr<int>, 8>::make_queue();
+        std::vector<std::shared_ptr<int>> batch(4, tracked);
+        assert(sink.enqueue(batch.data(), batch.size(), std::chrono::milliseconds(10)));
+        assert(tracked.use_count() == 9);
+        batch.clear();
+        assert(tracked.use_count() == 5);
+
+        // Dequeueing moves out of the ring, so no extra references linger in the slots
+        std::vector<std::shared_ptr<int>> out(4);
+        assert(source.try_dequeue(out.data(), 2) == 2);
+        assert(tracked.use_count() == 5);
+        out.clear();
+        assert(tracked.use_count() == 3);
+
+        std::shared_ptr<int> one;
+        assert(source.try_dequeue(one) && *one == 42);
+        assert(tracked.use_count() == 3);
+    }
+    // Destroying the queue releases the element still in the ring
+    assert(tracked.use_count() == 1);
+    std::cout << "  PASSED: shared_ptr payload lifetime" << std::endl;
+}
+
+void test_mutex_string_concurrent() {
+    std::cout << "Testing std::string concurrent bulk transfer..." << std::endl;
+    auto [sink, source] = MutexQueue<std::string, 64>::make_queue();
+    constexpr int num_elements = 20000;
+
+    std::thread producer([&sink = sink]() {
+        std::vector<std::string> batch;
+        for (int i = 0; i < num_elements;) {
+            batch.clear();
+            for (int j = 0; j < 16 && i < num_elements; ++j, ++i) {
+                batch.push_back(std::to_string(i));
+            }
+            assert(sink.enqueue(batch.data(), batch.size(), std::chrono::seconds(10)));
+        }
+    });
+    std::vector<std::string> batch(32);
+    for (int next = 0; next < num_elements;) {
+        const std::size_t n = source.dequeue(batch.data(), batch.size(), std::chrono::seconds(10));
+        assert(n > 0);
+        for (std::size_t i = 0; i < n; ++i) assert(batch[i] == std::to_string(next++));
+    }
+    producer.join();
+    assert(source.empty());
+    std::cout << "  PASSED: std::string concurrent bulk transfer" << std::endl;
+}
+
 void run_all_mutex_queue_tests() {
     std::cout << "\n=== Running MutexQueue Tests ===" << std::endl;
 
@@ -1090,6 +1430,9 @@ void run_all_mutex_queue_tests() {
     test_mutex_bulk_empty_dequeue();
     test_mutex_bulk_wrap_around();
     test_mutex_bulk_concurrent();
+    test_mutex_reserve_commit();
+    test_mutex_peek_consume();
+    test_mutex_drain();
     test_mutex_blocking_enqueue();
     test_mutex_blocking_dequeue();
     test_mutex_blocking_concurrent();
@@ -1112,6 +1455,15 @@ void run_all_mutex_queue_tests() {
     test_mutex_sink();
     test_mutex_source();
     test_mutex_sink_source_concurrent();
+    test_mutex_watermarks_invalid();
+    test_mutex_high_watermark();
+    test_mutex_low_watermark();
+    test_mutex_watermark_timeout_takes_data();
+    test_mutex_watermark_stream();
+    test_mutex_string_single();
+    test_mutex_string_bulk_wrap_around();
+    test_mutex_shared_ptr_lifetime();
+    test_mutex_string_concurrent();
 
     std::cout << "\n=== All MutexQueue tests passed ===" << std::endl;
 }
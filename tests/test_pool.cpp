@@ -0,0 +1,217 @@
+#include "assert.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <qbuf/pool.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+void test_pool_basic_operations() {
+    std::cout << "Testing pool basic operations..." << std::endl;
+    auto [sink, source] = make_pooled_queue<int, 4>();
+    assert(sink.capacity() == 4);
+    assert(source.empty());
+
+    auto slot = sink.try_acquire();
+    assert(slot.has_value() && *slot);
+    **slot = 42;
+    sink.enqueue(std::move(*slot));
+    assert(!*slot);
+    assert(source.size() == 1);
+
+    auto received = source.try_dequeue();
+    assert(received.has_value());
+    assert(**received == 42);
+    assert(source.empty());
+    assert(!source.try_dequeue().has_value());
+    std::cout << "  PASSED: pool basic operations" << std::endl;
+}
+
+void test_pool_exhaustion() {
+    std::cout << "Testing pool exhaustion..." << std::endl;
+    // Non-power-of-two slot counts are allowed
+    auto [sink, source] = make_pooled_queue<int, 5>();
+
+    std::vector<Pool<int, 5>::Slot> held;
+    for (int i = 0; i < 5; ++i) {
+        auto slot = sink.try_acquire();
+        assert(slot.has_value());
+        held.push_back(std::move(*slot));
+    }
+    assert(!sink.try_acquire().has_value());
+    assert(!sink.try_enqueue(1));
+
+    // A slot dropped by the producer goes straight back to its free stack
+    held.pop_back();
+    assert(sink.try_acquire().has_value());
+    std::cout << "  PASSED: pool exhaustion" << std::endl;
+}
+
+void test_pool_return_channel() {
+    std::cout << "Testing pool return channel..." << std::endl;
+    auto [sink, source] = make_pooled_queue<int, 4>();
+
+    for (int i = 0; i < 4; ++i) assert(sink.try_enqueue(i));
+    assert(!sink.try_enqueue(4));
+
+    // Slots held by the consumer stay unavailable until released
+    auto first = source.try_dequeue();
+    assert(first.has_value() && **first == 0);
+    assert(!sink.try_acquire().has_value());
+    first->reset();
+    assert(!*first);
+
+    auto slot = sink.try_acquire();
+    assert(slot.has_value());
+    slot->reset();
+
+    // Released in FIFO order as the consumer drops them
+    for (int i = 1; i < 4; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value() && **value == i);
+    }
+    for (int i = 0; i < 4; ++i) assert(sink.try_enqueue(10 + i));
+    for (int i = 0; i < 4; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value() && **value == 10 + i);
+    }
+    std::cout << "  PASSED: pool return channel" << std::endl;
+}
+
+void test_pool_slot_move() {
+    std::cout << "Testing pool slot move semantics..." << std::endl;
+    auto [sink, source] = make_pooled_queue<std::string, 2>();
+
+    Pool<std::string, 2>::Slot a = std::move(*sink.try_acquire());
+    Pool<std::string, 2>::Slot b;
+    assert(a && !b);
+    assert(b.get() == nullptr);
+    a->assign("hello");
+    b = std::move(a);
+    assert(!a && b);
+    assert(*b == "hello");
+
+    // Move-assigning over an owning slot releases the old one
+    Pool<std::string, 2>::Slot c = std::move(*sink.try_acquire());
+    assert(!sink.try_acquire().has_value());
+    c = std::move(b);
+    assert(*c == "hello");
+    assert(sink.try_acquire().has_value());
+
+    sink.enqueue(std::move(c));
+    auto received = source.try_dequeue();
+    assert(received.has_value() && **received == "hello");
+    std::cout << "  PASSED: pool slot move semantics" << std::endl;
+}
+
+void test_pool_slot_lifetime() {
+    std::cout << "Testing pool slot lifetime and enqueue checks..." << std::endl;
+    Pool<std::string, 4>::Slot kept_producer;
+    Pool<std::string, 4>::Slot kept_consumer;
+    {
+        auto [sink, source] = make_pooled_queue<std::string, 4>();
+        kept_producer = std::move(*sink.try_acquire());
+        assert(sink.try_enqueue(std::string("in flight")));
+        kept_consumer = std::move(*source.try_dequeue());
+
+        // Only a non-empty slot acquired from this sink can be enqueued
+        auto [other_sink, other_source] = make_pooled_queue<std::string, 4>();
+        auto foreign = other_sink.try_acquire();
+        Pool<std::string, 4>::Slot empty;
+        for (Pool<std::string, 4>::Slot* slot : { &empty, &*foreign, &kept_consumer }) {
+            bool threw = false;
+            try {
+                sink.enqueue(std::move(*slot));
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+        assert(*foreign && kept_consumer && source.empty());
+    }
+
+    // Both handles are gone; the slots keep the pool alive and release into it
+    kept_producer->assign("still usable");
+    assert(*kept_producer == "still usable");
+    assert(*kept_consumer == "in flight");
+    kept_consumer.reset();
+    kept_producer.reset();
+    assert(!kept_producer && !kept_consumer);
+
+    std::cout << "  PASSED: pool slot lifetime and enqueue checks" << std::endl;
+}
+
+void test_pool_blocking_timeout() {
+    std::cout << "Testing pool blocking timeout..." << std::endl;
+    auto [sink, source] = make_pooled_queue<int, 2>();
+
+    assert(!source.dequeue(std::chrono::milliseconds(5)).has_value());
+
+    auto a = sink.acquire(std::chrono::milliseconds(5));
+    auto b = sink.acquire(std::chrono::milliseconds(5));
+    assert(a.has_value() && b.has_value());
+    const auto start = std::chrono::steady_clock::now();
+    assert(!sink.acquire(std::chrono::milliseconds(5)).has_value());
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(5));
+    std::cout << "  PASSED: pool blocking timeout" << std::endl;
+}
+
+void test_pool_concurrent() {
+    std::cout << "Testing pool concurrent transfer..." << std::endl;
+    using Message = std::array<std::uint64_t, 128>;
+    auto [sink, source] = make_pooled_queue<Message, 16>();
+    constexpr std::uint64_t count = 100000;
+
+    std::thread producer([&sink = sink]() {
+        for (std::uint64_t i = 0; i < count; ++i) {
+            auto slot = sink.acquire(std::chrono::seconds(10));
+            assert(slot.has_value());
+            (**slot)[0] = i;
+            (**slot)[127] = ~i;
+            sink.enqueue(std::move(*slot));
+        }
+    });
+
+    for (std::uint64_t i = 0; i < count; ++i) {
+        auto slot = source.dequeue(std::chrono::seconds(10));
+        assert(slot.has_value());
+        assert((**slot)[0] == i);
+        assert((**slot)[127] == ~i);
+    }
+    producer.join();
+    assert(source.empty());
+    std::cout << "  PASSED: pool concurrent transfer" << std::endl;
+}
+
+void run_all_pool_tests() {
+    std::cout << "\n=== Running Pool Tests ===" << std::endl;
+
+    test_pool_basic_operations();
+    test_pool_exhaustion();
+    test_pool_return_channel();
+    test_pool_slot_move();
+    test_pool_slot_lifetime();
+    test_pool_blocking_timeout();
+    test_pool_concurrent();
+
+    std::cout << "\n=== All Pool tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_pool_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,287 @@
+#include "assert.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <qbuf/mmap_spsc.hpp>
+#include <qbuf/mpmc.hpp>
+#include <qbuf/mpsc.hpp>
+#include <qbuf/mutex_queue.hpp>
+#include <qbuf/queue.hpp>
+#include <qbuf/spsc.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace qbuf;
+
+static_assert(is_queue_v<SPSC<int, 64>>);
+static_assert(is_queue_v<SPSC<int, dynamic_extent>>);
+static_assert(is_queue_v<MmapSPSC<int, 64>>);
+static_assert(is_queue_v<MutexQueue<int, 64>>);
+static_assert(is_queue_v<MPMC<int, 64>>);
+static_assert(is_queue_v<MPSC<int, 64>>);
+static_assert(is_queue_v<Queue<int, 64, MirroredStorage, MutexSync>>);
+static_assert(!is_queue_v<int>);
+static_assert(!is_queue_v<std::vector<int>>);
+static_assert(std::is_same_v<queue_value_t<Queue<std::string, 8, HeapStorage>>, std::string>);
+
+// Every storage x sync combination; each test below runs over all of them
+template <typename T, std::size_t Capacity>
+using Combinations = std::tuple<
+    Queue<T, Capacity, InlineStorage, LockFreeSync>, Queue<T, Capacity, InlineStorage, MutexSync>,
+    Queue<T, Capacity, HeapStorage, LockFreeSync>, Queue<T, Capacity, HeapStorage, MutexSync>,
+    Queue<T, Capacity, MirroredStorage, LockFreeSync>,
+    Queue<T, Capacity, MirroredStorage, MutexSync>>;
+
+template <typename Q>
+std::string label() {
+    return std::string(Q::storage_policy::name) + "/" + Q::sync_policy::name;
+}
+
+template <template <typename> class Test, typename... Queues>
+void for_each_queue(std::tuple<Queues...>*) {
+    (Test<Queues>::run(), ...);
+}
+
+template <template <typename> class Test, typename Tuple>
+void for_each_queue() {
+    for_each_queue<Test>(static_cast<Tuple*>(nullptr));
+}
+
+template <typename Q>
+struct BasicOperations {
+    static void run() {
+        std::cout << "Testing basic operations (" << label<Q>() << ")..." << std::endl;
+        auto [sink, source] = Q::make_queue();
+        assert(source.empty() && sink.capacity() == 8);
+        assert(!source.try_dequeue().has_value());
+
+        // Occupancy is limited to Capacity - 1, whatever the storage rounds the ring up to
+        for (int i = 0; i < 7; ++i) assert(sink.try_enqueue(i));
+        assert(!sink.try_enqueue(7));
+        assert(sink.size() == 7 && source.size() == 7);
+
+        int out = -1;
+        assert(source.try_dequeue(out) && out == 0);
+        for (int i = 1; i < 7; ++i) assert(source.try_dequeue().value() == i);
+        assert(source.empty());
+        assert(!source.try_dequeue(out) && out == 0);
+        std::cout << "  PASSED: basic operations (" << label<Q>() << ")" << std::endl;
+    }
+};
+
+template <typename Q>
+struct BulkWrapAround {
+    static void run() {
+        std::cout << "Testing bulk wrap-around (" << label<Q>() << ")..." << std::endl;
+        auto [sink, source] = Q::make_queue();
+        std::vector<int> in(5);
+        std::vector<int> out(8);
+
+        // Batches of 5 through 8 usable slots push every batch across the end of the ring
+        int next = 0;
+        int expected = 0;
+        for (int round = 0; round < 1000; ++round) {
+            for (int& value : in) value = next++;
+            assert(sink.try_enqueue(in.data(), in.size()) == in.size());
+            assert(source.try_dequeue(out.data(), out.size()) == in.size());
+            for (std::size_t i = 0; i < in.size(); ++i) assert(out[i] == expected++);
+        }
+
+        // Partial transfers: only the free (or readable) part is taken
+        std::vector<int> many(20, 42);
+        assert(sink.try_enqueue(many.data(), many.size()) == 7);
+        assert(sink.try_enqueue(many.data(), many.size()) == 0);
+        assert(source.try_dequeue(out.data(), 3) == 3);
+        assert(source.try_dequeue(out.data(), out.size()) == 4);
+        assert(source.try_dequeue(out.data(), out.size()) == 0);
+        std::cout << "  PASSED: bulk wrap-around (" << label<Q>() << ")" << std::endl;
+    }
+};
+
+template <typename Q>
+struct Timeouts {
+    static void run() {
+        std::cout << "Testing timeouts (" << label<Q>() << ")..." << std::endl;
+        auto [sink, source] = Q::make_queue();
+        const auto timeout = std::chrono::milliseconds(5);
+
+        assert(!source.dequeue(timeout).has_value());
+        int out[4];
+        assert(source.dequeue(out, 4, timeout) == 0);
+
+        int in[7] = { 0, 1, 2, 3, 4, 5, 6 };
+        assert(sink.enqueue(in, 7, timeout));
+        assert(!sink.enqueue(7, timeout));
+        assert(!sink.enqueue(in, 1, timeout));
+        assert(source.dequeue(out, 4, timeout) == 4);
+        assert(out[3] == 3);
+        assert(source.dequeue(out, 4, timeout) == 3);
+        assert(out[2] == 6);
+        std::cout << "  PASSED: timeouts (" << label<Q>() << ")" << std::endl;
+    }
+};
+
+template <typename Q>
+struct Concurrent {
+    static void run() {
+        std::cout << "Testing concurrent blocking transfer (" << label<Q>() << ")..." << std::endl;
+        auto [sink, source] = Q::make_queue();
+        constexpr int count = 100000;
+        const auto timeout = std::chrono::seconds(10);
+
+        std::thread producer([&sink = sink, timeout]() {
+            int batch[3];
+            for (int i = 0; i < count;) {
+                if (i % 2 == 0 || i + 3 > count) {
+                    assert(sink.enqueue(i++, timeout));
+                } else {
+                    for (int& value : batch) value = i++;
+                    assert(sink.enqueue(batch, 3, timeout));
+                }
+            }
+        });
+        int batch[5];
+        for (int next = 0; next < count;) {
+            if (next % 3 == 0) {
+                auto value = source.dequeue(timeout);
+                assert(value.has_value() && *value == next++);
+            } else {
+                const std::size_t want = std::min(5, count - next);
+                assert(source.dequeue(batch, want, timeout) == want);
+                for (std::size_t i = 0; i < want; ++i) assert(batch[i] == next++);
+            }
+        }
+        producer.join();
+        assert(source.empty());
+        std::cout << "  PASSED: concurrent blocking transfer (" << label<Q>() << ")" << std::endl;
+    }
+};
+
+template <typename Q>
+struct Strings {
+    static void run() {
+        std::cout << "Testing std::string payloads (" << label<Q>() << ")..." << std::endl;
+        auto [sink, source] = Q::make_queue();
+        auto make = [](int i) { return "message " + std::to_string(i) + std::string(32, '.'); };
+
+        std::vector<std::string> in;
+        for (int i = 0; i < 5; ++i) in.push_back(make(i));
+        std::string moved = make(100);
+        assert(sink.try_enqueue(std::move(moved)));
+        assert(moved.empty());
+        assert(sink.try_enqueue(in.data(), in.size()) == 5);
+        assert(in[4] == make(4)); // bulk enqueue copies
+
+        std::vector<std::string> out(8);
+        assert(source.try_dequeue().value() == make(100));
+        assert(source.try_dequeue(out.data(), out.size()) == 5);
+        for (int i = 0; i < 5; ++i) assert(out[i] == make(i));
+
+        // Refused rvalues are not moved from
+        for (int i = 0; i < 7; ++i) assert(sink.try_enqueue(make(i)));
+        std::string refused = make(7);
+        assert(!sink.try_enqueue(std::move(refused)));
+        assert(refused == make(7));
+        std::cout << "  PASSED: std::string payloads (" << label<Q>() << ")" << std::endl;
+    }
+};
+
+void test_queue_shared_mutex_sink() {
+    std::cout << "Testing MutexSync with producers sharing one Sink..." << std::endl;
+    auto [sink, source] = Queue<int, 64, InlineStorage, MutexSync>::make_queue();
+    constexpr int producers = 4;
+    constexpr int per_producer = 20000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&sink = sink, p]() {
+            for (int i = 0; i < per_producer; ++i) {
+                assert(sink.enqueue(p * per_producer + i, std::chrono::seconds(10)));
+            }
+        });
+    }
+    std::vector<int> last(producers, -1);
+    for (int received = 0; received < producers * per_producer; ++received) {
+        const int value = source.dequeue(std::chrono::seconds(10)).value();
+        // Each producer's elements arrive in order
+        assert(value % per_producer > last[value / per_producer]);
+        last[value / per_producer] = value % per_producer;
+    }
+    for (auto& thread : threads) thread.join();
+    assert(source.empty());
+    std::cout << "  PASSED: MutexSync with producers sharing one Sink" << std::endl;
+}
+
+void test_queue_storage_options() {
+    std::cout << "Testing storage options..." << std::endl;
+    BufferOptions buffer_options;
+    buffer_options.huge_pages = true;
+    auto [heap_sink, heap_source] =
+        Queue<int, 1024, HeapStorage>::make_queue(buffer_options);
+    assert(heap_sink.try_enqueue(1) && heap_source.try_dequeue().value() == 1);
+
+    MmapOptions mmap_options;
+    mmap_options.populate = true;
+    auto [mirror_sink, mirror_source] =
+        Queue<std::uint64_t, 1024, MirroredStorage>::make_queue(mmap_options);
+    assert(mirror_sink.try_enqueue(2) && mirror_source.try_dequeue().value() == 2);
+
+    mmap_options.huge_page_size = 12345;
+    bool threw = false;
+    try {
+        Queue<int, 64, MirroredStorage>::make_queue(mmap_options);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "  PASSED: storage options" << std::endl;
+}
+
+void test_queue_mmap_make_queue() {
+    std::cout << "Testing MmapSPSC::make_queue..." << std::endl;
+    auto [sink, source] = MmapSPSC<int, 64>::make_queue();
+    assert(sink.try_enqueue(5) && source.try_dequeue().value() == 5);
+    MmapOptions options;
+    options.populate = true;
+    auto [populated_sink, populated_source] = MmapSPSC<int, 64>::make_queue(options);
+    assert(populated_sink.try_enqueue(6) && populated_source.try_dequeue().value() == 6);
+    std::cout << "  PASSED: MmapSPSC::make_queue" << std::endl;
+}
+
+void run_all_queue_tests() {
+    std::cout << "\n=== Running Policy Queue Tests ===" << std::endl;
+
+    for_each_queue<BasicOperations, Combinations<int, 8>>();
+    for_each_queue<BulkWrapAround, Combinations<int, 8>>();
+    for_each_queue<Timeouts, Combinations<int, 8>>();
+    for_each_queue<Concurrent, Combinations<int, 16>>();
+    for_each_queue<
+        Strings,
+        std::tuple<
+            Queue<std::string, 8, InlineStorage, LockFreeSync>,
+            Queue<std::string, 8, InlineStorage, MutexSync>,
+            Queue<std::string, 8, HeapStorage, LockFreeSync>,
+            Queue<std::string, 8, HeapStorage, MutexSync>>>();
+    test_queue_shared_mutex_sink();
+    test_queue_storage_options();
+    test_queue_mmap_make_queue();
+
+    std::cout << "\n=== All Policy Queue tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_queue_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
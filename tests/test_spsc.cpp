@@ -1,13 +1,24 @@
 #include "assert.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <qbuf/copy.hpp>
 #include <qbuf/spsc.hpp>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
 
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 using namespace qbuf;
 
 void test_basic_operations() {
@@ -67,6 +78,38 @@ void test_queue_full() {
     std::cout << "  PASSED: queue full" << std::endl;
 }
 
+void test_cached_index_refresh() {
+    std::cout << "Testing cached index refresh..." << std::endl;
+    auto [sink, source] = SPSC<int, 8>::make_queue();
+
+    // Fill the queue so the producer's cached head reports full
+    for (int i = 0; i < 7; ++i) {
+        assert(sink.try_enqueue(i));
+    }
+    assert(!sink.try_enqueue(999));
+
+    // Freeing space must be observed by the producer through a cache refresh
+    for (int i = 0; i < 3; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value());
+        assert(value.value() == i);
+    }
+    for (int i = 7; i < 10; ++i) {
+        assert(sink.try_enqueue(i));
+    }
+    assert(!sink.try_enqueue(999));
+
+    // Bulk dequeue must refresh the consumer's cached tail past what it last saw
+    std::vector<int> output(8, 0);
+    assert(source.try_dequeue(output.data(), output.size()) == 7);
+    for (int i = 0; i < 7; ++i) {
+        assert(output[i] == i + 3);
+    }
+    assert(!source.try_dequeue().has_value());
+
+    std::cout << "  PASSED: cached index refresh" << std::endl;
+}
+
 void test_fifo_ordering() {
     std::cout << "Testing FIFO ordering..." << std::endl;
     auto [sink, source] = SPSC<int, 8>::make_queue();
@@ -398,6 +441,478 @@ void test_bulk_concurrent() {
     std::cout << "  PASSED: concurrent bulk operations" << std::endl;
 }
 
+void test_reserve_commit() {
+    std::cout << "Testing reserve/commit..." << std::endl;
+    auto [sink, source] = SPSC<int, 8>::make_queue();
+
+    // Nothing is visible until commit
+    auto region = sink.reserve(5);
+    assert(region.size() == 5);
+    assert(region.second.empty());
+    for (std::size_t i = 0; i < region.size(); ++i) {
+        region[i] = static_cast<int>(i);
+    }
+    assert(source.empty());
+
+    // Partial commit publishes only the first slots
+    sink.commit(3);
+    assert(source.size() == 3);
+    for (int i = 0; i < 3; ++i) {
+        auto value = source.try_dequeue();
+        assert(value.has_value());
+        assert(value.value() == i);
+    }
+
+    // Reservation is capped by free space (7 usable slots, none occupied)
+    region = sink.reserve(100);
+    assert(region.size() == 7);
+
+    // Region crossing the end of the buffer is split in two segments
+    assert(region.first.size() == 5); // slots 3..7
+    assert(region.second.size() == 2); // slots 0..1
+    for (std::size_t i = 0; i < region.size(); ++i) {
+        region[i] = 100 + static_cast<int>(i);
+    }
+    sink.commit(region.size());
+    assert(sink.reserve(1).empty());
+
+    std::vector<int> output(7, 0);
+    assert(source.try_dequeue(output.data(), output.size()) == 7);
+    for (int i = 0; i < 7; ++i) {
+        assert(output[i] == 100 + i);
+    }
+
+    std::cout << "  PASSED: reserve/commit" << std::endl;
+}
+
+void test_reserve_commit_concurrent() {
+    std::cout << "Testing reserve/commit concurrent..." << std::endl;
+    auto [sink, source] = SPSC<int, 64>::make_queue();
+    constexpr int num_elements = 10000;
+
+    std::thread producer([sink = std::move(sink)]() mutable {
+        int next = 0;
+        while (next < num_elements) {
+            auto region = sink.reserve(static_cast<std::size_t>(num_elements - next));
+            for (std::size_t i = 0; i < region.size(); ++i) {
+                region[i] = next++;
+            }
+            sink.commit(region.size());
+            if (region.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([source = std::move(source)]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            std::optional<int> value;
+            while (!(value = source.try_dequeue()).has_value()) {
+                std::this_thread::yield();
+            }
+            assert(value.value() == i);
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    std::cout << "  PASSED: reserve/commit concurrent" << std::endl;
+}
+
+void test_peek_consume() {
+    std::cout << "Testing peek/consume..." << std::endl;
+    auto [sink, source] = SPSC<std::string, 8>::make_queue();
+
+    assert(source.peek().empty());
+
+    assert(sink.try_enqueue("a"));
+    assert(sink.try_enqueue("b"));
+    assert(sink.try_enqueue("c"));
+
+    // Peeking does not move anything out or advance the head
+    auto view = source.peek();
+    assert(view.size() == 3);
+    assert(view[0] == "a");
+    assert(view[2] == "c");
+    assert(source.size() == 3);
+
+    source.consume(2);
+    assert(source.size() == 1);
+    view = source.peek();
+    assert(view.size() == 1);
+    assert(view[0] == "c");
+    source.consume(1);
+    assert(source.empty());
+
+    // Fill across the wrap point: head is at 3, so 5 slots before the end and 2 after
+    for (int i = 0; i < 7; ++i) {
+        assert(sink.try_enqueue(std::to_string(i)));
+    }
+    view = source.peek();
+    assert(view.size() == 7);
+    assert(view.first.size() == 5);
+    assert(view.second.size() == 2);
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        assert(view[i] == std::to_string(i));
+    }
+    source.consume(view.size());
+    assert(source.empty());
+    assert(sink.try_enqueue("after"));
+
+    std::cout << "  PASSED: peek/consume" << std::endl;
+}
+
+void test_peek_consume_concurrent() {
+    std::cout << "Testing peek/consume concurrent..." << std::endl;
+    auto [sink, source] = SPSC<int, 64>::make_queue();
+    constexpr int num_elements = 10000;
+
+    std::thread producer([sink = std::move(sink)]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            while (!sink.try_enqueue(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([source = std::move(source)]() mutable {
+        int expected = 0;
+        while (expected < num_elements) {
+            auto view = source.peek();
+            for (std::size_t i = 0; i < view.size(); ++i) {
+                assert(view[i] == expected++);
+            }
+            source.consume(view.size());
+            if (view.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    std::cout << "  PASSED: peek/consume concurrent" << std::endl;
+}
+
+void test_drain() {
+    std::cout << "Testing drain..." << std::endl;
+    auto [sink, source] = SPSC<int, 8>::make_queue();
+    assert(source.drain([](int&) { assert(false); }) == 0);
+
+    // Wrap the readable region across the end of the buffer
+    for (int i = 0; i < 5; ++i) assert(sink.try_enqueue(i));
+    assert(source.drain([](int&) { }, 5) == 5);
+    for (int i = 0; i < 7; ++i) assert(sink.try_enqueue(i));
+
+    std::vector<int> seen;
+    assert(source.drain([&](int& value) { seen.push_back(value); }, 3) == 3);
+    assert(source.size() == 4);
+    assert(source.drain([&](int& value) { seen.push_back(value); }) == 4);
+    assert(seen == std::vector<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+    assert(source.empty());
+
+    // Slots come back to the producer every `release_every` elements
+    for (int i = 0; i < 7; ++i) assert(sink.try_enqueue(i));
+    std::vector<std::size_t> free_slots;
+    source.drain([&](int&) { free_slots.push_back(sink.capacity() - 1 - sink.size()); }, 7, 2);
+    assert(free_slots == std::vector<std::size_t>({ 0, 0, 2, 2, 4, 4, 6 }));
+    assert(source.empty());
+
+    // A throwing callback releases what it visited before the throw
+    for (int i = 0; i < 4; ++i) assert(sink.try_enqueue(i));
+    bool threw = false;
+    try {
+        source.drain([](int& value) {
+            if (value == 2) throw std::runtime_error("consumer failed");
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(source.size() == 2);
+    assert(source.try_dequeue().value() == 2);
+
+    // Elements can be moved out
+    auto [string_sink, string_source] = SPSC<std::string, 4>::make_queue();
+    assert(string_sink.try_enqueue(std::string(100, 'a')));
+    std::string taken;
+    assert(string_source.drain([&](std::string& value) { taken = std::move(value); }) == 1);
+    assert(taken.size() == 100);
+
+    std::cout << "  PASSED: drain" << std::endl;
+}
+
+void test_drain_concurrent() {
+    std::cout << "Testing drain concurrent..." << std::endl;
+    auto [sink, source] = SPSC<int, 64>::make_queue();
+    constexpr int num_elements = 100000;
+
+    std::thread producer([sink = std::move(sink)]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            while (!sink.try_enqueue(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([source = std::move(source)]() mutable {
+        int expected = 0;
+        while (expected < num_elements) {
+            const std::size_t n =
+                source.drain([&](int& value) { assert(value == expected++); }, 48, 16);
+            if (n == 0) std::this_thread::yield();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    std::cout << "  PASSED: drain concurrent" << std::endl;
+}
+
+namespace {
+// 64-byte trivially copyable payload, like a market-data record
+struct Tick {
+    std::uint64_t seq;
+    std::uint64_t fields[7];
+};
+} // namespace
+
+void test_bulk_trivially_copyable_wrap_around() {
+    std::cout << "Testing bulk trivially copyable wrap-around..." << std::endl;
+    auto [sink, source] = SPSC<Tick, 16>::make_queue();
+
+    std::vector<Tick> input(15);
+    std::vector<Tick> output(15);
+    std::uint64_t next_in = 0;
+    std::uint64_t next_out = 0;
+
+    // Batches of varying size walk the head/tail around the ring several times
+    for (std::size_t round = 0; round < 100; ++round) {
+        const std::size_t n = 1 + (round % 15);
+        for (std::size_t i = 0; i < n; ++i) {
+            input[i].seq = next_in;
+            for (std::size_t j = 0; j < 7; ++j) input[i].fields[j] = next_in * 7 + j;
+            ++next_in;
+        }
+        assert(sink.try_enqueue(input.data(), n) == n);
+        assert(source.try_dequeue(output.data(), n) == n);
+        for (std::size_t i = 0; i < n; ++i) {
+            assert(output[i].seq == next_out);
+            for (std::size_t j = 0; j < 7; ++j) assert(output[i].fields[j] == next_out * 7 + j);
+            ++next_out;
+        }
+    }
+
+    std::cout << "  PASSED: bulk trivially copyable wrap-around" << std::endl;
+}
+
+void test_stream_copy() {
+    std::cout << "Testing streaming copy..." << std::endl;
+
+    std::vector<std::uint8_t> src(300);
+    for (std::size_t i = 0; i < src.size(); ++i) src[i] = static_cast<std::uint8_t>(i * 31 + 7);
+
+    // Every destination misalignment and a range of lengths, including sub-vector sizes
+    for (std::size_t offset = 0; offset < 16; ++offset) {
+        for (std::size_t len : { 0, 1, 15, 16, 17, 64, 255, 280 }) {
+            std::vector<std::uint8_t> dst(src.size() + 16, 0);
+            detail::stream_copy(dst.data() + offset, src.data(), len);
+            for (std::size_t i = 0; i < offset; ++i) assert(dst[i] == 0);
+            for (std::size_t i = 0; i < len; ++i) assert(dst[offset + i] == src[i]);
+            for (std::size_t i = offset + len; i < dst.size(); ++i) assert(dst[i] == 0);
+        }
+    }
+
+    std::cout << "  PASSED: streaming copy" << std::endl;
+}
+
+void test_dynamic_capacity() {
+    std::cout << "Testing dynamic capacity..." << std::endl;
+    auto [sink, source] = SPSC<std::string, dynamic_extent>::make_queue(8);
+    assert(sink.capacity() == 8);
+    assert(source.capacity() == 8);
+
+    // Same occupancy rule as the fixed-capacity queue: Capacity - 1 elements
+    for (int i = 0; i < 7; ++i) {
+        assert(sink.try_enqueue(std::to_string(i)));
+    }
+    assert(!sink.try_enqueue("overflow"));
+
+    std::vector<std::string> output(8);
+    assert(source.try_dequeue(output.data(), 4) == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(output[i] == std::to_string(i));
+    }
+
+    // Bulk enqueue wraps around the end of the heap buffer
+    std::vector<std::string> input = { "a", "b", "c", "d" };
+    assert(sink.try_enqueue(input.data(), input.size()) == 4);
+    assert(source.try_dequeue(output.data(), 8) == 7);
+    assert(output[0] == "4");
+    assert(output[2] == "6");
+    assert(output[3] == "a");
+    assert(output[6] == "d");
+    assert(source.empty());
+
+    // Capacity must be a power of two greater than 1
+    bool threw = false;
+    try {
+        SPSC<int, dynamic_extent>::make_queue(12);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // A power of two whose byte size wraps around is rejected before anything is allocated
+    threw = false;
+    try {
+        SPSC<std::string, dynamic_extent>::make_queue(std::size_t { 1 } << 62);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "  PASSED: dynamic capacity" << std::endl;
+}
+
+void test_dynamic_capacity_concurrent() {
+    std::cout << "Testing dynamic capacity concurrent..." << std::endl;
+    BufferOptions options;
+    options.huge_pages = true;
+    auto [sink, source] = SPSC<int, dynamic_extent>::make_queue(1 << 16, options);
+    constexpr int num_elements = 100000;
+
+    std::thread producer([sink = std::move(sink)]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            while (!sink.try_enqueue(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([source = std::move(source)]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            std::optional<int> value;
+            while (!(value = source.try_dequeue()).has_value()) {
+                std::this_thread::yield();
+            }
+            assert(value.value() == i);
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    std::cout << "  PASSED: dynamic capacity concurrent" << std::endl;
+}
+
+void test_dynamic_capacity_numa_node() {
+    std::cout << "Testing dynamic capacity NUMA node..." << std::endl;
+    BufferOptions options;
+    options.numa_node = 0; // node 0 exists on every Linux system
+    auto [sink, source] = SPSC<std::string, dynamic_extent>::make_queue(1024, options);
+
+    for (int i = 0; i < 1000; ++i) assert(sink.try_enqueue(std::to_string(i)));
+    for (int i = 0; i < 1000; ++i) assert(source.try_dequeue().value() == std::to_string(i));
+
+#if defined(__linux__)
+    bool threw = false;
+    try {
+        options.numa_node = 1000;
+        SPSC<int, dynamic_extent>::make_queue(1024, options);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+#endif
+
+    std::cout << "  PASSED: dynamic capacity NUMA node" << std::endl;
+}
+
+// Blocking round trip through a small ring so both sides wait often
+template <typename Wait>
+void check_wait_strategy_round_trip(int num_elements) {
+    auto [sink, source] = SPSC<int, 8, Wait>::make_queue();
+
+    std::thread producer([sink = std::move(sink), num_elements]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            assert(sink.enqueue(i, std::chrono::seconds(5)));
+        }
+    });
+
+    std::thread consumer([source = std::move(source), num_elements]() mutable {
+        int buffer[4];
+        int expected = 0;
+        while (expected < num_elements) {
+            if (expected % 2 == 0) {
+                auto value = source.dequeue(std::chrono::seconds(5));
+                assert(value.has_value());
+                assert(value.value() == expected++);
+            } else {
+                const std::size_t want = std::min<std::size_t>(4, num_elements - expected);
+                assert(source.dequeue(buffer, want, std::chrono::seconds(5)) == want);
+                for (std::size_t i = 0; i < want; ++i) assert(buffer[i] == expected++);
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+}
+
+void test_wait_strategies() {
+    std::cout << "Testing wait strategies..." << std::endl;
+
+    check_wait_strategy_round_trip<YieldWait>(20000);
+    // Pure spinning only hands off when the scheduler preempts, so keep it short on small hosts
+    check_wait_strategy_round_trip<SpinWait>(200);
+    check_wait_strategy_round_trip<BackoffWait>(20000);
+    check_wait_strategy_round_trip<ParkingWait>(20000);
+    check_wait_strategy_round_trip<BasicParkingWait<0>>(20000); // park immediately
+
+    std::cout << "  PASSED: wait strategies" << std::endl;
+}
+
+void test_parking_wait_wakeup() {
+    std::cout << "Testing parking wait wakeup..." << std::endl;
+    auto [sink, source] = SPSC<int, 8, BasicParkingWait<0>>::make_queue();
+
+    // Consumer parks on the empty queue; the producer's enqueue must wake it long before the
+    // timeout
+    const auto start = std::chrono::steady_clock::now();
+    std::thread consumer([source = std::move(source)]() mutable {
+        auto value = source.dequeue(std::chrono::seconds(10));
+        assert(value.has_value());
+        assert(value.value() == 7);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(sink.try_enqueue(7));
+    consumer.join();
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+    std::cout << "  PASSED: parking wait wakeup" << std::endl;
+}
+
+void test_parking_wait_timeout() {
+    std::cout << "Testing parking wait timeout..." << std::endl;
+    auto [sink, source] = SPSC<int, 4, ParkingWait>::make_queue();
+
+    auto start = std::chrono::steady_clock::now();
+    assert(!source.dequeue(std::chrono::milliseconds(20)).has_value());
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    for (int i = 0; i < 3; ++i) assert(sink.try_enqueue(i));
+    start = std::chrono::steady_clock::now();
+    assert(!sink.enqueue(3, std::chrono::milliseconds(20)));
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    std::cout << "  PASSED: parking wait timeout" << std::endl;
+}
+
 void test_blocking_enqueue() {
     std::cout << "Testing blocking enqueue..." << std::endl;
     auto [sink, source] = SPSC<int, 8>::make_queue();
@@ -1593,11 +2108,272 @@ void test_source_bulk_with_strings() {
     std::cout << "  PASSED: SpscSource bulk with strings" << std::endl;
 }
 
+void test_in_place_operations() {
+    std::cout << "Testing emplace, try_dequeue(T&) and try_consume..." << std::endl;
+    auto [sink, source] = SPSC<std::string, 4>::make_queue();
+
+    // Assignable single argument, and constructor arguments
+    assert(sink.emplace("alpha"));
+    assert(sink.emplace(std::size_t { 3 }, 'x'));
+    const std::string copied = "gamma";
+    assert(sink.try_enqueue(copied));
+    assert(copied == "gamma");
+
+    // A refused element leaves its arguments untouched
+    std::string spare = "delta";
+    assert(!sink.emplace(std::move(spare)));
+    assert(!sink.try_enqueue(std::move(spare)));
+    assert(spare == "delta");
+
+    std::string out = "unchanged";
+    assert(source.try_dequeue(out));
+    assert(out == "alpha");
+    assert(sink.emplace(std::move(spare)));
+
+    // The callback sees the element in its slot
+    std::size_t seen = 0;
+    assert(source.try_consume([&](std::string& value) { seen = value.size(); }));
+    assert(seen == 3);
+
+    // A throwing callback leaves the element at the front
+    bool threw = false;
+    try {
+        source.try_consume([](std::string&) { throw std::runtime_error("consumer failed"); });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(source.size() == 2);
+    assert(source.try_consume([&](std::string& value) { out = std::move(value); }));
+    assert(out == "gamma");
+    assert(source.try_dequeue().value() == "delta");
+
+    // Empty queue: nothing is written and the callback is not invoked
+    assert(!source.try_dequeue(out));
+    assert(out == "gamma");
+    assert(!source.try_consume([](std::string&) { assert(false); }));
+
+    // Move-only elements
+    auto [ptr_sink, ptr_source] = SPSC<std::unique_ptr<int>, 4>::make_queue();
+    assert(ptr_sink.emplace(new int(7)));
+    std::unique_ptr<int> ptr;
+    assert(ptr_source.try_dequeue(ptr));
+    assert(*ptr == 7);
+
+    std::cout << "  PASSED: emplace, try_dequeue(T&) and try_consume" << std::endl;
+}
+
+void test_publish_batch() {
+    std::cout << "Testing deferred publish..." << std::endl;
+    auto [sink, source] = SPSC<int, 8>::make_queue();
+
+    bool threw = false;
+    try {
+        sink.set_publish_batch(PublishBatch { 0 });
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Writes become visible every 3 elements, or on flush()
+    sink.set_publish_batch(PublishBatch { 3 });
+    assert(sink.try_enqueue(0));
+    assert(sink.emplace(1));
+    assert(source.empty() && sink.unpublished() == 2);
+    assert(!source.try_dequeue().has_value());
+    assert(sink.try_enqueue(2));
+    assert(source.size() == 3 && sink.unpublished() == 0);
+    assert(sink.try_enqueue(3));
+    sink.flush();
+    assert(source.size() == 4);
+    for (int i = 0; i < 4; ++i) assert(source.try_dequeue().value() == i);
+
+    // A full ring is always published
+    sink.set_publish_batch(PublishBatch { 100 });
+    for (int i = 0; i < 7; ++i) assert(sink.try_enqueue(i));
+    assert(source.empty());
+    assert(!sink.try_enqueue(7));
+    assert(source.size() == 7);
+    assert(source.drain([](int&) { }) == 7);
+
+    // Bulk writes and commits publish the deferred elements with them
+    assert(sink.try_enqueue(0));
+    const int bulk[] = { 1, 2 };
+    assert(sink.try_enqueue(bulk, 2) == 2);
+    assert(source.size() == 3);
+    assert(sink.try_enqueue(3));
+    auto region = sink.reserve(1);
+    region[0] = 4;
+    sink.commit(1);
+    assert(source.size() == 5);
+    for (int i = 0; i < 5; ++i) assert(source.try_dequeue().value() == i);
+
+    // Blocking enqueue returns with everything published
+    assert(sink.try_enqueue(5));
+    assert(sink.enqueue(6, std::chrono::milliseconds(10)));
+    assert(source.size() == 2 && sink.unpublished() == 0);
+    assert(source.drain([](int&) { }) == 2);
+
+    // The time budget is checked by the next write
+    sink.set_publish_batch(PublishBatch { 100, std::chrono::milliseconds(1) });
+    assert(sink.try_enqueue(0));
+    assert(source.empty());
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    assert(sink.try_enqueue(1));
+    assert(source.size() == 2);
+    assert(source.drain([](int&) { }) == 2);
+
+    // Destroying and move-assigning over a sink publish its writes
+    assert(sink.try_enqueue(0));
+    {
+        auto moved = std::move(sink);
+        assert(moved.try_enqueue(1));
+        assert(source.empty());
+    }
+    assert(source.size() == 2);
+
+    auto [first_sink, first_source] = SPSC<int, 8>::make_queue();
+    auto [second_sink, second_source] = SPSC<int, 8>::make_queue();
+    first_sink.set_publish_batch(PublishBatch { 100 });
+    assert(first_sink.try_enqueue(42));
+    first_sink = std::move(second_sink);
+    assert(first_source.try_dequeue().value() == 42);
+    assert(first_sink.try_enqueue(43));
+    assert(second_source.try_dequeue().value() == 43);
+
+    std::cout << "  PASSED: deferred publish" << std::endl;
+}
+
+void test_publish_batch_concurrent() {
+    std::cout << "Testing deferred publish concurrent..." << std::endl;
+    auto [sink, source] = SPSC<int, 64>::make_queue();
+    constexpr int num_elements = 100000;
+
+    std::thread producer([sink = std::move(sink)]() mutable {
+        sink.set_publish_batch(PublishBatch { 16 });
+        for (int i = 0; i < num_elements; ++i) {
+            while (!sink.try_enqueue(i)) {
+                std::this_thread::yield();
+            }
+        }
+        // The last partial batch is published when the sink goes away
+    });
+
+    int expected = 0;
+    while (expected < num_elements) {
+        if (source.drain([&](int& value) { assert(value == expected++); }) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(source.empty());
+
+    std::cout << "  PASSED: deferred publish concurrent" << std::endl;
+}
+
+void test_stats_disabled() {
+    std::cout << "Testing stats without QBUF_STATS..." << std::endl;
+    auto [sink, source] = SPSC<int, 8>::make_queue();
+    assert(sink.try_enqueue(1));
+    assert(source.try_dequeue().has_value());
+
+    const QueueStats stats = source.stats();
+    assert(!stats.enabled);
+    assert(stats.producer.calls == 0 && stats.consumer.calls == 0);
+    assert(stats.high_water_mark == 0);
+    std::cout << "  PASSED: stats without QBUF_STATS" << std::endl;
+}
+
+#if defined(__linux__)
+// Readable within `timeout_ms`?
+bool fd_readable(int fd, int timeout_ms) {
+    pollfd entry { fd, POLLIN, 0 };
+    return poll(&entry, 1, timeout_ms) == 1 && (entry.revents & POLLIN) != 0;
+}
+
+void test_eventfd_notification() {
+    std::cout << "Testing eventfd notification..." << std::endl;
+    auto [sink, source] = SPSC<int, 8, EventFdWait>::make_queue();
+    const int fd = source.native_handle();
+    assert(fd >= 0);
+
+    // Not armed: publishing leaves the descriptor alone
+    assert(sink.try_enqueue(1));
+    assert(!fd_readable(fd, 0));
+    assert(!source.arm_notification()); // data is already there
+    assert(source.try_dequeue() == 1);
+
+    // Armed on an empty queue: only the first publish signals
+    assert(source.arm_notification());
+    assert(!fd_readable(fd, 0));
+    assert(sink.try_enqueue(2));
+    assert(fd_readable(fd, 0));
+    assert(sink.try_enqueue(3));
+    assert(source.try_dequeue() == 2);
+    assert(source.try_dequeue() == 3);
+
+    // Re-arming clears the previous signal
+    assert(source.arm_notification());
+    assert(!fd_readable(fd, 0));
+    std::cout << "  PASSED: eventfd notification" << std::endl;
+}
+
+void test_eventfd_epoll_consumer() {
+    std::cout << "Testing eventfd epoll consumer..." << std::endl;
+    auto [sink, source] = SPSC<int, 16, EventFdWait>::make_queue();
+    constexpr int num_elements = 20000;
+
+    const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    assert(epoll_fd >= 0);
+    epoll_event event {};
+    event.events = EPOLLIN;
+    assert(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, source.native_handle(), &event) == 0);
+
+    std::thread producer([sink = std::move(sink)]() mutable {
+        for (int i = 0; i < num_elements; ++i) {
+            while (!sink.try_enqueue(i)) std::this_thread::yield();
+            if (i % 1000 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    });
+
+    int next = 0;
+    while (next < num_elements) {
+        while (auto value = source.try_dequeue()) {
+            assert(*value == next);
+            ++next;
+        }
+        if (next == num_elements || !source.arm_notification()) continue;
+        epoll_event ready {};
+        assert(epoll_wait(epoll_fd, &ready, 1, 10000) == 1);
+    }
+    producer.join();
+    close(epoll_fd);
+    std::cout << "  PASSED: eventfd epoll consumer" << std::endl;
+}
+
+void test_eventfd_blocking_calls() {
+    std::cout << "Testing eventfd blocking calls..." << std::endl;
+    auto [sink, source] = SPSC<int, 4, BasicEventFdWait<0>>::make_queue();
+
+    auto start = std::chrono::steady_clock::now();
+    assert(!source.dequeue(std::chrono::milliseconds(20)).has_value());
+    assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    std::thread consumer([source = std::move(source)]() mutable {
+        for (int i = 0; i < 1000; ++i) assert(source.dequeue(std::chrono::seconds(10)) == i);
+    });
+    for (int i = 0; i < 1000; ++i) assert(sink.enqueue(i, std::chrono::seconds(10)));
+    consumer.join();
+    std::cout << "  PASSED: eventfd blocking calls" << std::endl;
+}
+#endif
+
 void run_all_spsc_tests() {
     std::cout << "\n=== Running SPSC Tests ===" << std::endl;
 
     test_basic_operations();
     test_queue_full();
+    test_cached_index_refresh();
     test_fifo_ordering();
     test_move_semantics();
     test_concurrent();
@@ -1608,6 +2384,25 @@ void run_all_spsc_tests() {
     test_bulk_wrap_around();
     test_bulk_with_strings();
     test_bulk_concurrent();
+    test_bulk_trivially_copyable_wrap_around();
+    test_stream_copy();
+    test_dynamic_capacity();
+    test_dynamic_capacity_concurrent();
+    test_dynamic_capacity_numa_node();
+    test_wait_strategies();
+    test_parking_wait_wakeup();
+    test_parking_wait_timeout();
+#if defined(__linux__)
+    test_eventfd_notification();
+    test_eventfd_epoll_consumer();
+    test_eventfd_blocking_calls();
+#endif
+    test_reserve_commit();
+    test_reserve_commit_concurrent();
+    test_peek_consume();
+    test_peek_consume_concurrent();
+    test_drain();
+    test_drain_concurrent();
     test_blocking_enqueue();
     test_blocking_dequeue();
     test_blocking_concurrent();
@@ -1642,6 +2437,10 @@ void run_all_spsc_tests() {
     test_sink_source_concurrent();
     test_sink_bulk_with_strings();
     test_source_bulk_with_strings();
+    test_in_place_operations();
+    test_publish_batch();
+    test_publish_batch_concurrent();
+    test_stats_disabled();
 
     std::cout << "\n=== All SPSC tests passed ===" << std::endl;
 }
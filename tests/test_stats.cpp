@@ -0,0 +1,139 @@
+// Built with QBUF_STATS defined (see CMakeLists.txt)
+#include "assert.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <qbuf/mmap_spsc.hpp>
+#include <qbuf/mutex_queue.hpp>
+#include <qbuf/spsc.hpp>
+#include <thread>
+
+#if !defined(QBUF_STATS)
+#error "test_stats must be compiled with QBUF_STATS"
+#endif
+
+using namespace qbuf;
+
+// Drive a queue with 7 usable slots through the same sequence and check every counter
+template <typename Sink, typename Source>
+void check_counters(Sink& sink, Source& source) {
+    assert(sink.stats().enabled);
+    assert(source.stats().enabled);
+
+    // Three single enqueues and a bulk that only fits four of five elements
+    for (int i = 0; i < 3; ++i) assert(sink.try_enqueue(i));
+    const int bulk[5] = { 3, 4, 5, 6, 7 };
+    assert(sink.try_enqueue(bulk, 5) == 4);
+    assert(!sink.try_enqueue(8));
+
+    auto stats = sink.stats();
+    assert(stats.producer.calls == 4);
+    assert(stats.producer.elements == 7);
+    assert(stats.producer.rejections == 1);
+    assert(stats.producer.batch_sizes[0] == 3);
+    assert(stats.producer.batch_sizes[2] == 1);
+    assert(stats.high_water_mark == 7);
+    assert(stats.consumer.calls == 0);
+
+    // A timed-out blocking enqueue counts its wait
+    assert(!sink.enqueue(8, std::chrono::milliseconds(2)));
+    stats = sink.stats();
+    assert(stats.producer.wait_iterations >= 1);
+    assert(stats.producer.wait_ns >= 1000000);
+    assert(stats.producer.calls == 4);
+
+    // Drain everything in one bulk call, then find the queue empty
+    int out[8];
+    assert(source.try_dequeue(out, 8) == 7);
+    assert(!source.try_dequeue().has_value());
+    stats = source.stats();
+    assert(stats.consumer.calls == 1);
+    assert(stats.consumer.elements == 7);
+    assert(stats.consumer.batch_sizes[2] == 1);
+    assert(stats.consumer.rejections >= 1);
+
+    // Zero-copy calls count as one call each
+    auto slots = sink.reserve(2);
+    assert(slots.size() == 2);
+    slots[0] = 10;
+    slots[1] = 11;
+    sink.commit(2);
+    assert(source.peek().size() == 2);
+    source.consume(2);
+    stats = source.stats();
+    assert(stats.producer.calls == 5);
+    assert(stats.producer.elements == 9);
+    assert(stats.producer.batch_sizes[1] == 1);
+    assert(stats.consumer.calls == 2);
+    assert(stats.consumer.elements == 9);
+    assert(stats.high_water_mark == 7);
+}
+
+void test_spsc_stats() {
+    std::cout << "Testing SPSC stats..." << std::endl;
+    auto [sink, source] = SPSC<int, 8>::make_queue();
+    check_counters(sink, source);
+    std::cout << "  PASSED: SPSC stats" << std::endl;
+}
+
+void test_mmap_spsc_stats() {
+    std::cout << "Testing MmapSPSC stats..." << std::endl;
+    // The ring is padded to a page, but occupancy is still limited to Capacity - 1
+    auto [sink, source] = MmapSPSC<int, 8>::create();
+    check_counters(sink, source);
+    std::cout << "  PASSED: MmapSPSC stats" << std::endl;
+}
+
+void test_mutex_queue_stats() {
+    std::cout << "Testing MutexQueue stats..." << std::endl;
+    auto [sink, source] = MutexQueue<int, 8>::make_queue();
+    check_counters(sink, source);
+    std::cout << "  PASSED: MutexQueue stats" << std::endl;
+}
+
+void test_stats_concurrent() {
+    std::cout << "Testing stats under concurrent use..." << std::endl;
+    auto [sink, source] = SPSC<int, 64>::make_queue();
+    constexpr int count = 100000;
+
+    std::thread producer([&, sink = std::move(sink)]() mutable {
+        for (int i = 0; i < count; ++i) assert(sink.enqueue(i, std::chrono::seconds(10)));
+    });
+    for (int i = 0; i < count; ++i) {
+        const auto value = source.dequeue(std::chrono::seconds(10));
+        assert(value.has_value() && *value == i);
+    }
+    producer.join();
+
+    const auto stats = source.stats();
+    assert(stats.producer.elements == count);
+    assert(stats.consumer.elements == count);
+    assert(stats.producer.calls == count);
+    assert(stats.consumer.batch_sizes[0] == count);
+    assert(stats.high_water_mark >= 1 && stats.high_water_mark <= 63);
+    std::cout << "  PASSED: stats under concurrent use" << std::endl;
+}
+
+void run_all_stats_tests() {
+    std::cout << "\n=== Running Stats Tests ===" << std::endl;
+
+    test_spsc_stats();
+    test_mmap_spsc_stats();
+    test_mutex_queue_stats();
+    test_stats_concurrent();
+
+    std::cout << "\n=== All Stats tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_stats_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,205 @@
+#include "assert.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <qbuf/thread_pool.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+void test_thread_pool_external_submit() {
+    std::cout << "Testing external submissions..." << std::endl;
+    ThreadPool pool(3);
+    assert(pool.workers() == 3);
+
+    std::atomic<int> sum { 0 };
+    for (int i = 1; i <= 10000; ++i) {
+        pool.submit([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); });
+    }
+    pool.wait_idle();
+    assert(sum.load() == 10000 * 10001 / 2);
+    assert(pool.pending() == 0);
+
+    // Submitters on several threads
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < 4; ++t) {
+        submitters.emplace_back([&pool, &sum]() {
+            for (int i = 0; i < 1000; ++i) {
+                pool.submit([&sum]() { sum.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto& submitter : submitters) submitter.join();
+    pool.wait_idle();
+    assert(sum.load() == 10000 * 10001 / 2 + 4000);
+
+    bool threw = false;
+    try {
+        ThreadPool empty(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "  PASSED: external submissions" << std::endl;
+}
+
+// Forks two children per task down to `depth`; every task counts itself
+void spawn_tree(ThreadPool& pool, std::atomic<int>& tasks, int depth) {
+    tasks.fetch_add(1, std::memory_order_relaxed);
+    if (depth == 0) return;
+    pool.submit([&pool, &tasks, depth]() { spawn_tree(pool, tasks, depth - 1); });
+    pool.submit([&pool, &tasks, depth]() { spawn_tree(pool, tasks, depth - 1); });
+}
+
+void test_thread_pool_forked_tasks() {
+    std::cout << "Testing forked tasks..." << std::endl;
+    ThreadPool pool(4);
+    std::atomic<int> tasks { 0 };
+    pool.submit([&pool, &tasks]() { spawn_tree(pool, tasks, 14); });
+    pool.wait_idle();
+    assert(tasks.load() == (1 << 15) - 1);
+
+    // One task forks more children than its deque holds; the overflow runs inline
+    std::atomic<int> children { 0 };
+    const int wide = static_cast<int>(ThreadPool::deque_capacity) * 2;
+    pool.submit([&pool, &children, wide]() {
+        for (int i = 0; i < wide; ++i) {
+            pool.submit([&children]() { children.fetch_add(1, std::memory_order_relaxed); });
+        }
+    });
+    pool.wait_idle();
+    assert(children.load() == wide);
+
+    std::cout << "  PASSED: forked tasks" << std::endl;
+}
+
+// Parallel Fibonacci: each task forks one child, computes the other half itself, and joins
+int fib(ThreadPool& pool, int n) {
+    if (n < 2) return n;
+    if (n < 12) return fib(pool, n - 1) + fib(pool, n - 2);
+    std::atomic<bool> done { false };
+    int left = 0;
+    pool.submit([&pool, &done, &left, n]() {
+        left = fib(pool, n - 1);
+        done.store(true, std::memory_order_release);
+    });
+    const int right = fib(pool, n - 2);
+    pool.wait_until([&done]() { return done.load(std::memory_order_acquire); });
+    return left + right;
+}
+
+void test_thread_pool_fork_join() {
+    std::cout << "Testing fork-join with wait_until..." << std::endl;
+    ThreadPool pool(4);
+    std::atomic<int> result { 0 };
+    pool.submit([&pool, &result]() { result.store(fib(pool, 24)); });
+    pool.wait_idle();
+    assert(result.load() == 46368);
+
+    // Outside the pool wait_until just polls
+    std::atomic<bool> ran { false };
+    pool.submit([&ran]() { ran.store(true); });
+    pool.wait_until([&ran]() { return ran.load(); });
+
+    // A single worker still completes joins by running its own children
+    ThreadPool single(1);
+    result.store(0);
+    single.submit([&single, &result]() { result.store(fib(single, 20)); });
+    single.wait_idle();
+    assert(result.load() == 6765);
+
+    std::cout << "  PASSED: fork-join with wait_until" << std::endl;
+}
+
+void test_thread_pool_task_exceptions() {
+    std::cout << "Testing task exceptions..." << std::endl;
+    ThreadPool pool(2);
+    std::atomic<int> ran { 0 };
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&ran, i]() {
+            ran.fetch_add(1, std::memory_order_relaxed);
+            if (i % 10 == 0) throw std::runtime_error("task failed");
+        });
+    }
+
+    // Every task still ran and counted as finished; wait_idle() reports the first failure once
+    bool threw = false;
+    try {
+        pool.wait_idle();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(ran.load() == 100);
+    assert(pool.pending() == 0);
+    pool.wait_idle();
+
+    // A forked task that throws does not take its worker down
+    pool.submit([&pool, &ran]() {
+        pool.submit([]() { throw std::runtime_error("child failed"); });
+        pool.submit([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); });
+    });
+    threw = false;
+    try {
+        pool.wait_idle();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && ran.load() == 101);
+
+    // wait_idle() from inside a task is refused instead of deadlocking
+    std::atomic<bool> refused { false };
+    pool.submit([&pool, &refused]() {
+        try {
+            pool.wait_idle();
+        } catch (const std::logic_error&) {
+            refused.store(true);
+        }
+    });
+    pool.wait_idle();
+    assert(refused.load());
+
+    std::cout << "  PASSED: task exceptions" << std::endl;
+}
+
+void test_thread_pool_destructor_drains() {
+    std::cout << "Testing destructor drains pending tasks..." << std::endl;
+    std::atomic<int> count { 0 };
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit([&count]() { count.fetch_add(1, std::memory_order_relaxed); });
+        }
+    }
+    assert(count.load() == 1000);
+
+    std::cout << "  PASSED: destructor drains pending tasks" << std::endl;
+}
+
+void run_all_thread_pool_tests() {
+    std::cout << "\n=== Running ThreadPool Tests ===" << std::endl;
+
+    test_thread_pool_external_submit();
+    test_thread_pool_forked_tasks();
+    test_thread_pool_fork_join();
+    test_thread_pool_task_exceptions();
+    test_thread_pool_destructor_drains();
+
+    std::cout << "\n=== All ThreadPool tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_thread_pool_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
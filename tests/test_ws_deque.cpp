@@ -0,0 +1,133 @@
+#include "assert.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <qbuf/ws_deque.hpp>
+#include <thread>
+#include <vector>
+
+using namespace qbuf;
+
+void test_ws_deque_owner_and_thief_ends() {
+    std::cout << "Testing owner and thief ends..." << std::endl;
+    auto [owner, stealer] = WsDeque<int, 8>::make_queue();
+    assert(owner.empty() && stealer.empty());
+    assert(owner.capacity() == 8);
+    assert(!owner.pop().has_value());
+    assert(!stealer.steal().has_value());
+
+    for (int i = 0; i < 4; ++i) assert(owner.push(i));
+    assert(owner.size() == 4 && stealer.size() == 4);
+
+    // The owner pops newest first, thieves take the oldest
+    assert(owner.pop().value() == 3);
+    assert(stealer.steal().value() == 0);
+    auto thief = stealer;
+    assert(thief.steal().value() == 1);
+    assert(owner.pop().value() == 2);
+    assert(owner.empty());
+    assert(!owner.pop().has_value());
+    assert(!thief.steal().has_value());
+
+    std::cout << "  PASSED: owner and thief ends" << std::endl;
+}
+
+void test_ws_deque_full_and_wraparound() {
+    std::cout << "Testing full deque and wraparound..." << std::endl;
+    auto [owner, stealer] = WsDeque<std::uint64_t, 4>::make_queue();
+
+    // All slots are usable
+    for (std::uint64_t i = 0; i < 4; ++i) assert(owner.push(i));
+    assert(!owner.push(4));
+    assert(stealer.steal().value() == 0);
+    assert(owner.push(4));
+    assert(!owner.push(5));
+
+    // Indices keep growing past the ring size while the contents stay in order
+    std::uint64_t next = 5;
+    std::uint64_t oldest = 1;
+    for (int round = 0; round < 100; ++round) {
+        assert(stealer.steal().value() == oldest++);
+        assert(owner.push(next++));
+        assert(owner.pop().value() == next - 1);
+        assert(owner.push(next - 1));
+    }
+    assert(owner.size() == 4);
+
+    std::cout << "  PASSED: full deque and wraparound" << std::endl;
+}
+
+void test_ws_deque_concurrent_steal() {
+    std::cout << "Testing concurrent steals..." << std::endl;
+    constexpr int count = 200000;
+    constexpr int thieves = 3;
+    auto [owner, stealer] = WsDeque<int, 64>::make_queue();
+    std::vector<std::atomic<int>> taken(count);
+    std::atomic<int> total { 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; ++t) {
+        threads.emplace_back([thief = stealer, &taken, &total]() mutable {
+            while (total.load(std::memory_order_relaxed) < count) {
+                if (auto value = thief.steal()) {
+                    taken[*value].fetch_add(1, std::memory_order_relaxed);
+                    total.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // The owner pushes everything and pops every third element back, racing the thieves for
+    // the last one whenever the deque is nearly drained
+    for (int i = 0; i < count;) {
+        if (owner.push(i)) {
+            ++i;
+        } else {
+            std::this_thread::yield();
+        }
+        if (i % 3 == 0) {
+            if (auto value = owner.pop()) {
+                taken[*value].fetch_add(1, std::memory_order_relaxed);
+                total.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    while (auto value = owner.pop()) {
+        taken[*value].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+    }
+    for (auto& thread : threads) thread.join();
+
+    // Every element was taken exactly once
+    assert(total.load() == count);
+    for (auto& value : taken) assert(value.load() == 1);
+    assert(owner.empty());
+
+    std::cout << "  PASSED: concurrent steals" << std::endl;
+}
+
+void run_all_ws_deque_tests() {
+    std::cout << "\n=== Running WsDeque Tests ===" << std::endl;
+
+    test_ws_deque_owner_and_thief_ends();
+    test_ws_deque_full_and_wraparound();
+    test_ws_deque_concurrent_steal();
+
+    std::cout << "\n=== All WsDeque tests passed ===" << std::endl;
+}
+
+int main() {
+    try {
+        run_all_ws_deque_tests();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest failed with exception: " << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "\nTest failed with unknown exception" << std::endl;
+        return 1;
+    }
+}